@@ -19,10 +19,18 @@
 #include "ObjectiveFunction.h"
 #include "MIPSolver/IMIPSolver.h"
 
+#include <algorithm>
+
 namespace SHOT
 {
 
-DualSolver::DualSolver(EnvironmentPtr envPtr) { env = envPtr; }
+DualSolver::DualSolver(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+
+    treeStrategySetting = env->settings->getSettingHandle<int>("TreeStrategy", "Dual");
+    saveHyperplanePointsSetting = env->settings->getSettingHandle<bool>("HyperplaneCuts.SaveHyperplanePoints", "Dual");
+}
 
 void DualSolver::addDualSolutionCandidate(DualSolution solution)
 {
@@ -102,7 +110,7 @@ void DualSolver::checkDualSolutionCandidates()
                 break;
             }
 
-            env->output->outputDebug(fmt::format("        New dual bound {}, source: {}", C.objValue, sourceDesc));
+            env->output->outputDebug("        New dual bound {}, source: {}", C.objValue, sourceDesc);
         }
     }
 
@@ -122,16 +130,23 @@ void DualSolver::addHyperplane(Hyperplane& hyperplane)
             && hyperplane.source != E_HyperplaneSource::ObjectiveCuttingPlane
             && (!hasHyperplaneBeenAdded(hyperplane.pointHash, hyperplane.sourceConstraint->index))))
     {
+        // The hyperplane in the waiting list only has the values needed to regenerate it
+        auto point = std::move(hyperplane.generatedPoint);
+        hyperplane.generatedPoint.clear();
+        hyperplane.generatedPointHandle = storeHyperplanePoint(hyperplanePoints, hyperplane, point);
+
         this->hyperplaneWaitingList.push_back(hyperplane);
+
+        hyperplane.generatedPoint = std::move(point);
+        hyperplane.generatedPointHandle = -1;
     }
     else
     {
-        env->output->outputDebug(
-            fmt::format("        Hyperplane with hash {} has been added already.", hyperplane.pointHash));
+        env->output->outputDebug("        Hyperplane with hash {} has been added already.", hyperplane.pointHash);
     }
 }
 
-void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
+void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane, bool isLazy)
 {
     std::string source = "";
 
@@ -189,12 +204,8 @@ void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
         genHyperplane.sourceConstraintIndex = -1;
 
     genHyperplane.iterationGenerated = env->results->getCurrentIteration()->iterationNumber;
-    genHyperplane.isLazy = false;
+    genHyperplane.isLazy = isLazy;
     genHyperplane.pointHash = hyperplane.pointHash;
-
-    if(env->settings->getSetting<bool>("HyperplaneCuts.SaveHyperplanePoints", "Dual"))
-        genHyperplane.generatedPoint = hyperplane.generatedPoint;
-
     genHyperplane.isSourceConvex = hyperplane.isSourceConvex;
 
     if(!genHyperplane.isSourceConvex)
@@ -208,51 +219,332 @@ void DualSolver::addGeneratedHyperplane(const Hyperplane& hyperplane)
 
     if(hasHyperplaneBeenAdded(genHyperplane.pointHash, genHyperplane.sourceConstraintIndex))
     {
-        env->output->outputTrace(fmt::format("        Not added hyperplane with hash {} to constraint {}",
-            genHyperplane.pointHash, genHyperplane.sourceConstraintIndex));
+        env->output->outputTrace("        Not added hyperplane with hash {} to constraint {}", genHyperplane.pointHash,
+            genHyperplane.sourceConstraintIndex);
         return;
     }
 
     if(hyperplane.sourceConstraint)
     {
-        env->output->outputTrace(fmt::format("        Added hyperplane with hash {} to constraint {}",
-            genHyperplane.pointHash, genHyperplane.sourceConstraint->index));
+        env->output->outputTrace("        Added hyperplane with hash {} to constraint {}", genHyperplane.pointHash,
+            genHyperplane.sourceConstraint->index);
+    }
+
+    if(saveHyperplanePointsSetting.get())
+    {
+        if(hyperplane.generatedPointHandle >= 0)
+        {
+            genHyperplane.generatedPointHandle
+                = generatedHyperplanePoints.copyPoint(hyperplanePoints, hyperplane.generatedPointHandle);
+        }
+        else if(hyperplane.generatedPoint.size() > 0)
+        {
+            genHyperplane.generatedPointHandle
+                = storeHyperplanePoint(generatedHyperplanePoints, hyperplane, hyperplane.generatedPoint);
+        }
     }
 
     generatedHyperplanes.push_back(genHyperplane);
 
+    bool isObjectiveHyperplane = (genHyperplane.source == E_HyperplaneSource::ObjectiveRootsearch
+        || genHyperplane.source == E_HyperplaneSource::ObjectiveCuttingPlane);
+    generatedHyperplaneIndex.add(
+        isObjectiveHyperplane ? -1 : genHyperplane.sourceConstraintIndex, genHyperplane.pointHash);
+
     auto currentIteration = env->results->getCurrentIteration();
     currentIteration->numHyperplanesAdded++;
     currentIteration->totNumHyperplanes++;
     env->solutionStatistics.iterationLastDualCutAdded = currentIteration->iterationNumber;
 
-    env->output->outputTrace("        Hyperplane generated from: " + source);
+    env->output->outputTrace("        Hyperplane generated from: {}", source);
 }
 
 bool DualSolver::hasHyperplaneBeenAdded(double hash, int constraintIndex)
 {
     // Cuts added as lazy might not actually always be added (e.g. in different threads), thus we have to allow them to
     // be added again
-    if(env->settings->getSetting<int>("TreeStrategy", "Dual") == static_cast<int>(ES_TreeStrategy::SingleTree))
+    if(treeStrategySetting.get() == static_cast<int>(ES_TreeStrategy::SingleTree))
         return false;
 
-    for(auto& H : generatedHyperplanes)
+    return (isInHashIndex(generatedHyperplaneIndex, constraintIndex, hash));
+}
+
+void DualSolver::clearGeneratedHyperplanes()
+{
+    generatedHyperplanes.clear();
+    generatedHyperplaneIndex.clear();
+    generatedHyperplanePoints.clear();
+}
+
+void DualSolver::clearHyperplaneWaitingList()
+{
+    hyperplaneWaitingList.clear();
+    hyperplanePoints.clear();
+}
+
+const VectorDouble& DualSolver::getHyperplanePoint(const Hyperplane& hyperplane, VectorDouble& point)
+{
+    if(hyperplane.generatedPointHandle < 0)
+        return (hyperplane.generatedPoint);
+
+    point.resize(env->reformulatedProblem->properties.numberOfVariables, 0.0);
+    hyperplanePoints.copyToDensePoint(hyperplane.generatedPointHandle, point);
+
+    return (point);
+}
+
+void DualSolver::getGeneratedHyperplanePoint(const GeneratedHyperplane& hyperplane, VectorDouble& point)
+{
+    assert(hyperplane.generatedPointHandle >= 0);
+
+    point.resize(env->reformulatedProblem->properties.numberOfVariables, 0.0);
+    generatedHyperplanePoints.copyToDensePoint(hyperplane.generatedPointHandle, point);
+}
+
+int DualSolver::storeHyperplanePoint(SparsePointArena& arena, const Hyperplane& hyperplane, const VectorDouble& point)
+{
+    bool isObjectiveHyperplane = hyperplane.isObjectiveHyperplane || !hyperplane.sourceConstraint;
+
+    auto variables = isObjectiveHyperplane ? env->reformulatedProblem->objectiveFunction->getGradientSparsityPattern()
+                                           : hyperplane.sourceConstraint->getGradientSparsityPattern();
+
+    for(auto& V : *variables)
+        arena.addValue(V->index, point);
+
+    // The CppAD tape used when calculating the gradient is evaluated in all of its variables, so their values are also
+    // needed when regenerating the cut
+    auto addTapeVariables = [&](const Variables& tapeVariables) {
+        for(auto& V : tapeVariables)
+        {
+            bool isInPattern = std::binary_search(variables->begin(), variables->end(), V,
+                [](const VariablePtr& variableOne, const VariablePtr& variableTwo) {
+                    return (variableOne->index < variableTwo->index);
+                });
+
+            if(!isInPattern)
+                arena.addValue(V->index, point);
+        }
+    };
+
+    if(isObjectiveHyperplane)
+    {
+        auto objective
+            = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(env->reformulatedProblem->objectiveFunction);
+
+        if(objective && objective->properties.hasNonlinearExpression)
+        {
+            addTapeVariables(objective->gradientTape ? objective->gradientTape->variables
+                                                     : env->reformulatedProblem->nonlinearExpressionVariables);
+        }
+    }
+    else if(auto constraint = std::dynamic_pointer_cast<NonlinearConstraint>(hyperplane.sourceConstraint);
+            constraint && constraint->properties.hasNonlinearExpression)
+    {
+        if(constraint->gradientTape)
+            addTapeVariables(constraint->gradientTape->variables);
+        else if(auto ownerProblem = constraint->ownerProblem.lock())
+            addTapeVariables(ownerProblem->nonlinearExpressionVariables);
+    }
+
+    return (arena.endPoint());
+}
+
+void DualSolver::addCutsToPool(const LinearConstraintBlock& createdConstraints, const VectorInteger& constraintIndexes,
+    const VectorInteger& hyperplaneIndexes)
+{
+    assert((int)constraintIndexes.size() == createdConstraints.getNumberOfRows());
+    assert(constraintIndexes.size() == hyperplaneIndexes.size());
+
+    int iterationNumber = env->results->getCurrentIteration()->iterationNumber;
+
+    for(int i = 0; i < createdConstraints.getNumberOfRows(); i++)
+    {
+        int rowStart = createdConstraints.rowStarts[i];
+        int rowEnd = createdConstraints.rowStarts[i + 1];
+
+        // Cuts with auxiliary variables in the MIP solver, e.g. objective cuts, cannot be evaluated in the solution
+        // points and are not managed
+        if(std::any_of(createdConstraints.variableIndexes.begin() + rowStart,
+               createdConstraints.variableIndexes.begin() + rowEnd,
+               [&](int index) { return (index >= env->reformulatedProblem->properties.numberOfVariables); }))
+        {
+            continue;
+        }
+
+        cutPool.variableIndexes.insert(cutPool.variableIndexes.end(),
+            createdConstraints.variableIndexes.begin() + rowStart, createdConstraints.variableIndexes.begin() + rowEnd);
+        cutPool.coefficients.insert(cutPool.coefficients.end(), createdConstraints.coefficients.begin() + rowStart,
+            createdConstraints.coefficients.begin() + rowEnd);
+        cutPool.rowStarts.push_back(cutPool.variableIndexes.size());
+        cutPool.constants.push_back(createdConstraints.constants[i]);
+
+        cutPoolConstraintIndexes.push_back(constraintIndexes[i]);
+        cutPoolHyperplaneIndexes.push_back(hyperplaneIndexes[i]);
+        cutPoolIterationsLastBinding.push_back(iterationNumber);
+        cutPoolIsActive.push_back(true);
+        numberOfActivePoolCuts++;
+    }
+
+    env->results->getCurrentIteration()->numberOfActivePoolCuts = numberOfActivePoolCuts;
+}
+
+void DualSolver::updateCutPool(const std::vector<SolutionPoint>& solutionPoints, int iterationNumber)
+{
+    auto currentIteration = env->results->getCurrentIteration();
+    currentIteration->numberOfActivePoolCuts = numberOfActivePoolCuts;
+
+    if(cutPool.getNumberOfRows() == 0 || solutionPoints.size() == 0)
+        return;
+
+    int maxAge = env->settings->getSetting<int>("HyperplaneCuts.Pool.MaxAge", "Dual");
+    int deleteAge = env->settings->getSetting<int>("HyperplaneCuts.Pool.DeleteAge", "Dual");
+    double slackTolerance = env->settings->getSetting<double>("HyperplaneCuts.Pool.SlackTolerance", "Dual");
+
+    VectorInteger deactivatedCuts;
+    VectorInteger activatedCuts;
+    VectorInteger deletedCuts;
+
+    for(int i = 0; i < cutPool.getNumberOfRows(); i++)
     {
-        if((H.source == E_HyperplaneSource::ObjectiveRootsearch
-               || H.source == E_HyperplaneSource::ObjectiveCuttingPlane)
-            && constraintIndex == -1 && Utilities::isAlmostEqual(H.pointHash, hash, 1e-8))
+        // The cuts are on the form sum(a_j * x_j) + c <= 0, so a value close to zero in a point means it is binding
+        double maxValue = SHOT_DBL_MIN;
+
+        for(auto& P : solutionPoints)
+        {
+            double value = cutPool.constants[i];
+
+            for(int j = cutPool.rowStarts[i]; j < cutPool.rowStarts[i + 1]; j++)
+                value += cutPool.coefficients[j] * P.point[cutPool.variableIndexes[j]];
+
+            maxValue = std::max(maxValue, value);
+        }
+
+        if(cutPoolIsActive[i])
+        {
+            if(maxValue >= -slackTolerance)
+                cutPoolIterationsLastBinding[i] = iterationNumber;
+            else if(iterationNumber - cutPoolIterationsLastBinding[i] >= maxAge)
+                deactivatedCuts.push_back(i);
+        }
+        else if(maxValue > slackTolerance)
         {
-            return (true);
+            activatedCuts.push_back(i);
         }
-        else if(H.source != E_HyperplaneSource::ObjectiveRootsearch
-            && H.source != E_HyperplaneSource::ObjectiveCuttingPlane && H.sourceConstraint->index == constraintIndex
-            && Utilities::isAlmostEqual(H.pointHash, hash, 1e-8))
+        else if(iterationNumber - cutPoolIterationsLastBinding[i] >= maxAge + deleteAge)
         {
-            return (true);
+            deletedCuts.push_back(i);
         }
     }
 
-    return (false);
+    if(deactivatedCuts.size() > 0)
+    {
+        VectorInteger constraintIndexes;
+
+        for(auto I : deactivatedCuts)
+            constraintIndexes.push_back(cutPoolConstraintIndexes[I]);
+
+        if(MIPSolver->deactivateLinearConstraints(constraintIndexes))
+        {
+            for(auto I : deactivatedCuts)
+            {
+                cutPoolIsActive[I] = false;
+
+                if(cutPoolHyperplaneIndexes[I] >= 0 && cutPoolHyperplaneIndexes[I] < (int)generatedHyperplanes.size())
+                    generatedHyperplanes[cutPoolHyperplaneIndexes[I]].isRemoved = true;
+            }
+
+            numberOfActivePoolCuts -= deactivatedCuts.size();
+            currentIteration->numberOfDeactivatedPoolCuts = deactivatedCuts.size();
+        }
+    }
+
+    if(activatedCuts.size() > 0)
+    {
+        VectorInteger constraintIndexes;
+        VectorDouble rightHandSides;
+
+        for(auto I : activatedCuts)
+        {
+            constraintIndexes.push_back(cutPoolConstraintIndexes[I]);
+            rightHandSides.push_back(-cutPool.constants[I]);
+        }
+
+        if(MIPSolver->activateLinearConstraints(constraintIndexes, rightHandSides))
+        {
+            for(auto I : activatedCuts)
+            {
+                cutPoolIsActive[I] = true;
+                cutPoolIterationsLastBinding[I] = iterationNumber;
+
+                if(cutPoolHyperplaneIndexes[I] >= 0 && cutPoolHyperplaneIndexes[I] < (int)generatedHyperplanes.size())
+                    generatedHyperplanes[cutPoolHyperplaneIndexes[I]].isRemoved = false;
+            }
+
+            numberOfActivePoolCuts += activatedCuts.size();
+            currentIteration->numberOfActivatedPoolCuts = activatedCuts.size();
+        }
+    }
+
+    // The rows of cuts that have been removed for long are deleted in one batch, so that the MIP problem does not only
+    // grow. The cuts are dropped from the pool, and the constraint indexes of the remaining cuts are decreased.
+    if(deletedCuts.size() > 0)
+    {
+        VectorInteger constraintIndexes;
+
+        for(auto I : deletedCuts)
+            constraintIndexes.push_back(cutPoolConstraintIndexes[I]);
+
+        std::sort(constraintIndexes.begin(), constraintIndexes.end());
+
+        if(MIPSolver->deleteLinearConstraints(constraintIndexes))
+        {
+            LinearConstraintBlock remainingCuts;
+            int numberOfRemainingCuts = 0;
+            size_t nextDeletedCut = 0;
+
+            for(int i = 0; i < cutPool.getNumberOfRows(); i++)
+            {
+                if(nextDeletedCut < deletedCuts.size() && deletedCuts[nextDeletedCut] == i)
+                {
+                    nextDeletedCut++;
+                    continue;
+                }
+
+                remainingCuts.variableIndexes.insert(remainingCuts.variableIndexes.end(),
+                    cutPool.variableIndexes.begin() + cutPool.rowStarts[i],
+                    cutPool.variableIndexes.begin() + cutPool.rowStarts[i + 1]);
+                remainingCuts.coefficients.insert(remainingCuts.coefficients.end(),
+                    cutPool.coefficients.begin() + cutPool.rowStarts[i],
+                    cutPool.coefficients.begin() + cutPool.rowStarts[i + 1]);
+                remainingCuts.rowStarts.push_back(remainingCuts.variableIndexes.size());
+                remainingCuts.constants.push_back(cutPool.constants[i]);
+
+                int constraintIndex = cutPoolConstraintIndexes[i];
+
+                cutPoolConstraintIndexes[numberOfRemainingCuts] = constraintIndex
+                    - (int)(std::lower_bound(constraintIndexes.begin(), constraintIndexes.end(), constraintIndex)
+                        - constraintIndexes.begin());
+                cutPoolHyperplaneIndexes[numberOfRemainingCuts] = cutPoolHyperplaneIndexes[i];
+                cutPoolIterationsLastBinding[numberOfRemainingCuts] = cutPoolIterationsLastBinding[i];
+                cutPoolIsActive[numberOfRemainingCuts] = cutPoolIsActive[i];
+                numberOfRemainingCuts++;
+            }
+
+            cutPool = std::move(remainingCuts);
+            cutPoolConstraintIndexes.resize(numberOfRemainingCuts);
+            cutPoolHyperplaneIndexes.resize(numberOfRemainingCuts);
+            cutPoolIterationsLastBinding.resize(numberOfRemainingCuts);
+            cutPoolIsActive.resize(numberOfRemainingCuts);
+
+            currentIteration->numberOfDeletedPoolCuts = deletedCuts.size();
+        }
+    }
+
+    currentIteration->numberOfActivePoolCuts = numberOfActivePoolCuts;
+
+    env->output->outputDebug("        Cut pool: {} of {} cuts active, {} removed, {} added again and {} deleted.",
+        numberOfActivePoolCuts, cutPool.getNumberOfRows(), currentIteration->numberOfDeactivatedPoolCuts,
+        currentIteration->numberOfActivatedPoolCuts, currentIteration->numberOfDeletedPoolCuts);
 }
 
 void DualSolver::addIntegerCut(IntegerCut integerCut)
@@ -269,8 +561,7 @@ void DualSolver::addIntegerCut(IntegerCut integerCut)
     if(!hasIntegerCutBeenAdded(integerCut.pointHash))
         this->integerCutWaitingList.push_back(integerCut);
     else
-        env->output->outputDebug(
-            fmt::format("        Integer cut with hash {} has been added already.", integerCut.pointHash));
+        env->output->outputDebug("        Integer cut with hash {} has been added already.", integerCut.pointHash);
 }
 
 void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
@@ -295,9 +586,10 @@ void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
         env->output->outputInfo("        Solution is no longer global since integer cut has been added.");
     }
 
-    env->output->outputDebug(fmt::format("        Added integer cut with hash {}", integerCut.pointHash));
+    env->output->outputDebug("        Added integer cut with hash {}", integerCut.pointHash);
 
     generatedIntegerCuts.push_back(integerCut);
+    generatedIntegerCutIndex.add(0, integerCut.pointHash);
 
     auto currentIteration = env->results->getCurrentIteration();
     currentIteration->numHyperplanesAdded++;
@@ -305,20 +597,21 @@ void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
 
     env->solutionStatistics.numberOfIntegerCuts++;
 
-    env->output->outputDebug("        Integer cut generated from: " + source);
+    env->output->outputDebug("        Integer cut generated from: {}", source);
 }
 
-bool DualSolver::hasIntegerCutBeenAdded(double hash)
+bool DualSolver::hasIntegerCutBeenAdded(double hash) { return (isInHashIndex(generatedIntegerCutIndex, 0, hash)); }
+
+bool DualSolver::isInHashIndex(const Utilities::HashIndex& index, int group, double hash)
 {
-    for(auto& IC : generatedIntegerCuts)
-    {
-        if(Utilities::isAlmostEqual(IC.pointHash, hash, 1e-8))
-        {
-            return (true);
-        }
-    }
+    bool found = index.contains(group, hash, env->solutionStatistics.numberOfHashIndexCollisions);
+
+    if(found)
+        env->solutionStatistics.numberOfHashIndexHits++;
+    else
+        env->solutionStatistics.numberOfHashIndexMisses++;
 
-    return (false);
+    return (found);
 }
 
 } // namespace SHOT
\ No newline at end of file
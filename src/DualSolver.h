@@ -10,7 +10,9 @@
 
 #pragma once
 #include "Environment.h"
+#include "Settings.h"
 #include "Structs.h"
+#include "Utilities.h"
 
 namespace SHOT
 {
@@ -28,16 +30,45 @@ public:
     void checkDualSolutionCandidates();
 
     void addHyperplane(Hyperplane& hyperplane);
-    void addGeneratedHyperplane(const Hyperplane& hyperplane);
+    // Lazy hyperplanes are the ones added in a callback of the MIP solver in the single-tree strategy
+    void addGeneratedHyperplane(const Hyperplane& hyperplane, bool isLazy = false);
     bool hasHyperplaneBeenAdded(double hash, int constraintIndex);
 
     void addIntegerCut(IntegerCut integerCut);
     void addGeneratedIntegerCut(IntegerCut integerCut);
     bool hasIntegerCutBeenAdded(double hash);
 
+    void clearGeneratedHyperplanes();
+    void clearHyperplaneWaitingList();
+
+    // Returns the point of the hyperplane. If it is stored in hyperplanePoints, it is written into point where only the
+    // values needed when calculating the source constraint or objective and its gradient are defined.
+    const VectorDouble& getHyperplanePoint(const Hyperplane& hyperplane, VectorDouble& point);
+
+    // Writes the saved point of the generated hyperplane into point, where only the values needed when calculating the
+    // source constraint or objective and its gradient are defined
+    void getGeneratedHyperplanePoint(const GeneratedHyperplane& hyperplane, VectorDouble& point);
+
+    // Adds the cuts given as the rows in createdConstraints to the cut pool, together with their constraint indexes in
+    // the MIP solver and their indexes in generatedHyperplanes (-1 if not there)
+    void addCutsToPool(const LinearConstraintBlock& createdConstraints, const VectorInteger& constraintIndexes,
+        const VectorInteger& hyperplaneIndexes);
+
+    // Deactivates the cuts in the pool that have not been binding in any of the solution points for
+    // HyperplaneCuts.Pool.MaxAge iterations, and activates the deactivated cuts violated by any of the points
+    void updateCutPool(const std::vector<SolutionPoint>& solutionPoints, int iterationNumber);
+
+    // The number of cuts in the cut pool, both active and deactivated
+    inline int getNumberOfPoolCuts() { return (cutPool.getNumberOfRows()); }
+
     std::vector<GeneratedHyperplane> generatedHyperplanes;
     std::vector<Hyperplane> hyperplaneWaitingList;
 
+    // The points of the hyperplanes in the waiting list and the saved points of the generated hyperplanes, restricted
+    // to the variables needed when calculating the source constraint or objective and its gradient
+    SparsePointArena hyperplanePoints;
+    SparsePointArena generatedHyperplanePoints;
+
     std::vector<IntegerCut> generatedIntegerCuts;
     std::vector<IntegerCut> integerCutWaitingList;
 
@@ -50,6 +81,27 @@ public:
 
 private:
     EnvironmentPtr env;
+
+    SettingHandle<int> treeStrategySetting;
+    SettingHandle<bool> saveHyperplanePointsSetting;
+
+    // Point hashes of the generated hyperplanes grouped by source constraint index (-1 for the objective), and of the
+    // generated integer cuts
+    Utilities::HashIndex generatedHyperplaneIndex;
+    Utilities::HashIndex generatedIntegerCutIndex;
+
+    bool isInHashIndex(const Utilities::HashIndex& index, int group, double hash);
+
+    // Stores the values in the dense point needed to regenerate the hyperplane and returns the handle
+    int storeHyperplanePoint(SparsePointArena& arena, const Hyperplane& hyperplane, const VectorDouble& point);
+
+    // The cuts in the cut pool, with the terms of each cut as a row in cutPool
+    LinearConstraintBlock cutPool;
+    VectorInteger cutPoolConstraintIndexes;
+    VectorInteger cutPoolHyperplaneIndexes;
+    VectorInteger cutPoolIterationsLastBinding;
+    std::vector<bool> cutPoolIsActive;
+    int numberOfActivePoolCuts = 0;
 };
 
 } // namespace SHOT
\ No newline at end of file
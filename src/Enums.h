@@ -262,6 +262,13 @@ enum class ES_AddPrimalPointAsInteriorPoint
     OnlyAverage
 };
 
+enum class ES_GradientTapePartitioning
+{
+    None,
+    Constraint,
+    ConnectedConstraints
+};
+
 enum class ES_HyperplaneCutStrategy
 {
     ESH,
@@ -301,7 +308,8 @@ enum class ES_RootsearchConstraintStrategy
 enum class ES_RootsearchMethod
 {
     BoostTOMS748,
-    BoostBisection
+    BoostBisection,
+    MultiSection
 };
 
 enum class ES_MIPSolver
@@ -11,6 +11,7 @@
 #include "Iteration.h"
 #include "Results.h"
 #include "Settings.h"
+#include "Timing.h"
 
 namespace SHOT
 {
@@ -27,8 +28,7 @@ Iteration::Iteration(EnvironmentPtr envPtr)
     else if(env->settings->getSetting<bool>("TreeStrategy.Multi.Reinitialize", "Dual"))
         this->totNumHyperplanes = 0;
     else
-        this->totNumHyperplanes
-            = env->results->iterations.at(env->results->getNumberOfIterations() - 1)->totNumHyperplanes;
+        this->totNumHyperplanes = env->results->getCurrentIteration()->totNumHyperplanes;
 
     this->maxDeviation = SHOT_DBL_MAX;
     this->boundaryDistance = SHOT_DBL_MAX;
@@ -39,6 +39,8 @@ Iteration::Iteration(EnvironmentPtr envPtr)
 
     currentObjectiveBounds.first = env->results->getCurrentDualBound();
     currentObjectiveBounds.second = env->results->getPrimalBound();
+
+    startTime = env->timing->getElapsedTime("Total");
 }
 
 Iteration::~Iteration()
@@ -83,4 +85,38 @@ int Iteration::getSolutionPointWithSmallestDeviationIndex()
 
     return (tmpIdx);
 }
+
+IterationSummary Iteration::getSummary()
+{
+    IterationSummary summary;
+
+    summary.iterationNumber = iterationNumber;
+
+    summary.isMIP = isMIP();
+    summary.solutionStatus = solutionStatus;
+    summary.numberOfSolutionPoints = solutionPoints.size();
+
+    summary.objectiveValue = objectiveValue;
+    summary.currentObjectiveBounds = currentObjectiveBounds;
+
+    summary.maxDeviation = maxDeviation;
+    summary.maxDeviationConstraint = maxDeviationConstraint;
+
+    summary.numHyperplanesAdded = numHyperplanesAdded;
+    summary.totNumHyperplanes = totNumHyperplanes;
+    summary.relaxedLazyHyperplanesAdded = relaxedLazyHyperplanesAdded;
+
+    summary.numberOfActivePoolCuts = numberOfActivePoolCuts;
+    summary.numberOfDeactivatedPoolCuts = numberOfDeactivatedPoolCuts;
+    summary.numberOfActivatedPoolCuts = numberOfActivatedPoolCuts;
+    summary.numberOfDeletedPoolCuts = numberOfDeletedPoolCuts;
+
+    summary.numberOfExploredNodes = numberOfExploredNodes;
+    summary.numberOfOpenNodes = numberOfOpenNodes;
+
+    summary.startTime = startTime;
+    summary.solutionTime = solutionTime;
+
+    return (summary);
+}
 } // namespace SHOT
\ No newline at end of file
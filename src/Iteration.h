@@ -15,6 +15,37 @@
 
 namespace SHOT
 {
+// The information about an iteration that is kept after the iteration has been removed from the iteration history
+struct IterationSummary
+{
+    int iterationNumber = 0;
+
+    bool isMIP = false;
+    E_ProblemSolutionStatus solutionStatus = E_ProblemSolutionStatus::None;
+    int numberOfSolutionPoints = 0;
+
+    double objectiveValue = NAN;
+    PairDouble currentObjectiveBounds;
+
+    double maxDeviation = 0.0;
+    int maxDeviationConstraint = -1;
+
+    int numHyperplanesAdded = 0;
+    int totNumHyperplanes = 0;
+    int relaxedLazyHyperplanesAdded = 0;
+
+    int numberOfActivePoolCuts = 0;
+    int numberOfDeactivatedPoolCuts = 0;
+    int numberOfActivatedPoolCuts = 0;
+    int numberOfDeletedPoolCuts = 0;
+
+    int numberOfExploredNodes = 0;
+    int numberOfOpenNodes = 0;
+
+    double startTime = 0.0;
+    double solutionTime = 0.0;
+};
+
 class Iteration
 {
 public:
@@ -49,12 +80,22 @@ public:
     int numberOfExploredNodes = 0;
     int numberOfOpenNodes = 0;
 
+    // The number of cuts in the MIP solver from the cut pool, and the cuts removed, added again and deleted from the
+    // MIP problem in this iteration
+    int numberOfActivePoolCuts = 0;
+    int numberOfDeactivatedPoolCuts = 0;
+    int numberOfActivatedPoolCuts = 0;
+    int numberOfDeletedPoolCuts = 0;
+
     double boundaryDistance;
 
     bool isMIP();
     bool isSolved = false;
 
-    double solutionTime;
+    // The total solution time when the iteration was created, and the time used for solving its dual problem
+    double startTime = 0.0;
+    double solutionTime = 0.0;
+
     bool hasInfeasibilityRepairBeenPerformed = false;
     bool wasInfeasibilityRepairSuccessful = false;
     int numberOfInfeasibilityRepairedConstraints = 0;
@@ -66,6 +107,8 @@ public:
     SolutionPoint getSolutionPointWithSmallestDeviation();
     int getSolutionPointWithSmallestDeviationIndex();
 
+    IterationSummary getSummary();
+
 private:
     EnvironmentPtr env;
 };
@@ -82,6 +82,22 @@ public:
         const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
         = 0;
 
+    // Adds all the rows in the block at once, returns the index of the first added constraint or -1 if they could not
+    // be added
+    virtual int addLinearConstraints(const LinearConstraintBlock& constraints) = 0;
+
+    // Relaxes the right-hand sides of the given <= constraints so that they are not enforced, e.g. for the cuts removed
+    // from the cut pool. The constraints are kept, so that the indexes of the other constraints do not change.
+    virtual bool deactivateLinearConstraints(const VectorInteger& constraintIndexes) = 0;
+
+    // Restores the right-hand sides of constraints deactivated with deactivateLinearConstraints
+    virtual bool activateLinearConstraints(const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides)
+        = 0;
+
+    // Deletes the constraints with the given indexes, which should be increasing, e.g. cuts that have been deactivated
+    // for long. The indexes of the constraints after a deleted one are decreased.
+    virtual bool deleteLinearConstraints(const VectorInteger& constraintIndexes) = 0;
+
     virtual void setTimeLimit(double seconds) = 0;
 
     virtual void setCutOff(double cutOff) = 0;
@@ -103,11 +119,20 @@ public:
     virtual void presolveAndUpdateBounds() = 0;
     virtual std::pair<VectorDouble, VectorDouble> presolveAndGetNewBounds() = 0;
 
-    virtual bool createHyperplane(Hyperplane hyperplane) = 0;
-    virtual bool createInteriorHyperplane(Hyperplane hyperplane) = 0;
+    virtual bool createHyperplane(const Hyperplane& hyperplane) = 0;
+
+    // Creates the hyperplanes as one block of linear constraints, returns the constraint index of each of them or -1 if
+    // it was not added. The terms of the added constraints are given as the rows in createdConstraints.
+    virtual VectorInteger createHyperplanes(
+        const std::vector<Hyperplane>& hyperplanes, LinearConstraintBlock& createdConstraints)
+        = 0;
+
+    virtual bool createInteriorHyperplane(const Hyperplane& hyperplane) = 0;
     virtual bool createIntegerCut(IntegerCut& integerCut) = 0;
 
-    virtual std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) = 0;
+    virtual std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(
+        const Hyperplane& hyperplane)
+        = 0;
 
     virtual bool supportsQuadraticObjective() = 0;
     virtual bool supportsQuadraticConstraints() = 0;
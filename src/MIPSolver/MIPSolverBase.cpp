@@ -17,6 +17,8 @@
 #include "../Settings.h"
 #include "../Utilities.h"
 
+#include <algorithm>
+
 namespace SHOT
 {
 
@@ -110,18 +112,83 @@ std::vector<SolutionPoint> MIPSolverBase::getAllVariableSolutions()
     return (lastSolutions);
 }
 
-bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
+bool MIPSolverBase::createHyperplane(const Hyperplane& hyperplane)
 {
-    auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
+    auto terms = createCheckedHyperplaneTerms(hyperplane);
 
-    auto optional = createHyperplaneTerms(hyperplane);
+    if(!terms)
+        return (false);
 
-    if(!optional)
-    {
+    if(addLinearConstraint(terms->first, terms->second, createHyperplaneIdentifier(hyperplane), false,
+           !hyperplane.isSourceConvex)
+        < 0)
         return (false);
+
+    return (true);
+}
+
+VectorInteger MIPSolverBase::createHyperplanes(
+    const std::vector<Hyperplane>& hyperplanes, LinearConstraintBlock& createdConstraints)
+{
+    VectorInteger constraintIndexes(hyperplanes.size(), -1);
+
+    LinearConstraintBlock block;
+
+    // Creating the names is expensive, and they are only used in the problem files written in debug mode
+    bool nameConstraints = env->settings->getSetting<bool>("Debug.Enable", "Output");
+
+    for(size_t i = 0; i < hyperplanes.size(); i++)
+    {
+        auto terms = createCheckedHyperplaneTerms(hyperplanes[i]);
+
+        if(!terms)
+            continue;
+
+        for(auto& E : terms->first)
+        {
+            block.variableIndexes.push_back(E.first);
+            block.coefficients.push_back(E.second);
+        }
+
+        block.rowStarts.push_back(block.variableIndexes.size());
+        block.constants.push_back(terms->second);
+        block.allowRepair.push_back(!hyperplanes[i].isSourceConvex);
+
+        if(nameConstraints)
+            block.names.push_back(createHyperplaneIdentifier(hyperplanes[i]));
+        else
+            constraintCounter++;
+
+        constraintIndexes[i] = block.getNumberOfRows() - 1;
     }
 
-    auto tmpPair = optional.value();
+    if(block.getNumberOfRows() == 0)
+        return (constraintIndexes);
+
+    int firstConstraintIndex = addLinearConstraints(block);
+
+    for(auto& I : constraintIndexes)
+    {
+        if(I >= 0)
+            I = (firstConstraintIndex >= 0) ? firstConstraintIndex + I : -1;
+    }
+
+    if(firstConstraintIndex >= 0)
+        createdConstraints = std::move(block);
+
+    return (constraintIndexes);
+}
+
+std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createCheckedHyperplaneTerms(
+    const Hyperplane& hyperplane)
+{
+    auto optional = createHyperplaneTerms(hyperplane);
+
+    if(!optional)
+        return (optional);
+
+    auto& tmpPair = optional.value();
+    auto& point = env->dualSolver->getHyperplanePoint(hyperplane, hyperplanePoint);
 
     for(auto& E : tmpPair.first)
     {
@@ -131,14 +198,14 @@ bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
                 env->output->outputError("        Warning: hyperplane for objective function not generated, NaN or inf "
                                          "found in linear terms for "
                     + env->reformulatedProblem->getVariable(E.first)->name + " = "
-                    + std::to_string(hyperplane.generatedPoint.at(E.first)));
+                    + std::to_string(point.at(E.first)));
             else
                 env->output->outputError("        Warning: hyperplane for constraint "
                     + hyperplane.sourceConstraint->name + " not generated,  NaN or inf found in linear terms for "
                     + env->reformulatedProblem->getVariable(E.first)->name + " = "
-                    + std::to_string(hyperplane.generatedPoint.at(E.first)));
+                    + std::to_string(point.at(E.first)));
 
-            return (false);
+            return (std::nullopt);
         }
     }
 
@@ -162,8 +229,11 @@ bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
         }
     }
 
-    std::string constraintName;
+    return (optional);
+}
 
+std::string MIPSolverBase::createHyperplaneIdentifier(const Hyperplane& hyperplane)
+{
     std::string identifier = getConstraintIdentifier(hyperplane.source);
 
     if(hyperplane.sourceConstraint != nullptr)
@@ -172,18 +242,17 @@ bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
     identifier += "_" + std::to_string(constraintCounter);
     constraintCounter++;
 
-    if(addLinearConstraint(tmpPair.first, tmpPair.second, identifier, false, !hyperplane.isSourceConvex) < 0)
-        return (false);
-
-    return (true);
+    return (identifier);
 }
 
-std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyperplaneTerms(Hyperplane hyperplane)
+std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyperplaneTerms(
+    const Hyperplane& hyperplane)
 {
     std::map<int, double> elements;
     double constant = 0.0;
-    SparseVariableVector gradient;
+    SparseVariableVector& gradient = hyperplaneGradient;
     double signFactor = 1.0; // Will be -1.0 for greater than constraints
+    auto& point = env->dualSolver->getHyperplanePoint(hyperplane, hyperplanePoint);
 
     if(hyperplane.isObjectiveHyperplane)
     {
@@ -191,26 +260,24 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
 
         if(env->reformulatedProblem->objectiveFunction->properties.hasNonlinearExpression)
         {
-            gradient
-                = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
-                      ->calculateGradient(hyperplane.generatedPoint, true);
+            std::dynamic_pointer_cast<NonlinearObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
+                ->calculateGradient(point, true, gradient);
         }
         else
         {
-            gradient
-                = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
-                      ->calculateGradient(hyperplane.generatedPoint, true);
+            std::dynamic_pointer_cast<QuadraticObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
+                ->calculateGradient(point, true, gradient);
         }
 
         elements.emplace(dualAuxiliaryObjectiveVariableIndex, -1.0);
 
-        env->output->outputTrace("        HP point generated for objective function with "
-            + std::to_string(gradient.size()) + " elements and constant " + std::to_string(constant));
+        env->output->outputTrace("        HP point generated for objective function with {} elements and constant {}",
+            gradient.size(), constant);
     }
     else
     {
         assert(hyperplane.sourceConstraint);
-        auto maxDev = hyperplane.sourceConstraint->calculateNumericValue(hyperplane.generatedPoint);
+        auto maxDev = hyperplane.sourceConstraint->calculateNumericValue(point);
 
         if(maxDev.isFulfilledRHS && !maxDev.isFulfilledLHS)
         {
@@ -222,16 +289,11 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
             constant = maxDev.normalizedRHSValue;
         }
 
-        gradient = std::dynamic_pointer_cast<NonlinearConstraint>(hyperplane.sourceConstraint)
-                       ->calculateGradient(hyperplane.generatedPoint, true);
+        hyperplane.sourceConstraint->calculateGradient(point, true, gradient);
 
-        auto nonzeroes
-            = std::count_if(gradient.begin(), gradient.end(), [](auto element) { return (element.second != 0.0); });
-
-        if(nonzeroes == 0)
+        if(gradient.size() == 0)
         {
-            gradient = std::dynamic_pointer_cast<NonlinearConstraint>(hyperplane.sourceConstraint)
-                           ->calculateGradient(hyperplane.generatedPoint, false);
+            hyperplane.sourceConstraint->calculateGradient(point, false, gradient);
 
             double eps = 0.000001;
 
@@ -244,15 +306,14 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
             env->output->outputDebug("        All gradients nonzero, adding tolerance.");
         }
 
-        env->output->outputTrace("        HP point generated for constraint index "
-            + std::to_string(hyperplane.sourceConstraintIndex) + " with " + std::to_string(gradient.size())
-            + " elements.");
+        env->output->outputTrace("        HP point generated for constraint index {} with {} elements.",
+            hyperplane.sourceConstraintIndex, gradient.size());
     }
 
     for(auto const& G : gradient)
     {
         double coefficient = signFactor * G.second;
-        int variableIndex = G.first->index;
+        int variableIndex = G.first;
 
         auto element = elements.emplace(variableIndex, coefficient);
 
@@ -262,10 +323,10 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
             element.first->second += coefficient;
         }
 
-        constant += signFactor * (-G.second) * hyperplane.generatedPoint.at(variableIndex);
+        constant += signFactor * (-G.second) * point.at(variableIndex);
 
-        env->output->outputTrace("         Gradient for variable " + G.first->name + " in point "
-            + std::to_string(hyperplane.generatedPoint.at(variableIndex)) + ": " + std::to_string(coefficient));
+        env->output->outputTrace("         Gradient for variable {} in point {}: {}",
+            env->reformulatedProblem->getVariable(variableIndex)->name, point.at(variableIndex), coefficient);
     }
 
     std::optional<std::pair<std::map<int, double>, double>> optional;
@@ -278,7 +339,7 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
     return (optional);
 }
 
-bool MIPSolverBase::createInteriorHyperplane([[maybe_unused]] Hyperplane hyperplane)
+bool MIPSolverBase::createInteriorHyperplane([[maybe_unused]] const Hyperplane& hyperplane)
 {
     /*
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
@@ -369,8 +430,8 @@ void MIPSolverBase::presolveAndUpdateBounds()
         if(newLB)
         {
             env->reformulatedProblem->getVariable(i)->lowerBound = newBounds.first.at(i);
-            env->output->outputDebug("        Lower bound for variable (" + std::to_string(i) + ") updated from "
-                + Utilities::toString(currBounds.first) + " to " + Utilities::toString(newBounds.first.at(i)));
+            env->output->outputDebug("        Lower bound for variable ({}) updated from {} to {}", i,
+                Utilities::toString(currBounds.first), Utilities::toString(newBounds.first.at(i)));
 
             if(!env->reformulatedProblem->allVariables[i]->properties.hasLowerBoundBeenTightened)
             {
@@ -382,8 +443,8 @@ void MIPSolverBase::presolveAndUpdateBounds()
         if(newUB)
         {
             env->reformulatedProblem->getVariable(i)->upperBound = newBounds.second.at(i);
-            env->output->outputDebug("        Upper bound for variable (" + std::to_string(i) + ") updated from "
-                + Utilities::toString(currBounds.second) + " to " + Utilities::toString(newBounds.second.at(i)));
+            env->output->outputDebug("        Upper bound for variable ({}) updated from {} to {}", i,
+                Utilities::toString(currBounds.second), Utilities::toString(newBounds.second.at(i)));
 
             if(!env->reformulatedProblem->allVariables[i]->properties.hasUpperBoundBeenTightened)
             {
@@ -439,5 +500,33 @@ void MIPSolverBase::unfixVariables()
     isVariablesFixed = false;
 }
 
+void MIPSolverBase::updateConstraintIndexesAfterDeletion(const VectorInteger& deletedConstraintIndexes)
+{
+    auto isDeleted = [&](int index) {
+        return (std::binary_search(deletedConstraintIndexes.begin(), deletedConstraintIndexes.end(), index));
+    };
+
+    // The number of deleted constraints before a constraint is subtracted from its index
+    auto getIndexAfterDeletion = [&](int index) {
+        return (index
+            - (int)(std::lower_bound(deletedConstraintIndexes.begin(), deletedConstraintIndexes.end(), index)
+                - deletedConstraintIndexes.begin()));
+    };
+
+    if(cutOffConstraintDefined)
+        cutOffConstraintIndex = getIndexAfterDeletion(cutOffConstraintIndex);
+
+    integerCuts.erase(std::remove_if(integerCuts.begin(), integerCuts.end(), isDeleted), integerCuts.end());
+
+    for(auto& I : integerCuts)
+        I = getIndexAfterDeletion(I);
+
+    for(auto it = deletedConstraintIndexes.rbegin(); it != deletedConstraintIndexes.rend(); it++)
+    {
+        if(*it < (int)allowRepairOfConstraint.size())
+            allowRepairOfConstraint.erase(allowRepairOfConstraint.begin() + *it);
+    }
+}
+
 int MIPSolverBase::getNumberOfOpenNodes() { return (env->solutionStatistics.numberOfOpenNodes); }
 } // namespace SHOT
\ No newline at end of file
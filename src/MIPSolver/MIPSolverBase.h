@@ -12,6 +12,7 @@
 #include "../Environment.h"
 #include "../Enums.h"
 #include "../Structs.h"
+#include "../Model/Variables.h"
 #include "IMIPSolver.h"
 
 #include "IRelaxationStrategy.h"
@@ -38,6 +39,16 @@ private:
 
     bool warningMessageShownLargeRHS = false;
 
+    // Reused when calculating the gradients for the hyperplanes, and for the points of the hyperplanes in the waiting
+    // list
+    SparseVariableVector hyperplaneGradient;
+    VectorDouble hyperplanePoint;
+
+    // Returns the terms of the hyperplane if they are finite, badly scaled cuts are rescaled
+    std::optional<std::pair<std::map<int, double>, double>> createCheckedHyperplaneTerms(const Hyperplane& hyperplane);
+
+    std::string createHyperplaneIdentifier(const Hyperplane& hyperplane);
+
 protected:
     int numberOfVariables = 0;
     int numberOfConstraints = 0;
@@ -51,17 +62,24 @@ protected:
     bool cutOffConstraintDefined = false;
     int cutOffConstraintIndex;
 
+    // Removes the deleted constraints from the stored constraint indexes, e.g. of the cutoff constraint and the integer
+    // cuts, and decreases the indexes after them
+    void updateConstraintIndexesAfterDeletion(const VectorInteger& deletedConstraintIndexes);
+
     bool hasQuadraticObjective = false;
     bool hasQudraticConstraint = false;
 
 public:
     ~MIPSolverBase();
 
-    virtual bool createHyperplane(Hyperplane hyperplane);
+    virtual bool createHyperplane(const Hyperplane& hyperplane);
+
+    virtual VectorInteger createHyperplanes(
+        const std::vector<Hyperplane>& hyperplanes, LinearConstraintBlock& createdConstraints);
 
-    virtual bool createInteriorHyperplane(Hyperplane hyperplane);
+    virtual bool createInteriorHyperplane(const Hyperplane& hyperplane);
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane);
+    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(const Hyperplane& hyperplane);
 
     virtual void setCutOffAsConstraint(double cutOff) = 0;
 
@@ -94,6 +112,8 @@ public:
         const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
         = 0;
 
+    virtual int addLinearConstraints(const LinearConstraintBlock& constraints) = 0;
+
     virtual void activateDiscreteVariables(bool activate) = 0;
 
     virtual int getNumberOfExploredNodes() = 0;
@@ -25,10 +25,13 @@
 #include "CoinBuild.hpp"
 #include "CoinModel.hpp"
 #include "CoinPragma.hpp"
+#include "CoinWarmStartBasis.hpp"
 #include "CbcModel.hpp"
 #include "CbcSolver.hpp"
 #include "OsiClpSolverInterface.hpp"
 
+#include <algorithm>
+
 namespace SHOT
 {
 
@@ -84,6 +87,8 @@ bool MIPSolverCbc::initializeProblem()
     cachedSolutionHasChanged = true;
     isVariablesFixed = false;
 
+    warmStartBasis.reset();
+
     checkParameters();
 
     return (true);
@@ -372,6 +377,114 @@ int MIPSolverCbc::addLinearConstraint(
     return (osiInterface->getNumRows() - 1);
 }
 
+int MIPSolverCbc::addLinearConstraints(const LinearConstraintBlock& constraints)
+{
+    int numConstraintsBefore = osiInterface->getNumRows();
+
+    try
+    {
+        int numberOfRows = constraints.getNumberOfRows();
+
+        std::vector<CoinBigIndex> rowStarts(constraints.rowStarts.begin(), constraints.rowStarts.end());
+        VectorDouble rowLowerBounds(numberOfRows, -osiInterface->getInfinity());
+        VectorDouble rowUpperBounds(numberOfRows);
+
+        for(int i = 0; i < numberOfRows; i++)
+            rowUpperBounds[i] = -constraints.constants[i];
+
+        osiInterface->addRows(numberOfRows, rowStarts.data(), constraints.variableIndexes.data(),
+            constraints.coefficients.data(), rowLowerBounds.data(), rowUpperBounds.data());
+
+        if(osiInterface->getNumRows() != numConstraintsBefore + numberOfRows)
+        {
+            env->output->outputDebug("        Linear constraints not added by Cbc");
+            return (-1);
+        }
+
+        for(size_t i = 0; i < constraints.names.size(); i++)
+            osiInterface->setRowName(numConstraintsBefore + i, constraints.names[i]);
+
+        allowRepairOfConstraint.insert(
+            allowRepairOfConstraint.end(), constraints.allowRepair.begin(), constraints.allowRepair.end());
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Error when adding linear constraints in Cbc: ", e.what());
+        return (-1);
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("        Error when adding linear constraints in Cbc: ", e.message());
+        return (-1);
+    }
+
+    return (numConstraintsBefore);
+}
+
+bool MIPSolverCbc::deactivateLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        for(auto I : constraintIndexes)
+            osiInterface->setRowUpper(I, osiInterface->getInfinity());
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("        Error when deactivating linear constraints in Cbc: ", e.message());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverCbc::activateLinearConstraints(const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides)
+{
+    try
+    {
+        for(size_t i = 0; i < constraintIndexes.size(); i++)
+            osiInterface->setRowUpper(constraintIndexes[i], rightHandSides[i]);
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("        Error when activating linear constraints in Cbc: ", e.message());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverCbc::deleteLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        osiInterface->deleteRows(constraintIndexes.size(), constraintIndexes.data());
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError("        Error when deleting linear constraints in Cbc: ", e.message());
+        return (false);
+    }
+
+    // The basis is still valid if the slack variables of the deleted constraints are basic, which is the case for
+    // constraints that have not been enforced since it was saved
+    if(warmStartBasis)
+    {
+        bool areSlacksBasic = std::all_of(constraintIndexes.begin(), constraintIndexes.end(), [&](int I) {
+            return (I < warmStartBasis->getNumArtificial()
+                && warmStartBasis->getArtifStatus(I) == CoinWarmStartBasis::basic);
+        });
+
+        if(areSlacksBasic)
+            warmStartBasis->deleteRows(constraintIndexes.size(), constraintIndexes.data());
+        else
+            warmStartBasis.reset();
+    }
+
+    updateConstraintIndexesAfterDeletion(constraintIndexes);
+
+    return (true);
+}
+
 void MIPSolverCbc::activateDiscreteVariables(bool activate)
 {
     if(activate)
@@ -461,7 +574,7 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
     E_ProblemSolutionStatus MIPSolutionStatus;
     cachedSolutionHasChanged = true;
 
-    const int numArguments = 17;
+    const int numArguments = 19;
     char* argv[numArguments];
     std::string arg;
 
@@ -565,28 +678,30 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
     arg = fmt::format("{}", this->timeLimit);
     argv[12] = strdup(arg.c_str());
 
+    // sos is the default preprocessing in Cbc
+    argv[13] = strdup("-preprocess");
+    argv[14] = strdup(isSingleTree ? "off" : "sos");
+
     if(cbcModel->haveMultiThreadSupport())
     {
-        argv[13] = strdup("-threads");
+        argv[15] = strdup("-threads");
         arg = std::to_string(numberOfThreads);
-        argv[14] = strdup(arg.c_str());
+        argv[16] = strdup(arg.c_str());
 
-        argv[15] = strdup("-solve");
-        argv[16] = strdup("-quit");
+        argv[17] = strdup("-solve");
+        argv[18] = strdup("-quit");
     }
     else
     {
-        argv[13] = strdup("-solve");
-        argv[14] = strdup("-quit");
-        argv[15] = strdup("");
-        argv[16] = strdup("");
+        argv[15] = strdup("-solve");
+        argv[16] = strdup("-quit");
+        argv[17] = strdup("");
+        argv[18] = strdup("");
     }
 
     try
     {
-        cbcModel = std::make_unique<CbcModel>(*osiInterface);
-
-        initializeSolverSettings();
+        rebuildCbcModel();
 
         // Adding the MIP starts provided
         try
@@ -603,20 +718,10 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
             env->output->outputError("        Error when adding MIP start to Cbc", e.what());
         }
 
-        CbcMain0(*cbcModel);
-
-        if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
-        {
-            cbcModel->setLogLevel(0);
-            osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
-        }
-
         TerminationEventHandler eventHandler(env);
         cbcModel->passInEventHandler(&eventHandler);
 
-        CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel);
-
-        MIPSolutionStatus = getSolutionStatus();
+        MIPSolutionStatus = solveCbcModel(numArguments, const_cast<const char**>(argv));
     }
     catch(std::exception& e)
     {
@@ -632,21 +737,8 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         {
             osiInterface->setColBounds(getDualAuxiliaryObjectiveVariableIndex(), -1000000000.0, 1000000000.0);
 
-            cbcModel = std::make_unique<CbcModel>(*osiInterface);
-
-            initializeSolverSettings();
-
-            CbcMain0(*cbcModel);
-
-            if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
-            {
-                cbcModel->setLogLevel(0);
-                osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
-            }
-
-            CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel);
-
-            MIPSolutionStatus = getSolutionStatus();
+            rebuildCbcModel();
+            MIPSolutionStatus = solveCbcModel(numArguments, const_cast<const char**>(argv));
 
             osiInterface->setColBounds(getDualAuxiliaryObjectiveVariableIndex(), -getUnboundedVariableBoundValue(),
                 getUnboundedVariableBoundValue());
@@ -710,21 +802,8 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
 
         if(problemUpdated)
         {
-            cbcModel = std::make_unique<CbcModel>(*osiInterface);
-
-            initializeSolverSettings();
-
-            CbcMain0(*cbcModel);
-
-            if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
-            {
-                cbcModel->setLogLevel(0);
-                osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
-            }
-
-            CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel);
-
-            MIPSolutionStatus = getSolutionStatus();
+            rebuildCbcModel();
+            MIPSolutionStatus = solveCbcModel(numArguments, const_cast<const char**>(argv));
 
             for(auto& P : originalObjectiveCoefficients)
             {
@@ -742,6 +821,90 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
     return (MIPSolutionStatus);
 }
 
+void MIPSolverCbc::rebuildCbcModel()
+{
+    env->timing->startTimer("DualProblemsCbcRebuild");
+
+    if(warmStartBasis)
+    {
+        if(warmStartBasis->getNumArtificial() <= osiInterface->getNumRows()
+            && warmStartBasis->getNumStructural() == osiInterface->getNumCols())
+        {
+            // The slack variables of rows added since the basis was saved, e.g. new hyperplanes, become basic. This
+            // is primal infeasible only for the new rows, so the dual simplex method can continue from the basis.
+            warmStartBasis->resize(osiInterface->getNumRows(), osiInterface->getNumCols());
+            osiInterface->setWarmStart(warmStartBasis.get());
+        }
+        else
+        {
+            // Rows have been removed, so the basis does not correspond to the problem anymore
+            warmStartBasis.reset();
+        }
+    }
+
+    cbcModel = std::make_unique<CbcModel>(*osiInterface);
+
+    initializeSolverSettings();
+
+    CbcMain0(*cbcModel);
+
+    if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+    {
+        cbcModel->setLogLevel(0);
+        osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
+    }
+
+    env->timing->stopTimer("DualProblemsCbcRebuild");
+}
+
+E_ProblemSolutionStatus MIPSolverCbc::solveCbcModel(int numberOfArguments, const char** arguments)
+{
+    env->timing->startTimer("DualProblemsCbcSolve");
+
+    initializeCallbacks();
+
+    CbcMain1(numberOfArguments, arguments, *cbcModel);
+
+    auto MIPSolutionStatus = getSolutionStatus();
+
+    env->timing->stopTimer("DualProblemsCbcSolve");
+
+    if(MIPSolutionStatus == E_ProblemSolutionStatus::Optimal
+        || MIPSolutionStatus == E_ProblemSolutionStatus::SolutionLimit
+        || MIPSolutionStatus == E_ProblemSolutionStatus::TimeLimit
+        || MIPSolutionStatus == E_ProblemSolutionStatus::NodeLimit)
+    {
+        saveWarmStartBasis();
+    }
+
+    return (MIPSolutionStatus);
+}
+
+void MIPSolverCbc::saveWarmStartBasis()
+{
+    auto solver = cbcModel->solver();
+
+    // The solver in the Cbc model might be a preprocessed version of the problem if the solution was interrupted
+    if(solver == nullptr || solver->getNumRows() != osiInterface->getNumRows()
+        || solver->getNumCols() != osiInterface->getNumCols())
+    {
+        warmStartBasis.reset();
+        return;
+    }
+
+    std::unique_ptr<CoinWarmStart> warmStart(solver->getWarmStart());
+
+    if(auto basis = dynamic_cast<CoinWarmStartBasis*>(warmStart.get()))
+    {
+        warmStart.release();
+        warmStartBasis.reset(basis);
+    }
+    else
+    {
+        warmStartBasis.reset();
+    }
+}
+
 bool MIPSolverCbc::repairInfeasibility()
 {
     if(env->dualSolver->generatedHyperplanes.size() == 0)
@@ -998,13 +1161,13 @@ bool MIPSolverCbc::repairInfeasibility()
             if(rowSense[repairConstraints.at(i)] == 'L')
             {
                 osiInterface->setRowUpper(repairConstraints[i], oldRHS + 1.5 * slackValue);
-                env->output->outputDebug("        Constraint: " + osiInterface->getRowName(repairConstraints[i])
-                    + " repaired with infeasibility = " + std::to_string(1.5 * slackValue));
+                env->output->outputDebug("        Constraint: {} repaired with infeasibility = {}",
+                    osiInterface->getRowName(repairConstraints[i]), 1.5 * slackValue);
             }
             else if(rowSense[repairConstraints.at(i)] == 'G')
             {
-                env->output->outputDebug("        Constraint: " + osiInterface->getRowName(repairConstraints[i])
-                    + " repaired with infeasibility = " + std::to_string(-1.5 * slackValue));
+                env->output->outputDebug("        Constraint: {} repaired with infeasibility = {}",
+                    osiInterface->getRowName(repairConstraints[i]), -1.5 * slackValue);
                 osiInterface->setRowUpper(repairConstraints[i], oldRHS - 1.5 * slackValue);
             }
 
@@ -1031,7 +1194,7 @@ bool MIPSolverCbc::repairInfeasibility()
             return (false);
         }
 
-        env->output->outputDebug("        Number of constraints modified: " + std::to_string(numRepairs));
+        env->output->outputDebug("        Number of constraints modified: {}", numRepairs);
 
         cbcModel = std::make_unique<CbcModel>(*osiInterface);
 
@@ -1079,13 +1242,13 @@ void MIPSolverCbc::setCutOff(double cutOff)
     {
         this->cutOff = cutOff + cutOffTol;
 
-        env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for minimization.", this->cutOff));
+        env->output->outputDebug("        Setting cutoff value to  {} for minimization.", this->cutOff);
     }
     else
     {
         this->cutOff = -1 * (cutOff + cutOffTol);
 
-        env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for maximization.", this->cutOff));
+        env->output->outputDebug("        Setting cutoff value to  {} for maximization.", this->cutOff);
     }
 }
 
@@ -1117,15 +1280,13 @@ void MIPSolverCbc::setCutOffAsConstraint([[maybe_unused]] double cutOff)
             {
                 osiInterface->setRowUpper(cutOffConstraintIndex, cutOff);
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for minimization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for minimization.", cutOff);
             }
             else
             {
                 osiInterface->setRowUpper(cutOffConstraintIndex, -cutOff);
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint value to " + Utilities::toString(cutOff) + " for maximization.");
+                env->output->outputDebug("        Setting cutoff constraint value to {:.3f} for maximization.", cutOff);
             }
 
             modelUpdated = true;
@@ -19,6 +19,7 @@
 class OsiClpSolverInterface;
 class CbcModel;
 class CoinModel;
+class CoinWarmStartBasis;
 
 namespace SHOT
 {
@@ -44,7 +45,7 @@ public:
     virtual int print();
 };
 
-class MIPSolverCbc : public IMIPSolver, MIPSolverBase
+class MIPSolverCbc : public IMIPSolver, public MIPSolverBase
 {
 public:
     MIPSolverCbc(EnvironmentPtr envPtr);
@@ -87,16 +88,31 @@ public:
     int addLinearConstraint(const std::map<int, double>& elements, double constant, std::string name,
         bool isGreaterThan, bool allowRepair) override;
 
-    bool createHyperplane(Hyperplane hyperplane) override { return (MIPSolverBase::createHyperplane(hyperplane)); }
+    int addLinearConstraints(const LinearConstraintBlock& constraints) override;
+
+    bool deactivateLinearConstraints(const VectorInteger& constraintIndexes) override;
+    bool activateLinearConstraints(const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides) override;
+    bool deleteLinearConstraints(const VectorInteger& constraintIndexes) override;
+
+    bool createHyperplane(const Hyperplane& hyperplane) override
+    {
+        return (MIPSolverBase::createHyperplane(hyperplane));
+    }
+
+    VectorInteger createHyperplanes(
+        const std::vector<Hyperplane>& hyperplanes, LinearConstraintBlock& createdConstraints) override
+    {
+        return (MIPSolverBase::createHyperplanes(hyperplanes, createdConstraints));
+    }
 
     bool createIntegerCut(IntegerCut& integerCut) override;
 
-    bool createInteriorHyperplane(Hyperplane hyperplane) override
+    bool createInteriorHyperplane(const Hyperplane& hyperplane) override
     {
         return (MIPSolverBase::createInteriorHyperplane(hyperplane));
     }
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) override
+    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(const Hyperplane& hyperplane) override
     {
         return (MIPSolverBase::createHyperplaneTerms(hyperplane));
     }
@@ -179,12 +195,15 @@ public:
 
     std::string getSolverVersion() override;
 
-private:
+protected:
     std::unique_ptr<OsiClpSolverInterface> osiInterface;
     std::unique_ptr<CbcModel> cbcModel;
     std::unique_ptr<CoinModel> coinModel;
     std::unique_ptr<CbcMessageHandler> messageHandler;
 
+    // The basis from the previous solve, used as a warm start for the next one
+    std::unique_ptr<CoinWarmStartBasis> warmStartBasis;
+
     CoinPackedVector objectiveLinearExpression;
 
     long int solLimit;
@@ -195,6 +214,21 @@ private:
     std::vector<std::vector<std::pair<std::string, double>>> MIPStarts;
 
     std::vector<E_VariableType> variableTypes;
+
+    // In the single-tree strategy the columns cannot be changed by preprocessing, since the lazy constraints are given
+    // in the original variables
+    bool isSingleTree = false;
+
+    // Adds callbacks to the Cbc model before it is solved, e.g. the lazy constraint generator in the single-tree
+    // strategy
+    virtual void initializeCallbacks() {};
+
+    // Creates a new Cbc model from the current problem, warm started with the saved basis
+    void rebuildCbcModel();
+
+    E_ProblemSolutionStatus solveCbcModel(int numberOfArguments, const char** arguments);
+
+    void saveWarmStartBasis();
 };
 
 } // namespace SHOT
\ No newline at end of file
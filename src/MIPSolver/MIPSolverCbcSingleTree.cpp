@@ -0,0 +1,571 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "MIPSolverCbcSingleTree.h"
+
+#include "../DualSolver.h"
+#include "../EventHandler.h"
+#include "../Iteration.h"
+#include "../Output.h"
+#include "../PrimalSolver.h"
+#include "../Results.h"
+#include "../Settings.h"
+#include "../TaskHandler.h"
+#include "../Timing.h"
+#include "../Utilities.h"
+
+#include "../Model/Problem.h"
+
+#include <algorithm>
+
+#include "CbcCutGenerator.hpp"
+#include "CbcModel.hpp"
+#include "OsiAuxInfo.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "OsiRowCut.hpp"
+
+namespace SHOT
+{
+
+MIPSolverCbcSingleTree::MIPSolverCbcSingleTree(EnvironmentPtr envPtr) : MIPSolverCbc(envPtr) { isSingleTree = true; }
+
+MIPSolverCbcSingleTree::~MIPSolverCbcSingleTree() = default;
+
+void MIPSolverCbcSingleTree::initializeSolverSettings()
+{
+    MIPSolverCbc::initializeSolverSettings();
+
+    // The callbacks are not thread-safe
+    numberOfThreads = 1;
+}
+
+void MIPSolverCbcSingleTree::initializeCallbacks()
+{
+    if(!lazyConstraintGenerator)
+    {
+        lazyConstraintGenerator = std::make_unique<CbcLazyConstraintGenerator>(env);
+        primalSolutionHeuristic = std::make_unique<CbcPrimalSolutionHeuristic>(env);
+    }
+
+    // The generator is called in every node and for every solution, and must not be switched off by Cbc
+    cbcModel->addCutGenerator(lazyConstraintGenerator.get(), 1, "SHOT lazy constraints", true, true);
+    cbcModel->cutGenerator(cbcModel->numberCutGenerators() - 1)->setMustCallAgain(true);
+    cbcModel->cutGenerator(cbcModel->numberCutGenerators() - 1)->setGlobalCuts(true);
+
+    cbcModel->addHeuristic(primalSolutionHeuristic.get(), "SHOT primal solutions");
+
+    // Solver type 4 tells Cbc that the lazy constraints are needed for an integer solution to be valid, so that also
+    // the solutions found by its own heuristics are given to the generator, and rejected if they violate a new cut
+    OsiBabSolver solverCharacteristics(4);
+    cbcModel->solver()->setAuxiliaryInfo(&solverCharacteristics);
+
+    CbcSingleTreeEventHandler eventHandler(env);
+    cbcModel->passInEventHandler(&eventHandler);
+}
+
+CbcLazyConstraintGenerator::CbcLazyConstraintGenerator(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+
+    integerTolerance = env->settings->getSetting<double>("Tolerance.Integer", "Primal");
+    constraintTolerance = env->settings->getSetting<double>("ConstraintTolerance", "Termination");
+    isMinimization = env->reformulatedProblem->objectiveFunction->properties.isMinimize;
+
+    env->solutionStatistics.iterationLastLazyAdded = 0;
+
+    if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        if(static_cast<ES_HyperplaneCutStrategy>(env->settings->getSetting<int>("CutStrategy", "Dual"))
+            == ES_HyperplaneCutStrategy::ESH)
+        {
+            tUpdateInteriorPoint = std::make_shared<TaskUpdateInteriorPoint>(env);
+            taskSelectHPPts = std::make_shared<TaskSelectHyperplanePointsESH>(env);
+        }
+        else
+        {
+            taskSelectHPPts = std::make_shared<TaskSelectHyperplanePointsECP>(env);
+        }
+    }
+
+    auto NLPProblemSource = static_cast<ES_PrimalNLPProblemSource>(
+        env->settings->getSetting<int>("FixedInteger.SourceProblem", "Primal"));
+
+    if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
+        || NLPProblemSource == ES_PrimalNLPProblemSource::OriginalProblem)
+    {
+        taskSelectPrimNLPOriginal = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, false);
+    }
+
+    if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
+        || NLPProblemSource == ES_PrimalNLPProblemSource::ReformulatedProblem)
+    {
+        taskSelectPrimNLPReformulated = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, true);
+    }
+
+    if(env->reformulatedProblem->objectiveFunction->properties.classification
+        > E_ObjectiveFunctionClassification::Quadratic)
+    {
+        taskSelectHPPtsByObjectiveRootsearch = std::make_shared<TaskSelectHyperplanePointsObjectiveFunction>(env);
+    }
+
+    if(env->settings->getSetting<bool>("Rootsearch.Use", "Primal")
+        && env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        taskSelectPrimalSolutionFromRootsearch = std::make_shared<TaskSelectPrimalCandidatesFromRootsearch>(env);
+    }
+
+    lastUpdatedPrimal = env->results->getPrimalBound();
+}
+
+void CbcLazyConstraintGenerator::generateCuts(
+    const OsiSolverInterface& si, OsiCuts& cs, [[maybe_unused]] const CglTreeInfo info)
+{
+    try
+    {
+        int numberOfVariables = (env->dualSolver->MIPSolver->hasDualAuxiliaryObjectiveVariable())
+            ? si.getNumCols() - 1
+            : si.getNumCols();
+
+        const double* columnSolution = si.getColSolution();
+        VectorDouble solution(columnSolution, columnSolution + numberOfVariables);
+
+        bool isIntegerFeasible = true;
+
+        for(int i = 0; i < numberOfVariables; i++)
+        {
+            if(si.isInteger(i) && std::abs(solution[i] - std::round(solution[i])) > integerTolerance)
+            {
+                isIntegerFeasible = false;
+                break;
+            }
+        }
+
+        if(!isIntegerFeasible)
+        {
+            addRelaxedLazyConstraint(solution, si, cs);
+            return;
+        }
+
+        auto currIter = env->results->getCurrentIteration();
+
+        if(currIter->isSolved)
+        {
+            env->results->createIteration();
+            currIter = env->results->getCurrentIteration();
+            currIter->isDualProblemDiscrete = true;
+            currIter->dualProblemClass = env->dualSolver->MIPSolver->getProblemClass();
+        }
+
+        SolutionPoint solutionCandidate;
+        NumericConstraintValue maxDev;
+
+        if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+        {
+            maxDev = env->reformulatedProblem->getMaxNumericConstraintValue(
+                solution, env->reformulatedProblem->nonlinearConstraints);
+
+            solutionCandidate.maxDeviation = PairIndexValue(maxDev.constraint->index, maxDev.normalizedValue);
+        }
+        else
+        {
+            solutionCandidate.maxDeviation = PairIndexValue(-1, 0.0);
+        }
+
+        // The objective value of the dual problem, which is given by the auxiliary variable if there is one
+        double objectiveValue = (env->dualSolver->MIPSolver->hasDualAuxiliaryObjectiveVariable())
+            ? columnSolution[env->dualSolver->MIPSolver->getDualAuxiliaryObjectiveVariableIndex()]
+            : env->reformulatedProblem->objectiveFunction->calculateValue(solution);
+
+        solutionCandidate.point = solution;
+        solutionCandidate.objectiveValue = objectiveValue;
+        solutionCandidate.iterFound = currIter->iterationNumber;
+
+        std::vector<SolutionPoint> candidatePoints { solutionCandidate };
+
+        int numberOfCutsBefore = cs.sizeRowCuts();
+
+        addLazyConstraint(candidatePoints, si, cs);
+
+        // Cbc accepts the solution unless one of the generated cuts is violated in it, so if the point is infeasible
+        // but the selected hyperplanes do not cut it off, e.g. since they have already been added, a cutting plane is
+        // added in the point itself
+        if(solutionCandidate.maxDeviation.value > constraintTolerance)
+        {
+            bool isCutOff = false;
+
+            for(int i = numberOfCutsBefore; i < cs.sizeRowCuts(); i++)
+            {
+                if(cs.rowCutPtr(i)->violated(columnSolution) > constraintTolerance)
+                {
+                    isCutOff = true;
+                    break;
+                }
+            }
+
+            if(!isCutOff && !addCuttingPlane(solution, maxDev, si, cs))
+            {
+                env->output->outputWarning("        Could not cut off the infeasible integer solution in Cbc.");
+            }
+        }
+
+        currIter->maxDeviation = solutionCandidate.maxDeviation.value;
+        currIter->maxDeviationConstraint = solutionCandidate.maxDeviation.index;
+        currIter->solutionStatus = E_ProblemSolutionStatus::Feasible;
+        currIter->objectiveValue = objectiveValue;
+
+        auto bounds = std::make_pair(env->results->getCurrentDualBound(), env->results->getPrimalBound());
+        currIter->currentObjectiveBounds = bounds;
+
+        if(env->settings->getSetting<bool>("Rootsearch.Use", "Primal")
+            && env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+        {
+            taskSelectPrimalSolutionFromRootsearch.get()->run(candidatePoints);
+            env->primalSolver->checkPrimalSolutionCandidates();
+        }
+
+        if(checkFixedNLPStrategy(candidatePoints.at(0)))
+        {
+            env->primalSolver->addFixedNLPCandidate(candidatePoints.at(0).point, E_PrimalNLPSource::FirstSolution,
+                objectiveValue, currIter->iterationNumber, candidatePoints.at(0).maxDeviation);
+
+            if(taskSelectPrimNLPOriginal)
+                taskSelectPrimNLPOriginal->run();
+
+            env->primalSolver->addFixedNLPCandidate(candidatePoints.at(0).point, E_PrimalNLPSource::FirstSolution,
+                objectiveValue, currIter->iterationNumber, candidatePoints.at(0).maxDeviation);
+
+            if(taskSelectPrimNLPReformulated)
+                taskSelectPrimNLPReformulated->run();
+
+            env->primalSolver->fixedPrimalNLPCandidates.clear();
+
+            env->primalSolver->checkPrimalSolutionCandidates();
+        }
+
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual"))
+        {
+            int addedIntegerCuts = 0;
+
+            for(auto& IC : env->dualSolver->integerCutWaitingList)
+            {
+                if(this->createIntegerCut(IC, si, cs))
+                {
+                    env->dualSolver->addGeneratedIntegerCut(IC);
+                    addedIntegerCuts++;
+                }
+            }
+
+            if(addedIntegerCuts > 0)
+                env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
+
+            env->dualSolver->integerCutWaitingList.clear();
+        }
+
+        currIter->isSolved = true;
+
+        auto threadId = "";
+        printIterationReport(candidatePoints.at(0), threadId);
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Error when generating lazy constraints in Cbc", e.what());
+    }
+}
+
+void CbcLazyConstraintGenerator::addRelaxedLazyConstraint(
+    const VectorDouble& solution, const OsiSolverInterface& si, OsiCuts& cs)
+{
+    if(env->results->getCurrentIteration()->relaxedLazyHyperplanesAdded
+        >= env->settings->getSetting<int>("Relaxation.MaxLazyConstraints", "Dual"))
+        return;
+
+    int waitingListSize = env->dualSolver->hyperplaneWaitingList.size();
+
+    SolutionPoint solutionRelaxed;
+
+    if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        auto maxDev = env->reformulatedProblem->getMaxNumericConstraintValue(
+            solution, env->reformulatedProblem->nonlinearConstraints);
+        solutionRelaxed.maxDeviation = PairIndexValue(maxDev.constraint->index, maxDev.normalizedValue);
+    }
+    else
+    {
+        solutionRelaxed.maxDeviation = PairIndexValue(-1, 0.0);
+    }
+
+    solutionRelaxed.point = solution;
+    solutionRelaxed.objectiveValue = env->reformulatedProblem->objectiveFunction->calculateValue(solution);
+    solutionRelaxed.iterFound = env->results->getCurrentIteration()->iterationNumber;
+    solutionRelaxed.isRelaxedPoint = true;
+
+    std::vector<SolutionPoint> solutionPoints = { solutionRelaxed };
+
+    addLazyConstraint(solutionPoints, si, cs);
+
+    env->results->getCurrentIteration()->relaxedLazyHyperplanesAdded
+        += (env->dualSolver->hyperplaneWaitingList.size() - waitingListSize);
+}
+
+void CbcLazyConstraintGenerator::addLazyConstraint(
+    std::vector<SolutionPoint> candidatePoints, const OsiSolverInterface& si, OsiCuts& cs)
+{
+    if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        if(static_cast<ES_HyperplaneCutStrategy>(env->settings->getSetting<int>("CutStrategy", "Dual"))
+            == ES_HyperplaneCutStrategy::ESH)
+        {
+            tUpdateInteriorPoint->run();
+            static_cast<TaskSelectHyperplanePointsESH*>(taskSelectHPPts.get())->run(candidatePoints);
+        }
+        else
+        {
+            static_cast<TaskSelectHyperplanePointsECP*>(taskSelectHPPts.get())->run(candidatePoints);
+        }
+    }
+
+    if(env->reformulatedProblem->objectiveFunction->properties.classification
+        > E_ObjectiveFunctionClassification::Quadratic)
+    {
+        taskSelectHPPtsByObjectiveRootsearch->run(candidatePoints);
+    }
+
+    for(auto& hp : env->dualSolver->hyperplaneWaitingList)
+    {
+        if(this->createHyperplane(hp, si, cs))
+            this->lastNumAddedHyperplanes++;
+    }
+
+    env->dualSolver->clearHyperplaneWaitingList();
+}
+
+bool CbcLazyConstraintGenerator::createHyperplane(
+    const Hyperplane& hyperplane, const OsiSolverInterface& si, OsiCuts& cs)
+{
+    auto optionalHyperplanes = env->dualSolver->MIPSolver->createHyperplaneTerms(hyperplane);
+
+    if(!optionalHyperplanes)
+    {
+        return (false);
+    }
+
+    auto tmpPair = optionalHyperplanes.value();
+
+    for(auto& E : tmpPair.first)
+    {
+        if(E.second != E.second) // Check for NaN
+        {
+            env->output->outputError("        Warning: hyperplane for constraint "
+                + std::to_string(hyperplane.sourceConstraint->index)
+                + " not generated, NaN found in linear terms for variable "
+                + env->problem->getVariable(E.first)->name);
+            return (false);
+        }
+    }
+
+    // Small fix to fix badly scaled cuts.
+    if(std::abs(tmpPair.second) > 1e15)
+    {
+        double scalingFactor = std::abs(tmpPair.second) - 1e15;
+
+        for(auto& E : tmpPair.first)
+            E.second /= scalingFactor;
+
+        tmpPair.second /= scalingFactor;
+
+        if(!warningMessageShownLargeRHS)
+        {
+            env->output->outputWarning("        Large values found in RHS of cut, you might want to consider "
+                                       "reducing the bounds of the nonlinear variables.");
+            warningMessageShownLargeRHS = true;
+        }
+    }
+
+    VectorInteger variableIndexes;
+    VectorDouble coefficients;
+
+    for(auto& E : tmpPair.first)
+    {
+        variableIndexes.push_back(E.first);
+        coefficients.push_back(E.second);
+    }
+
+    // The hyperplanes are valid in the whole tree, since they are outer approximations of the feasible set
+    OsiRowCut cut;
+    cut.setRow(variableIndexes.size(), variableIndexes.data(), coefficients.data());
+    cut.setLb(-si.getInfinity());
+    cut.setUb(-tmpPair.second);
+    cut.setGloballyValid(true);
+    cs.insert(cut);
+
+    env->dualSolver->addGeneratedHyperplane(hyperplane, true);
+
+    return (true);
+}
+
+bool CbcLazyConstraintGenerator::addCuttingPlane(const VectorDouble& point,
+    const NumericConstraintValue& constraintValue, const OsiSolverInterface& si, OsiCuts& cs)
+{
+    Hyperplane hyperplane;
+    hyperplane.sourceConstraint = constraintValue.constraint;
+    hyperplane.sourceConstraintIndex = constraintValue.constraint->index;
+    hyperplane.generatedPoint = point;
+    hyperplane.isSourceConvex = (constraintValue.constraint->properties.convexity <= E_Convexity::Convex);
+    hyperplane.source = E_HyperplaneSource::MIPOptimalSolutionPoint;
+
+    if(!createHyperplane(hyperplane, si, cs))
+        return (false);
+
+    this->lastNumAddedHyperplanes++;
+    return (true);
+}
+
+bool CbcLazyConstraintGenerator::createIntegerCut(IntegerCut& integerCut, const OsiSolverInterface& si, OsiCuts& cs)
+{
+    if(!integerCut.areAllVariablesBinary)
+    {
+        env->output->outputDebug("        Integer cut for nonbinary variables not supported in single-tree strategy.");
+        return (false);
+    }
+
+    VectorInteger variableIndexes;
+    VectorDouble coefficients;
+    double lowerBound = 1.0;
+    size_t index = 0;
+
+    for(auto& VAR : env->reformulatedProblem->allVariables)
+    {
+        if(!(VAR->properties.type == E_VariableType::Binary || VAR->properties.type == E_VariableType::Integer))
+            continue;
+
+        int variableValue = integerCut.variableValues[index];
+
+        if(variableValue == VAR->upperBound)
+        {
+            variableIndexes.push_back(VAR->index);
+            coefficients.push_back(-1.0);
+            lowerBound -= variableValue;
+        }
+        else if(variableValue == VAR->lowerBound)
+        {
+            variableIndexes.push_back(VAR->index);
+            coefficients.push_back(1.0);
+        }
+
+        index++;
+    }
+
+    OsiRowCut cut;
+    cut.setRow(variableIndexes.size(), variableIndexes.data(), coefficients.data());
+    cut.setLb(lowerBound);
+    cut.setUb(si.getInfinity());
+    cut.setGloballyValid(true);
+    cs.insert(cut);
+
+    return (true);
+}
+
+CbcPrimalSolutionHeuristic::CbcPrimalSolutionHeuristic(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+    lastProvidedPrimalBound = env->results->getPrimalBound();
+}
+
+int CbcPrimalSolutionHeuristic::solution(double& objectiveValue, double* newSolution)
+{
+    auto primalBound = env->results->getPrimalBound();
+    bool isMinimization = env->reformulatedProblem->objectiveFunction->properties.isMinimize;
+
+    if(env->results->primalSolution.size() == 0
+        || (isMinimization && primalBound >= lastProvidedPrimalBound)
+        || (!isMinimization && primalBound <= lastProvidedPrimalBound))
+        return (0);
+
+    auto solver = model_->solver();
+    auto& primalSol = env->results->primalSolution;
+
+    std::vector<double> solution(solver->getNumCols(), 0.0);
+
+    if(primalSol.size() + env->reformulatedProblem->auxiliaryVariables.size() > solution.size())
+        return (0);
+
+    for(size_t i = 0; i < primalSol.size(); i++)
+        solution[i] = primalSol[i];
+
+    for(size_t i = 0; i < env->reformulatedProblem->auxiliaryVariables.size(); i++)
+        solution[i + primalSol.size()] = env->reformulatedProblem->auxiliaryVariables[i]->calculate(primalSol);
+
+    size_t auxiliaryObjectiveIndex = env->reformulatedProblem->auxiliaryVariables.size() + primalSol.size();
+
+    if(auxiliaryObjectiveIndex < solution.size())
+    {
+        if(env->reformulatedProblem->auxiliaryObjectiveVariable)
+            solution[auxiliaryObjectiveIndex]
+                = env->reformulatedProblem->auxiliaryObjectiveVariable->calculate(primalSol);
+        else if(env->dualSolver->MIPSolver->hasDualAuxiliaryObjectiveVariable())
+            solution[auxiliaryObjectiveIndex] = env->reformulatedProblem->objectiveFunction->calculateValue(primalSol);
+    }
+
+    // Cbc minimizes internally, and checks the objective value again before accepting the solution
+    const double* objectiveCoefficients = solver->getObjCoefficients();
+    double value = 0.0;
+
+    for(size_t i = 0; i < solution.size(); i++)
+        value += objectiveCoefficients[i] * solution[i];
+
+    objectiveValue = value * solver->getObjSense();
+    std::copy(solution.begin(), solution.end(), newSolution);
+
+    lastProvidedPrimalBound = primalBound;
+
+    env->output->outputDebug("        Primal solution with objective value {} given to Cbc.", primalBound);
+
+    return (1);
+}
+
+CbcSingleTreeEventHandler::CbcSingleTreeEventHandler(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+    isMinimization = env->reformulatedProblem->objectiveFunction->properties.isMinimize;
+}
+
+CbcEventHandler::CbcAction CbcSingleTreeEventHandler::event(CbcEvent whichEvent)
+{
+    if(whichEvent != CbcEventHandler::CbcEvent::node && whichEvent != CbcEventHandler::CbcEvent::solution
+        && whichEvent != CbcEventHandler::CbcEvent::heuristicSolution)
+        return (CbcEventHandler::CbcAction::noAction);
+
+    // The objective is minimized in the Cbc model, so the bound has the wrong sign for maximization problems
+    double dualBound = model_->getBestPossibleObjValue();
+
+    if(!isMinimization)
+        dualBound *= -1.0;
+
+    if((isMinimization && dualBound > env->results->getCurrentDualBound())
+        || (!isMinimization && dualBound < env->results->getCurrentDualBound()))
+    {
+        VectorDouble doubleSolution; // Empty since we have no point
+
+        DualSolution sol = { doubleSolution, E_DualSolutionSource::MIPSolverBound, dualBound,
+            env->results->getCurrentIteration()->iterationNumber, false };
+        env->dualSolver->addDualSolutionCandidate(sol);
+    }
+
+    if(env->results->isAbsoluteObjectiveGapToleranceMet() || env->results->isRelativeObjectiveGapToleranceMet()
+        || checkIterationLimit() || checkUserTermination())
+    {
+        env->output->outputDebug("        Terminating Cbc since a termination criterion is met.");
+        return (CbcEventHandler::CbcAction::stop);
+    }
+
+    return (CbcEventHandler::CbcAction::noAction);
+}
+} // namespace SHOT
@@ -0,0 +1,98 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "MIPSolverBase.h"
+#include "MIPSolverCbc.h"
+#include "MIPSolverCallbackBase.h"
+
+#include "CbcEventHandler.hpp"
+#include "CbcHeuristic.hpp"
+#include "CglCutGenerator.hpp"
+
+namespace SHOT
+{
+
+// Adds hyperplanes as lazy constraints for the integer-feasible solutions found by Cbc. Cbc calls the generator for
+// each solution before it is accepted, and rejects the solution if a violated cut is returned.
+class CbcLazyConstraintGenerator : public CglCutGenerator, public MIPSolverCallbackBase
+{
+public:
+    CbcLazyConstraintGenerator(EnvironmentPtr envPtr);
+    ~CbcLazyConstraintGenerator() override = default;
+
+    CglCutGenerator* clone() const override { return new CbcLazyConstraintGenerator(*this); }
+
+    void generateCuts(const OsiSolverInterface& si, OsiCuts& cs, const CglTreeInfo info = CglTreeInfo()) override;
+
+private:
+    double integerTolerance;
+    double constraintTolerance;
+
+    bool createHyperplane(const Hyperplane& hyperplane, const OsiSolverInterface& si, OsiCuts& cs);
+
+    bool createIntegerCut(IntegerCut& integerCut, const OsiSolverInterface& si, OsiCuts& cs);
+
+    void addLazyConstraint(std::vector<SolutionPoint> candidatePoints, const OsiSolverInterface& si, OsiCuts& cs);
+
+    void addRelaxedLazyConstraint(const VectorDouble& solution, const OsiSolverInterface& si, OsiCuts& cs);
+
+    // Adds a cutting plane in the point for the given constraint, even if the same hyperplane has been added before
+    bool addCuttingPlane(const VectorDouble& point, const NumericConstraintValue& constraintValue,
+        const OsiSolverInterface& si, OsiCuts& cs);
+};
+
+// Gives the primal solutions found by SHOT, e.g. from the fixed NLP problems, to Cbc
+class CbcPrimalSolutionHeuristic : public CbcHeuristic
+{
+public:
+    CbcPrimalSolutionHeuristic(EnvironmentPtr envPtr);
+    ~CbcPrimalSolutionHeuristic() override = default;
+
+    CbcHeuristic* clone() const override { return new CbcPrimalSolutionHeuristic(*this); }
+
+    void resetModel(CbcModel* model) override { setModel(model); }
+
+    int solution(double& objectiveValue, double* newSolution) override;
+
+private:
+    EnvironmentPtr env;
+    double lastProvidedPrimalBound;
+};
+
+// Updates the dual bound and terminates Cbc when the termination criteria are met
+class CbcSingleTreeEventHandler : public CbcEventHandler, public MIPSolverCallbackBase
+{
+public:
+    CbcSingleTreeEventHandler(EnvironmentPtr envPtr);
+    ~CbcSingleTreeEventHandler() override = default;
+
+    CbcSingleTreeEventHandler* clone() const override { return new CbcSingleTreeEventHandler(*this); }
+
+    CbcAction event(CbcEvent whichEvent) override;
+};
+
+class MIPSolverCbcSingleTree : public MIPSolverCbc
+{
+public:
+    MIPSolverCbcSingleTree(EnvironmentPtr envPtr);
+    ~MIPSolverCbcSingleTree() override;
+
+    void initializeSolverSettings() override;
+
+protected:
+    void initializeCallbacks() override;
+
+private:
+    // Cbc uses copies of these, but the tasks in the lazy constraint generator are shared by the copies
+    std::unique_ptr<CbcLazyConstraintGenerator> lazyConstraintGenerator;
+    std::unique_ptr<CbcPrimalSolutionHeuristic> primalSolutionHeuristic;
+};
+} // namespace SHOT
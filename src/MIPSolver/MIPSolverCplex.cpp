@@ -553,6 +553,121 @@ int MIPSolverCplex::addLinearConstraint(
     return (cplexInstance.getNrows() - 1);
 }
 
+int MIPSolverCplex::addLinearConstraints(const LinearConstraintBlock& constraints)
+{
+    int numConstraintsBefore = cplexInstance.getNrows();
+
+    try
+    {
+        int numberOfRows = constraints.getNumberOfRows();
+
+        IloRangeArray ranges(cplexEnv);
+
+        for(int i = 0; i < numberOfRows; i++)
+        {
+            IloExpr expr(cplexEnv);
+
+            for(int j = constraints.rowStarts[i]; j < constraints.rowStarts[i + 1]; j++)
+                expr += constraints.coefficients[j] * cplexVars[constraints.variableIndexes[j]];
+
+            IloRange range(cplexEnv, -IloInfinity, expr, -constraints.constants[i]);
+
+            if(!constraints.names.empty())
+                range.setName(constraints.names[i].c_str());
+
+            ranges.add(range);
+            expr.end();
+        }
+
+        cplexModel.add(ranges);
+        cplexInstance.extract(cplexModel);
+
+        // Make sure that Cplex actually has added the constraints
+        if(cplexInstance.getNrows() != numConstraintsBefore + numberOfRows)
+        {
+            env->output->outputDebug("        Hyperplanes not added by Cplex");
+            ranges.endElements();
+            ranges.end();
+            return (-1);
+        }
+
+        cplexConstrs.add(ranges);
+        ranges.end();
+
+        allowRepairOfConstraint.insert(
+            allowRepairOfConstraint.end(), constraints.allowRepair.begin(), constraints.allowRepair.end());
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError("        Error when adding linear constraints", e.getMessage());
+        return (-1);
+    }
+
+    return (numConstraintsBefore);
+}
+
+bool MIPSolverCplex::deactivateLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        for(auto I : constraintIndexes)
+            cplexConstrs[I].setUB(IloInfinity);
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError("        Error when deactivating linear constraints", e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverCplex::activateLinearConstraints(
+    const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides)
+{
+    try
+    {
+        for(size_t i = 0; i < constraintIndexes.size(); i++)
+            cplexConstrs[constraintIndexes[i]].setUB(rightHandSides[i]);
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError("        Error when activating linear constraints", e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverCplex::deleteLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        IloRangeArray deletedConstraints(cplexEnv);
+
+        for(auto I : constraintIndexes)
+            deletedConstraints.add(cplexConstrs[I]);
+
+        cplexModel.remove(deletedConstraints);
+
+        // The indexes are increasing, so the ones not yet removed are not affected
+        for(auto it = constraintIndexes.rbegin(); it != constraintIndexes.rend(); it++)
+            cplexConstrs.remove(*it);
+
+        deletedConstraints.endElements();
+        deletedConstraints.end();
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError("        Error when deleting linear constraints", e.getMessage());
+        return (false);
+    }
+
+    updateConstraintIndexesAfterDeletion(constraintIndexes);
+
+    return (true);
+}
+
 void MIPSolverCplex::activateDiscreteVariables(bool activate)
 {
     try
@@ -874,8 +989,7 @@ bool MIPSolverCplex::repairInfeasibility()
                 if(infeas[i] > 1e-10) // Cplex does not accept too small values, so zero cannot be used
                 {
                     numRepairs++;
-                    env->output->outputDebug("        Constraint: " + std::to_string(i)
-                        + " repaired with infeasibility = " + std::to_string(infeas[i]));
+                    env->output->outputDebug("        Constraint: {} repaired with infeasibility = {}", i, infeas[i]);
                     double newRHS = cplexConstrs[i].getUB() + 1.5 * infeas[i];
 
                     cplexConstrs[i].setUB(newRHS);
@@ -883,8 +997,7 @@ bool MIPSolverCplex::repairInfeasibility()
                 else if(infeas[i] < -1e-10) // Should not happen for generated cuts
                 {
                     numRepairs++;
-                    env->output->outputDebug("        Constraint: " + std::to_string(i)
-                        + " repaired with infeasibility = " + std::to_string(infeas[i]));
+                    env->output->outputDebug("        Constraint: {} repaired with infeasibility = {}", i, infeas[i]);
                     double newLHS = cplexConstrs[i].getLB() + 1.5 * infeas[i];
                     cplexConstrs[i].setLB(newLHS);
                 }
@@ -910,7 +1023,7 @@ bool MIPSolverCplex::repairInfeasibility()
                 return (false);
             }
 
-            env->output->outputDebug("        Number of constraints modified: " + std::to_string(numRepairs));
+            env->output->outputDebug("        Number of constraints modified: {}", numRepairs);
 
             return (true);
         }
@@ -1102,12 +1215,12 @@ void MIPSolverCplex::setCutOff(double cutOff)
         if(isMinimizationProblem)
         {
             cplexInstance.setParam(IloCplex::Param::MIP::Tolerances::UpperCutoff, cutOff);
-            env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for minimization.", cutOff));
+            env->output->outputDebug("        Setting cutoff value to  {} for minimization.", cutOff);
         }
         else
         {
             cplexInstance.setParam(IloCplex::Param::MIP::Tolerances::LowerCutoff, cutOff);
-            env->output->outputDebug(fmt::format("        Setting cutoff value to  {} for maximization.", cutOff));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff);
         }
     }
     catch(IloException& e)
@@ -1133,8 +1246,7 @@ void MIPSolverCplex::setCutOffAsConstraint(double cutOff)
                 cplexConstrs.add(tmpRange);
                 allowRepairOfConstraint.push_back(false);
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for maximization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for maximization.", cutOff);
             }
             else
             {
@@ -1144,8 +1256,7 @@ void MIPSolverCplex::setCutOffAsConstraint(double cutOff)
                 cplexConstrs.add(tmpRange);
                 allowRepairOfConstraint.push_back(false);
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for minimization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for minimization.", cutOff);
             }
 
             cutOffConstraintIndex = cplexConstrs.getSize() - 1;
@@ -1159,14 +1270,12 @@ void MIPSolverCplex::setCutOffAsConstraint(double cutOff)
             if(env->reformulatedProblem->objectiveFunction->properties.isMaximize)
             {
                 cplexConstrs[cutOffConstraintIndex].setLB(cutOff);
-                env->output->outputDebug(
-                    "        Setting cutoff constraint value to " + Utilities::toString(cutOff) + " for maximization.");
+                env->output->outputDebug("        Setting cutoff constraint value to {:.3f} for maximization.", cutOff);
             }
             else
             {
                 cplexConstrs[cutOffConstraintIndex].setUB(cutOff);
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for minimization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for minimization.", cutOff);
             }
 
             modelUpdated = true;
@@ -1229,7 +1338,7 @@ void MIPSolverCplex::deleteMIPStarts()
             env->output->outputError("        Error when deleting MIP starting points", e.getMessage());
         }
 
-        env->output->outputDebug("        Deleted " + std::to_string(numStarts) + " MIP starting points.");
+        env->output->outputDebug("        Deleted {} MIP starting points.", numStarts);
     }
 }
 
@@ -1418,8 +1527,7 @@ std::pair<VectorDouble, VectorDouble> MIPSolverCplex::presolveAndGetNewBounds()
             if(isUpdated)
             {
                 cplexInstance.extract(cplexModel);
-                env->output->outputDebug(
-                    "        Removed " + std::to_string(numconstr) + " redundant constraints from MIP model.");
+                env->output->outputDebug("        Removed {} redundant constraints from MIP model.", numconstr);
                 env->solutionStatistics.numberOfConstraintsRemovedInPresolve = numconstr;
             }
         }
@@ -1457,7 +1565,7 @@ void MIPSolverCplex::writePresolvedToFile([[maybe_unused]] std::string filename)
 void MIPSolverCplex::checkParameters() { }
 
 bool MIPSolverCplex::createHyperplane(
-    Hyperplane hyperplane, std::function<IloConstraint(IloRange)> addConstraintFunction)
+    const Hyperplane& hyperplane, std::function<IloConstraint(IloRange)> addConstraintFunction)
 {
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
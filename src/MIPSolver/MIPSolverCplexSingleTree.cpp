@@ -348,7 +348,7 @@ void CplexCallback::invoke(const IloCplex::Callback::Context& context)
                 }
 
                 if(addedIntegerCuts > 0)
-                    env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+                    env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
                 env->dualSolver->integerCutWaitingList.clear();
             }
@@ -407,7 +407,7 @@ void CplexCallback::invoke(const IloCplex::Callback::Context& context)
 /// Destructor
 CplexCallback::~CplexCallback() = default;
 
-bool CplexCallback::createHyperplane(Hyperplane hyperplane, const IloCplex::Callback::Context& context)
+bool CplexCallback::createHyperplane(const Hyperplane& hyperplane, const IloCplex::Callback::Context& context)
 {
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
     auto optionalHyperplanes = env->dualSolver->MIPSolver->createHyperplaneTerms(hyperplane);
@@ -468,7 +468,7 @@ bool CplexCallback::createHyperplane(Hyperplane hyperplane, const IloCplex::Call
         if(hyperplane.sourceConstraint != nullptr)
             identifier = identifier + "_" + hyperplane.sourceConstraint->name;
 
-        env->dualSolver->addGeneratedHyperplane(hyperplane);
+        env->dualSolver->addGeneratedHyperplane(hyperplane, true);
 
         tmpRange.end();
         expr.end();
@@ -564,7 +564,7 @@ void CplexCallback::addLazyConstraint(
             this->lastNumAddedHyperplanes++;
         }
 
-        env->dualSolver->hyperplaneWaitingList.clear();
+        env->dualSolver->clearHyperplaneWaitingList();
     }
     catch(IloException& e)
     {
@@ -177,8 +177,8 @@ void InfoCallbackI::main() // Called at each node...
     if(env->results->isRelativeObjectiveGapToleranceMet())
     {
         env->output->outputDebug(
-            "        Terminated by relative objective gap tolerance in info callback: " + Utilities::toString(relObjGap)
-            + " < " + Utilities::toString(env->settings->getSetting<double>("ObjectiveGap.Relative", "Termination")));
+            "        Terminated by relative objective gap tolerance in info callback: {:.3f} < {:.3f}", relObjGap,
+            env->settings->getSetting<double>("ObjectiveGap.Relative", "Termination"));
 
         this->abort();
         return;
@@ -186,8 +186,8 @@ void InfoCallbackI::main() // Called at each node...
     else if(env->results->isAbsoluteObjectiveGapToleranceMet())
     {
         env->output->outputDebug(
-            "        Terminated by absolute objective gap tolerance in info callback: " + Utilities::toString(absObjGap)
-            + " < " + Utilities::toString(env->settings->getSetting<double>("ObjectiveGap.Absolute", "Termination")));
+            "        Terminated by absolute objective gap tolerance in info callback: {:.3f} < {:.3f}", absObjGap,
+            env->settings->getSetting<double>("ObjectiveGap.Absolute", "Termination"));
 
         this->abort();
         return;
@@ -491,7 +491,7 @@ void CtCallbackI::main()
         this->lastNumAddedHyperplanes++;
     }
 
-    env->dualSolver->hyperplaneWaitingList.clear();
+    env->dualSolver->clearHyperplaneWaitingList();
 
     if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual"))
     {
@@ -507,7 +507,7 @@ void CtCallbackI::main()
         }
 
         if(addedIntegerCuts > 0)
-            env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+            env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
         env->dualSolver->integerCutWaitingList.clear();
     }
@@ -516,7 +516,7 @@ void CtCallbackI::main()
     solution.clear();
 }
 
-bool CtCallbackI::createHyperplane(Hyperplane hyperplane)
+bool CtCallbackI::createHyperplane(const Hyperplane& hyperplane)
 {
     auto optional = env->dualSolver->MIPSolver->createHyperplaneTerms(hyperplane);
 
@@ -589,7 +589,7 @@ bool CtCallbackI::createHyperplane(Hyperplane hyperplane)
         if(hyperplane.sourceConstraint != nullptr)
             identifier = identifier + "_" + hyperplane.sourceConstraint->name;
 
-        env->dualSolver->addGeneratedHyperplane(hyperplane);
+        env->dualSolver->addGeneratedHyperplane(hyperplane, true);
 
         optional.value().first.clear();
     }
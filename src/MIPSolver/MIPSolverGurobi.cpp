@@ -480,6 +480,117 @@ int MIPSolverGurobi::addLinearConstraint(
     return (gurobiModel->get(GRB_IntAttr_NumConstrs) - 1);
 }
 
+int MIPSolverGurobi::addLinearConstraints(const LinearConstraintBlock& constraints)
+{
+    int numConstraintsBefore = -1;
+
+    try
+    {
+        int numberOfRows = constraints.getNumberOfRows();
+        numConstraintsBefore = gurobiModel->get(GRB_IntAttr_NumConstrs);
+
+        std::vector<GRBLinExpr> expressions(numberOfRows);
+        std::vector<char> senses(numberOfRows, GRB_LESS_EQUAL);
+        VectorDouble rightHandSides(numberOfRows);
+
+        for(int i = 0; i < numberOfRows; i++)
+        {
+            for(int j = constraints.rowStarts[i]; j < constraints.rowStarts[i + 1]; j++)
+            {
+                if(std::abs(constraints.coefficients[j]) > 1e-13) // Gurobi might crash otherwise
+                    expressions[i] += constraints.coefficients[j] * gurobiModel->getVar(constraints.variableIndexes[j]);
+            }
+
+            rightHandSides[i] = -constraints.constants[i];
+        }
+
+        auto addedConstraints = gurobiModel->addConstrs(expressions.data(), senses.data(), rightHandSides.data(),
+            constraints.names.empty() ? nullptr : constraints.names.data(), numberOfRows);
+        delete[] addedConstraints;
+
+        gurobiModel->update();
+
+        if(gurobiModel->get(GRB_IntAttr_NumConstrs) != numConstraintsBefore + numberOfRows)
+        {
+            env->output->outputInfo("        Hyperplanes not added by Gurobi");
+            return (-1);
+        }
+
+        allowRepairOfConstraint.insert(
+            allowRepairOfConstraint.end(), constraints.allowRepair.begin(), constraints.allowRepair.end());
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError("        Error when adding linear constraints", e.getMessage());
+        return (-1);
+    }
+
+    return (numConstraintsBefore);
+}
+
+bool MIPSolverGurobi::deactivateLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        for(auto I : constraintIndexes)
+            gurobiModel->getConstr(I).set(GRB_DoubleAttr_RHS, GRB_INFINITY);
+
+        gurobiModel->update();
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError("        Error when deactivating linear constraints", e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverGurobi::activateLinearConstraints(
+    const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides)
+{
+    try
+    {
+        for(size_t i = 0; i < constraintIndexes.size(); i++)
+            gurobiModel->getConstr(constraintIndexes[i]).set(GRB_DoubleAttr_RHS, rightHandSides[i]);
+
+        gurobiModel->update();
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError("        Error when activating linear constraints", e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool MIPSolverGurobi::deleteLinearConstraints(const VectorInteger& constraintIndexes)
+{
+    try
+    {
+        // The constraints are fetched before any is removed, since the indexes change when the model is updated
+        std::vector<GRBConstr> deletedConstraints;
+
+        for(auto I : constraintIndexes)
+            deletedConstraints.push_back(gurobiModel->getConstr(I));
+
+        for(auto& C : deletedConstraints)
+            gurobiModel->remove(C);
+
+        gurobiModel->update();
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError("        Error when deleting linear constraints", e.getMessage());
+        return (false);
+    }
+
+    updateConstraintIndexesAfterDeletion(constraintIndexes);
+
+    return (true);
+}
+
 bool MIPSolverGurobi::createIntegerCut(IntegerCut& integerCut)
 {
     bool allowIntegerCutRepair = env->settings->getSetting<bool>("MIP.InfeasibilityRepair.IntegerCuts", "Dual");
@@ -844,7 +955,7 @@ E_ProblemSolutionStatus MIPSolverGurobi::solveProblem()
 
             gurobiModel->update();
 
-            if(env->results->iterations.size() > 0) // Might not have iterations if we are using the minimax solver
+            if(env->results->getNumberOfIterations() > 0) // Might not have iterations if we are using the minimax solver
                 env->results->getCurrentIteration()->hasInfeasibilityRepairBeenPerformed = true;
         }
     }
@@ -937,8 +1048,8 @@ bool MIPSolverGurobi::repairInfeasibility()
 
             numRepairs++;
 
-            env->output->outputDebug("        Constraint: " + constraint.get(GRB_StringAttr_ConstrName)
-                + " repaired with infeasibility = " + std::to_string(1.5 * slackValue));
+            env->output->outputDebug("        Constraint: {} repaired with infeasibility = {}",
+                constraint.get(GRB_StringAttr_ConstrName), 1.5 * slackValue);
         }
 
         env->results->getCurrentIteration()->numberOfInfeasibilityRepairedConstraints = numRepairs;
@@ -959,7 +1070,7 @@ bool MIPSolverGurobi::repairInfeasibility()
             return (false);
         }
 
-        env->output->outputDebug("        Number of constraints modified: " + std::to_string(numRepairs));
+        env->output->outputDebug("        Number of constraints modified: {}", numRepairs);
 
         return (true);
     }
@@ -1020,14 +1131,12 @@ void MIPSolverGurobi::setCutOff(double cutOff)
         if(isMinimizationProblem)
         {
             gurobiModel->getEnv().set(GRB_DoubleParam_Cutoff, cutOff + cutOffTol);
-            env->output->outputDebug(
-                fmt::format("        Setting cutoff value to  {} for maximization.", cutOff + cutOffTol));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff + cutOffTol);
         }
         else
         {
             gurobiModel->getEnv().set(GRB_DoubleParam_Cutoff, cutOff - cutOffTol);
-            env->output->outputDebug(
-                fmt::format("        Setting cutoff value to  {} for maximization.", cutOff - cutOffTol));
+            env->output->outputDebug("        Setting cutoff value to  {} for maximization.", cutOff - cutOffTol);
         }
     }
     catch(GRBException& e)
@@ -1049,15 +1158,13 @@ void MIPSolverGurobi::setCutOffAsConstraint(double cutOff)
             {
                 gurobiModel->addConstr(-objectiveLinearExpression <= -cutOff, "CUTOFF_C");
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for maximization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for maximization.", cutOff);
             }
             else
             {
                 gurobiModel->addConstr(objectiveLinearExpression <= cutOff, "CUTOFF_C");
 
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for minimization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for minimization.", cutOff);
             }
 
             allowRepairOfConstraint.push_back(false);
@@ -1080,8 +1187,7 @@ void MIPSolverGurobi::setCutOffAsConstraint(double cutOff)
             else
             {
                 constraint.set(GRB_DoubleAttr_RHS, cutOff);
-                env->output->outputDebug(
-                    "        Setting cutoff constraint to " + Utilities::toString(cutOff) + " for minimization.");
+                env->output->outputDebug("        Setting cutoff constraint to {:.3f} for minimization.", cutOff);
             }
 
             modelUpdated = true;
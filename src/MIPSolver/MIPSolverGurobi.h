@@ -61,16 +61,31 @@ public:
     int addLinearConstraint(const std::map<int, double>& elements, double constant, std::string name,
         bool isGreaterThan, bool allowRepair) override;
 
-    bool createHyperplane(Hyperplane hyperplane) override { return (MIPSolverBase::createHyperplane(hyperplane)); }
+    int addLinearConstraints(const LinearConstraintBlock& constraints) override;
+
+    bool deactivateLinearConstraints(const VectorInteger& constraintIndexes) override;
+    bool activateLinearConstraints(const VectorInteger& constraintIndexes, const VectorDouble& rightHandSides) override;
+    bool deleteLinearConstraints(const VectorInteger& constraintIndexes) override;
+
+    bool createHyperplane(const Hyperplane& hyperplane) override
+    {
+        return (MIPSolverBase::createHyperplane(hyperplane));
+    }
+
+    VectorInteger createHyperplanes(
+        const std::vector<Hyperplane>& hyperplanes, LinearConstraintBlock& createdConstraints) override
+    {
+        return (MIPSolverBase::createHyperplanes(hyperplanes, createdConstraints));
+    }
 
     bool createIntegerCut(IntegerCut& integerCut) override;
 
-    bool createInteriorHyperplane(Hyperplane hyperplane) override
+    bool createInteriorHyperplane(const Hyperplane& hyperplane) override
     {
         return (MIPSolverBase::createInteriorHyperplane(hyperplane));
     }
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) override
+    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(const Hyperplane& hyperplane) override
     {
         return (MIPSolverBase::createHyperplaneTerms(hyperplane));
     }
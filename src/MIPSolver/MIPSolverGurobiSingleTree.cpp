@@ -427,7 +427,7 @@ void GurobiCallbackSingleTree::callback()
                 }
 
                 if(addedIntegerCuts > 0)
-                    env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+                    env->output->outputDebug("        Added {} integer cut(s)", addedIntegerCuts);
 
                 env->dualSolver->integerCutWaitingList.clear();
             }
@@ -479,7 +479,7 @@ void GurobiCallbackSingleTree::callback()
     }
 }
 
-bool GurobiCallbackSingleTree::createHyperplane(Hyperplane hyperplane)
+bool GurobiCallbackSingleTree::createHyperplane(const Hyperplane& hyperplane)
 {
     try
     {
@@ -534,7 +534,7 @@ bool GurobiCallbackSingleTree::createHyperplane(Hyperplane hyperplane)
 
         addLazy(expr <= -tmpPair.second);
 
-        env->dualSolver->addGeneratedHyperplane(hyperplane);
+        env->dualSolver->addGeneratedHyperplane(hyperplane, true);
     }
     catch(GRBException& e)
     {
@@ -677,7 +677,7 @@ void GurobiCallbackSingleTree::addLazyConstraint(std::vector<SolutionPoint> cand
             this->lastNumAddedHyperplanes++;
         }
 
-        env->dualSolver->hyperplaneWaitingList.clear();
+        env->dualSolver->clearHyperplaneWaitingList();
     }
     catch(GRBException& e)
     {
@@ -155,10 +155,10 @@ bool RelaxationStrategyStandard::isObjectiveStagnant()
     if(prevIter->iterationNumber < numSteps)
         return (false);
 
-    auto prevIter2 = env->results->iterations[prevIter->iterationNumber - numSteps];
+    auto prevIter2 = env->results->getIterationSummary(prevIter->iterationNumber - numSteps + 1);
 
     // TODO: should be substituted with parameter
-    if(std::abs((prevIter->objectiveValue - prevIter2->objectiveValue) / prevIter->objectiveValue) < 0.000001)
+    if(std::abs((prevIter->objectiveValue - prevIter2.objectiveValue) / prevIter->objectiveValue) < 0.000001)
         return (true);
 
     return (false);
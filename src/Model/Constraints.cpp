@@ -157,10 +157,34 @@ std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> NumericConstra
 
 NumericConstraintValue NumericConstraint::calculateNumericValue(const VectorDouble& point, double correction)
 {
-    double value = calculateFunctionValue(point) - correction;
+    NumericConstraintValue constrValue = getNumericValue(calculateFunctionValue(point) - correction);
+    constrValue.constraint = getPointer();
+
+    return constrValue;
+}
+
+void NumericConstraint::calculateNumericValues(const PointBatch& points, NumericConstraintValues& values)
+{
+    // Each thread has its own storage for the function values
+    thread_local VectorDouble functionValues;
+    calculateFunctionValues(points, functionValues);
+
+    auto pointer = getPointer();
+
+    values.clear();
+    values.reserve(points.getNumberOfPoints());
 
+    for(auto value : functionValues)
+    {
+        values.push_back(getNumericValue(value));
+        values.back().constraint = pointer;
+    }
+}
+
+NumericConstraintValue NumericConstraint::getNumericValue(double value)
+{
     NumericConstraintValue constrValue;
-    constrValue.constraint = getPointer();
+
     constrValue.functionValue = value;
     constrValue.isFulfilledRHS = (value <= valueRHS);
     constrValue.normalizedRHSValue = value - valueRHS;
@@ -219,6 +243,12 @@ Interval LinearConstraint::calculateFunctionValue(const IntervalVector& interval
     return value;
 }
 
+void LinearConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    values.assign(points.getNumberOfPoints(), constant);
+    linearTerms.calculate(points, values.data());
+}
+
 Interval LinearConstraint::getConstraintFunctionBounds()
 {
     Interval value = linearTerms.getBounds();
@@ -234,14 +264,15 @@ void LinearConstraint::takeOwnership(ProblemPtr owner)
     linearTerms.takeOwnership(owner);
 }
 
-SparseVariableVector LinearConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
+void LinearConstraint::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector gradient = linearTerms.calculateGradient(point);
+    gradient.clear();
+    linearTerms.calculateGradient(point, gradient);
+    gradient.sortAndCombine();
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
-
-    return gradient;
+        gradient.eraseZeroes();
 }
 
 void LinearConstraint::initializeGradientSparsityPattern()
@@ -261,11 +292,10 @@ void LinearConstraint::initializeGradientSparsityPattern()
 
 void LinearConstraint::initializeHessianSparsityPattern() { NumericConstraint::initializeHessianSparsityPattern(); }
 
-SparseVariableMatrix LinearConstraint::calculateHessian(
-    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
+void LinearConstraint::calculateHessian(
+    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian;
-    return hessian;
+    hessian.clear();
 }
 
 NumericConstraintValue LinearConstraint::calculateNumericValue(
@@ -336,6 +366,12 @@ Interval QuadraticConstraint::calculateFunctionValue(const IntervalVector& inter
     return value;
 }
 
+void QuadraticConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    LinearConstraint::calculateFunctionValues(points, values);
+    quadraticTerms.calculate(points, values.data());
+}
+
 Interval QuadraticConstraint::getConstraintFunctionBounds()
 {
     Interval value = LinearConstraint::getConstraintFunctionBounds();
@@ -351,12 +387,15 @@ void QuadraticConstraint::takeOwnership(ProblemPtr owner)
     quadraticTerms.takeOwnership(owner);
 }
 
-SparseVariableVector QuadraticConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
+void QuadraticConstraint::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector linearGradient = LinearConstraint::calculateGradient(point, eraseZeroes);
-    SparseVariableVector quadraticGradient = quadraticTerms.calculateGradient(point);
+    LinearConstraint::calculateGradient(point, false, gradient);
+    quadraticTerms.calculateGradient(point, gradient);
+    gradient.sortAndCombine();
 
-    return (Utilities::combineSparseVariableVectors(linearGradient, quadraticGradient));
+    if(eraseZeroes)
+        gradient.eraseZeroes();
 }
 
 void QuadraticConstraint::initializeGradientSparsityPattern()
@@ -381,56 +420,15 @@ void QuadraticConstraint::initializeGradientSparsityPattern()
     }
 }
 
-SparseVariableMatrix QuadraticConstraint::calculateHessian(
-    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
+void QuadraticConstraint::calculateHessian(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian;
-
-    for(auto& T : quadraticTerms)
-    {
-        if(T->coefficient == 0.0)
-            continue;
-
-        if(T->firstVariable == T->secondVariable) // variable squared
-        {
-            auto value = 2 * T->coefficient;
-            auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
+    LinearConstraint::calculateHessian(point, false, hessian);
+    quadraticTerms.calculateHessian(point, hessian);
+    hessian.sortAndCombine();
 
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-        }
-        else
-        {
-            // Only save elements above the diagonal since the Hessian is symmetric
-            if(T->firstVariable->index < T->secondVariable->index)
-            {
-                auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
-            else
-            {
-                auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->secondVariable, T->firstVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
-        }
-    }
-
-    return hessian;
+    if(eraseZeroes)
+        hessian.eraseZeroes();
 }
 
 void QuadraticConstraint::initializeHessianSparsityPattern()
@@ -549,6 +547,9 @@ void NonlinearConstraint::add(SignomialTermPtr term)
 
 void NonlinearConstraint::add(NonlinearExpressionPtr expression)
 {
+    // The compiled expression is no longer valid
+    expressionTape.reset();
+
     if(nonlinearExpression)
     {
         NonlinearExpressions terms;
@@ -600,11 +601,40 @@ double NonlinearConstraint::calculateFunctionValue(const VectorDouble& point)
         value += signomialTerms.calculate(point);
 
     if(this->properties.hasNonlinearExpression)
-        value += nonlinearExpression->calculate(point);
+    {
+        if(expressionTape)
+            value += expressionTape->calculate(expressionTapeIndex, point);
+        else
+            value += nonlinearExpression->calculate(point);
+    }
 
     return value;
 }
 
+void NonlinearConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    QuadraticConstraint::calculateFunctionValues(points, values);
+
+    if(this->properties.hasMonomialTerms)
+        monomialTerms.calculate(points, values.data());
+
+    if(this->properties.hasSignomialTerms)
+        signomialTerms.calculate(points, values.data());
+
+    if(this->properties.hasNonlinearExpression)
+    {
+        if(expressionTape)
+        {
+            expressionTape->calculate(expressionTapeIndex, points, values.data());
+        }
+        else
+        {
+            for(int k = 0; k < points.getNumberOfPoints(); k++)
+                values[k] += nonlinearExpression->calculate(points.getPoint(k));
+        }
+    }
+}
+
 Interval NonlinearConstraint::calculateFunctionValue(const IntervalVector& intervalVector)
 {
     Interval value = QuadraticConstraint::calculateFunctionValue(intervalVector);
@@ -616,7 +646,12 @@ Interval NonlinearConstraint::calculateFunctionValue(const IntervalVector& inter
         value += signomialTerms.calculate(intervalVector);
 
     if(this->properties.hasNonlinearExpression)
-        value += nonlinearExpression->calculate(intervalVector);
+    {
+        if(expressionTape)
+            value += expressionTape->calculate(expressionTapeIndex, intervalVector);
+        else
+            value += nonlinearExpression->calculate(intervalVector);
+    }
 
     return value;
 }
@@ -644,23 +679,16 @@ Interval NonlinearConstraint::getConstraintFunctionBounds()
     return value;
 }
 
-SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
+void NonlinearConstraint::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector gradient = QuadraticConstraint::calculateGradient(point, eraseZeroes);
-
-    SparseVariableVector monomialGradient;
+    QuadraticConstraint::calculateGradient(point, false, gradient);
 
     if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
-
-    SparseVariableVector signomialGradient;
+        monomialTerms.calculateGradient(point, gradient);
 
     if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
+        signomialTerms.calculateGradient(point, gradient);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -669,47 +697,35 @@ SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble&
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+            auto& tapeFunction = gradientTape ? gradientTape->function : sharedOwnerProblem->ADFunctions;
+            auto& tapeVariables
+                = gradientTape ? gradientTape->variables : sharedOwnerProblem->nonlinearExpressionVariables;
 
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+            std::vector<double> pointNonlinearSubset(tapeVariables.size());
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+            for(size_t i = 0; i < tapeVariables.size(); i++)
+                pointNonlinearSubset[i] = point[tapeVariables[i]->index];
 
             CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
-            sharedOwnerProblem->ADFunctions.subgraph_jac_rev(pointNonlinearSubset, subset);
+            tapeFunction.subgraph_jac_rev(pointNonlinearSubset, subset);
 
             const std::vector<size_t>& col(subset.col());
             const std::vector<double>& value(subset.val());
 
-            std::vector<size_t> rowMajor = subset.row_major();
-
-            for(auto k : rowMajor)
+            for(size_t k = 0; k < subset.nnz(); k++)
             {
-                double coefficient = value[k];
-
-                if(coefficient == 0.0)
+                if(value[k] == 0.0)
                     continue;
 
-                auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
-
-                auto element = gradient.emplace(VAR, coefficient);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
+                gradient.add(tapeVariables[col[k]]->index, value[k]);
             }
         }
     }
 
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
+    gradient.sortAndCombine();
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(result, 0.0);
-
-    return result;
+        gradient.eraseZeroes();
 }
 
 void NonlinearConstraint::initializeGradientSparsityPattern()
@@ -756,20 +772,21 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
             assert(sharedOwnerProblem->properties.numberOfNonlinearExpressions > 0);
             assert(this->nonlinearExpressionIndex >= 0);
 
+            auto& tapeFunction = gradientTape ? gradientTape->function : sharedOwnerProblem->ADFunctions;
+            auto& tapeVariables
+                = gradientTape ? gradientTape->variables : sharedOwnerProblem->nonlinearExpressionVariables;
+
             // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
             // of the gradient may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+            auto nonlinearVariablesInExpressionMap = std::vector<bool>(tapeFunction.Domain(), true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+            auto nonlinearFunctionMap = std::vector<bool>(tapeFunction.Range(), false);
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            nonlinearFunctionMap[gradientTape ? this->gradientTapeRow : this->nonlinearExpressionIndex] = true;
 
             CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            sharedOwnerProblem->ADFunctions.subgraph_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+            tapeFunction.subgraph_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
             // Save for later use when calculating gradients
             nonlinearGradientSparsityPattern = pattern;
@@ -780,7 +797,7 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
             {
                 for(auto& VAR : variablesInNonlinearExpression)
                 {
-                    if((size_t)VAR->properties.nonlinearVariableIndex == variableIndices[i])
+                    if(VAR == tapeVariables[variableIndices[i]])
                     {
                         if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
                             == gradientSparsityPattern->end())
@@ -796,19 +813,20 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
     nonlinearGradientSparsityMapGenerated = true;
 }
 
-SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& point, bool eraseZeroes = true)
+void NonlinearConstraint::calculateTermsHessian(const VectorDouble& point, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian = QuadraticConstraint::calculateHessian(point, eraseZeroes);
+    QuadraticConstraint::calculateHessian(point, false, hessian);
 
     if(properties.hasMonomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
-    }
+        monomialTerms.calculateHessian(point, hessian);
 
     if(properties.hasSignomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
-    }
+        signomialTerms.calculateHessian(point, hessian);
+}
+
+void NonlinearConstraint::calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian)
+{
+    calculateTermsHessian(point, hessian);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -817,51 +835,18 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
-
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
-
-            std::vector<double> weights(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
+            std::vector<double> weights(sharedOwnerProblem->ADFunctions.Range(), 0.0);
             weights[this->nonlinearExpressionIndex] = 1.0;
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
-
-            // TODO: utilize sparsity pattern
-            auto calculatedHessian = sharedOwnerProblem->ADFunctions.SparseHessian(pointNonlinearSubset, weights);
-
-            for(auto& V1 : variablesInNonlinearExpression)
-            {
-                for(auto& V2 : variablesInNonlinearExpression)
-                {
-                    size_t hessianIndex = V1->properties.nonlinearVariableIndex * numberOfNonlinearVariables
-                        + V2->properties.nonlinearVariableIndex;
-
-                    double hessianValue = calculatedHessian[hessianIndex];
-
-                    if(hessianValue == 0.0)
-                        continue;
-
-                    // Only save elements above the diagonal since the Hessian is symmetric
-                    if(V1->index <= V2->index)
-                    {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
-
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
-                    }
-                }
-            }
+            sharedOwnerProblem->calculateNonlinearExpressionsHessian(point, weights, nonlinearHessianSubset,
+                nonlinearHessianSparsityPattern, nonlinearHessianWork, hessian);
         }
     }
 
-    if(eraseZeroes)
-        Utilities::erase_if<std::pair<VariablePtr, VariablePtr>, double>(hessian, 0.0);
+    hessian.sortAndCombine();
 
-    return (hessian);
+    if(eraseZeroes)
+        hessian.eraseZeroes();
 }
 
 void NonlinearConstraint::initializeHessianSparsityPattern()
@@ -939,6 +924,10 @@ void NonlinearConstraint::initializeHessianSparsityPattern()
 
             nonlinearHessianSparsityPattern = pattern;
 
+            // Save the upper triagonal part for later use when calculating Hessians
+            nonlinearHessianSubset = sharedOwnerProblem->getUpperTriangularNonlinearHessianSubset(pattern);
+            nonlinearHessianWork.clear();
+
             const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
             const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
 
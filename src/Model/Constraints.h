@@ -19,6 +19,7 @@
 #include "Variables.h"
 #include "Terms.h"
 #include "NonlinearExpressions.h"
+#include "ExpressionTape.h"
 
 #include "cppad/cppad.hpp"
 #include "cppad/utility.hpp"
@@ -131,15 +132,22 @@ public:
 
     virtual Interval getConstraintFunctionBounds() = 0;
 
-    virtual SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) = 0;
+    // Clears the provided storage and fills it with the gradient in sparse representation sorted by variable index
+    virtual void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) = 0;
     virtual std::shared_ptr<Variables> getGradientSparsityPattern();
 
-    // Returns the upper triagonal part of the Hessian matrix is sparse representation
-    virtual SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) = 0;
+    // Fills the provided storage with the upper triagonal part of the Hessian matrix in sparse representation
+    virtual void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) = 0;
     virtual std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getHessianSparsityPattern();
 
     virtual NumericConstraintValue calculateNumericValue(const VectorDouble& point, double correction = 0.0);
 
+    // Clears the provided storage and fills it with the function value in each of the points
+    virtual void calculateFunctionValues(const PointBatch& points, VectorDouble& values) = 0;
+
+    // Clears the provided storage and fills it with the constraint value in each of the points
+    void calculateNumericValues(const PointBatch& points, NumericConstraintValues& values);
+
     bool isFulfilled(const VectorDouble& point) override;
 
     void takeOwnership(ProblemPtr owner) override = 0;
@@ -151,6 +159,8 @@ public:
 protected:
     virtual void initializeGradientSparsityPattern() = 0;
     virtual void initializeHessianSparsityPattern() = 0;
+
+    NumericConstraintValue getNumericValue(double functionValue);
 };
 
 class LinearConstraint : public NumericConstraint
@@ -184,6 +194,7 @@ public:
 
     double calculateFunctionValue(const VectorDouble& point) override;
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
@@ -191,10 +202,10 @@ public:
 
     void takeOwnership(ProblemPtr owner) override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
 
-    // Returns the upper triagonal part of the Hessian matrix is sparse representation
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    // Fills the provided storage with the upper triagonal part of the Hessian matrix in sparse representation
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
 
     NumericConstraintValue calculateNumericValue(const VectorDouble& point, double correction = 0.0) override;
 
@@ -262,6 +273,7 @@ public:
 
     double calculateFunctionValue(const VectorDouble& point) override;
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
@@ -269,10 +281,10 @@ public:
 
     void takeOwnership(ProblemPtr owner) override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
 
-    // Returns the upper triagonal part of the Hessian matrix is sparse representation
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    // Fills the provided storage with the upper triagonal part of the Hessian matrix in sparse representation
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
 
     NumericConstraintValue calculateNumericValue(const VectorDouble& point, double correction = 0.0) override;
 
@@ -301,9 +313,21 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // The compiled nonlinear expression used when calculating function values, created when finalizing the problem
+    ExpressionTapePtr expressionTape;
+    int expressionTapeIndex = -1;
+
+    // The CppAD tape and its row used when calculating the gradient, if not set the tape of the whole problem is used
+    NonlinearGradientTapePtr gradientTape;
+    int gradientTapeRow = -1;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
+    // The upper triagonal part of the Hessian sparsity pattern and the CppAD work storage, reused between the calls
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> nonlinearHessianSubset;
+    CppAD::sparse_hes_work nonlinearHessianWork;
+
     bool nonlinearGradientSparsityMapGenerated = false;
     bool nonlinearHessianSparsityMapGenerated = false;
 
@@ -392,13 +416,18 @@ public:
     void updateFactorableFunction();
 
     double calculateFunctionValue(const VectorDouble& point) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
+
+    // Fills the provided storage with the upper triagonal part of the Hessian matrix in sparse representation
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
 
-    // Returns the upper triagonal part of the Hessian matrix is sparse representation
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    // Fills the provided storage with the upper triagonal Hessian elements of all terms except the nonlinear
+    // expression, without sorting and combining them
+    void calculateTermsHessian(const VectorDouble& point, SparseVariableMatrix& hessian);
 
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
 
@@ -0,0 +1,432 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "ExpressionTape.h"
+
+#include <algorithm>
+
+namespace SHOT
+{
+
+int ExpressionTape::add(NonlinearExpressionPtr expression)
+{
+    int firstInstruction = instructions.size();
+    std::map<NonlinearExpression*, int> compiledSlots;
+
+    compile(expression.get(), firstInstruction, compiledSlots);
+
+    expressionRanges.emplace_back(firstInstruction, instructions.size());
+
+    return (expressionRanges.size() - 1);
+}
+
+int ExpressionTape::compile(
+    NonlinearExpression* expression, int firstInstruction, std::map<NonlinearExpression*, int>& compiledSlots)
+{
+    if(auto slot = compiledSlots.find(expression); slot != compiledSlots.end())
+        return (slot->second);
+
+    ExpressionTapeInstruction instruction;
+    instruction.type = expression->getType();
+
+    switch(instruction.type)
+    {
+    case E_NonlinearExpressionTypes::Constant:
+        instruction.constant = static_cast<ExpressionConstant*>(expression)->constant;
+        break;
+
+    case E_NonlinearExpressionTypes::Variable:
+        instruction.firstOperand = static_cast<ExpressionVariable*>(expression)->variable->index;
+        break;
+
+    case E_NonlinearExpressionTypes::Divide:
+    case E_NonlinearExpressionTypes::Power:
+    {
+        auto binary = static_cast<ExpressionBinary*>(expression);
+
+        instruction.firstOperand = compile(binary->firstChild.get(), firstInstruction, compiledSlots);
+        instruction.secondOperand = compile(binary->secondChild.get(), firstInstruction, compiledSlots);
+        instruction.isConstantPower = (binary->secondChild->getType() == E_NonlinearExpressionTypes::Constant);
+        break;
+    }
+
+    case E_NonlinearExpressionTypes::Sum:
+    case E_NonlinearExpressionTypes::Product:
+    {
+        auto general = static_cast<ExpressionGeneral*>(expression);
+
+        // The children need to be compiled before their slots can be added contiguously to the operand list
+        std::vector<int> childSlots;
+        childSlots.reserve(general->children.size());
+
+        for(auto& C : general->children)
+            childSlots.push_back(compile(C.get(), firstInstruction, compiledSlots));
+
+        instruction.firstOperand = operands.size();
+        instruction.secondOperand = childSlots.size();
+        operands.insert(operands.end(), childSlots.begin(), childSlots.end());
+        break;
+    }
+
+    default: // Unary operations
+        instruction.firstOperand
+            = compile(static_cast<ExpressionUnary*>(expression)->child.get(), firstInstruction, compiledSlots);
+        break;
+    }
+
+    int slot = instructions.size() - firstInstruction;
+    instructions.push_back(instruction);
+    compiledSlots.emplace(expression, slot);
+
+    return (slot);
+}
+
+double ExpressionTape::calculate(int expressionIndex, const VectorDouble& point) const
+{
+    auto [firstInstruction, lastInstruction] = expressionRanges[expressionIndex];
+
+    // Each thread has its own storage for the intermediate values
+    thread_local std::vector<double> values;
+    values.resize(lastInstruction - firstInstruction);
+
+    const ExpressionTapeInstruction* instruction = &instructions[firstInstruction];
+    double* value = values.data();
+
+    for(int i = 0; i < lastInstruction - firstInstruction; i++, instruction++)
+    {
+        switch(instruction->type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            value[i] = instruction->constant;
+            break;
+        case E_NonlinearExpressionTypes::Variable:
+            value[i] = point[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::Negate:
+            value[i] = -value[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::Invert:
+            value[i] = 1.0 / value[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::SquareRoot:
+            value[i] = sqrt(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Log:
+            value[i] = log(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Exp:
+            value[i] = exp(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Square:
+            value[i] = value[instruction->firstOperand] * value[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::Cos:
+            value[i] = cos(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Sin:
+            value[i] = sin(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Tan:
+            value[i] = tan(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcCos:
+            value[i] = acos(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcSin:
+            value[i] = asin(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcTan:
+            value[i] = atan(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Abs:
+            value[i] = fabs(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Divide:
+            value[i] = value[instruction->firstOperand] / value[instruction->secondOperand];
+            break;
+        case E_NonlinearExpressionTypes::Power:
+            value[i] = ExpressionPower::calculatePower(
+                value[instruction->firstOperand], value[instruction->secondOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Sum:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            double sum = 0.0;
+
+            for(int j = 0; j < instruction->secondOperand; j++)
+                sum += value[operand[j]];
+
+            value[i] = sum;
+            break;
+        }
+        case E_NonlinearExpressionTypes::Product:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            double product = 1.0;
+
+            for(int j = 0; j < instruction->secondOperand; j++)
+            {
+                if(value[operand[j]] == 0.0)
+                {
+                    product = 0.0;
+                    break;
+                }
+
+                product *= value[operand[j]];
+            }
+
+            value[i] = product;
+            break;
+        }
+        }
+    }
+
+    return (values.back());
+}
+
+Interval ExpressionTape::calculate(int expressionIndex, const IntervalVector& intervalVector) const
+{
+    auto [firstInstruction, lastInstruction] = expressionRanges[expressionIndex];
+
+    // Each thread has its own storage for the intermediate values
+    thread_local std::vector<Interval> values;
+    values.resize(lastInstruction - firstInstruction);
+
+    const ExpressionTapeInstruction* instruction = &instructions[firstInstruction];
+    Interval* value = values.data();
+
+    for(int i = 0; i < lastInstruction - firstInstruction; i++, instruction++)
+    {
+        switch(instruction->type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            value[i] = Interval(instruction->constant);
+            break;
+        case E_NonlinearExpressionTypes::Variable:
+            value[i] = intervalVector[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::Negate:
+            value[i] = -value[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::Invert:
+            value[i] = 1.0 / value[instruction->firstOperand];
+            break;
+        case E_NonlinearExpressionTypes::SquareRoot:
+            value[i] = sqrt(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Log:
+        {
+            auto childValue = value[instruction->firstOperand];
+
+            if(childValue.l() <= 0)
+                childValue.l(SHOT_DBL_EPS);
+
+            value[i] = log(childValue);
+            break;
+        }
+        case E_NonlinearExpressionTypes::Exp:
+            value[i] = exp(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Square:
+            value[i] = pow(value[instruction->firstOperand], 2);
+            break;
+        case E_NonlinearExpressionTypes::Cos:
+            value[i] = cos(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Sin:
+            value[i] = sin(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Tan:
+            value[i] = tan(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcCos:
+            value[i] = acos(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcSin:
+            value[i] = asin(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::ArcTan:
+            value[i] = atan(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Abs:
+            value[i] = fabs(value[instruction->firstOperand]);
+            break;
+        case E_NonlinearExpressionTypes::Divide:
+            value[i] = value[instruction->firstOperand] / value[instruction->secondOperand];
+            break;
+        case E_NonlinearExpressionTypes::Power:
+            value[i] = ExpressionPower::calculatePower(
+                value[instruction->firstOperand], value[instruction->secondOperand], instruction->isConstantPower);
+            break;
+        case E_NonlinearExpressionTypes::Sum:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            Interval sum(0.);
+
+            for(int j = 0; j < instruction->secondOperand; j++)
+                sum += value[operand[j]];
+
+            value[i] = sum;
+            break;
+        }
+        case E_NonlinearExpressionTypes::Product:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            Interval product(1., 1.);
+
+            for(int j = 0; j < instruction->secondOperand; j++)
+                product = product * value[operand[j]];
+
+            value[i] = product;
+            break;
+        }
+        }
+    }
+
+    return (values.back());
+}
+
+void ExpressionTape::calculate(int expressionIndex, const PointBatch& points, double* values) const
+{
+    auto [firstInstruction, lastInstruction] = expressionRanges[expressionIndex];
+    int numberOfPoints = points.getNumberOfPoints();
+
+    // Each thread has its own storage for the intermediate values, the values of each slot in all points are stored
+    // contiguously
+    thread_local std::vector<double> slotValues;
+    slotValues.resize((lastInstruction - firstInstruction) * numberOfPoints);
+
+    const ExpressionTapeInstruction* instruction = &instructions[firstInstruction];
+
+    for(int i = 0; i < lastInstruction - firstInstruction; i++, instruction++)
+    {
+        double* value = slotValues.data() + i * numberOfPoints;
+
+        // The operands of unary and binary operations are slots, the others refer to variables or the operand list
+        bool hasOperandSlots = (instruction->type != E_NonlinearExpressionTypes::Constant
+            && instruction->type != E_NonlinearExpressionTypes::Variable
+            && instruction->type != E_NonlinearExpressionTypes::Sum
+            && instruction->type != E_NonlinearExpressionTypes::Product);
+
+        const double* first
+            = hasOperandSlots ? slotValues.data() + instruction->firstOperand * numberOfPoints : nullptr;
+        const double* second = (hasOperandSlots && instruction->secondOperand >= 0)
+            ? slotValues.data() + instruction->secondOperand * numberOfPoints
+            : nullptr;
+
+        switch(instruction->type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            std::fill(value, value + numberOfPoints, instruction->constant);
+            break;
+        case E_NonlinearExpressionTypes::Variable:
+            std::copy_n(points.getVariableValues(instruction->firstOperand), numberOfPoints, value);
+            break;
+        case E_NonlinearExpressionTypes::Negate:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = -first[k];
+            break;
+        case E_NonlinearExpressionTypes::Invert:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = 1.0 / first[k];
+            break;
+        case E_NonlinearExpressionTypes::SquareRoot:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = sqrt(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Log:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = log(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Exp:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = exp(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Square:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = first[k] * first[k];
+            break;
+        case E_NonlinearExpressionTypes::Cos:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = cos(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Sin:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = sin(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Tan:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = tan(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::ArcCos:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = acos(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::ArcSin:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = asin(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::ArcTan:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = atan(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Abs:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = fabs(first[k]);
+            break;
+        case E_NonlinearExpressionTypes::Divide:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = first[k] / second[k];
+            break;
+        case E_NonlinearExpressionTypes::Power:
+            for(int k = 0; k < numberOfPoints; k++)
+                value[k] = ExpressionPower::calculatePower(first[k], second[k]);
+            break;
+        case E_NonlinearExpressionTypes::Sum:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            std::fill(value, value + numberOfPoints, 0.0);
+
+            for(int j = 0; j < instruction->secondOperand; j++)
+            {
+                const double* term = slotValues.data() + operand[j] * numberOfPoints;
+
+                for(int k = 0; k < numberOfPoints; k++)
+                    value[k] += term[k];
+            }
+
+            break;
+        }
+        case E_NonlinearExpressionTypes::Product:
+        {
+            const int* operand = operands.data() + instruction->firstOperand;
+            std::fill(value, value + numberOfPoints, 1.0);
+
+            // A zero factor gives a zero product regardless of the other factors, as when evaluating in one point
+            for(int j = 0; j < instruction->secondOperand; j++)
+            {
+                const double* factor = slotValues.data() + operand[j] * numberOfPoints;
+
+                for(int k = 0; k < numberOfPoints; k++)
+                    value[k] = (value[k] == 0.0 || factor[k] == 0.0) ? 0.0 : value[k] * factor[k];
+            }
+
+            break;
+        }
+        }
+    }
+
+    const double* result = slotValues.data() + (lastInstruction - firstInstruction - 1) * numberOfPoints;
+
+    for(int k = 0; k < numberOfPoints; k++)
+        values[k] += result[k];
+}
+
+} // namespace SHOT
@@ -0,0 +1,75 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "../Structs.h"
+#include "NonlinearExpressions.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace SHOT
+{
+
+// One operation in a compiled expression. The result of the operation is stored in the slot with the same position
+// (relative to the first instruction of the expression) as the instruction itself.
+struct ExpressionTapeInstruction
+{
+    E_NonlinearExpressionTypes type;
+
+    // The slot of the first operand, the index of the variable, or the position of the first operand in the operand
+    // list for sums and products
+    int firstOperand = -1;
+
+    // The slot of the second operand, or the number of operands in the operand list for sums and products
+    int secondOperand = -1;
+
+    double constant = 0.0;
+
+    // Whether the exponent of a power is a constant expression, this affects the interval evaluation
+    bool isConstantPower = false;
+};
+
+// Nonlinear expression trees lowered into flat, topologically ordered instruction arrays. The instructions of all
+// expressions in a problem are stored contiguously, and each expression refers to its own range of instructions.
+class ExpressionTape
+{
+public:
+    ExpressionTape() = default;
+
+    // Compiles the expression and returns the index to use when evaluating it
+    int add(NonlinearExpressionPtr expression);
+
+    double calculate(int expressionIndex, const VectorDouble& point) const;
+    Interval calculate(int expressionIndex, const IntervalVector& intervalVector) const;
+
+    // Adds the value of the expression in each of the points to the corresponding element in values
+    void calculate(int expressionIndex, const PointBatch& points, double* values) const;
+
+    inline size_t getNumberOfExpressions() const { return (expressionRanges.size()); }
+    inline size_t getNumberOfInstructions() const { return (instructions.size()); }
+
+private:
+    std::vector<ExpressionTapeInstruction> instructions;
+    std::vector<int> operands;
+
+    // The first and one past the last instruction for each expression
+    std::vector<std::pair<int, int>> expressionRanges;
+
+    // Returns the slot of the result relative to the first instruction in the expression, subexpressions that are
+    // shared within the expression are only compiled once
+    int compile(
+        NonlinearExpression* expression, int firstInstruction, std::map<NonlinearExpression*, int>& compiledSlots);
+};
+
+using ExpressionTapePtr = std::shared_ptr<ExpressionTape>;
+
+} // namespace SHOT
@@ -28,6 +28,16 @@ using FactorableFunctionPtr = std::shared_ptr<FactorableFunction>;
 using Interval = mc::Interval;
 using IntervalVector = std::vector<Interval>;
 
+// A CppAD tape of the nonlinear expressions in a group of functions, used when calculating their gradients so that
+// the whole problem does not need to be swept. The independent variables are the ones in variables.
+struct NonlinearGradientTape
+{
+    CppAD::ADFun<double> function;
+    Variables variables;
+};
+
+using NonlinearGradientTapePtr = std::shared_ptr<NonlinearGradientTape>;
+
 enum class E_NonlinearExpressionTypes
 {
     Constant,
@@ -1712,9 +1722,18 @@ public:
 
     inline double calculate(const VectorDouble& point) const override
     {
-        auto firstChildValue = firstChild->calculate(point);
-        auto secondChildValue = secondChild->calculate(point);
+        return (calculatePower(firstChild->calculate(point), secondChild->calculate(point)));
+    }
 
+    inline Interval calculate(const IntervalVector& intervalVector) const override
+    {
+        return (calculatePower(firstChild->calculate(intervalVector), secondChild->calculate(intervalVector),
+            secondChild->getType() == E_NonlinearExpressionTypes::Constant));
+    }
+
+    // These are also used when evaluating compiled expressions
+    static inline double calculatePower(double firstChildValue, double secondChildValue)
+    {
         if(std::abs(firstChildValue - 0.0) <= 1e-10 * std::abs(firstChildValue))
         {
             return 0.0;
@@ -1738,14 +1757,11 @@ public:
         return (pow(firstChildValue, secondChildValue));
     }
 
-    inline Interval calculate(const IntervalVector& intervalVector) const override
+    static inline Interval calculatePower(Interval baseBounds, Interval powerBounds, bool isConstantPower)
     {
-        auto baseBounds = firstChild->calculate(intervalVector);
-        auto powerBounds = secondChild->calculate(intervalVector);
-
         Interval bounds(0.0);
 
-        if(secondChild->getType() == E_NonlinearExpressionTypes::Constant)
+        if(isConstantPower)
         {
             double power = powerBounds.l();
 
@@ -254,25 +254,15 @@ Interval LinearObjectiveFunction::calculateValue(const IntervalVector& intervalV
     return value;
 }
 
-SparseVariableVector LinearObjectiveFunction::calculateGradient(
-    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
+void LinearObjectiveFunction::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector gradient;
-
-    for(auto& T : linearTerms)
-    {
-        auto element = gradient.emplace(T->variable, T->coefficient);
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += T->coefficient;
-        }
-    }
+    gradient.clear();
+    linearTerms.calculateGradient(point, gradient);
+    gradient.sortAndCombine();
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
-
-    return gradient;
+        gradient.eraseZeroes();
 }
 
 void LinearObjectiveFunction::initializeGradientSparsityPattern()
@@ -290,12 +280,10 @@ void LinearObjectiveFunction::initializeGradientSparsityPattern()
     }
 }
 
-SparseVariableMatrix LinearObjectiveFunction::calculateHessian(
-    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
+void LinearObjectiveFunction::calculateHessian(
+    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian;
-
-    return hessian;
+    hessian.clear();
 }
 
 void LinearObjectiveFunction::initializeHessianSparsityPattern()
@@ -426,49 +414,15 @@ Interval QuadraticObjectiveFunction::calculateValue(const IntervalVector& interv
     return value;
 }
 
-SparseVariableVector QuadraticObjectiveFunction::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
+void QuadraticObjectiveFunction::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector gradient = LinearObjectiveFunction::calculateGradient(point, eraseZeroes);
-
-    for(auto& T : quadraticTerms)
-    {
-        if(T->firstVariable == T->secondVariable) // variable squared
-        {
-            auto value = 2 * T->coefficient * point[T->firstVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-        }
-        else
-        {
-            auto value = T->coefficient * point[T->secondVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-
-            value = T->coefficient * point[T->firstVariable->index];
-            element = gradient.emplace(T->secondVariable, value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-        }
-    }
+    LinearObjectiveFunction::calculateGradient(point, false, gradient);
+    quadraticTerms.calculateGradient(point, gradient);
+    gradient.sortAndCombine();
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
-
-    return gradient;
+        gradient.eraseZeroes();
 }
 
 void QuadraticObjectiveFunction::initializeGradientSparsityPattern()
@@ -490,56 +444,15 @@ void QuadraticObjectiveFunction::initializeGradientSparsityPattern()
     }
 }
 
-SparseVariableMatrix QuadraticObjectiveFunction::calculateHessian(
-    [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
+void QuadraticObjectiveFunction::calculateHessian(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian;
+    LinearObjectiveFunction::calculateHessian(point, false, hessian);
+    quadraticTerms.calculateHessian(point, hessian);
+    hessian.sortAndCombine();
 
-    for(auto& T : quadraticTerms)
-    {
-        if(T->coefficient == 0.0)
-            continue;
-
-        if(T->firstVariable == T->secondVariable) // variable squared
-        {
-            auto value = 2 * T->coefficient;
-            auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-        }
-        else
-        {
-            // Only save elements above the diagonal since the Hessian is symmetric
-            if(T->firstVariable->index < T->secondVariable->index)
-            {
-                auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
-            else
-            {
-                auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->secondVariable, T->firstVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
-        }
-    }
-
-    return hessian;
+    if(eraseZeroes)
+        hessian.eraseZeroes();
 }
 
 void QuadraticObjectiveFunction::initializeHessianSparsityPattern()
@@ -554,7 +467,7 @@ void QuadraticObjectiveFunction::initializeHessianSparsityPattern()
         auto firstVariable
             = (T->firstVariable->index < T->secondVariable->index) ? T->firstVariable : T->secondVariable;
         auto secondVariable
-            = (T->firstVariable->index > T->secondVariable->index) ? T->secondVariable : T->firstVariable;
+            = (T->firstVariable->index < T->secondVariable->index) ? T->secondVariable : T->firstVariable;
 
         auto key = std::make_pair(firstVariable, secondVariable);
 
@@ -626,6 +539,9 @@ void NonlinearObjectiveFunction::add(SignomialTermPtr term)
 
 void NonlinearObjectiveFunction::add(NonlinearExpressionPtr expression)
 {
+    // The compiled expression is no longer valid
+    expressionTape.reset();
+
     if(nonlinearExpression)
     {
         NonlinearExpressions terms;
@@ -758,7 +674,12 @@ double NonlinearObjectiveFunction::calculateValue(const VectorDouble& point)
     value += signomialTerms.calculate(point);
 
     if(this->properties.hasNonlinearExpression)
-        value += nonlinearExpression->calculate(point);
+    {
+        if(expressionTape)
+            value += expressionTape->calculate(expressionTapeIndex, point);
+        else
+            value += nonlinearExpression->calculate(point);
+    }
 
     return value;
 }
@@ -772,7 +693,12 @@ Interval NonlinearObjectiveFunction::calculateValue(const IntervalVector& interv
     try
     {
         if(this->properties.hasNonlinearExpression)
-            value += nonlinearExpression->calculate(intervalVector);
+        {
+            if(expressionTape)
+                value += expressionTape->calculate(expressionTapeIndex, intervalVector);
+            else
+                value += nonlinearExpression->calculate(intervalVector);
+        }
     }
     catch(const mc::Interval::Exceptions&)
     {
@@ -782,9 +708,10 @@ Interval NonlinearObjectiveFunction::calculateValue(const IntervalVector& interv
     return value;
 }
 
-SparseVariableVector NonlinearObjectiveFunction::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
+void NonlinearObjectiveFunction::calculateGradient(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient)
 {
-    SparseVariableVector gradient = QuadraticObjectiveFunction::calculateGradient(point, eraseZeroes);
+    QuadraticObjectiveFunction::calculateGradient(point, false, gradient);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -793,61 +720,41 @@ SparseVariableVector NonlinearObjectiveFunction::calculateGradient(const VectorD
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+            auto& tapeFunction = gradientTape ? gradientTape->function : sharedOwnerProblem->ADFunctions;
+            auto& tapeVariables
+                = gradientTape ? gradientTape->variables : sharedOwnerProblem->nonlinearExpressionVariables;
 
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+            std::vector<double> pointNonlinearSubset(tapeVariables.size());
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+            for(size_t i = 0; i < tapeVariables.size(); i++)
+                pointNonlinearSubset[i] = point[tapeVariables[i]->index];
 
             CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
-            sharedOwnerProblem->ADFunctions.subgraph_jac_rev(pointNonlinearSubset, subset);
+            tapeFunction.subgraph_jac_rev(pointNonlinearSubset, subset);
 
             const std::vector<size_t>& col(subset.col());
             const std::vector<double>& value(subset.val());
 
-            std::vector<size_t> rowMajor = subset.row_major();
-
-            for(auto k : rowMajor)
+            for(size_t k = 0; k < subset.nnz(); k++)
             {
-                double coefficient = value[k];
-
-                if(coefficient == 0.0)
+                if(value[k] == 0.0)
                     continue;
 
-                auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
-
-                auto element = gradient.emplace(VAR, coefficient);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
+                gradient.add(tapeVariables[col[k]]->index, value[k]);
             }
         }
     }
 
-    SparseVariableVector monomialGradient;
-
     if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
-
-    SparseVariableVector signomialGradient;
+        monomialTerms.calculateGradient(point, gradient);
 
     if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
+        signomialTerms.calculateGradient(point, gradient);
 
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
+    gradient.sortAndCombine();
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
-
-    return result;
+        gradient.eraseZeroes();
 }
 
 void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
@@ -921,20 +828,21 @@ void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
             assert(sharedOwnerProblem->properties.numberOfNonlinearExpressions > 0);
             assert(this->nonlinearExpressionIndex >= 0);
 
+            auto& tapeFunction = gradientTape ? gradientTape->function : sharedOwnerProblem->ADFunctions;
+            auto& tapeVariables
+                = gradientTape ? gradientTape->variables : sharedOwnerProblem->nonlinearExpressionVariables;
+
             // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
             // of the gradient may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+            auto nonlinearVariablesInExpressionMap = std::vector<bool>(tapeFunction.Domain(), true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+            auto nonlinearFunctionMap = std::vector<bool>(tapeFunction.Range(), false);
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            nonlinearFunctionMap[gradientTape ? this->gradientTapeRow : this->nonlinearExpressionIndex] = true;
 
             CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            sharedOwnerProblem->ADFunctions.subgraph_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+            tapeFunction.subgraph_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
             // Save for later use when calculating gradients
             nonlinearGradientSparsityPattern = pattern;
@@ -945,7 +853,7 @@ void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
             {
                 for(auto& VAR : variablesInNonlinearExpression)
                 {
-                    if((size_t)VAR->properties.nonlinearVariableIndex == variableIndices[i])
+                    if(VAR == tapeVariables[variableIndices[i]])
                     {
                         if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
                             == gradientSparsityPattern->end())
@@ -978,19 +886,21 @@ void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
     nonlinearGradientSparsityMapGenerated = true;
 }
 
-SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDouble& point, bool eraseZeroes = true)
+void NonlinearObjectiveFunction::calculateTermsHessian(const VectorDouble& point, SparseVariableMatrix& hessian)
 {
-    SparseVariableMatrix hessian = QuadraticObjectiveFunction::calculateHessian(point, eraseZeroes);
+    QuadraticObjectiveFunction::calculateHessian(point, false, hessian);
 
     if(properties.hasMonomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
-    }
+        monomialTerms.calculateHessian(point, hessian);
 
     if(properties.hasSignomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
-    }
+        signomialTerms.calculateHessian(point, hessian);
+}
+
+void NonlinearObjectiveFunction::calculateHessian(
+    const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian)
+{
+    calculateTermsHessian(point, hessian);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -999,49 +909,18 @@ SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDo
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
-
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
-
-            std::vector<double> weights(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
+            std::vector<double> weights(sharedOwnerProblem->ADFunctions.Range(), 0.0);
             weights[this->nonlinearExpressionIndex] = 1.0;
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
-
-            CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearHessianSparsityPattern);
-
-            auto calculatedHessian = sharedOwnerProblem->ADFunctions.SparseHessian(pointNonlinearSubset, weights);
-
-            for(auto& V1 : variablesInNonlinearExpression)
-            {
-                for(auto& V2 : variablesInNonlinearExpression)
-                {
-                    size_t hessianIndex = V1->properties.nonlinearVariableIndex * numberOfNonlinearVariables
-                        + V2->properties.nonlinearVariableIndex;
-
-                    double hessianValue = calculatedHessian[hessianIndex];
-
-                    if(hessianValue == 0.0)
-                        continue;
-
-                    // Only save elements above the diagonal since the Hessian is symmetric
-                    if(V1->index <= V2->index)
-                    {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
-
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
-                    }
-                }
-            }
+            sharedOwnerProblem->calculateNonlinearExpressionsHessian(point, weights, nonlinearHessianSubset,
+                nonlinearHessianSparsityPattern, nonlinearHessianWork, hessian);
         }
     }
 
-    return hessian;
+    hessian.sortAndCombine();
+
+    if(eraseZeroes)
+        hessian.eraseZeroes();
 }
 
 void NonlinearObjectiveFunction::initializeHessianSparsityPattern()
@@ -1108,7 +987,7 @@ void NonlinearObjectiveFunction::initializeHessianSparsityPattern()
                 = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
 
             auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, true);
+                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
 
             nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
 
@@ -1119,6 +998,10 @@ void NonlinearObjectiveFunction::initializeHessianSparsityPattern()
 
             nonlinearHessianSparsityPattern = pattern;
 
+            // Save the upper triagonal part for later use when calculating Hessians
+            nonlinearHessianSubset = sharedOwnerProblem->getUpperTriangularNonlinearHessianSubset(pattern);
+            nonlinearHessianWork.clear();
+
             const std::vector<size_t>& rowIndices(nonlinearHessianSparsityPattern.row());
             const std::vector<size_t>& colIndices(nonlinearHessianSparsityPattern.col());
 
@@ -14,6 +14,7 @@
 #include "Variables.h"
 #include "Terms.h"
 #include "NonlinearExpressions.h"
+#include "ExpressionTape.h"
 
 #include <vector>
 
@@ -95,10 +96,10 @@ public:
 
     virtual Interval getBounds();
 
-    virtual SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) = 0;
+    virtual void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) = 0;
     virtual std::shared_ptr<Variables> getGradientSparsityPattern();
 
-    virtual SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) = 0;
+    virtual void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) = 0;
     virtual std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getHessianSparsityPattern();
 
     virtual std::ostream& print(std::ostream&) const = 0;
@@ -165,9 +166,9 @@ public:
     double calculateValue(const VectorDouble& point) override;
     Interval calculateValue(const IntervalVector& intervalVector) override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
 
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
 
     std::ostream& print(std::ostream& stream) const override;
 
@@ -248,8 +249,8 @@ public:
 
     void takeOwnership(ProblemPtr owner) override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
 
     std::ostream& print(std::ostream& stream) const override;
 
@@ -344,9 +345,21 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // The compiled nonlinear expression used when calculating function values, created when finalizing the problem
+    ExpressionTapePtr expressionTape;
+    int expressionTapeIndex = -1;
+
+    // The CppAD tape and its row used when calculating the gradient, if not set the tape of the whole problem is used
+    NonlinearGradientTapePtr gradientTape;
+    int gradientTapeRow = -1;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
+    // The upper triagonal part of the Hessian sparsity pattern and the CppAD work storage, reused between the calls
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> nonlinearHessianSubset;
+    CppAD::sparse_hes_work nonlinearHessianWork;
+
     bool nonlinearGradientSparsityMapGenerated = false;
     bool nonlinearHessianSparsityMapGenerated = false;
 
@@ -381,8 +394,12 @@ public:
     double calculateValue(const VectorDouble& point) override;
     Interval calculateValue(const IntervalVector& intervalVector) override;
 
-    SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
-    SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
+    void calculateGradient(const VectorDouble& point, bool eraseZeroes, SparseVariableVector& gradient) override;
+    void calculateHessian(const VectorDouble& point, bool eraseZeroes, SparseVariableMatrix& hessian) override;
+
+    // Fills the provided storage with the upper triagonal Hessian elements of all terms except the nonlinear
+    // expression, without sorting and combining them
+    void calculateTermsHessian(const VectorDouble& point, SparseVariableMatrix& hessian);
 
     std::ostream& print(std::ostream& stream) const override;
 
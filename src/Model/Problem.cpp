@@ -18,6 +18,12 @@
 
 #include "../Tasks/TaskReformulateProblem.h"
 
+#include <cmath>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <thread>
+
 namespace SHOT
 {
 
@@ -121,7 +127,10 @@ void Problem::updateConstraints()
                 T->coefficient *= -1.0;
 
             if(C->nonlinearExpression)
+            {
                 C->nonlinearExpression = simplify(std::make_shared<ExpressionNegate>(C->nonlinearExpression));
+                C->expressionTape.reset();
+            }
 
             C->constant *= -1.0;
         }
@@ -738,6 +747,127 @@ void Problem::updateProperties()
     properties.isValid = true;
 }
 
+void Problem::updateExpressionTape()
+{
+    expressionTape = std::make_shared<ExpressionTape>();
+
+    for(auto& C : nonlinearConstraints)
+    {
+        if(C->properties.hasNonlinearExpression && C->nonlinearExpression)
+        {
+            C->expressionTapeIndex = expressionTape->add(C->nonlinearExpression);
+            C->expressionTape = expressionTape;
+        }
+        else
+        {
+            C->expressionTape.reset();
+        }
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction))
+    {
+        if(objective->properties.hasNonlinearExpression && objective->nonlinearExpression)
+        {
+            objective->expressionTapeIndex = expressionTape->add(objective->nonlinearExpression);
+            objective->expressionTape = expressionTape;
+        }
+        else
+        {
+            objective->expressionTape.reset();
+        }
+    }
+}
+
+namespace
+{
+
+// A point within the variable bounds, where infinite bounds are replaced with finite ones, used to record tapes
+std::vector<double> getTapeTestPoint(const Variables& variables, double fraction = 0.618033988749895)
+{
+    std::vector<double> point(variables.size());
+
+    for(size_t i = 0; i < variables.size(); i++)
+    {
+        double lowerBound = std::max(variables[i]->lowerBound, -100.0);
+        double upperBound = std::min(variables[i]->upperBound, 100.0);
+
+        point[i] = (lowerBound <= upperBound) ? lowerBound + fraction * (upperBound - lowerBound)
+                                              : variables[i]->lowerBound;
+    }
+
+    return (point);
+}
+
+// The points an optimized tape is compared with the original one in: the bounds, the midpoint and some random interior
+// points. The random points are always the same, so that the same tapes are optimized in each run.
+std::vector<std::vector<double>> getTapeTestPoints(const Variables& variables)
+{
+    std::vector<std::vector<double>> points;
+
+    for(double fraction : { 0.618033988749895, 0.0, 1.0, 0.5 })
+        points.push_back(getTapeTestPoint(variables, fraction));
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    for(int k = 0; k < 3; k++)
+    {
+        std::vector<double> point(variables.size());
+
+        for(size_t i = 0; i < variables.size(); i++)
+            point[i] = getTapeTestPoint({ variables[i] }, distribution(generator))[0];
+
+        points.push_back(point);
+    }
+
+    return (points);
+}
+
+// Optimizes the tape, i.e. removes unused and duplicated operations. The optimized tape is only used if its function
+// values and Jacobians in all the test points are the same as for the original tape.
+bool optimizeTape(CppAD::ADFun<double>& function, const std::vector<std::vector<double>>& testPoints)
+{
+    CppAD::ADFun<double> optimizedFunction;
+    optimizedFunction = function;
+    optimizedFunction.optimize();
+
+    auto isEqual = [](double first, double second) {
+        if(std::isnan(first) || std::isnan(second))
+            return (std::isnan(first) && std::isnan(second));
+
+        if(std::isinf(first) || std::isinf(second))
+            return (first == second);
+
+        return (std::abs(first - second) <= 1e-10 * std::max(1.0, std::abs(first)));
+    };
+
+    for(auto& P : testPoints)
+    {
+        auto values = function.Forward(0, P);
+        auto optimizedValues = optimizedFunction.Forward(0, P);
+
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            if(!isEqual(values[i], optimizedValues[i]))
+                return (false);
+        }
+
+        auto jacobian = function.Jacobian(P);
+        auto optimizedJacobian = optimizedFunction.Jacobian(P);
+
+        for(size_t i = 0; i < jacobian.size(); i++)
+        {
+            if(!isEqual(jacobian[i], optimizedJacobian[i]))
+                return (false);
+        }
+    }
+
+    function = std::move(optimizedFunction);
+    return (true);
+}
+
+} // namespace
+
 void Problem::updateFactorableFunctions()
 {
     if(properties.numberOfVariablesInNonlinearExpressions == 0)
@@ -795,6 +925,173 @@ void Problem::updateFactorableFunctions()
     CppAD::AD<double>::abort_recording();
 }
 
+void Problem::updateGradientTapes()
+{
+    gradientTapes.clear();
+
+    for(auto& C : constraintsWithNonlinearExpressions)
+    {
+        C->gradientTape.reset();
+        C->gradientTapeRow = -1;
+        C->nonlinearGradientSparsityMapGenerated = false;
+    }
+
+    auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction);
+
+    if(objective)
+    {
+        objective->gradientTape.reset();
+        objective->gradientTapeRow = -1;
+        objective->nonlinearGradientSparsityMapGenerated = false;
+    }
+
+    auto partitioning = static_cast<ES_GradientTapePartitioning>(
+        env->settings->getSetting<int>("AutomaticDifferentiation.GradientTapes", "Model"));
+
+    if(partitioning == ES_GradientTapePartitioning::None || factorableFunctions.size() == 0)
+        return;
+
+    // The functions with nonlinear expressions, where the objective function is last
+    std::vector<NonlinearExpressionPtr> expressions;
+    std::vector<Variables*> expressionVariables;
+
+    for(auto& C : constraintsWithNonlinearExpressions)
+    {
+        expressions.push_back(C->nonlinearExpression);
+        expressionVariables.push_back(&C->variablesInNonlinearExpression);
+    }
+
+    bool hasNonlinearObjective = (objective && objective->nonlinearExpressionIndex >= 0);
+
+    if(hasNonlinearObjective)
+    {
+        expressions.push_back(objective->nonlinearExpression);
+        expressionVariables.push_back(&objective->variablesInNonlinearExpression);
+    }
+
+    // The group of each function, functions sharing variables are in the same group if partitioning by connected
+    // constraints
+    std::vector<int> expressionGroups(expressions.size());
+    std::iota(expressionGroups.begin(), expressionGroups.end(), 0);
+
+    if(partitioning == ES_GradientTapePartitioning::ConnectedConstraints)
+    {
+        std::vector<int> parents(expressions.size());
+        std::iota(parents.begin(), parents.end(), 0);
+
+        auto findRoot = [&](int index) {
+            while(parents[index] != index)
+            {
+                parents[index] = parents[parents[index]];
+                index = parents[index];
+            }
+
+            return (index);
+        };
+
+        // The first function each nonlinear variable appears in
+        std::vector<int> variableFunctions(properties.numberOfVariablesInNonlinearExpressions, -1);
+
+        for(size_t i = 0; i < expressions.size(); i++)
+        {
+            for(auto& V : *expressionVariables[i])
+            {
+                int& firstFunction = variableFunctions[V->properties.nonlinearVariableIndex];
+
+                if(firstFunction == -1)
+                    firstFunction = i;
+                else
+                    parents[findRoot(i)] = findRoot(firstFunction);
+            }
+        }
+
+        for(size_t i = 0; i < expressions.size(); i++)
+            expressionGroups[i] = findRoot(i);
+    }
+
+    std::vector<VectorInteger> groups(expressions.size());
+
+    for(size_t i = 0; i < expressions.size(); i++)
+        groups[expressionGroups[i]].push_back(i);
+
+    bool optimize = env->settings->getSetting<bool>("AutomaticDifferentiation.Optimize", "Model");
+    int numberOfUnoptimizedTapes = 0;
+
+    for(auto& G : groups)
+    {
+        if(G.size() == 0)
+            continue;
+
+        auto tape = std::make_shared<NonlinearGradientTape>();
+
+        for(auto I : G)
+        {
+            for(auto& V : *expressionVariables[I])
+                tape->variables.push_back(V);
+        }
+
+        std::sort(tape->variables.begin(), tape->variables.end(),
+            [](const VariablePtr& first, const VariablePtr& second) {
+                return (first->properties.nonlinearVariableIndex < second->properties.nonlinearVariableIndex);
+            });
+
+        tape->variables.erase(std::unique(tape->variables.begin(), tape->variables.end()), tape->variables.end());
+
+        auto testPoint = getTapeTestPoint(tape->variables);
+
+        // The expressions are recorded with the variables of the tape as independent variables
+        std::vector<CppAD::AD<double>> tapeVariables(tape->variables.size());
+
+        for(size_t i = 0; i < tape->variables.size(); i++)
+        {
+            tapeVariables[i] = testPoint[i];
+            tape->variables[i]->factorableFunctionVariable = &tapeVariables[i];
+        }
+
+        CppAD::Independent(tapeVariables);
+
+        std::vector<CppAD::AD<double>> tapeFunctions;
+
+        for(auto I : G)
+            tapeFunctions.push_back(expressions[I]->getFactorableFunction());
+
+        tape->function.Dependent(tapeVariables, tapeFunctions);
+
+        for(auto& V : tape->variables)
+            V->factorableFunctionVariable = &factorableFunctionVariables[V->properties.nonlinearVariableIndex];
+
+        if(optimize && !optimizeTape(tape->function, getTapeTestPoints(tape->variables)))
+            numberOfUnoptimizedTapes++;
+
+        for(size_t i = 0; i < G.size(); i++)
+        {
+            if(hasNonlinearObjective && G[i] == (int)expressions.size() - 1)
+            {
+                objective->gradientTape = tape;
+                objective->gradientTapeRow = i;
+            }
+            else
+            {
+                constraintsWithNonlinearExpressions[G[i]]->gradientTape = tape;
+                constraintsWithNonlinearExpressions[G[i]]->gradientTapeRow = i;
+            }
+        }
+
+        gradientTapes.push_back(tape);
+    }
+
+    CppAD::AD<double>::abort_recording();
+
+    env->output->outputDebug(" Created {} CppAD tapes for the gradients of {} nonlinear expressions.",
+        gradientTapes.size(), expressions.size());
+
+    if(numberOfUnoptimizedTapes > 0)
+    {
+        env->output->outputDebug(
+            " {} optimized CppAD tapes differ from the original ones and are not used.", numberOfUnoptimizedTapes);
+    }
+}
+
 Problem::Problem(EnvironmentPtr env) : env(env) { }
 
 Problem::~Problem()
@@ -825,6 +1122,9 @@ void Problem::finalize()
 {
     updateProperties();
     updateFactorableFunctions();
+    updateGradientTapes();
+    updateExpressionTape();
+    updateDecomposition();
     assert(verifyOwnership());
 
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
@@ -1257,6 +1557,172 @@ std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> Problem::getLa
     return (lagrangianHessianSparsityPattern);
 }
 
+void Problem::initializeLagrangianNonlinearHessianSparsityPattern()
+{
+    lagrangianNonlinearHessianSparsityPatternGenerated = true;
+
+    if(factorableFunctions.size() == 0)
+        return;
+
+    auto nonlinearVariablesInExpressionMap = std::vector<bool>(ADFunctions.Domain(), true);
+    auto nonlinearFunctionMap = std::vector<bool>(ADFunctions.Range(), true);
+
+    ADFunctions.for_hes_sparsity(
+        nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, lagrangianNonlinearHessianSparsityPattern);
+
+    lagrangianNonlinearHessianSubset
+        = getUpperTriangularNonlinearHessianSubset(lagrangianNonlinearHessianSparsityPattern);
+
+    lagrangianNonlinearHessianWork.clear();
+    lagrangianNonlinearHessianWeights = VectorDouble(ADFunctions.Range(), 0.0);
+}
+
+void Problem::calculateLagrangianHessian(const VectorDouble& point, double objectiveFactor,
+    const VectorDouble& constraintFactors, bool eraseZeroes, SparseVariableMatrix& hessian)
+{
+    hessian.clear();
+
+    auto nonlinearObjective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction);
+
+    if(objectiveFactor != 0.0)
+    {
+        // The nonlinear expressions are handled separately below
+        if(nonlinearObjective)
+            nonlinearObjective->calculateTermsHessian(point, lagrangianTermsHessian);
+        else
+            objectiveFunction->calculateHessian(point, false, lagrangianTermsHessian);
+
+        for(auto& E : lagrangianTermsHessian)
+            hessian.add(E.first.first, E.first.second, objectiveFactor * E.second);
+    }
+
+    for(auto& C : quadraticConstraints)
+    {
+        double factor = constraintFactors[C->index];
+
+        if(factor == 0.0)
+            continue;
+
+        C->calculateHessian(point, false, lagrangianTermsHessian);
+
+        for(auto& E : lagrangianTermsHessian)
+            hessian.add(E.first.first, E.first.second, factor * E.second);
+    }
+
+    for(auto& C : nonlinearConstraints)
+    {
+        double factor = constraintFactors[C->index];
+
+        if(factor == 0.0)
+            continue;
+
+        C->calculateTermsHessian(point, lagrangianTermsHessian);
+
+        for(auto& E : lagrangianTermsHessian)
+            hessian.add(E.first.first, E.first.second, factor * E.second);
+    }
+
+    if(!lagrangianNonlinearHessianSparsityPatternGenerated)
+        initializeLagrangianNonlinearHessianSparsityPattern();
+
+    if(lagrangianNonlinearHessianSubset.nnz() > 0)
+    {
+        bool hasNonzeroWeight = false;
+
+        for(auto& C : constraintsWithNonlinearExpressions)
+        {
+            lagrangianNonlinearHessianWeights[C->nonlinearExpressionIndex] = constraintFactors[C->index];
+
+            if(constraintFactors[C->index] != 0.0)
+                hasNonzeroWeight = true;
+        }
+
+        if(nonlinearObjective && nonlinearObjective->nonlinearExpressionIndex >= 0)
+        {
+            lagrangianNonlinearHessianWeights[nonlinearObjective->nonlinearExpressionIndex] = objectiveFactor;
+
+            if(objectiveFactor != 0.0)
+                hasNonzeroWeight = true;
+        }
+
+        if(hasNonzeroWeight)
+        {
+            calculateNonlinearExpressionsHessian(point, lagrangianNonlinearHessianWeights,
+                lagrangianNonlinearHessianSubset, lagrangianNonlinearHessianSparsityPattern,
+                lagrangianNonlinearHessianWork, hessian);
+        }
+    }
+
+    hessian.sortAndCombine();
+
+    if(eraseZeroes)
+        hessian.eraseZeroes();
+}
+
+CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> Problem::getUpperTriangularNonlinearHessianSubset(
+    const CppAD::sparse_rc<std::vector<size_t>>& pattern)
+{
+    const std::vector<size_t>& rowIndices(pattern.row());
+    const std::vector<size_t>& colIndices(pattern.col());
+
+    size_t numberOfElements = 0;
+
+    for(size_t i = 0; i < pattern.nnz(); i++)
+    {
+        if(rowIndices[i] <= colIndices[i])
+            numberOfElements++;
+    }
+
+    CppAD::sparse_rc<std::vector<size_t>> upperTriangularPattern(pattern.nr(), pattern.nc(), numberOfElements);
+
+    size_t counter = 0;
+
+    for(size_t i = 0; i < pattern.nnz(); i++)
+    {
+        if(rowIndices[i] <= colIndices[i])
+        {
+            upperTriangularPattern.set(counter, rowIndices[i], colIndices[i]);
+            counter++;
+        }
+    }
+
+    return (CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>>(upperTriangularPattern));
+}
+
+void Problem::calculateNonlinearExpressionsHessian(const VectorDouble& point, const VectorDouble& weights,
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>>& subset,
+    const CppAD::sparse_rc<std::vector<size_t>>& pattern, CppAD::sparse_hes_work& work, SparseVariableMatrix& hessian)
+{
+    if(subset.nnz() == 0)
+        return;
+
+    nonlinearExpressionVariableValues.resize(properties.numberOfVariablesInNonlinearExpressions);
+
+    for(auto& VAR : nonlinearExpressionVariables)
+        nonlinearExpressionVariableValues[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+
+    ADFunctions.sparse_hes(nonlinearExpressionVariableValues, weights, subset, pattern, "cppad.symmetric", work);
+
+    const std::vector<size_t>& rowIndices(subset.row());
+    const std::vector<size_t>& colIndices(subset.col());
+    const std::vector<double>& values(subset.val());
+
+    for(size_t k = 0; k < subset.nnz(); k++)
+    {
+        if(values[k] == 0.0)
+            continue;
+
+        int firstIndex = nonlinearExpressionVariables[rowIndices[k]]->index;
+        int secondIndex = nonlinearExpressionVariables[colIndices[k]]->index;
+
+        // Only elements above the diagonal are saved since the Hessian is symmetric
+        if(firstIndex <= secondIndex)
+            hessian.add(firstIndex, secondIndex, values[k]);
+        else
+            hessian.add(secondIndex, firstIndex, values[k]);
+    }
+}
+
 std::optional<NumericConstraintValue> Problem::getMostDeviatingNumericConstraint(const VectorDouble& point)
 {
     return (this->getMostDeviatingNumericConstraint(point, numericConstraints));
@@ -1414,16 +1880,41 @@ NumericConstraintValue getMaxNumericConstraintValue(const VectorDouble& point,
     return value;
 }
 
-NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const LinearConstraints constraintSelection)
+namespace
 {
-    assert(constraintSelection.size() > 0);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point);
+// The number of consecutive constraints evaluated by a thread at a time when the constraints are evaluated in
+// parallel. The chunks are large enough for the cost of distributing them to be small, and a thread accesses
+// neighbouring constraints.
+constexpr int evaluationChunkSize = 256;
+
+inline int getNumberOfChunks(int numberOfConstraints)
+{
+    return ((numberOfConstraints + evaluationChunkSize - 1) / evaluationChunkSize);
+}
+
+// Calls calculateChunk(chunk, first, last) for the consecutive chunks of the constraints with indexes first, ...,
+// last - 1 using the given number of threads
+void calculateInChunks(
+    int numberOfConstraints, int numberOfThreads, const std::function<void(int, int, int)>& calculateChunk)
+{
+    Utilities::parallelFor(getNumberOfChunks(numberOfConstraints), numberOfThreads, [&](int chunk) {
+        calculateChunk(chunk, chunk * evaluationChunkSize,
+            std::min(numberOfConstraints, (chunk + 1) * evaluationChunkSize));
+    });
+}
 
-    for(size_t i = 1; i < constraintSelection.size(); i++)
+// Returns the largest value of the constraints with indexes first, ..., last - 1, where the first one is used if
+// several have the same value
+template <typename T>
+NumericConstraintValue getMaxConstraintValue(
+    const VectorDouble& point, const std::vector<T>& constraintSelection, int first, int last, double correction)
+{
+    auto value = constraintSelection[first]->calculateNumericValue(point, correction);
+
+    for(int i = first + 1; i < last; i++)
     {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+        auto tmpValue = constraintSelection[i]->calculateNumericValue(point, correction);
 
         if(tmpValue.normalizedValue > value.normalizedValue)
         {
@@ -1434,105 +1925,256 @@ NumericConstraintValue Problem::getMaxNumericConstraintValue(
     return value;
 }
 
-NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const QuadraticConstraints constraintSelection)
+template <typename T>
+NumericConstraintValue getMaxConstraintValue(
+    const VectorDouble& point, const std::vector<T>& constraintSelection, double correction, int numberOfThreads)
 {
     assert(constraintSelection.size() > 0);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point);
+    int numberOfConstraints = constraintSelection.size();
 
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+    if(numberOfThreads == 1)
+        return (getMaxConstraintValue(point, constraintSelection, 0, numberOfConstraints, correction));
 
-        if(tmpValue.normalizedValue > value.normalizedValue)
-        {
-            value = tmpValue;
-        }
+    std::vector<NumericConstraintValue> chunkValues(getNumberOfChunks(numberOfConstraints));
+
+    calculateInChunks(numberOfConstraints, numberOfThreads, [&](int chunk, int first, int last) {
+        chunkValues[chunk] = getMaxConstraintValue(point, constraintSelection, first, last, correction);
+    });
+
+    auto value = chunkValues[0];
+
+    for(size_t i = 1; i < chunkValues.size(); i++)
+    {
+        if(chunkValues[i].normalizedValue > value.normalizedValue)
+            value = chunkValues[i];
     }
 
     return value;
 }
 
+// Keeps the given number of largest values, sorted in decreasing order. Only the largest values are sorted, after
+// they have been selected with a partial sort.
+void keepLargestValues(NumericConstraintValues& values, int numberOfValues)
+{
+    if((int)values.size() > numberOfValues)
+    {
+        std::nth_element(values.begin(), values.begin() + (numberOfValues - 1), values.end(),
+            std::greater<NumericConstraintValue>());
+
+        values.erase(values.begin() + numberOfValues, values.end());
+    }
+
+    std::sort(values.begin(), values.end(), std::greater<NumericConstraintValue>());
+}
+
+} // namespace
+
+int Problem::getEvaluationThreads(size_t numberOfConstraints)
+{
+    // The settings are not looked up if there are too few constraints to benefit from several threads
+    if(numberOfConstraints < 2 * evaluationChunkSize)
+        return (1);
+
+    int minimumConstraints = env->settings->getSetting<int>("Evaluation.Parallel.MinimumConstraints", "Model");
+
+    if(minimumConstraints == 0 || (int)numberOfConstraints < minimumConstraints)
+        return (1);
+
+    int numberOfThreads = env->settings->getSetting<int>("Threads", "Strategy");
+
+    if(numberOfThreads <= 0)
+        numberOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    return (numberOfThreads);
+}
+
+NumericConstraintValue Problem::getMaxNumericConstraintValue(
+    const VectorDouble& point, const LinearConstraints constraintSelection)
+{
+    return (getMaxConstraintValue(
+        point, constraintSelection, 0.0, getEvaluationThreads(constraintSelection.size())));
+}
+
+NumericConstraintValue Problem::getMaxNumericConstraintValue(
+    const VectorDouble& point, const QuadraticConstraints constraintSelection)
+{
+    return (getMaxConstraintValue(
+        point, constraintSelection, 0.0, getEvaluationThreads(constraintSelection.size())));
+}
+
 NumericConstraintValue Problem::getMaxNumericConstraintValue(
     const VectorDouble& point, const NonlinearConstraints constraintSelection, double correction)
 {
+    return (getMaxConstraintValue(
+        point, constraintSelection, correction, getEvaluationThreads(constraintSelection.size())));
+}
+
+NumericConstraintValue Problem::getMaxNumericConstraintValue(
+    const VectorDouble& point, const NumericConstraints constraintSelection)
+{
+    return (getMaxConstraintValue(
+        point, constraintSelection, 0.0, getEvaluationThreads(constraintSelection.size())));
+}
+
+NumericConstraintValue Problem::getMaxNumericConstraintValue(const VectorDouble& point,
+    const std::vector<NumericConstraint*>& constraintSelection, std::vector<NumericConstraint*>& activeConstraints)
+{
+    assert(activeConstraints.size() == 0);
     assert(constraintSelection.size() > 0);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point, correction);
+    int numberOfConstraints = constraintSelection.size();
 
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point, correction);
+    auto calculateChunk = [&](int first, int last, std::vector<NumericConstraint*>& chunkActiveConstraints) {
+        auto value = constraintSelection[first]->calculateNumericValue(point);
 
-        if(tmpValue.normalizedValue > value.normalizedValue)
+        if(value.normalizedValue > 0)
+            chunkActiveConstraints.push_back(constraintSelection[first]);
+
+        for(int i = first + 1; i < last; i++)
         {
-            value = tmpValue;
+            auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+
+            if(tmpValue.normalizedValue > value.normalizedValue)
+            {
+                value = tmpValue;
+            }
+
+            if(tmpValue.normalizedValue > 0)
+                chunkActiveConstraints.push_back(constraintSelection[i]);
         }
+
+        return (value);
+    };
+
+    int numberOfThreads = getEvaluationThreads(numberOfConstraints);
+
+    if(numberOfThreads == 1)
+        return (calculateChunk(0, numberOfConstraints, activeConstraints));
+
+    int numberOfChunks = getNumberOfChunks(numberOfConstraints);
+    std::vector<NumericConstraintValue> chunkValues(numberOfChunks);
+    std::vector<std::vector<NumericConstraint*>> chunkActiveConstraints(numberOfChunks);
+
+    calculateInChunks(numberOfConstraints, numberOfThreads, [&](int chunk, int first, int last) {
+        chunkValues[chunk] = calculateChunk(first, last, chunkActiveConstraints[chunk]);
+    });
+
+    auto value = chunkValues[0];
+
+    for(int i = 0; i < numberOfChunks; i++)
+    {
+        if(chunkValues[i].normalizedValue > value.normalizedValue)
+            value = chunkValues[i];
+
+        activeConstraints.insert(
+            activeConstraints.end(), chunkActiveConstraints[i].begin(), chunkActiveConstraints[i].end());
     }
 
     return value;
 }
 
-NumericConstraintValue Problem::getMaxNumericConstraintValue(
-    const VectorDouble& point, const NumericConstraints constraintSelection)
+template <typename T>
+NumericConstraintValues getMaxNumericConstraintValues(
+    const PointBatch& points, const std::vector<T>& constraintSelection, int first, int last)
 {
-    assert(constraintSelection.size() > 0);
+    NumericConstraintValues values;
+    constraintSelection[first]->calculateNumericValues(points, values);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point);
+    NumericConstraintValues tmpValues;
 
-    for(size_t i = 1; i < constraintSelection.size(); i++)
+    for(int i = first + 1; i < last; i++)
     {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+        constraintSelection[i]->calculateNumericValues(points, tmpValues);
 
-        if(tmpValue.normalizedValue > value.normalizedValue)
+        for(int k = 0; k < points.getNumberOfPoints(); k++)
         {
-            value = tmpValue;
+            if(tmpValues[k].normalizedValue > values[k].normalizedValue)
+                values[k] = tmpValues[k];
         }
     }
 
-    return value;
+    return values;
 }
 
-NumericConstraintValue Problem::getMaxNumericConstraintValue(const VectorDouble& point,
-    const std::vector<NumericConstraint*>& constraintSelection, std::vector<NumericConstraint*>& activeConstraints)
+template <typename T>
+NumericConstraintValues getMaxNumericConstraintValues(
+    const PointBatch& points, const std::vector<T>& constraintSelection, int numberOfThreads)
 {
-    assert(activeConstraints.size() == 0);
     assert(constraintSelection.size() > 0);
 
-    auto value = constraintSelection[0]->calculateNumericValue(point);
+    int numberOfConstraints = constraintSelection.size();
 
-    if(value.normalizedValue > 0)
-        activeConstraints.push_back(constraintSelection[0]);
+    if(numberOfThreads == 1)
+        return (getMaxNumericConstraintValues(points, constraintSelection, 0, numberOfConstraints));
 
-    for(size_t i = 1; i < constraintSelection.size(); i++)
-    {
-        auto tmpValue = constraintSelection[i]->calculateNumericValue(point);
+    std::vector<NumericConstraintValues> chunkValues(getNumberOfChunks(numberOfConstraints));
 
-        if(tmpValue.normalizedValue > value.normalizedValue)
+    calculateInChunks(numberOfConstraints, numberOfThreads, [&](int chunk, int first, int last) {
+        chunkValues[chunk] = getMaxNumericConstraintValues(points, constraintSelection, first, last);
+    });
+
+    auto values = std::move(chunkValues[0]);
+
+    for(size_t i = 1; i < chunkValues.size(); i++)
+    {
+        for(int k = 0; k < points.getNumberOfPoints(); k++)
         {
-            value = tmpValue;
+            if(chunkValues[i][k].normalizedValue > values[k].normalizedValue)
+                values[k] = chunkValues[i][k];
         }
-
-        if(tmpValue.normalizedValue > 0)
-            activeConstraints.push_back(constraintSelection[i]);
     }
 
-    return value;
+    return values;
+}
+
+NumericConstraintValues Problem::getMaxNumericConstraintValues(
+    const PointBatch& points, const NonlinearConstraints constraintSelection)
+{
+    return (SHOT::getMaxNumericConstraintValues(
+        points, constraintSelection, getEvaluationThreads(constraintSelection.size())));
+}
+
+NumericConstraintValues Problem::getMaxNumericConstraintValues(
+    const PointBatch& points, const std::vector<NumericConstraint*>& constraintSelection)
+{
+    return (SHOT::getMaxNumericConstraintValues(
+        points, constraintSelection, getEvaluationThreads(constraintSelection.size())));
 }
 
 template <typename T>
 NumericConstraintValues Problem::getAllDeviatingConstraints(
     const VectorDouble& point, double tolerance, std::vector<T> constraintSelection, double correction)
 {
+    int numberOfConstraints = constraintSelection.size();
+
+    auto calculateChunk = [&](int first, int last, NumericConstraintValues& constraintValues) {
+        for(int i = first; i < last; i++)
+        {
+            NumericConstraintValue constraintValue = constraintSelection[i]->calculateNumericValue(point, correction);
+            if(constraintValue.normalizedValue > tolerance)
+                constraintValues.push_back(constraintValue);
+        }
+    };
+
     NumericConstraintValues constraintValues;
-    for(auto& C : constraintSelection)
+    int numberOfThreads = getEvaluationThreads(numberOfConstraints);
+
+    if(numberOfThreads == 1)
     {
-        NumericConstraintValue constraintValue = C->calculateNumericValue(point, correction);
-        if(constraintValue.normalizedValue > tolerance)
-            constraintValues.push_back(constraintValue);
+        calculateChunk(0, numberOfConstraints, constraintValues);
+        return constraintValues;
     }
 
+    // The values are combined in the order of the constraints, so that the result does not depend on the threads
+    std::vector<NumericConstraintValues> chunkValues(getNumberOfChunks(numberOfConstraints));
+
+    calculateInChunks(numberOfConstraints, numberOfThreads,
+        [&](int chunk, int first, int last) { calculateChunk(first, last, chunkValues[chunk]); });
+
+    for(auto& V : chunkValues)
+        constraintValues.insert(constraintValues.end(), V.begin(), V.end());
+
     return constraintValues;
 }
 
@@ -1548,14 +2190,61 @@ NumericConstraintValues Problem::getFractionOfDeviatingNonlinearConstraints(
 
     auto values = getAllDeviatingConstraints(point, tolerance, this->nonlinearConstraints, correction);
 
-    std::sort(values.begin(), values.end(), std::greater<NumericConstraintValue>());
+    keepLargestValues(values, fractionNumbers);
+    return values;
+}
+
+std::vector<NumericConstraintValues> Problem::getFractionOfDeviatingNonlinearConstraints(
+    const PointBatch& points, double tolerance, double fraction)
+{
+    if(fraction > 1)
+        fraction = 1;
+    else if(fraction < 0)
+        fraction = 0;
+
+    int fractionNumbers = std::max(1, (int)ceil(fraction * this->nonlinearConstraints.size()));
+    int numberOfConstraints = nonlinearConstraints.size();
+
+    auto calculateChunk = [&](int first, int last, std::vector<NumericConstraintValues>& values) {
+        NumericConstraintValues constraintValues;
 
-    if((int)values.size() <= fractionNumbers) // Not enough elements to need truncating
+        for(int i = first; i < last; i++)
+        {
+            nonlinearConstraints[i]->calculateNumericValues(points, constraintValues);
+
+            for(int k = 0; k < points.getNumberOfPoints(); k++)
+            {
+                if(constraintValues[k].normalizedValue > tolerance)
+                    values[k].push_back(constraintValues[k]);
+            }
+        }
+    };
+
+    std::vector<NumericConstraintValues> values(points.getNumberOfPoints());
+    int numberOfThreads = getEvaluationThreads(numberOfConstraints);
+
+    if(numberOfThreads == 1)
+    {
+        calculateChunk(0, numberOfConstraints, values);
+    }
+    else
     {
-        return values;
+        std::vector<std::vector<NumericConstraintValues>> chunkValues(
+            getNumberOfChunks(numberOfConstraints), std::vector<NumericConstraintValues>(points.getNumberOfPoints()));
+
+        calculateInChunks(numberOfConstraints, numberOfThreads,
+            [&](int chunk, int first, int last) { calculateChunk(first, last, chunkValues[chunk]); });
+
+        for(auto& C : chunkValues)
+        {
+            for(int k = 0; k < points.getNumberOfPoints(); k++)
+                values[k].insert(values[k].end(), C[k].begin(), C[k].end());
+        }
     }
 
-    values.resize(fractionNumbers);
+    for(auto& V : values)
+        keepLargestValues(V, fractionNumbers);
+
     return values;
 }
 
@@ -1664,63 +2353,113 @@ void Problem::doFBBT()
     bool useNonlinearBoundTightening
         = env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.UseNonlinear", "Model");
 
-    bool stopTightening = false;
+    double minimumRelativeTightening
+        = env->settings->getSetting<double>("BoundTightening.FeasibilityBased.MinimumRelativeTightening", "Model");
 
     int numberOfTightenedVariablesBefore = std::count_if(allVariables.begin(), allVariables.end(),
         [](auto V) { return (V->properties.hasLowerBoundBeenTightened || V->properties.hasUpperBoundBeenTightened); });
 
-    for(int i = 0; i < numberOfIterations; i++)
+    std::vector<NumericConstraintPtr> constraints;
+    constraints.reserve(linearConstraints.size() + quadraticConstraints.size() + nonlinearConstraints.size());
+
+    for(auto& C : linearConstraints)
+        constraints.push_back(C);
+
+    for(auto& C : quadraticConstraints)
+        constraints.push_back(C);
+
+    if(useNonlinearBoundTightening)
     {
-        bool boundsUpdated = false;
+        for(auto& C : nonlinearConstraints)
+            constraints.push_back(C);
+    }
+
+    auto incidence = getVariableConstraintIncidence(constraints);
+
+    // Initially all constraints are in the worklist, afterwards a constraint is only added again if the bound of one
+    // of its variables has been tightened effectively, and if it has not been used the maximum number of times
+    std::deque<int> worklist(constraints.size());
+    std::iota(worklist.begin(), worklist.end(), 0);
+    std::vector<bool> isInWorklist(constraints.size(), true);
+    VectorInteger numberOfPropagations(constraints.size(), 0);
+    int totalNumberOfPropagations = 0;
+
+    VectorDouble lowerBoundsBefore;
+    VectorDouble upperBoundsBefore;
 
-        env->output->outputDebug(fmt::format("  Bound tightening pass {} of {}.", i + 1, numberOfIterations));
+    auto isInfiniteBound = [](double bound) { return (std::abs(bound) >= SHOT_DBL_MAX); };
 
-        for(auto& C : linearConstraints)
+    while(!worklist.empty())
+    {
+        if(env->timing->getElapsedTime("BoundTightening") - startTime > timeLimit)
         {
-            if(env->timing->getElapsedTime("BoundTightening") - startTime > timeLimit)
-            {
-                stopTightening = true;
-                break;
-            }
+            env->output->outputDebug("  Time limit reached in bound tightening.");
+            break;
+        }
+
+        int constraintPosition = worklist.front();
+        worklist.pop_front();
+        isInWorklist[constraintPosition] = false;
+
+        numberOfPropagations[constraintPosition]++;
+        totalNumberOfPropagations++;
+
+        auto& variables = incidence.constraintVariables[constraintPosition];
 
-            boundsUpdated = doFBBTOnConstraint(C, timeLimit + startTime) || boundsUpdated;
+        lowerBoundsBefore.resize(variables.size());
+        upperBoundsBefore.resize(variables.size());
+
+        for(size_t j = 0; j < variables.size(); j++)
+        {
+            lowerBoundsBefore[j] = variables[j]->lowerBound;
+            upperBoundsBefore[j] = variables[j]->upperBound;
         }
 
-        if(stopTightening)
-            break;
+        if(!doFBBTOnConstraint(constraints[constraintPosition], timeLimit + startTime))
+            continue;
 
-        for(auto& C : quadraticConstraints)
+        for(size_t j = 0; j < variables.size(); j++)
         {
-            if(env->timing->getElapsedTime("BoundTightening") - startTime > timeLimit)
+            // The term bounds are calculated from the cached variable bounds, so these must reflect the tightening
+            // before the next constraint is propagated
+            if(variablesUpdated)
             {
-                stopTightening = true;
-                break;
+                int variableIndex = variables[j]->index;
+                variableLowerBounds[variableIndex] = variables[j]->lowerBound;
+                variableUpperBounds[variableIndex] = variables[j]->upperBound;
+                variableBounds[variableIndex] = Interval(variables[j]->lowerBound, variables[j]->upperBound);
             }
 
-            boundsUpdated = doFBBTOnConstraint(C, timeLimit + startTime) || boundsUpdated;
-        }
+            double widthBefore = upperBoundsBefore[j] - lowerBoundsBefore[j];
+            double widthAfter = variables[j]->upperBound - variables[j]->lowerBound;
 
-        if(stopTightening)
-            break;
+            // An infinite bound that becomes finite is an effective tightening even if the width is still infinite
+            bool isBoundMadeFinite
+                = (isInfiniteBound(lowerBoundsBefore[j]) && !isInfiniteBound(variables[j]->lowerBound))
+                || (isInfiniteBound(upperBoundsBefore[j]) && !isInfiniteBound(variables[j]->upperBound));
 
-        if(useNonlinearBoundTightening)
-        {
-            for(auto& C : nonlinearConstraints)
+            // Infinite or huge domains that become smaller always count as effective tightenings
+            if(!isBoundMadeFinite
+                && (widthAfter >= widthBefore
+                    || (std::isfinite(widthBefore)
+                        && widthBefore - widthAfter <= minimumRelativeTightening * std::max(widthBefore, 1.0))))
+                continue;
+
+            for(auto otherPosition : incidence.variableConstraints[variables[j]->index])
             {
-                if(env->timing->getElapsedTime("BoundTightening") - startTime > timeLimit)
+                if(!isInWorklist[otherPosition] && numberOfPropagations[otherPosition] < numberOfIterations)
                 {
-                    stopTightening = true;
-                    break;
+                    worklist.push_back(otherPosition);
+                    isInWorklist[otherPosition] = true;
                 }
-
-                boundsUpdated = doFBBTOnConstraint(C, timeLimit + startTime) || boundsUpdated;
             }
         }
-
-        if(stopTightening || !boundsUpdated)
-            break;
     }
 
+    env->output->outputDebug(fmt::format(
+        "  Bound tightening used {} constraint propagations for {} constraints.", totalNumberOfPropagations,
+        constraints.size()));
+
     int numberOfTightenedVariablesAfter = std::count_if(allVariables.begin(), allVariables.end(),
         [](auto V) { return (V->properties.hasLowerBoundBeenTightened || V->properties.hasUpperBoundBeenTightened); });
 
@@ -1742,6 +2481,232 @@ void Problem::doFBBT()
     env->timing->stopTimer("BoundTightening");
 }
 
+VariableConstraintIncidence Problem::getVariableConstraintIncidence(
+    const std::vector<NumericConstraintPtr>& constraints)
+{
+    VariableConstraintIncidence incidence;
+    incidence.constraintVariables.resize(constraints.size());
+    incidence.variableConstraints.resize(allVariables.size());
+
+    for(size_t i = 0; i < constraints.size(); i++)
+    {
+        auto& variables = incidence.constraintVariables[i];
+        auto constraint = constraints[i].get();
+
+        if(constraint->properties.hasLinearTerms)
+        {
+            for(auto& T : static_cast<LinearConstraint*>(constraint)->linearTerms)
+            {
+                if(T->coefficient != 0.0)
+                    variables.push_back(T->variable.get());
+            }
+        }
+
+        if(constraint->properties.hasQuadraticTerms)
+        {
+            for(auto& T : static_cast<QuadraticConstraint*>(constraint)->quadraticTerms)
+            {
+                if(T->coefficient == 0.0)
+                    continue;
+
+                variables.push_back(T->firstVariable.get());
+                variables.push_back(T->secondVariable.get());
+            }
+        }
+
+        if(auto nonlinearConstraint = dynamic_cast<NonlinearConstraint*>(constraint))
+        {
+            for(auto& V : nonlinearConstraint->variablesInMonomialTerms)
+                variables.push_back(V.get());
+
+            for(auto& V : nonlinearConstraint->variablesInSignomialTerms)
+                variables.push_back(V.get());
+
+            for(auto& V : nonlinearConstraint->variablesInNonlinearExpression)
+                variables.push_back(V.get());
+        }
+
+        std::sort(variables.begin(), variables.end(),
+            [](const Variable* variableOne, const Variable* variableTwo) {
+                return (variableOne->index < variableTwo->index);
+            });
+
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+
+        variables.erase(std::remove_if(variables.begin(), variables.end(),
+                            [&](const Variable* V) { return (V->index < 0 || V->index >= (int)allVariables.size()); }),
+            variables.end());
+
+        for(auto& V : variables)
+            incidence.variableConstraints[V->index].push_back(i);
+    }
+
+    return (incidence);
+}
+
+void Problem::updateDecomposition()
+{
+    decomposition = ProblemDecomposition();
+
+    auto incidence = getVariableConstraintIncidence(numericConstraints);
+
+    std::vector<int> parents(allVariables.size());
+    std::iota(parents.begin(), parents.end(), 0);
+
+    auto findRoot = [&](int index) {
+        while(parents[index] != index)
+        {
+            parents[index] = parents[parents[index]];
+            index = parents[index];
+        }
+
+        return (index);
+    };
+
+    auto isNonlinear = [](const NumericConstraintPtr& constraint) {
+        return (constraint->properties.hasQuadraticTerms || constraint->properties.hasMonomialTerms
+            || constraint->properties.hasSignomialTerms || constraint->properties.hasNonlinearExpression);
+    };
+
+    // The nonlinear and quadratic constraints connect all of their variables
+    for(size_t i = 0; i < numericConstraints.size(); i++)
+    {
+        auto& variables = incidence.constraintVariables[i];
+
+        if(!isNonlinear(numericConstraints[i]) || variables.size() == 0)
+            continue;
+
+        for(size_t j = 1; j < variables.size(); j++)
+            parents[findRoot(variables[j]->index)] = findRoot(variables[0]->index);
+    }
+
+    // Whether the component with the variable as root contains nonlinear or quadratic constraints
+    std::vector<bool> isNonlinearComponent(allVariables.size(), false);
+
+    for(size_t i = 0; i < numericConstraints.size(); i++)
+    {
+        if(isNonlinear(numericConstraints[i]) && incidence.constraintVariables[i].size() > 0)
+            isNonlinearComponent[findRoot(incidence.constraintVariables[i][0]->index)] = true;
+    }
+
+    // A linear constraint is a linking constraint if its variables are in several nonlinear components, otherwise its
+    // variables are added to the nonlinear component, if any
+    std::vector<bool> isLinking(numericConstraints.size(), false);
+    VectorInteger nonlinearComponents;
+
+    for(size_t i = 0; i < numericConstraints.size(); i++)
+    {
+        auto& variables = incidence.constraintVariables[i];
+
+        if(isNonlinear(numericConstraints[i]) || variables.size() == 0)
+            continue;
+
+        nonlinearComponents.clear();
+
+        for(auto& V : variables)
+        {
+            int root = findRoot(V->index);
+
+            if(isNonlinearComponent[root]
+                && std::find(nonlinearComponents.begin(), nonlinearComponents.end(), root) == nonlinearComponents.end())
+                nonlinearComponents.push_back(root);
+        }
+
+        if(nonlinearComponents.size() > 1)
+        {
+            isLinking[i] = true;
+            continue;
+        }
+
+        for(size_t j = 1; j < variables.size(); j++)
+            parents[findRoot(variables[j]->index)] = findRoot(variables[0]->index);
+
+        if(nonlinearComponents.size() == 1)
+            isNonlinearComponent[findRoot(variables[0]->index)] = true;
+    }
+
+    decomposition.constraintBlocks.assign(numericConstraints.size(), -1);
+    decomposition.variableBlocks.assign(allVariables.size(), -1);
+
+    // The block of each component, the blocks are numbered in the order of their first constraint
+    std::vector<int> componentBlocks(allVariables.size(), -1);
+
+    for(size_t i = 0; i < numericConstraints.size(); i++)
+    {
+        auto& variables = incidence.constraintVariables[i];
+
+        if(isLinking[i])
+        {
+            decomposition.linkingConstraints.push_back(i);
+            continue;
+        }
+
+        if(variables.size() == 0)
+            continue;
+
+        int& block = componentBlocks[findRoot(variables[0]->index)];
+
+        if(block == -1)
+        {
+            block = decomposition.blockConstraints.size();
+            decomposition.blockConstraints.emplace_back();
+        }
+
+        decomposition.constraintBlocks[i] = block;
+        decomposition.blockConstraints[block].push_back(i);
+    }
+
+    decomposition.blockVariables.resize(decomposition.blockConstraints.size());
+
+    for(size_t i = 0; i < allVariables.size(); i++)
+    {
+        int block = componentBlocks[findRoot(i)];
+
+        if(block == -1)
+            continue;
+
+        decomposition.variableBlocks[i] = block;
+        decomposition.blockVariables[block].push_back(i);
+    }
+
+    env->output->outputDebug(" Problem has {} blocks and {} linking constraints.", decomposition.getNumberOfBlocks(),
+        decomposition.linkingConstraints.size());
+}
+
+VectorInteger Problem::getBlockVariables(const std::vector<NumericConstraint*>& constraints) const
+{
+    VectorInteger blocks;
+    size_t numberOfVariables = 0;
+
+    for(auto& C : constraints)
+    {
+        if(C->index < 0 || C->index >= (int)decomposition.constraintBlocks.size())
+            return (VectorInteger());
+
+        int block = decomposition.constraintBlocks[C->index];
+
+        if(block == -1)
+            return (VectorInteger());
+
+        if(std::find(blocks.begin(), blocks.end(), block) != blocks.end())
+            continue;
+
+        blocks.push_back(block);
+        numberOfVariables += decomposition.blockVariables[block].size();
+
+        if(2 * numberOfVariables > allVariables.size())
+            return (VectorInteger());
+    }
+
+    VectorInteger variables;
+    variables.reserve(numberOfVariables);
+
+    for(auto B : blocks)
+        variables.insert(variables.end(), decomposition.blockVariables[B].begin(), decomposition.blockVariables[B].end());
+
+    return (variables);
+}
+
 bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLimit)
 {
     bool boundsUpdated = false;
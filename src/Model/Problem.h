@@ -18,6 +18,7 @@
 #include "AuxiliaryVariables.h"
 #include "ObjectiveFunction.h"
 #include "Constraints.h"
+#include "ExpressionTape.h"
 
 #include <memory>
 #include <optional>
@@ -74,6 +75,29 @@ struct ProblemProperties
     bool isReformulated = false; // True if this is the reformulated problem
 };
 
+// The variables in each constraint in a list of constraints, and the positions in the list of the constraints each
+// variable (given by its index) appears in
+struct VariableConstraintIncidence
+{
+    std::vector<std::vector<Variable*>> constraintVariables;
+    std::vector<VectorInteger> variableConstraints;
+};
+
+// The block structure of a problem, given by the connected components of the variable-constraint incidence graph.
+// Linear constraints that would connect several components containing nonlinear or quadratic constraints are not part
+// of any block, but are considered linking constraints.
+struct ProblemDecomposition
+{
+    std::vector<VectorInteger> blockVariables; // The indexes of the variables in each block
+    std::vector<VectorInteger> blockConstraints; // The indexes of the numeric constraints in each block
+    VectorInteger linkingConstraints;
+
+    VectorInteger variableBlocks; // The block of each variable, -1 if it is not in any block
+    VectorInteger constraintBlocks; // The block of each numeric constraint, -1 if it is not in any block
+
+    inline int getNumberOfBlocks() const { return (blockVariables.size()); }
+};
+
 class DllExport Problem : public std::enable_shared_from_this<Problem>
 {
 private:
@@ -87,11 +111,31 @@ private:
 
     NonlinearConstraints constraintsWithNonlinearExpressions;
 
+    // Used when calculating the Hessian of the Lagrangian, the sparsity pattern and CppAD work storage are initialized
+    // on the first call and then reused
+    CppAD::sparse_rc<std::vector<size_t>> lagrangianNonlinearHessianSparsityPattern;
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> lagrangianNonlinearHessianSubset;
+    CppAD::sparse_hes_work lagrangianNonlinearHessianWork;
+    bool lagrangianNonlinearHessianSparsityPatternGenerated = false;
+
+    VectorDouble lagrangianNonlinearHessianWeights;
+    SparseVariableMatrix lagrangianTermsHessian;
+    VectorDouble nonlinearExpressionVariableValues;
+
+    void initializeLagrangianNonlinearHessianSparsityPattern();
+
+    // Returns the number of threads used when evaluating the given number of constraints in a point, which is one
+    // unless there are enough constraints for the setting Evaluation.Parallel.MinimumConstraints in category Model
+    int getEvaluationThreads(size_t numberOfConstraints);
+
     void updateVariableBounds(); // This is called by updateVariables()
     void updateVariables();
     void updateConstraints();
     void updateConvexity();
     void updateFactorableFunctions();
+    void updateGradientTapes();
+    void updateExpressionTape();
+    void updateDecomposition();
 
     bool verifyOwnership();
 
@@ -131,6 +175,19 @@ public:
     std::vector<CppAD::AD<double>> factorableFunctions;
     CppAD::ADFun<double> ADFunctions;
 
+    // The tapes used when calculating gradients of the nonlinear expressions, if partitioned according to the setting
+    // AutomaticDifferentiation.GradientTapes, otherwise ADFunctions is used
+    std::vector<NonlinearGradientTapePtr> gradientTapes;
+
+    // The nonlinear expressions compiled for faster evaluation of function values
+    ExpressionTapePtr expressionTape;
+
+    // The convexity of the blocks of quadratic terms already checked in the objective and the constraints
+    QuadraticConvexityCache quadraticConvexityCache;
+
+    // The block structure of the problem, updated when finalizing the problem
+    ProblemDecomposition decomposition;
+
     void updateProperties();
 
     // This also updates the problem properties
@@ -175,6 +232,23 @@ public:
     std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getConstraintsHessianSparsityPattern();
     std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> getLagrangianHessianSparsityPattern();
 
+    // Fills the provided storage with the upper triagonal part of the Hessian of the Lagrangian, where the objective
+    // function is weighted with objectiveFactor and the constraints with constraintFactors (indexed by constraint
+    // index). The nonlinear expressions of all functions are evaluated in one weighted sweep.
+    void calculateLagrangianHessian(const VectorDouble& point, double objectiveFactor,
+        const VectorDouble& constraintFactors, bool eraseZeroes, SparseVariableMatrix& hessian);
+
+    // Returns the upper triagonal elements of a Hessian sparsity pattern w.r.t. the nonlinear expression variables
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> getUpperTriangularNonlinearHessianSubset(
+        const CppAD::sparse_rc<std::vector<size_t>>& pattern);
+
+    // Calculates the elements in subset of the Hessian of the nonlinear expressions weighted with weights, and adds
+    // them to the provided storage, which needs to be sorted and combined afterwards
+    void calculateNonlinearExpressionsHessian(const VectorDouble& point, const VectorDouble& weights,
+        CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>>& subset,
+        const CppAD::sparse_rc<std::vector<size_t>>& pattern, CppAD::sparse_hes_work& work,
+        SparseVariableMatrix& hessian);
+
     std::optional<NumericConstraintValue> getMostDeviatingNumericConstraint(const VectorDouble& point);
     std::optional<NumericConstraintValue> getMostDeviatingNonlinearOrQuadraticConstraint(const VectorDouble& point);
     std::optional<NumericConstraintValue> getMostDeviatingNonlinearConstraint(const VectorDouble& point);
@@ -207,6 +281,12 @@ public:
     NumericConstraintValue getMaxNumericConstraintValue(const VectorDouble& point,
         const std::vector<NumericConstraint*>& constraintSelection, std::vector<NumericConstraint*>& activeConstraints);
 
+    // Returns the maximum constraint value among the selected constraints in each of the points
+    NumericConstraintValues getMaxNumericConstraintValues(
+        const PointBatch& points, const NonlinearConstraints constraintSelection);
+    NumericConstraintValues getMaxNumericConstraintValues(
+        const PointBatch& points, const std::vector<NumericConstraint*>& constraintSelection);
+
     template <typename T>
     NumericConstraintValues getAllDeviatingConstraints(
         const VectorDouble& point, double tolerance, std::vector<T> constraintSelection, double correction = 0.0);
@@ -214,6 +294,10 @@ public:
     NumericConstraintValues getFractionOfDeviatingNonlinearConstraints(
         const VectorDouble& point, double tolerance, double fraction, double correction = 0.0);
 
+    // As above, but each constraint is evaluated in all of the points at once
+    std::vector<NumericConstraintValues> getFractionOfDeviatingNonlinearConstraints(
+        const PointBatch& points, double tolerance, double fraction);
+
     virtual NumericConstraintValues getAllDeviatingNumericConstraints(const VectorDouble& point, double tolerance);
 
     virtual NumericConstraintValues getAllDeviatingLinearConstraints(const VectorDouble& point, double tolerance);
@@ -235,6 +319,13 @@ public:
 
     void saveProblemToFile(std::string filename);
 
+    VariableConstraintIncidence getVariableConstraintIncidence(const std::vector<NumericConstraintPtr>& constraints);
+
+    // Returns the indexes of the variables in the blocks of the constraints, i.e. the only variables the values of the
+    // constraints can depend on. Returns an empty vector if a constraint is not in a block or if the blocks contain
+    // more than half of the variables, since then all variables should be used.
+    VectorInteger getBlockVariables(const std::vector<NumericConstraint*>& constraints) const;
+
     void doFBBT();
     bool doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLimit);
 
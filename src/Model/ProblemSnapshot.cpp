@@ -0,0 +1,900 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "ProblemSnapshot.h"
+
+#include "../Output.h"
+#include "../Utilities.h"
+
+#include "Problem.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "spdlog/fmt/fmt.h"
+
+namespace SHOT
+{
+
+namespace
+{
+
+// The layout of a snapshot is
+//
+//   header:   magic, version, byte order mark, source format, reformulation settings, number of problems (1 or 2)
+//   problems: name, properties, variables, expression nodes, auxiliary variable definitions, objective, constraints
+//
+// Numbers are stored in the byte order of the platform that wrote the snapshot, and snapshots written on a platform
+// with another byte order, or with another version, are rejected. The version needs to be increased whenever the
+// layout is changed.
+constexpr char snapshotMagic[8] = { 'S', 'H', 'O', 'T', 'S', 'N', 'A', 'P' };
+constexpr uint32_t snapshotVersion = 1;
+constexpr uint32_t snapshotByteOrderMark = 0x01020304;
+
+enum class E_SnapshotFunctionType : int32_t
+{
+    Linear,
+    Quadratic,
+    Nonlinear
+};
+
+enum class E_SnapshotConstraintList : int32_t
+{
+    Linear,
+    Quadratic,
+    Nonlinear
+};
+
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(std::ostream& stream) : stream(stream) {}
+
+    template <typename T> void write(T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeString(const std::string& value)
+    {
+        write<uint64_t>(value.size());
+        stream.write(value.data(), value.size());
+    }
+
+private:
+    std::ostream& stream;
+};
+
+class SnapshotReader
+{
+public:
+    SnapshotReader(const char* begin, const char* end) : position(begin), end(end) {}
+
+    template <typename T> T read()
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+
+        T value;
+        std::memcpy(&value, advance(sizeof(T)), sizeof(T));
+        return (value);
+    }
+
+    std::string readString()
+    {
+        auto size = read<uint64_t>();
+        return (std::string(advance(size), size));
+    }
+
+    const char* advance(size_t size)
+    {
+        if((size_t)(end - position) < size)
+            throw std::runtime_error("The snapshot is truncated.");
+
+        auto current = position;
+        position += size;
+        return (current);
+    }
+
+private:
+    const char* position;
+    const char* end;
+};
+
+class ProblemSnapshotWriter
+{
+public:
+    ProblemSnapshotWriter(SnapshotWriter& writer, ProblemPtr problem) : writer(writer), problem(problem) {}
+
+    void write()
+    {
+        writer.writeString(problem->name);
+        writer.write(problem->properties.isReformulated);
+        writer.write<int32_t>(problem->properties.numberOfAddedLinearizations);
+
+        for(auto& V : problem->auxiliaryVariables)
+            auxiliaryVariables.emplace(V.get(), V.get());
+
+        if(problem->auxiliaryObjectiveVariable)
+        {
+            auxiliaryVariables.emplace(
+                problem->auxiliaryObjectiveVariable.get(), problem->auxiliaryObjectiveVariable.get());
+        }
+
+        writeVariables();
+
+        // The expression nodes are collected first, so that all references to them are to already written nodes
+        for(auto& V : problem->auxiliaryVariables)
+            addExpressionNodes(V->nonlinearExpression.get());
+
+        if(problem->auxiliaryObjectiveVariable)
+            addExpressionNodes(problem->auxiliaryObjectiveVariable->nonlinearExpression.get());
+
+        if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(problem->objectiveFunction))
+            addExpressionNodes(objective->nonlinearExpression.get());
+
+        for(auto& C : problem->numericConstraints)
+        {
+            if(auto constraint = std::dynamic_pointer_cast<NonlinearConstraint>(C))
+                addExpressionNodes(constraint->nonlinearExpression.get());
+        }
+
+        writeExpressionNodes();
+
+        for(auto& V : problem->allVariables)
+        {
+            if(auto auxiliaryVariable = auxiliaryVariables.find(V.get()); auxiliaryVariable != auxiliaryVariables.end())
+                writeAuxiliaryVariableDefinition(auxiliaryVariable->second);
+        }
+
+        writeObjectiveFunction();
+        writeConstraints();
+    }
+
+private:
+    SnapshotWriter& writer;
+    ProblemPtr problem;
+
+    // The auxiliary variables among all variables, which are not polymorphic
+    std::unordered_map<Variable*, AuxiliaryVariable*> auxiliaryVariables;
+
+    std::vector<NonlinearExpression*> expressionNodes;
+    std::unordered_map<NonlinearExpression*, int> expressionNodeIds;
+
+    void writeVariables()
+    {
+        // Integer variables with binary bounds are changed into binary variables when finalizing the problem, but
+        // are kept among the integer variables
+        std::unordered_set<Variable*> integerVariables;
+
+        for(auto& V : problem->integerVariables)
+            integerVariables.insert(V.get());
+
+        writer.write<int32_t>(problem->allVariables.size());
+
+        for(auto& V : problem->allVariables)
+        {
+            auto addedType = (integerVariables.count(V.get()) > 0) ? E_VariableType::Integer : V->properties.type;
+
+            writer.write(auxiliaryVariables.count(V.get()) > 0);
+            writer.writeString(V->name);
+            writer.write<int32_t>(V->index);
+            writer.write(V->properties.type);
+            writer.write(addedType);
+            writer.write(V->properties.auxiliaryType);
+            writer.write(V->lowerBound);
+            writer.write(V->upperBound);
+            writer.write(V->properties.hasLowerBoundBeenTightened);
+            writer.write(V->properties.hasUpperBoundBeenTightened);
+        }
+    }
+
+    void writeAuxiliaryVariableDefinition(AuxiliaryVariable* variable)
+    {
+        writer.write(variable->constant);
+        writeTerms(variable->linearTerms);
+        writeTerms(variable->quadraticTerms);
+        writeTerms(variable->monomialTerms);
+        writeTerms(variable->signomialTerms);
+        writeExpressionReference(variable->nonlinearExpression.get());
+    }
+
+    // Adds the expression and its children, the children before their parents, if they have not been added
+    void addExpressionNodes(NonlinearExpression* expression)
+    {
+        if(expression == nullptr || expressionNodeIds.count(expression) > 0)
+            return;
+
+        if(auto unary = dynamic_cast<ExpressionUnary*>(expression))
+        {
+            addExpressionNodes(unary->child.get());
+        }
+        else if(auto binary = dynamic_cast<ExpressionBinary*>(expression))
+        {
+            addExpressionNodes(binary->firstChild.get());
+            addExpressionNodes(binary->secondChild.get());
+        }
+        else if(auto general = dynamic_cast<ExpressionGeneral*>(expression))
+        {
+            for(auto& C : general->children)
+                addExpressionNodes(C.get());
+        }
+
+        expressionNodeIds.emplace(expression, expressionNodes.size());
+        expressionNodes.push_back(expression);
+    }
+
+    void writeExpressionNodes()
+    {
+        writer.write<int32_t>(expressionNodes.size());
+
+        for(auto E : expressionNodes)
+        {
+            writer.write(E->getType());
+
+            if(auto constant = dynamic_cast<ExpressionConstant*>(E))
+            {
+                writer.write(constant->constant);
+            }
+            else if(auto variable = dynamic_cast<ExpressionVariable*>(E))
+            {
+                writer.write<int32_t>(variable->variable->index);
+            }
+            else if(auto unary = dynamic_cast<ExpressionUnary*>(E))
+            {
+                writeExpressionReference(unary->child.get());
+            }
+            else if(auto binary = dynamic_cast<ExpressionBinary*>(E))
+            {
+                writeExpressionReference(binary->firstChild.get());
+                writeExpressionReference(binary->secondChild.get());
+            }
+            else if(auto general = dynamic_cast<ExpressionGeneral*>(E))
+            {
+                writer.write<int32_t>(general->children.size());
+
+                for(auto& C : general->children)
+                    writeExpressionReference(C.get());
+            }
+        }
+    }
+
+    void writeExpressionReference(NonlinearExpression* expression)
+    {
+        writer.write<int32_t>((expression == nullptr) ? -1 : expressionNodeIds.at(expression));
+    }
+
+    void writeTerms(const LinearTerms& terms)
+    {
+        writer.write<int32_t>(terms.size());
+
+        for(auto& T : terms)
+        {
+            writer.write(T->coefficient);
+            writer.write<int32_t>(T->variable->index);
+        }
+    }
+
+    void writeTerms(const QuadraticTerms& terms)
+    {
+        writer.write<int32_t>(terms.size());
+
+        for(auto& T : terms)
+        {
+            writer.write(T->coefficient);
+            writer.write<int32_t>(T->firstVariable->index);
+            writer.write<int32_t>(T->secondVariable->index);
+        }
+    }
+
+    void writeTerms(const MonomialTerms& terms)
+    {
+        writer.write<int32_t>(terms.size());
+
+        for(auto& T : terms)
+        {
+            writer.write(T->coefficient);
+            writer.write<int32_t>(T->variables.size());
+
+            for(auto& V : T->variables)
+                writer.write<int32_t>(V->index);
+        }
+    }
+
+    void writeTerms(const SignomialTerms& terms)
+    {
+        writer.write<int32_t>(terms.size());
+
+        for(auto& T : terms)
+        {
+            writer.write(T->coefficient);
+            writer.write<int32_t>(T->elements.size());
+
+            for(auto& E : T->elements)
+            {
+                writer.write<int32_t>(E->variable->index);
+                writer.write(E->power);
+            }
+        }
+    }
+
+    void writeObjectiveFunction()
+    {
+        auto linearObjective = std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction);
+        auto quadraticObjective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(problem->objectiveFunction);
+        auto nonlinearObjective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(problem->objectiveFunction);
+
+        if(nonlinearObjective)
+            writer.write(E_SnapshotFunctionType::Nonlinear);
+        else if(quadraticObjective)
+            writer.write(E_SnapshotFunctionType::Quadratic);
+        else
+            writer.write(E_SnapshotFunctionType::Linear);
+
+        writer.write(problem->objectiveFunction->direction);
+        writer.write(problem->objectiveFunction->properties.classification);
+        writer.write(problem->objectiveFunction->constant);
+
+        writeTerms(linearObjective->linearTerms);
+
+        if(quadraticObjective)
+            writeTerms(quadraticObjective->quadraticTerms);
+
+        if(nonlinearObjective)
+        {
+            writeTerms(nonlinearObjective->monomialTerms);
+            writeTerms(nonlinearObjective->signomialTerms);
+            writeExpressionReference(nonlinearObjective->nonlinearExpression.get());
+        }
+    }
+
+    void writeConstraints()
+    {
+        // The list a constraint is in is not always given by its type, e.g. quadratic constraints considered as
+        // nonlinear are nonlinear constraints with only quadratic terms
+        std::unordered_set<NumericConstraint*> linearConstraints;
+        std::unordered_set<NumericConstraint*> quadraticConstraints;
+
+        for(auto& C : problem->linearConstraints)
+            linearConstraints.insert(C.get());
+
+        for(auto& C : problem->quadraticConstraints)
+            quadraticConstraints.insert(C.get());
+
+        writer.write<int32_t>(problem->numericConstraints.size());
+
+        for(auto& C : problem->numericConstraints)
+        {
+            auto linearConstraint = std::dynamic_pointer_cast<LinearConstraint>(C);
+            auto quadraticConstraint = std::dynamic_pointer_cast<QuadraticConstraint>(C);
+            auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(C);
+
+            if(nonlinearConstraint)
+                writer.write(E_SnapshotFunctionType::Nonlinear);
+            else if(quadraticConstraint)
+                writer.write(E_SnapshotFunctionType::Quadratic);
+            else
+                writer.write(E_SnapshotFunctionType::Linear);
+
+            if(linearConstraints.count(C.get()) > 0)
+                writer.write(E_SnapshotConstraintList::Linear);
+            else if(quadraticConstraints.count(C.get()) > 0)
+                writer.write(E_SnapshotConstraintList::Quadratic);
+            else
+                writer.write(E_SnapshotConstraintList::Nonlinear);
+
+            writer.writeString(C->name);
+            writer.write(C->valueLHS);
+            writer.write(C->valueRHS);
+            writer.write(C->constant);
+
+            writeTerms(linearConstraint->linearTerms);
+
+            if(quadraticConstraint)
+                writeTerms(quadraticConstraint->quadraticTerms);
+
+            if(nonlinearConstraint)
+            {
+                writeTerms(nonlinearConstraint->monomialTerms);
+                writeTerms(nonlinearConstraint->signomialTerms);
+                writeExpressionReference(nonlinearConstraint->nonlinearExpression.get());
+            }
+        }
+    }
+};
+
+class ProblemSnapshotReader
+{
+public:
+    ProblemSnapshotReader(SnapshotReader& reader, EnvironmentPtr env) : reader(reader), env(env) {}
+
+    ProblemPtr read()
+    {
+        problem = std::make_shared<Problem>(env);
+
+        problem->name = reader.readString();
+        problem->properties.isReformulated = reader.read<bool>();
+        problem->properties.numberOfAddedLinearizations = reader.read<int32_t>();
+
+        auto auxiliaryVariables = readVariables();
+
+        readExpressionNodes();
+
+        for(auto& V : auxiliaryVariables)
+        {
+            V->constant = reader.read<double>();
+            V->linearTerms = readLinearTerms();
+            V->quadraticTerms = readQuadraticTerms();
+            V->monomialTerms = readMonomialTerms();
+            V->signomialTerms = readSignomialTerms();
+            V->nonlinearExpression = readExpressionReference();
+        }
+
+        auto objectiveClassification = readObjectiveFunction();
+        readConstraints();
+
+        problem->finalize();
+
+        // A quadratic objective function that the MIP solver cannot handle is considered as nonlinear in the
+        // reformulated problem, which needs to be set again since the classification is recalculated when finalizing
+        if(objectiveClassification == E_ObjectiveFunctionClassification::QuadraticConsideredAsNonlinear
+            && problem->objectiveFunction->properties.classification == E_ObjectiveFunctionClassification::Quadratic)
+        {
+            problem->objectiveFunction->properties.classification = objectiveClassification;
+            problem->properties.isMIQPProblem = false;
+            problem->properties.isMINLPProblem = true;
+        }
+
+        return (problem);
+    }
+
+private:
+    SnapshotReader& reader;
+    EnvironmentPtr env;
+    ProblemPtr problem;
+
+    std::vector<VariablePtr> variables;
+    std::vector<NonlinearExpressionPtr> expressionNodes;
+
+    std::vector<AuxiliaryVariablePtr> readVariables()
+    {
+        std::vector<AuxiliaryVariablePtr> auxiliaryVariables;
+
+        auto numberOfVariables = reader.read<int32_t>();
+
+        if(numberOfVariables < 0)
+            throw std::runtime_error("The snapshot contains an invalid number of variables.");
+
+        variables.resize(numberOfVariables);
+
+        for(int i = 0; i < numberOfVariables; i++)
+        {
+            auto isAuxiliary = reader.read<bool>();
+            auto name = reader.readString();
+            auto index = reader.read<int32_t>();
+            auto type = reader.read<E_VariableType>();
+            auto addedType = reader.read<E_VariableType>();
+            auto auxiliaryType = reader.read<E_AuxiliaryVariableType>();
+            auto lowerBound = reader.read<double>();
+            auto upperBound = reader.read<double>();
+
+            if(index < 0 || index >= numberOfVariables || variables[index])
+                throw std::runtime_error(fmt::format("The snapshot contains an invalid index for variable {}.", name));
+
+            VariablePtr variable;
+
+            if(isAuxiliary)
+            {
+                auto auxiliaryVariable
+                    = std::make_shared<AuxiliaryVariable>(name, index, addedType, lowerBound, upperBound);
+                auxiliaryVariable->properties.auxiliaryType = auxiliaryType;
+                auxiliaryVariables.push_back(auxiliaryVariable);
+                variable = auxiliaryVariable;
+            }
+            else
+            {
+                variable = std::make_shared<Variable>(name, index, addedType, lowerBound, upperBound);
+            }
+
+            variable->lowerBound = lowerBound;
+            variable->upperBound = upperBound;
+            variable->properties.hasLowerBoundBeenTightened = reader.read<bool>();
+            variable->properties.hasUpperBoundBeenTightened = reader.read<bool>();
+
+            variables[index] = variable;
+
+            if(isAuxiliary)
+                problem->add(auxiliaryVariables.back());
+            else
+                problem->add(variable);
+
+            variable->properties.type = type;
+        }
+
+        return (auxiliaryVariables);
+    }
+
+    VariablePtr readVariableReference()
+    {
+        auto index = reader.read<int32_t>();
+
+        if(index < 0 || index >= (int)variables.size())
+            throw std::runtime_error(fmt::format("The snapshot refers to the nonexisting variable {}.", index));
+
+        return (variables[index]);
+    }
+
+    NonlinearExpressionPtr readExpressionReference()
+    {
+        auto id = reader.read<int32_t>();
+
+        if(id == -1)
+            return (nullptr);
+
+        if(id < 0 || id >= (int)expressionNodes.size())
+            throw std::runtime_error(fmt::format("The snapshot refers to the nonexisting expression node {}.", id));
+
+        return (expressionNodes[id]);
+    }
+
+    void readExpressionNodes()
+    {
+        auto numberOfNodes = reader.read<int32_t>();
+
+        if(numberOfNodes < 0)
+            throw std::runtime_error("The snapshot contains an invalid number of expression nodes.");
+
+        expressionNodes.reserve(numberOfNodes);
+
+        for(int i = 0; i < numberOfNodes; i++)
+            expressionNodes.push_back(readExpressionNode());
+    }
+
+    // The children of a node have always been read before the node
+    NonlinearExpressionPtr readExpressionNode()
+    {
+        auto type = reader.read<E_NonlinearExpressionTypes>();
+
+        switch(type)
+        {
+        case(E_NonlinearExpressionTypes::Constant):
+            return (std::make_shared<ExpressionConstant>(reader.read<double>()));
+        case(E_NonlinearExpressionTypes::Variable):
+            return (std::make_shared<ExpressionVariable>(readVariableReference()));
+        case(E_NonlinearExpressionTypes::Negate):
+            return (std::make_shared<ExpressionNegate>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Invert):
+            return (std::make_shared<ExpressionInvert>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::SquareRoot):
+            return (std::make_shared<ExpressionSquareRoot>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Log):
+            return (std::make_shared<ExpressionLog>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Exp):
+            return (std::make_shared<ExpressionExp>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Square):
+            return (std::make_shared<ExpressionSquare>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Cos):
+            return (std::make_shared<ExpressionCos>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Sin):
+            return (std::make_shared<ExpressionSin>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Tan):
+            return (std::make_shared<ExpressionTan>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::ArcCos):
+            return (std::make_shared<ExpressionArcCos>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::ArcSin):
+            return (std::make_shared<ExpressionArcSin>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::ArcTan):
+            return (std::make_shared<ExpressionArcTan>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Abs):
+            return (std::make_shared<ExpressionAbs>(readExpressionReference()));
+        case(E_NonlinearExpressionTypes::Divide):
+        {
+            auto firstChild = readExpressionReference();
+            return (std::make_shared<ExpressionDivide>(firstChild, readExpressionReference()));
+        }
+        case(E_NonlinearExpressionTypes::Power):
+        {
+            auto firstChild = readExpressionReference();
+            return (std::make_shared<ExpressionPower>(firstChild, readExpressionReference()));
+        }
+        case(E_NonlinearExpressionTypes::Sum):
+            return (std::make_shared<ExpressionSum>(readExpressionReferences()));
+        case(E_NonlinearExpressionTypes::Product):
+            return (std::make_shared<ExpressionProduct>(readExpressionReferences()));
+        default:
+            throw std::runtime_error(
+                fmt::format("The snapshot contains an expression node of unknown type {}.", static_cast<int>(type)));
+        }
+    }
+
+    NonlinearExpressions readExpressionReferences()
+    {
+        NonlinearExpressions expressions;
+        auto numberOfExpressions = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfExpressions; i++)
+            expressions.add(readExpressionReference());
+
+        return (expressions);
+    }
+
+    LinearTerms readLinearTerms()
+    {
+        LinearTerms terms;
+        auto numberOfTerms = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfTerms; i++)
+        {
+            auto coefficient = reader.read<double>();
+            terms.add(std::make_shared<LinearTerm>(coefficient, readVariableReference()));
+        }
+
+        return (terms);
+    }
+
+    QuadraticTerms readQuadraticTerms()
+    {
+        QuadraticTerms terms;
+        auto numberOfTerms = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfTerms; i++)
+        {
+            auto coefficient = reader.read<double>();
+            auto firstVariable = readVariableReference();
+            terms.add(std::make_shared<QuadraticTerm>(coefficient, firstVariable, readVariableReference()));
+        }
+
+        return (terms);
+    }
+
+    MonomialTerms readMonomialTerms()
+    {
+        MonomialTerms terms;
+        auto numberOfTerms = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfTerms; i++)
+        {
+            auto coefficient = reader.read<double>();
+            auto numberOfVariables = reader.read<int32_t>();
+            Variables termVariables;
+
+            for(int j = 0; j < numberOfVariables; j++)
+                termVariables.push_back(readVariableReference());
+
+            terms.add(std::make_shared<MonomialTerm>(coefficient, termVariables));
+        }
+
+        return (terms);
+    }
+
+    SignomialTerms readSignomialTerms()
+    {
+        SignomialTerms terms;
+        auto numberOfTerms = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfTerms; i++)
+        {
+            auto coefficient = reader.read<double>();
+            auto numberOfElements = reader.read<int32_t>();
+            SignomialElements elements;
+
+            for(int j = 0; j < numberOfElements; j++)
+            {
+                auto variable = readVariableReference();
+                elements.push_back(std::make_shared<SignomialElement>(variable, reader.read<double>()));
+            }
+
+            terms.add(std::make_shared<SignomialTerm>(coefficient, elements));
+        }
+
+        return (terms);
+    }
+
+    // The terms are only added to the function if there are any, since adding also updates the function properties
+    template <typename T> void addLinearTerms(T& function)
+    {
+        if(auto terms = readLinearTerms(); terms.size() > 0)
+            function->add(terms);
+    }
+
+    template <typename T> void addQuadraticTerms(T& function)
+    {
+        if(auto terms = readQuadraticTerms(); terms.size() > 0)
+            function->add(terms);
+    }
+
+    template <typename T> void addNonlinearTerms(T& function)
+    {
+        if(auto terms = readMonomialTerms(); terms.size() > 0)
+            function->add(terms);
+
+        if(auto terms = readSignomialTerms(); terms.size() > 0)
+            function->add(terms);
+
+        if(auto expression = readExpressionReference())
+            function->add(expression);
+    }
+
+    E_ObjectiveFunctionClassification readObjectiveFunction()
+    {
+        auto type = reader.read<E_SnapshotFunctionType>();
+        auto direction = reader.read<E_ObjectiveFunctionDirection>();
+        auto classification = reader.read<E_ObjectiveFunctionClassification>();
+        auto constant = reader.read<double>();
+
+        ObjectiveFunctionPtr objective;
+
+        if(type == E_SnapshotFunctionType::Nonlinear)
+        {
+            auto nonlinearObjective = std::make_shared<NonlinearObjectiveFunction>();
+            addLinearTerms(nonlinearObjective);
+            addQuadraticTerms(nonlinearObjective);
+            addNonlinearTerms(nonlinearObjective);
+            objective = nonlinearObjective;
+        }
+        else if(type == E_SnapshotFunctionType::Quadratic)
+        {
+            auto quadraticObjective = std::make_shared<QuadraticObjectiveFunction>();
+            addLinearTerms(quadraticObjective);
+            addQuadraticTerms(quadraticObjective);
+            objective = quadraticObjective;
+        }
+        else
+        {
+            auto linearObjective = std::make_shared<LinearObjectiveFunction>();
+            addLinearTerms(linearObjective);
+            objective = linearObjective;
+        }
+
+        objective->direction = direction;
+        objective->constant = constant;
+
+        problem->add(std::move(objective));
+
+        return (classification);
+    }
+
+    void readConstraints()
+    {
+        auto numberOfConstraints = reader.read<int32_t>();
+
+        for(int i = 0; i < numberOfConstraints; i++)
+        {
+            auto type = reader.read<E_SnapshotFunctionType>();
+            auto list = reader.read<E_SnapshotConstraintList>();
+            auto name = reader.readString();
+            auto valueLHS = reader.read<double>();
+            auto valueRHS = reader.read<double>();
+
+            LinearConstraintPtr constraint;
+
+            if(type == E_SnapshotFunctionType::Nonlinear)
+            {
+                auto nonlinearConstraint = std::make_shared<NonlinearConstraint>(i, name, valueLHS, valueRHS);
+                nonlinearConstraint->constant = reader.read<double>();
+                addLinearTerms(nonlinearConstraint);
+                addQuadraticTerms(nonlinearConstraint);
+                addNonlinearTerms(nonlinearConstraint);
+                constraint = nonlinearConstraint;
+            }
+            else if(type == E_SnapshotFunctionType::Quadratic)
+            {
+                auto quadraticConstraint = std::make_shared<QuadraticConstraint>(i, name, valueLHS, valueRHS);
+                quadraticConstraint->constant = reader.read<double>();
+                addLinearTerms(quadraticConstraint);
+                addQuadraticTerms(quadraticConstraint);
+                constraint = quadraticConstraint;
+            }
+            else
+            {
+                constraint = std::make_shared<LinearConstraint>(i, name, valueLHS, valueRHS);
+                constraint->constant = reader.read<double>();
+                addLinearTerms(constraint);
+            }
+
+            if(list == E_SnapshotConstraintList::Linear)
+            {
+                problem->add(constraint);
+            }
+            else if(list == E_SnapshotConstraintList::Quadratic)
+            {
+                auto quadraticConstraint = std::dynamic_pointer_cast<QuadraticConstraint>(constraint);
+
+                if(!quadraticConstraint)
+                    throw std::runtime_error(fmt::format("The snapshot contains an invalid constraint {}.", name));
+
+                problem->add(quadraticConstraint);
+            }
+            else
+            {
+                auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(constraint);
+
+                if(!nonlinearConstraint)
+                    throw std::runtime_error(fmt::format("The snapshot contains an invalid constraint {}.", name));
+
+                problem->add(nonlinearConstraint);
+            }
+        }
+    }
+};
+
+} // namespace
+
+void writeProblemSnapshot(const ProblemSnapshot& snapshot, const std::string& fileName)
+{
+    std::ofstream stream(fileName, std::ios::binary | std::ios::trunc);
+
+    if(!stream)
+        throw std::runtime_error(fmt::format("Could not open snapshot file {} for writing.", fileName));
+
+    SnapshotWriter writer(stream);
+
+    stream.write(snapshotMagic, sizeof(snapshotMagic));
+    writer.write(snapshotVersion);
+    writer.write(snapshotByteOrderMark);
+    writer.write(snapshot.sourceFormat);
+    writer.writeString(snapshot.reformulationSettings);
+    writer.write<int32_t>(snapshot.reformulatedProblem ? 2 : 1);
+
+    ProblemSnapshotWriter(writer, snapshot.problem).write();
+
+    if(snapshot.reformulatedProblem)
+        ProblemSnapshotWriter(writer, snapshot.reformulatedProblem).write();
+
+    if(!stream.flush())
+        throw std::runtime_error(fmt::format("Could not write snapshot file {}.", fileName));
+}
+
+ProblemSnapshot readProblemSnapshot(EnvironmentPtr env, const std::string& fileName)
+{
+    Utilities::MappedFile file;
+
+    if(!file.open(fileName))
+        throw std::runtime_error(fmt::format("Could not open snapshot file {}.", fileName));
+
+    SnapshotReader reader(file.begin(), file.end());
+
+    if(std::memcmp(reader.advance(sizeof(snapshotMagic)), snapshotMagic, sizeof(snapshotMagic)) != 0)
+        throw std::runtime_error(fmt::format("The file {} is not a problem snapshot.", fileName));
+
+    if(auto version = reader.read<uint32_t>(); version != snapshotVersion)
+    {
+        throw std::runtime_error(fmt::format(
+            "The snapshot {} has version {}, but only version {} is supported.", fileName, version, snapshotVersion));
+    }
+
+    if(reader.read<uint32_t>() != snapshotByteOrderMark)
+    {
+        throw std::runtime_error(
+            fmt::format("The snapshot {} was written on a platform with another byte order.", fileName));
+    }
+
+    ProblemSnapshot snapshot;
+
+    snapshot.sourceFormat = reader.read<ES_SourceFormat>();
+    snapshot.reformulationSettings = reader.readString();
+
+    auto numberOfProblems = reader.read<int32_t>();
+
+    snapshot.problem = ProblemSnapshotReader(reader, env).read();
+
+    if(numberOfProblems > 1)
+        snapshot.reformulatedProblem = ProblemSnapshotReader(reader, env).read();
+
+    env->output->outputDebug(fmt::format(" Problem read from snapshot {}.", fileName));
+
+    return (snapshot);
+}
+
+} // namespace SHOT
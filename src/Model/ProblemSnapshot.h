@@ -0,0 +1,42 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Environment.h"
+#include "../Enums.h"
+#include "../Structs.h"
+
+#include <string>
+
+namespace SHOT
+{
+
+// The contents of a binary problem snapshot. The snapshot contains the finalized original problem and, if available,
+// the reformulated problem, together with the settings the reformulation was made with.
+struct ProblemSnapshot
+{
+    ES_SourceFormat sourceFormat = ES_SourceFormat::None;
+    std::string reformulationSettings;
+
+    ProblemPtr problem;
+    ProblemPtr reformulatedProblem;
+};
+
+// Writes the problems in the snapshot to a binary file. Only the structure of the problems is written, e.g. variables,
+// terms and nonlinear expressions, while the data derived from it, such as properties, convexity, sparsity patterns
+// and CppAD tapes, is recalculated when the snapshot is read. Throws std::runtime_error if the file cannot be written.
+void writeProblemSnapshot(const ProblemSnapshot& snapshot, const std::string& fileName);
+
+// Reads a snapshot written with writeProblemSnapshot and finalizes the problems in the given environment. Throws
+// std::runtime_error if the file cannot be read, or if it is not a snapshot of a compatible version.
+ProblemSnapshot readProblemSnapshot(EnvironmentPtr env, const std::string& fileName);
+
+} // namespace SHOT
@@ -13,9 +13,14 @@
 #include "../Settings.h"
 
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 #include <Eigen/Eigenvalues>
 #include "Eigen/src/SparseCore/SparseUtil.h"
 
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
 namespace SHOT
 {
 Interval Term::getBounds()
@@ -32,8 +37,147 @@ Interval Term::getBounds()
     return (interval);
 }
 
+namespace
+{
+// Blocks with at most this many variables are checked with a dense eigenvalue decomposition
+const int maxBlockSizeForEigenvalues = 50;
+
+// Larger blocks for which the factorization is ill-conditioned are also checked with a dense eigenvalue decomposition,
+// if they have at most this many variables
+const int maxBlockSizeForEigenvalueFallback = 1000;
+
+// Only blocks with more variables than this are cached, since smaller ones are faster to check than to look up
+const int minBlockSizeForCache = 10;
+
+// A factorization is considered ill-conditioned if the ratio between its smallest and largest pivots is smaller
+const double pivotRatioTolerance = 1e-10;
+
+// Eigenvalues that are smaller in magnitude than this times the largest one are rounding errors of zero eigenvalues
+const double zeroEigenvalueRatioTolerance = 1e-10;
+
+enum class E_Definiteness
+{
+    Definite,
+    NotDefinite,
+    IllConditioned
+};
+
+// Checks the convexity of a block from the eigenvalues of its matrix, of which only the lower triangular part is used
+QuadraticBlockConvexity getBlockConvexityFromEigenvalues(const Eigen::SparseMatrix<double>& matrix, double tolerance)
+{
+    QuadraticBlockConvexity result;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(
+        Eigen::MatrixXd(matrix), Eigen::DecompositionOptions::EigenvaluesOnly);
+
+    if(eigenSolver.info() != Eigen::Success)
+    {
+        result.isDetermined = false;
+        return (result);
+    }
+
+    // The eigenvalues are sorted in increasing order
+    result.minEigenValue = eigenSolver.eigenvalues()(0);
+
+    double maxAbsEigenValue = eigenSolver.eigenvalues().cwiseAbs().maxCoeff();
+
+    if(result.minEigenValue < 0.0 && result.minEigenValue >= -zeroEigenvalueRatioTolerance * maxAbsEigenValue)
+        result.minEigenValue = 0.0;
+
+    result.isConvex = result.minEigenValue >= -tolerance;
+    result.isConcave = eigenSolver.eigenvalues()(matrix.rows() - 1) <= tolerance;
+
+    return (result);
+}
+
+// Checks if scale * matrix + shift * I is positive definite with a sparse LDL^T factorization of the lower triangular
+// part of the matrix
+E_Definiteness getDefiniteness(const Eigen::SparseMatrix<double>& matrix, double scale, double shift)
+{
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> factorization;
+    factorization.setShift(shift, scale);
+    factorization.compute(matrix);
+
+    // A zero pivot, which means that the matrix is singular or close to singular
+    if(factorization.info() != Eigen::Success)
+        return (E_Definiteness::IllConditioned);
+
+    auto pivots = factorization.vectorD();
+
+    double minPivot = pivots.minCoeff();
+    double maxPivot = pivots.cwiseAbs().maxCoeff();
+
+    if(minPivot > pivotRatioTolerance * maxPivot)
+        return (E_Definiteness::Definite);
+
+    if(minPivot < -pivotRatioTolerance * maxPivot)
+        return (E_Definiteness::NotDefinite);
+
+    return (E_Definiteness::IllConditioned);
+}
+
+// Checks the convexity of a block, i.e. if the matrix is positive or negative semidefinite within the tolerance
+QuadraticBlockConvexity getBlockConvexity(const Eigen::SparseMatrix<double>& matrix, double tolerance)
+{
+    int size = matrix.rows();
+
+    if(size == 1)
+    {
+        QuadraticBlockConvexity result;
+        double value = matrix.coeff(0, 0);
+
+        result.minEigenValue = value;
+        result.isConvex = value >= -tolerance;
+        result.isConcave = value <= tolerance;
+
+        return (result);
+    }
+
+    if(size <= maxBlockSizeForEigenvalues)
+        return (getBlockConvexityFromEigenvalues(matrix, tolerance));
+
+    // The matrix is positive semidefinite within the tolerance if the shifted matrix is positive definite. Since the
+    // block is connected, it cannot be both convex and concave unless the terms are within the tolerance from zero.
+    QuadraticBlockConvexity result;
+
+    auto convexity = getDefiniteness(matrix, 1.0, tolerance);
+
+    if(convexity == E_Definiteness::Definite)
+    {
+        result.isConvex = true;
+        // Singular matrices give ill-conditioned factorizations and are semidefinite without the tolerance
+        result.minEigenValue = (getDefiniteness(matrix, 1.0, 0.0) != E_Definiteness::NotDefinite) ? 0.0 : -tolerance;
+        return (result);
+    }
+
+    auto concavity = getDefiniteness(matrix, -1.0, tolerance);
+
+    if(concavity == E_Definiteness::Definite)
+    {
+        result.isConcave = true;
+        result.minEigenValue = -SHOT_DBL_MAX;
+        return (result);
+    }
+
+    if(convexity == E_Definiteness::NotDefinite && concavity == E_Definiteness::NotDefinite)
+    {
+        result.minEigenValue = -SHOT_DBL_MAX;
+        return (result);
+    }
+
+    if(size <= maxBlockSizeForEigenvalueFallback)
+        return (getBlockConvexityFromEigenvalues(matrix, tolerance));
+
+    result.isDetermined = false;
+    return (result);
+}
+} // namespace
+
 void QuadraticTerms::updateConvexity()
 {
+    minEigenValue = SHOT_DBL_MAX;
+    minEigenValueWithinTolerance = false;
+
     if(size() == 0)
     {
         convexity = E_Convexity::Linear;
@@ -41,34 +185,33 @@ void QuadraticTerms::updateConvexity()
     }
 
     std::vector<Eigen::Triplet<double>> elements;
-    elements.reserve(2 * size());
+    elements.reserve(size());
+
+    std::unordered_map<Variable*, int> variableMap;
+    variableMap.reserve(2 * size());
+
+    std::vector<Variable*> variables;
 
-    std::map<VariablePtr, int> variableMap;
+    auto getVariableIndex = [&](Variable* variable) {
+        auto element = variableMap.emplace(variable, variables.size());
+
+        // Variable not already indexed found, but inserted into map
+        if(element.second)
+            variables.push_back(variable);
+
+        return (element.first->second);
+    };
 
     bool allSquares = true;
     bool allPositive = true;
     bool allNegative = true;
     bool allBilinear = true;
 
-    int variableCounter = 0;
-
     for(auto& T : (*this))
     {
         if(T->firstVariable == T->secondVariable)
         {
-            int currentVariableIndex;
-            auto element = variableMap.emplace(T->firstVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found
-                currentVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentVariableIndex = element.first->second;
-            }
+            int currentVariableIndex = getVariableIndex(T->firstVariable.get());
 
             allPositive = allPositive && T->coefficient >= 0;
             allNegative = allNegative && T->coefficient <= 0;
@@ -78,45 +221,12 @@ void QuadraticTerms::updateConvexity()
         }
         else
         {
-            int currentFirstVariableIndex;
-            auto element = variableMap.emplace(T->firstVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found, but inserted into map
-                currentFirstVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentFirstVariableIndex = element.first->second;
-            }
-
-            int currentSecondVariableIndex;
-            element = variableMap.emplace(T->secondVariable, variableCounter);
-
-            if(element.second)
-            {
-                // Variable not already indexed found, but inserted into map
-                currentSecondVariableIndex = variableCounter;
-                variableCounter++;
-            }
-            else
-            {
-                currentSecondVariableIndex = element.first->second;
-            }
+            int currentFirstVariableIndex = getVariableIndex(T->firstVariable.get());
+            int currentSecondVariableIndex = getVariableIndex(T->secondVariable.get());
 
             allSquares = false;
 
-            // Matrix is self adjoint, so only need lower triangular elements
-            if(T->firstVariable->index > T->secondVariable->index)
-            {
-                elements.emplace_back(currentFirstVariableIndex, currentSecondVariableIndex, 0.5 * T->coefficient);
-            }
-            else
-            {
-                elements.emplace_back(currentSecondVariableIndex, currentFirstVariableIndex, 0.5 * T->coefficient);
-            }
+            elements.emplace_back(currentFirstVariableIndex, currentSecondVariableIndex, 0.5 * T->coefficient);
         }
     }
 
@@ -138,26 +248,10 @@ void QuadraticTerms::updateConvexity()
         return;
     }
 
-    int numberOfVariables = variableMap.size();
-
-    Eigen::SparseMatrix<double> matrix(numberOfVariables, numberOfVariables);
-    matrix.setFromTriplets(elements.begin(), elements.end());
-
-    Eigen::SelfAdjointEigenSolver<Eigen::SparseMatrix<double>> eigenSolver(
-        matrix, Eigen::DecompositionOptions::EigenvaluesOnly);
-
-    if(eigenSolver.info() != Eigen::Success)
-    {
-        convexity = E_Convexity::Unknown;
-        return;
-    }
-
-    bool areAllPositiveOrZero = true;
-    bool areAllNegativeOrZero = true;
-
     double eigenvalueTolerance = 0.0;
+    auto sharedOwnerProblem = ownerProblem.lock();
 
-    if(auto sharedOwnerProblem = ownerProblem.lock())
+    if(sharedOwnerProblem)
     {
         if(sharedOwnerProblem->env->settings)
         {
@@ -170,19 +264,127 @@ void QuadraticTerms::updateConvexity()
         }
     }
 
-    for(int i = 0; i < numberOfVariables; i++)
+    // The matrix is block diagonal with one block for each connected component of the graph where the variables are
+    // nodes and the bilinear terms are edges, and it is semidefinite if and only if all blocks are
+    int numberOfVariables = variables.size();
+    std::vector<int> componentRoots(numberOfVariables);
+    std::iota(componentRoots.begin(), componentRoots.end(), 0);
+
+    auto findRoot = [&](int variable) {
+        while(componentRoots[variable] != variable)
+        {
+            componentRoots[variable] = componentRoots[componentRoots[variable]];
+            variable = componentRoots[variable];
+        }
+
+        return (variable);
+    };
+
+    for(auto& E : elements)
+    {
+        if(E.row() != E.col() && E.value() != 0.0)
+            componentRoots[findRoot(E.row())] = findRoot(E.col());
+    }
+
+    // The variables in each block are ordered by their index in the problem, so that blocks with the same structure
+    // have identical matrices
+    std::vector<int> variableOrder(numberOfVariables);
+    std::iota(variableOrder.begin(), variableOrder.end(), 0);
+    std::sort(variableOrder.begin(), variableOrder.end(),
+        [&](int first, int second) { return (variables[first]->index < variables[second]->index); });
+
+    std::vector<int> blockIndexes(numberOfVariables, -1);
+    std::vector<int> positionsInBlock(numberOfVariables);
+    std::vector<int> blockSizes;
+
+    for(int V : variableOrder)
     {
-        double eigenvalue = eigenSolver.eigenvalues().col(0)[i];
+        int root = findRoot(V);
+
+        if(blockIndexes[root] == -1)
+        {
+            blockIndexes[root] = blockSizes.size();
+            blockSizes.push_back(0);
+        }
+
+        positionsInBlock[V] = blockSizes[blockIndexes[root]]++;
+    }
+
+    std::vector<std::vector<Eigen::Triplet<double>>> blockElements(blockSizes.size());
+
+    for(auto& E : elements)
+    {
+        // The variables in bilinear terms with zero coefficients can be in different blocks
+        if(E.row() != E.col() && E.value() == 0.0)
+            continue;
+
+        int firstPosition = positionsInBlock[E.row()];
+        int secondPosition = positionsInBlock[E.col()];
+
+        // Matrix is self adjoint, so only need lower triangular elements
+        blockElements[blockIndexes[findRoot(E.row())]].emplace_back(
+            std::max(firstPosition, secondPosition), std::min(firstPosition, secondPosition), E.value());
+    }
+
+    bool areAllConvex = true;
+    bool areAllConcave = true;
+
+    for(size_t i = 0; i < blockSizes.size(); i++)
+    {
+        Eigen::SparseMatrix<double> matrix(blockSizes[i], blockSizes[i]);
+        matrix.setFromTriplets(blockElements[i].begin(), blockElements[i].end());
+
+        QuadraticBlockConvexity blockConvexity;
+
+        if(sharedOwnerProblem && blockSizes[i] > minBlockSizeForCache)
+        {
+            std::vector<double> key;
+            key.reserve(3 * matrix.nonZeros() + 2);
+            key.push_back(eigenvalueTolerance);
+            key.push_back(blockSizes[i]);
+
+            for(int k = 0; k < matrix.outerSize(); k++)
+            {
+                for(Eigen::SparseMatrix<double>::InnerIterator it(matrix, k); it; ++it)
+                {
+                    key.push_back(it.row());
+                    key.push_back(it.col());
+                    key.push_back(it.value());
+                }
+            }
+
+            auto cachedConvexity = sharedOwnerProblem->quadraticConvexityCache.find(key);
+
+            if(cachedConvexity != sharedOwnerProblem->quadraticConvexityCache.end())
+            {
+                blockConvexity = cachedConvexity->second;
+            }
+            else
+            {
+                blockConvexity = getBlockConvexity(matrix, eigenvalueTolerance);
+                sharedOwnerProblem->quadraticConvexityCache.emplace(std::move(key), blockConvexity);
+            }
+        }
+        else
+        {
+            blockConvexity = getBlockConvexity(matrix, eigenvalueTolerance);
+        }
+
+        if(!blockConvexity.isDetermined)
+        {
+            convexity = E_Convexity::Unknown;
+            return;
+        }
 
-        this->minEigenValue = std::min(minEigenValue, eigenvalue);
+        this->minEigenValue = std::min(minEigenValue, blockConvexity.minEigenValue);
 
-        areAllNegativeOrZero = areAllNegativeOrZero && eigenvalue <= eigenvalueTolerance;
-        areAllPositiveOrZero = areAllPositiveOrZero && eigenvalue >= -eigenvalueTolerance;
+        areAllConvex = areAllConvex && blockConvexity.isConvex;
+        areAllConcave = areAllConcave && blockConvexity.isConcave;
     }
 
-    if(areAllPositiveOrZero)
+    if(areAllConvex)
         convexity = E_Convexity::Convex;
-    else if(areAllNegativeOrZero)
+    else if(areAllConcave)
         convexity = E_Convexity::Concave;
     else
         convexity = E_Convexity::Nonconvex;
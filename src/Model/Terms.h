@@ -18,6 +18,7 @@
 
 #include "ffunc.hpp"
 
+#include <map>
 #include <vector>
 
 namespace SHOT
@@ -39,6 +40,9 @@ public:
 
     virtual Interval calculate(const IntervalVector& intervalVector) const = 0;
 
+    // Adds the value of the term in each of the points to the corresponding element in values
+    virtual void calculate(const PointBatch& points, double* values) const = 0;
+
     virtual Interval getBounds();
 
     void inline takeOwnership(ProblemPtr owner) { ownerProblem = owner; }
@@ -74,6 +78,14 @@ public:
         return value;
     }
 
+    inline void calculate(const PointBatch& points, double* values) const override
+    {
+        const double* variableValues = points.getVariableValues(variable->index);
+
+        for(int k = 0; k < points.getNumberOfPoints(); k++)
+            values[k] += coefficient * variableValues[k];
+    }
+
     E_Convexity getConvexity() const override { return E_Convexity::Linear; };
 
     E_Monotonicity getMonotonicity() const override
@@ -176,6 +188,15 @@ public:
         return value;
     }
 
+    // Adds the value of the terms in each of the points to the corresponding element in values
+    void calculate(const PointBatch& points, double* values) const
+    {
+        for(auto& TERM : *this)
+        {
+            TERM->calculate(points, values);
+        }
+    }
+
     Interval getBounds() const
     {
         Interval bounds(0.0, 0.0);
@@ -265,24 +286,16 @@ public:
         }
     }
 
-    SparseVariableVector calculateGradient([[maybe_unused]] const VectorDouble& point) const
+    // Adds the gradient elements to the provided storage, which needs to be sorted and combined afterwards
+    void calculateGradient([[maybe_unused]] const VectorDouble& point, SparseVariableVector& gradient) const
     {
-        SparseVariableVector gradient;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0.0)
                 continue;
 
-            auto element = gradient.emplace(T->variable, T->coefficient);
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += T->coefficient;
-            }
+            gradient.add(T->variable->index, T->coefficient);
         }
-
-        return gradient;
     };
 };
 
@@ -339,6 +352,15 @@ public:
         return value;
     }
 
+    inline void calculate(const PointBatch& points, double* values) const override
+    {
+        const double* firstVariableValues = points.getVariableValues(firstVariable->index);
+        const double* secondVariableValues = points.getVariableValues(secondVariable->index);
+
+        for(int k = 0; k < points.getNumberOfPoints(); k++)
+            values[k] += coefficient * firstVariableValues[k] * secondVariableValues[k];
+    }
+
     E_Convexity getConvexity() const override
     {
         if(firstVariable == secondVariable)
@@ -408,12 +430,29 @@ inline std::ostream& operator<<(std::ostream& stream, QuadraticTermPtr term)
     return stream;
 }
 
+// The convexity of a connected block of quadratic terms, i.e. of a diagonal block of the symmetric matrix of the terms
+struct QuadraticBlockConvexity
+{
+    bool isDetermined = true;
+    bool isConvex = false;
+    bool isConcave = false;
+
+    // The smallest eigenvalue, or a lower bound for it if the block was checked with a factorization
+    double minEigenValue = SHOT::SHOT_DBL_MAX;
+};
+
+// The convexity of blocks of quadratic terms, with the tolerance and the nonzeros of the lower triangular part of the
+// block as key, so that blocks with identical structure in different constraints are only checked once
+using QuadraticConvexityCache = std::map<std::vector<double>, QuadraticBlockConvexity>;
+
 class QuadraticTerms : public Terms<QuadraticTermPtr>
 {
 private:
     void updateConvexity() override;
 
 public:
+    // The smallest eigenvalue of the symmetric matrix of the terms. For large blocks, for which the convexity is checked
+    // with a factorization, only a lower bound for the eigenvalue is known.
     double minEigenValue = SHOT::SHOT_DBL_MAX;
     bool minEigenValueWithinTolerance = false;
 
@@ -452,50 +491,48 @@ public:
         }
     }
 
-    SparseVariableVector calculateGradient(const VectorDouble& point) const
+    // Adds the gradient elements to the provided storage, which needs to be sorted and combined afterwards
+    void calculateGradient(const VectorDouble& point, SparseVariableVector& gradient) const
     {
-        SparseVariableVector gradient;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0.0)
                 continue;
 
-            if(T->firstVariable == T->secondVariable) // variable squared
-            {
-                auto value = 2 * T->coefficient * point[T->firstVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
+            int firstIndex = T->firstVariable->index;
+            int secondIndex = T->secondVariable->index;
 
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+            if(firstIndex == secondIndex) // variable squared
+            {
+                gradient.add(firstIndex, 2 * T->coefficient * point[firstIndex]);
             }
             else
             {
-                auto value = T->coefficient * point[T->secondVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(firstIndex, T->coefficient * point[secondIndex]);
+                gradient.add(secondIndex, T->coefficient * point[firstIndex]);
+            }
+        }
+    };
 
-                value = T->coefficient * point[T->firstVariable->index];
+    // Adds the upper triangular Hessian elements to the provided storage, which needs to be sorted and combined
+    // afterwards
+    void calculateHessian([[maybe_unused]] const VectorDouble& point, SparseVariableMatrix& hessian) const
+    {
+        for(auto& T : (*this))
+        {
+            if(T->coefficient == 0.0)
+                continue;
 
-                element = gradient.emplace(T->secondVariable, value);
+            int firstIndex = T->firstVariable->index;
+            int secondIndex = T->secondVariable->index;
 
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-            }
+            if(firstIndex == secondIndex) // variable squared
+                hessian.add(firstIndex, secondIndex, 2 * T->coefficient);
+            else if(firstIndex < secondIndex)
+                hessian.add(firstIndex, secondIndex, T->coefficient);
+            else
+                hessian.add(secondIndex, firstIndex, T->coefficient);
         }
-
-        return gradient;
     };
 };
 
@@ -561,6 +598,26 @@ public:
         return value;
     }
 
+    inline void calculate(const PointBatch& points, double* values) const override
+    {
+        int numberOfPoints = points.getNumberOfPoints();
+
+        // Each thread has its own storage for the products
+        thread_local VectorDouble termValues;
+        termValues.assign(numberOfPoints, coefficient);
+
+        for(auto& V : variables)
+        {
+            const double* variableValues = points.getVariableValues(V->index);
+
+            for(int k = 0; k < numberOfPoints; k++)
+                termValues[k] *= variableValues[k];
+        }
+
+        for(int k = 0; k < numberOfPoints; k++)
+            values[k] += termValues[k];
+    }
+
     inline E_Convexity getConvexity() const override { return E_Convexity::Nonconvex; };
 
     inline E_Monotonicity getMonotonicity() const override { return E_Monotonicity::Unknown; };
@@ -648,10 +705,9 @@ public:
         }
     }
 
-    SparseVariableVector calculateGradient(const VectorDouble& point) const
+    // Adds the gradient elements to the provided storage, which needs to be sorted and combined afterwards
+    void calculateGradient(const VectorDouble& point, SparseVariableVector& gradient) const
     {
-        SparseVariableVector gradient;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0.0)
@@ -659,7 +715,7 @@ public:
 
             for(auto& V1 : T->variables)
             {
-                double value = 1.0;
+                double value = T->coefficient;
 
                 for(auto& V2 : T->variables)
                 {
@@ -669,17 +725,15 @@ public:
                     value *= V2->calculate(point);
                 }
 
-                gradient.emplace(V1, value);
+                gradient.add(V1->index, value);
             }
         };
-
-        return gradient;
     };
 
-    SparseVariableMatrix calculateHessian(const VectorDouble& point) const
+    // Adds the upper triangular Hessian elements to the provided storage, which needs to be sorted and combined
+    // afterwards
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const
     {
-        SparseVariableMatrix hessian;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0)
@@ -702,20 +756,10 @@ public:
                         value *= V3->calculate(point);
                     }
 
-                    std::pair<VariablePtr, VariablePtr> variablePair = std::make_pair(V1, V2);
-
-                    auto element = hessian.emplace(variablePair, value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += value;
-                    }
+                    hessian.add(V1->index, V2->index, value);
                 }
             }
         }
-
-        return hessian;
     };
 };
 
@@ -914,6 +958,26 @@ public:
         return value;
     }
 
+    inline void calculate(const PointBatch& points, double* values) const override
+    {
+        int numberOfPoints = points.getNumberOfPoints();
+
+        // Each thread has its own storage for the products
+        thread_local VectorDouble termValues;
+        termValues.assign(numberOfPoints, coefficient);
+
+        for(auto& E : elements)
+        {
+            const double* variableValues = points.getVariableValues(E->variable->index);
+
+            for(int k = 0; k < numberOfPoints; k++)
+                termValues[k] *= pow(variableValues[k], E->power);
+        }
+
+        for(int k = 0; k < numberOfPoints; k++)
+            values[k] += termValues[k];
+    }
+
     inline E_Convexity getConvexity() const override
     {
         size_t numberPositivePowers = 0;
@@ -1107,10 +1171,9 @@ public:
         }
     }
 
-    inline SparseVariableVector calculateGradient(const VectorDouble& point) const
+    // Adds the gradient elements to the provided storage, which needs to be sorted and combined afterwards
+    inline void calculateGradient(const VectorDouble& point, SparseVariableVector& gradient) const
     {
-        SparseVariableVector gradient;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0.0)
@@ -1133,23 +1196,15 @@ public:
                     }
                 }
 
-                auto element = gradient.emplace(E1->variable, T->coefficient * value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(E1->variable->index, T->coefficient * value);
             }
         };
-
-        return gradient;
     };
 
-    SparseVariableMatrix calculateHessian(const VectorDouble& point) const
+    // Adds the upper triangular Hessian elements to the provided storage, which needs to be sorted and combined
+    // afterwards
+    void calculateHessian(const VectorDouble& point, SparseVariableMatrix& hessian) const
     {
-        SparseVariableMatrix hessian;
-
         for(auto& T : (*this))
         {
             if(T->coefficient == 0)
@@ -1177,20 +1232,10 @@ public:
                             = E1->power * E2->power / (E1->variable->calculate(point) * E2->variable->calculate(point));
                     }
 
-                    auto variablePair = std::make_pair(E1->variable, E2->variable);
-
-                    auto element = hessian.emplace(variablePair, corrFactor * value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += corrFactor * value;
-                    }
+                    hessian.add(E1->variable->index, E2->variable->index, corrFactor * value);
                 }
             }
         }
-
-        return hessian;
     };
 };
 
@@ -13,6 +13,8 @@
 #include "../Enums.h"
 #include "../Structs.h"
 
+#include <algorithm>
+#include <cassert>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -129,8 +131,174 @@ public:
 };
 
 using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
-using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
+
+// A flat sparse vector with elements (variable index, value). Elements are first appended with add() and then sorted
+// by variable index and combined with sortAndCombine(). The storage is kept when cleared, so an instance can be reused
+// as a scratch buffer without new allocations.
+class SparseVariableVector : private std::vector<std::pair<int, double>>
+{
+public:
+    using std::vector<std::pair<int, double>>::operator[];
+
+    using std::vector<std::pair<int, double>>::at;
+    using std::vector<std::pair<int, double>>::begin;
+    using std::vector<std::pair<int, double>>::clear;
+    using std::vector<std::pair<int, double>>::empty;
+    using std::vector<std::pair<int, double>>::end;
+    using std::vector<std::pair<int, double>>::reserve;
+    using std::vector<std::pair<int, double>>::size;
+
+    SparseVariableVector() = default;
+
+    inline void add(int variableIndex, double value) { this->emplace_back(variableIndex, value); }
+
+    // Sorts the elements by variable index and sums the values of elements with the same index
+    inline void sortAndCombine()
+    {
+        if(this->size() < 2)
+            return;
+
+        std::sort(this->begin(), this->end(),
+            [](const std::pair<int, double>& elementOne, const std::pair<int, double>& elementTwo) {
+                return (elementOne.first < elementTwo.first);
+            });
+
+        size_t last = 0;
+
+        for(size_t i = 1; i < this->size(); i++)
+        {
+            if((*this)[i].first == (*this)[last].first)
+                (*this)[last].second += (*this)[i].second;
+            else
+                (*this)[++last] = (*this)[i];
+        }
+
+        this->resize(last + 1);
+    }
+
+    inline void eraseZeroes()
+    {
+        this->erase(std::remove_if(this->begin(), this->end(),
+                        [](const std::pair<int, double>& element) { return (element.second == 0.0); }),
+            this->end());
+    }
+};
+
+// A flat sparse matrix with elements ((row variable index, column variable index), value). Used for the upper
+// triangular part of Hessians, i.e. the row index should be less than or equal to the column index. Works as
+// SparseVariableVector w.r.t. adding, sorting and reusing the storage.
+class SparseVariableMatrix : private std::vector<std::pair<std::pair<int, int>, double>>
+{
+public:
+    using std::vector<std::pair<std::pair<int, int>, double>>::operator[];
+
+    using std::vector<std::pair<std::pair<int, int>, double>>::at;
+    using std::vector<std::pair<std::pair<int, int>, double>>::begin;
+    using std::vector<std::pair<std::pair<int, int>, double>>::clear;
+    using std::vector<std::pair<std::pair<int, int>, double>>::empty;
+    using std::vector<std::pair<std::pair<int, int>, double>>::end;
+    using std::vector<std::pair<std::pair<int, int>, double>>::reserve;
+    using std::vector<std::pair<std::pair<int, int>, double>>::size;
+
+    SparseVariableMatrix() = default;
+
+    inline void add(int firstVariableIndex, int secondVariableIndex, double value)
+    {
+        this->emplace_back(std::make_pair(firstVariableIndex, secondVariableIndex), value);
+    }
+
+    // Sorts the elements in row major order and sums the values of elements with the same indices
+    inline void sortAndCombine()
+    {
+        if(this->size() < 2)
+            return;
+
+        std::sort(this->begin(), this->end(),
+            [](const std::pair<std::pair<int, int>, double>& elementOne,
+                const std::pair<std::pair<int, int>, double>& elementTwo) {
+                return (elementOne.first < elementTwo.first);
+            });
+
+        size_t last = 0;
+
+        for(size_t i = 1; i < this->size(); i++)
+        {
+            if((*this)[i].first == (*this)[last].first)
+                (*this)[last].second += (*this)[i].second;
+            else
+                (*this)[++last] = (*this)[i];
+        }
+
+        this->resize(last + 1);
+    }
+
+    inline void eraseZeroes()
+    {
+        this->erase(std::remove_if(this->begin(), this->end(),
+                        [](const std::pair<std::pair<int, int>, double>& element) { return (element.second == 0.0); }),
+            this->end());
+    }
+};
+
+// A batch of points stored variable by variable, i.e. the values of one variable in all points are contiguous. This
+// way functions can be evaluated in all points at once with tight loops over the points.
+class PointBatch
+{
+public:
+    PointBatch() = default;
+
+    PointBatch(int numberOfVariables, int numberOfPoints) { resize(numberOfVariables, numberOfPoints); }
+
+    inline void resize(int numberOfVariables, int numberOfPoints)
+    {
+        this->numberOfVariables = numberOfVariables;
+        this->numberOfPoints = numberOfPoints;
+        values.resize(numberOfVariables * numberOfPoints);
+    }
+
+    // Points with more variables than the batch are truncated
+    inline void setPoints(const std::vector<VectorDouble>& points)
+    {
+        resize(numberOfVariables, points.size());
+
+        for(int k = 0; k < numberOfPoints; k++)
+            setPoint(k, points[k]);
+    }
+
+    inline void setPoint(int pointIndex, const VectorDouble& point)
+    {
+        assert((int)point.size() >= numberOfVariables);
+
+        for(int i = 0; i < numberOfVariables; i++)
+            values[i * numberOfPoints + pointIndex] = point[i];
+    }
+
+    inline VectorDouble getPoint(int pointIndex) const
+    {
+        VectorDouble point(numberOfVariables);
+
+        for(int i = 0; i < numberOfVariables; i++)
+            point[i] = values[i * numberOfPoints + pointIndex];
+
+        return (point);
+    }
+
+    // Returns the values of the variable in all the points
+    inline const double* getVariableValues(int variableIndex) const
+    {
+        return (values.data() + variableIndex * numberOfPoints);
+    }
+
+    inline double* getVariableValues(int variableIndex) { return (values.data() + variableIndex * numberOfPoints); }
+
+    inline int getNumberOfVariables() const { return (numberOfVariables); }
+    inline int getNumberOfPoints() const { return (numberOfPoints); }
+
+private:
+    VectorDouble values;
+    int numberOfVariables = 0;
+    int numberOfPoints = 0;
+};
 
 class Variables : private std::vector<VariablePtr>
 {
@@ -18,18 +18,1104 @@
 
 #include "tinyxml2.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
 #ifdef HAS_STD_FILESYSTEM
 #include <filesystem>
 namespace fs = std;
 #endif
 
-#ifdef HAS_STD_EXPERIMENTAL_FILESYSTEM
-#include <experimental/filesystem>
-namespace fs = std::experimental;
-#endif
+#ifdef HAS_STD_EXPERIMENTAL_FILESYSTEM
+#include <experimental/filesystem>
+namespace fs = std::experimental;
+#endif
+
+namespace SHOT
+{
+
+namespace
+{
+
+enum class E_XMLEvent
+{
+    StartElement,
+    EndElement,
+    Text,
+    EndOfDocument
+};
+
+// A minimal non-validating pull parser for XML. Names, attribute values and texts refer directly to the parsed buffer
+// and entities are not decoded. Empty elements are reported as a start element directly followed by an end element.
+// Throws std::runtime_error if the XML is malformed.
+class XMLPullParser
+{
+public:
+    std::string_view name;
+    std::string_view text;
+
+    XMLPullParser(const char* begin, const char* end) : position(begin), end(end) {}
+
+    E_XMLEvent next()
+    {
+        if(isInEmptyElement)
+        {
+            isInEmptyElement = false;
+            return (E_XMLEvent::EndElement);
+        }
+
+        while(position < end)
+        {
+            if(*position != '<')
+            {
+                auto textStart = position;
+                position = std::find(position, end, '<');
+                text = std::string_view(textStart, position - textStart);
+
+                if(std::any_of(text.begin(), text.end(), [](char c) { return (!std::isspace((unsigned char)c)); }))
+                    return (E_XMLEvent::Text);
+            }
+            else if(startsWith("<?"))
+            {
+                skipPast("?>");
+            }
+            else if(startsWith("<!--"))
+            {
+                skipPast("-->");
+            }
+            else if(startsWith("<![CDATA["))
+            {
+                position += 9;
+                auto textStart = position;
+                skipPast("]]>");
+                text = std::string_view(textStart, position - 3 - textStart);
+                return (E_XMLEvent::Text);
+            }
+            else if(startsWith("<!"))
+            {
+                skipPast(">");
+            }
+            else if(startsWith("</"))
+            {
+                position += 2;
+                name = readName();
+                skipWhitespace();
+                expect('>');
+                return (E_XMLEvent::EndElement);
+            }
+            else
+            {
+                position++;
+                readStartElement();
+                return (E_XMLEvent::StartElement);
+            }
+        }
+
+        return (E_XMLEvent::EndOfDocument);
+    }
+
+    // Returns the value of an attribute of the current start element
+    std::optional<std::string_view> getAttribute(std::string_view attributeName) const
+    {
+        for(auto& A : attributes)
+        {
+            if(A.first == attributeName)
+                return (A.second);
+        }
+
+        return (std::nullopt);
+    }
+
+    // Skips the contents of the current start element including its end element
+    void skipElement()
+    {
+        int depth = 1;
+
+        while(depth > 0)
+        {
+            switch(next())
+            {
+            case E_XMLEvent::StartElement:
+                depth++;
+                break;
+            case E_XMLEvent::EndElement:
+                depth--;
+                break;
+            case E_XMLEvent::EndOfDocument:
+                throw std::runtime_error("Unexpected end of XML document.");
+            default:
+                break;
+            }
+        }
+    }
+
+    // Returns the first text in the current start element and skips the rest of its contents
+    std::string_view readText()
+    {
+        std::string_view elementText;
+        int depth = 1;
+
+        while(depth > 0)
+        {
+            switch(next())
+            {
+            case E_XMLEvent::StartElement:
+                depth++;
+                break;
+            case E_XMLEvent::EndElement:
+                depth--;
+                break;
+            case E_XMLEvent::Text:
+                if(depth == 1 && elementText.empty())
+                    elementText = text;
+                break;
+            case E_XMLEvent::EndOfDocument:
+                throw std::runtime_error("Unexpected end of XML document.");
+            }
+        }
+
+        return (elementText);
+    }
+
+private:
+    const char* position;
+    const char* end;
+
+    std::vector<std::pair<std::string_view, std::string_view>> attributes;
+    bool isInEmptyElement = false;
+
+    inline bool startsWith(std::string_view prefix) const
+    {
+        return ((size_t)(end - position) >= prefix.size() && std::string_view(position, prefix.size()) == prefix);
+    }
+
+    inline void skipWhitespace()
+    {
+        while(position < end && std::isspace((unsigned char)*position))
+            position++;
+    }
+
+    inline void skipPast(std::string_view delimiter)
+    {
+        position = std::search(position, end, delimiter.begin(), delimiter.end());
+
+        if(position == end)
+            throw std::runtime_error(fmt::format("Missing {} in XML document.", delimiter));
+
+        position += delimiter.size();
+    }
+
+    inline void expect(char character)
+    {
+        if(position == end || *position != character)
+            throw std::runtime_error(fmt::format("Expected {} in XML document.", character));
+
+        position++;
+    }
+
+    inline std::string_view readName()
+    {
+        auto nameStart = position;
+
+        while(position < end && !std::isspace((unsigned char)*position) && *position != '/' && *position != '>'
+            && *position != '=')
+            position++;
+
+        if(position == nameStart)
+            throw std::runtime_error("Expected a name in XML document.");
+
+        return (std::string_view(nameStart, position - nameStart));
+    }
+
+    void readStartElement()
+    {
+        name = readName();
+        attributes.clear();
+
+        while(true)
+        {
+            skipWhitespace();
+
+            if(position == end)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(*position == '>')
+            {
+                position++;
+                return;
+            }
+
+            if(*position == '/')
+            {
+                position++;
+                expect('>');
+                isInEmptyElement = true;
+                return;
+            }
+
+            auto attributeName = readName();
+            skipWhitespace();
+            expect('=');
+            skipWhitespace();
+
+            if(position == end || (*position != '"' && *position != '\''))
+                throw std::runtime_error("Expected a quoted attribute value in XML document.");
+
+            char quote = *position++;
+            auto valueStart = position;
+            position = std::find(position, end, quote);
+
+            if(position == end)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            attributes.emplace_back(attributeName, std::string_view(valueStart, position - valueStart));
+            position++;
+        }
+    }
+};
+
+// Replaces the predefined and numeric XML entities with the characters they represent
+std::string decodeEntities(std::string_view text)
+{
+    if(text.find('&') == std::string_view::npos)
+        return (std::string(text));
+
+    std::string decoded;
+    decoded.reserve(text.size());
+
+    for(size_t i = 0; i < text.size(); i++)
+    {
+        size_t entityEnd = (text[i] == '&') ? text.find(';', i) : std::string_view::npos;
+
+        if(entityEnd == std::string_view::npos)
+        {
+            decoded.push_back(text[i]);
+            continue;
+        }
+
+        auto entity = text.substr(i + 1, entityEnd - i - 1);
+
+        if(entity == "lt")
+            decoded.push_back('<');
+        else if(entity == "gt")
+            decoded.push_back('>');
+        else if(entity == "amp")
+            decoded.push_back('&');
+        else if(entity == "quot")
+            decoded.push_back('"');
+        else if(entity == "apos")
+            decoded.push_back('\'');
+        else if(entity.size() > 1 && entity[0] == '#')
+        {
+            bool isHexadecimal = (entity[1] == 'x' || entity[1] == 'X');
+            auto digits = entity.substr(isHexadecimal ? 2 : 1);
+            unsigned int codePoint = 0;
+            auto result
+                = std::from_chars(digits.data(), digits.data() + digits.size(), codePoint, isHexadecimal ? 16 : 10);
+
+            if(result.ec != std::errc() || result.ptr != digits.data() + digits.size())
+            {
+                decoded.push_back(text[i]);
+                continue;
+            }
+
+            // Encoded as UTF-8
+            if(codePoint < 0x80)
+            {
+                decoded.push_back((char)codePoint);
+            }
+            else if(codePoint < 0x800)
+            {
+                decoded.push_back((char)(0xC0 | (codePoint >> 6)));
+                decoded.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+            else if(codePoint < 0x10000)
+            {
+                decoded.push_back((char)(0xE0 | (codePoint >> 12)));
+                decoded.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+                decoded.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+            else
+            {
+                decoded.push_back((char)(0xF0 | (codePoint >> 18)));
+                decoded.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+                decoded.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+                decoded.push_back((char)(0x80 | (codePoint & 0x3F)));
+            }
+        }
+        else
+        {
+            decoded.push_back(text[i]);
+            continue;
+        }
+
+        i = entityEnd;
+    }
+
+    return (decoded);
+}
+
+inline std::string_view trimNumber(std::string_view text)
+{
+    while(!text.empty() && std::isspace((unsigned char)text.front()))
+        text.remove_prefix(1);
+
+    while(!text.empty() && std::isspace((unsigned char)text.back()))
+        text.remove_suffix(1);
+
+    // Not accepted by from_chars
+    if(!text.empty() && text.front() == '+')
+        text.remove_prefix(1);
+
+    return (text);
+}
+
+// Converts the whole text to a number without the copies and locale handling of std::stod, throws
+// std::invalid_argument if it is not a valid number
+double parseDouble(std::string_view text)
+{
+    text = trimNumber(text);
+    double value;
+
+#ifdef __cpp_lib_to_chars
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if(result.ec != std::errc() || result.ptr != text.data() + text.size())
+        throw std::invalid_argument(fmt::format("Cannot convert {} to a number.", text));
+#else
+    size_t numberOfConvertedCharacters;
+    value = std::stod(std::string(text), &numberOfConvertedCharacters);
+
+    if(numberOfConvertedCharacters != text.size())
+        throw std::invalid_argument(fmt::format("Cannot convert {} to a number.", text));
+#endif
+
+    return (value);
+}
+
+int parseInteger(std::string_view text)
+{
+    text = trimNumber(text);
+    int value;
+
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if(result.ec != std::errc() || result.ptr != text.data() + text.size())
+        throw std::invalid_argument(fmt::format("Cannot convert {} to an integer.", text));
+
+    return (value);
+}
+
+// The attributes of the OSiL nonlinear expression nodes that are needed when creating the expressions
+struct NonlinearNodeAttributes
+{
+    double value = 0.0;
+    double coefficient = 1.0;
+    int variableIndex = -1;
+};
+
+// Creates the expression corresponding to an OSiL nonlinear node from its already converted child nodes
+NonlinearExpressionPtr createNonlinearExpression(std::string_view type, NonlinearExpressions& children,
+    const NonlinearNodeAttributes& attributes, const ProblemPtr& destination)
+{
+    auto checkNumberOfChildren = [&](size_t numberOfChildren) {
+        if(children.size() < numberOfChildren)
+            throw std::invalid_argument(fmt::format("Too few operands for OSiL function {}.", type));
+    };
+
+    if(type == "plus")
+    {
+        checkNumberOfChildren(2);
+        return std::make_shared<ExpressionSum>(children[0], children[1]);
+    }
+    else if(type == "sum")
+    {
+        switch(children.size())
+        {
+        case 0:
+            return std::make_shared<ExpressionConstant>(0.);
+        case 1:
+            return children[0];
+        default:
+            return std::make_shared<ExpressionSum>(children);
+        }
+    }
+    else if(type == "minus")
+    {
+        checkNumberOfChildren(2);
+        return std::make_shared<ExpressionSum>(children[0], std::make_shared<ExpressionNegate>(children[1]));
+    }
+    else if(type == "negate")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionNegate>(children[0]);
+    }
+    else if(type == "times")
+    {
+        checkNumberOfChildren(2);
+        return std::make_shared<ExpressionProduct>(children[0], children[1]);
+    }
+    else if(type == "divide")
+    {
+        checkNumberOfChildren(2);
+        return std::make_shared<ExpressionDivide>(children[0], children[1]);
+    }
+    else if(type == "power")
+    {
+        checkNumberOfChildren(2);
+        return std::make_shared<ExpressionPower>(children[0], children[1]);
+    }
+    else if(type == "product")
+    {
+        switch(children.size())
+        {
+        case 0:
+            return std::make_shared<ExpressionConstant>(0.);
+        case 1:
+            return children[0];
+        default:
+            return std::make_shared<ExpressionProduct>(children);
+        }
+    }
+    else if(type == "abs")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionAbs>(children[0]);
+    }
+    else if(type == "square")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionSquare>(children[0]);
+    }
+    else if(type == "sqrt")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionSquareRoot>(children[0]);
+    }
+    else if(type == "ln")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionLog>(children[0]);
+    }
+    else if(type == "exp")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionExp>(children[0]);
+    }
+    else if(type == "sin")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionSin>(children[0]);
+    }
+    else if(type == "cos")
+    {
+        checkNumberOfChildren(1);
+        return std::make_shared<ExpressionCos>(children[0]);
+    }
+    else if(type == "number")
+    {
+        return std::make_shared<ExpressionConstant>(attributes.value);
+    }
+    else if(type == "pi")
+    {
+        return std::make_shared<ExpressionConstant>(3.14159265);
+    }
+    else if(type == "variable")
+    {
+        if(attributes.coefficient == 0.)
+            return std::make_shared<ExpressionConstant>(0.);
+
+        auto variable = std::make_shared<ExpressionVariable>(destination->getVariable(attributes.variableIndex));
+
+        if(attributes.coefficient == 1.)
+            return variable;
+        if(attributes.coefficient == -1.)
+            return std::make_shared<ExpressionNegate>(variable);
+
+        return std::make_shared<ExpressionProduct>(
+            std::make_shared<ExpressionConstant>(attributes.coefficient), variable);
+    }
+
+    throw OperationNotImplementedException(fmt::format("Error: Unsupported OSiL function {}", type));
+}
+
+// Reads an OSiL file in one pass with the pull parser. Variables and nonlinear expressions are created directly when
+// read, while the objective, constraints and their terms are kept in flat arrays until the end of the file, since the
+// type of a constraint depends on whether it has quadratic or nonlinear terms further down in the file.
+class OSiLStreamReader
+{
+public:
+    OSiLStreamReader(EnvironmentPtr envPtr, ProblemPtr problem, const char* begin, const char* end)
+        : env(envPtr), problem(problem), parser(begin, end)
+    {
+    }
+
+    E_ProblemCreationStatus read()
+    {
+        E_ProblemCreationStatus status = E_ProblemCreationStatus::NormalCompletion;
+
+        for(auto event = parser.next(); event != E_XMLEvent::EndOfDocument; event = parser.next())
+        {
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            // The elements containing the sections are entered, all other unknown elements are skipped
+            if(parser.name == "osil" || parser.name == "instanceData")
+                continue;
+            else if(parser.name == "instanceHeader")
+                readInstanceHeader();
+            else if(parser.name == "variables")
+                status = readVariables();
+            else if(parser.name == "objectives")
+                status = readObjectives();
+            else if(parser.name == "constraints")
+                readConstraints();
+            else if(parser.name == "linearConstraintCoefficients")
+                status = readLinearConstraintCoefficients();
+            else if(parser.name == "quadraticCoefficients")
+                readQuadraticCoefficients();
+            else if(parser.name == "nonlinearExpressions")
+                readNonlinearExpressions();
+            else
+                parser.skipElement();
+
+            if(status != E_ProblemCreationStatus::NormalCompletion)
+                return (status);
+        }
+
+        return (createConstraintsAndObjective());
+    }
+
+private:
+    EnvironmentPtr env;
+    ProblemPtr problem;
+    XMLPullParser parser;
+
+    int numberOfVariables = 0;
+
+    int numberOfObjectives = 0;
+    E_ObjectiveFunctionDirection objectiveDirection = E_ObjectiveFunctionDirection::Minimize;
+    double objectiveConstant = 0.0;
+    VectorInteger objectiveVariableIndexes;
+    VectorDouble objectiveCoefficients;
+
+    VectorDouble constraintLowerBounds;
+    VectorDouble constraintUpperBounds;
+    std::vector<std::string> constraintNames;
+
+    int numberOfLinearCoefficients = 0;
+    bool isRowFormat = false;
+    VectorInteger linearStarts;
+    VectorInteger linearIndexes;
+    VectorDouble linearCoefficients;
+
+    VectorInteger quadraticPlacements;
+    VectorInteger quadraticFirstVariableIndexes;
+    VectorInteger quadraticSecondVariableIndexes;
+    VectorDouble quadraticCoefficients;
+
+    std::map<int, NonlinearExpressionPtr> nonlinearExpressions;
+
+    void readInstanceHeader()
+    {
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name == "name")
+                problem->name = decodeEntities(parser.readText());
+            else
+                parser.skipElement();
+        }
+    }
+
+    E_ProblemCreationStatus readVariables()
+    {
+        double minLBCont = env->settings->getSetting<double>("Variables.Continuous.MinimumLowerBound", "Model");
+        double maxUBCont = env->settings->getSetting<double>("Variables.Continuous.MaximumUpperBound", "Model");
+        double minLBInt = env->settings->getSetting<double>("Variables.Integer.MinimumLowerBound", "Model");
+        double maxUBInt = env->settings->getSetting<double>("Variables.Integer.MaximumUpperBound", "Model");
+
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name != "var")
+            {
+                parser.skipElement();
+                continue;
+            }
+
+            auto name = parser.getAttribute("name");
+
+            if(!name)
+                return (E_ProblemCreationStatus::ErrorInVariables);
+
+            auto typeAttribute = parser.getAttribute("type");
+            char type = (typeAttribute && !typeAttribute->empty()) ? typeAttribute->front() : 'C';
+
+            auto lowerBoundAttribute = parser.getAttribute("lb");
+            auto upperBoundAttribute = parser.getAttribute("ub");
+
+            double variableLB = lowerBoundAttribute ? parseDouble(*lowerBoundAttribute) : 0.0; // By OSiL definition
+            double variableUB = upperBoundAttribute ? parseDouble(*upperBoundAttribute) : SHOT_DBL_MAX;
+
+            E_VariableType variableType;
+
+            switch(type)
+            {
+            case 'C':
+                variableType = E_VariableType::Real;
+                variableLB = std::max(variableLB, minLBCont);
+                variableUB = std::min(variableUB, maxUBCont);
+                break;
+
+            case 'B':
+                variableType = E_VariableType::Binary;
+                variableLB = std::max(variableLB, 0.0);
+                variableUB = std::min(variableUB, 1.0);
+                break;
+
+            case 'I':
+                variableType = E_VariableType::Integer;
+                variableLB = std::max(variableLB, minLBInt);
+                variableUB = std::min(variableUB, maxUBInt);
+                break;
+
+            case 'D':
+                variableType = E_VariableType::Semicontinuous;
+                variableLB = std::max(variableLB, 0.0);
+                variableUB = std::min(variableUB, maxUBCont);
+                break;
+
+            default:
+                return (E_ProblemCreationStatus::ErrorInVariables);
+            }
+
+            problem->add(std::make_shared<SHOT::Variable>(
+                decodeEntities(*name), numberOfVariables, variableType, variableLB, variableUB));
+
+            numberOfVariables++;
+            parser.skipElement();
+        }
+
+        return (E_ProblemCreationStatus::NormalCompletion);
+    }
+
+    E_ProblemCreationStatus readObjectives()
+    {
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            // Only one objective is supported
+            if(parser.name != "obj" || numberOfObjectives > 0)
+                return (E_ProblemCreationStatus::ErrorInObjective);
+
+            numberOfObjectives++;
+
+            auto direction = parser.getAttribute("maxOrMin");
+
+            if(!direction)
+                return (E_ProblemCreationStatus::ErrorInObjective);
+
+            objectiveDirection = (*direction == "min") ? E_ObjectiveFunctionDirection::Minimize
+                                                       : E_ObjectiveFunctionDirection::Maximize;
+
+            if(auto constant = parser.getAttribute("constant"))
+                objectiveConstant = parseDouble(*constant);
+
+            for(event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+            {
+                if(event == E_XMLEvent::EndOfDocument)
+                    throw std::runtime_error("Unexpected end of XML document.");
+
+                if(event != E_XMLEvent::StartElement)
+                    continue;
+
+                if(parser.name != "coef")
+                {
+                    parser.skipElement();
+                    continue;
+                }
+
+                auto index = parser.getAttribute("idx");
+
+                if(!index)
+                    return (E_ProblemCreationStatus::ErrorInObjective);
+
+                objectiveVariableIndexes.push_back(parseInteger(*index));
+                objectiveCoefficients.push_back(parseDouble(parser.readText()));
+            }
+        }
+
+        return (E_ProblemCreationStatus::NormalCompletion);
+    }
 
-namespace SHOT
-{
+    void readConstraints()
+    {
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name == "con")
+            {
+                auto lowerBound = parser.getAttribute("lb");
+                auto upperBound = parser.getAttribute("ub");
+                auto name = parser.getAttribute("name");
+
+                constraintLowerBounds.push_back(lowerBound ? parseDouble(*lowerBound) : SHOT_DBL_MIN);
+                constraintUpperBounds.push_back(upperBound ? parseDouble(*upperBound) : SHOT_DBL_MAX);
+                constraintNames.push_back(
+                    name ? decodeEntities(*name) : "con" + std::to_string(constraintNames.size()));
+            }
+
+            parser.skipElement();
+        }
+    }
+
+    // Reads the el elements of an array in the linear constraint coefficients, where each element is repeated mult
+    // times with the increment incr
+    template <typename T> void readArray(std::vector<T>& values)
+    {
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name != "el")
+                throw std::runtime_error(fmt::format("Unsupported array element {} in OSiL file.", parser.name));
+
+            auto multiplicityAttribute = parser.getAttribute("mult");
+            auto incrementAttribute = parser.getAttribute("incr");
+
+            int multiplicity = multiplicityAttribute ? parseInteger(*multiplicityAttribute) : 1;
+            int increment = incrementAttribute ? parseInteger(*incrementAttribute) : 0;
+
+            T value;
+
+            if constexpr(std::is_same_v<T, int>)
+                value = parseInteger(parser.readText());
+            else
+                value = parseDouble(parser.readText());
+
+            for(int i = 0; i < multiplicity; i++)
+                values.push_back(value + i * increment);
+        }
+    }
+
+    E_ProblemCreationStatus readLinearConstraintCoefficients()
+    {
+        auto numberOfValues = parser.getAttribute("numberOfValues");
+
+        if(!numberOfValues)
+            return (E_ProblemCreationStatus::ErrorInConstraints);
+
+        numberOfLinearCoefficients = parseInteger(*numberOfValues);
+
+        linearIndexes.reserve(numberOfLinearCoefficients);
+        linearCoefficients.reserve(numberOfLinearCoefficients);
+
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name == "start")
+            {
+                readArray(linearStarts);
+            }
+            else if(parser.name == "colIdx" || parser.name == "rowIdx")
+            {
+                isRowFormat = (parser.name == "colIdx");
+                readArray(linearIndexes);
+            }
+            else if(parser.name == "value")
+            {
+                readArray(linearCoefficients);
+            }
+            else
+            {
+                parser.skipElement();
+            }
+        }
+
+        if((int)linearIndexes.size() != numberOfLinearCoefficients
+            || (int)linearCoefficients.size() != numberOfLinearCoefficients)
+        {
+            env->output->outputError(fmt::format("Error when parsing linear terms in constraints."));
+            return (E_ProblemCreationStatus::ErrorInConstraints);
+        }
+
+        return (E_ProblemCreationStatus::NormalCompletion);
+    }
+
+    void readQuadraticCoefficients()
+    {
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name == "qTerm")
+            {
+                auto placement = parser.getAttribute("idx");
+                auto coefficient = parser.getAttribute("coef");
+                auto firstVariableIndex = parser.getAttribute("idxOne");
+                auto secondVariableIndex = parser.getAttribute("idxTwo");
+
+                if(!placement || !firstVariableIndex || !secondVariableIndex)
+                    throw std::runtime_error("Missing index in quadratic term.");
+
+                quadraticPlacements.push_back(parseInteger(*placement));
+                quadraticCoefficients.push_back(coefficient ? parseDouble(*coefficient) : 1.0);
+                quadraticFirstVariableIndexes.push_back(parseInteger(*firstVariableIndex));
+                quadraticSecondVariableIndexes.push_back(parseInteger(*secondVariableIndex));
+            }
+
+            parser.skipElement();
+        }
+    }
+
+    void readNonlinearExpressions()
+    {
+        if(numberOfVariables == 0)
+            throw std::runtime_error("Nonlinear expressions before the variables.");
+
+        for(auto event = parser.next(); event != E_XMLEvent::EndElement; event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event != E_XMLEvent::StartElement)
+                continue;
+
+            if(parser.name != "nl")
+            {
+                parser.skipElement();
+                continue;
+            }
+
+            auto index = parser.getAttribute("idx");
+
+            if(!index)
+                throw std::runtime_error("Missing index in nonlinear expression.");
+
+            int constraintIndex = parseInteger(*index);
+            auto expression = readNonlinearExpression();
+
+            if(expression)
+                nonlinearExpressions.emplace(constraintIndex, expression);
+        }
+    }
+
+    // Builds the expression tree in an nl element bottom-up with an explicit stack of the open nodes, so that deep
+    // expressions do not use the call stack
+    NonlinearExpressionPtr readNonlinearExpression()
+    {
+        struct OpenNode
+        {
+            std::string_view type;
+            NonlinearExpressions children;
+            NonlinearNodeAttributes attributes;
+        };
+
+        std::vector<OpenNode> openNodes;
+        NonlinearExpressionPtr expression;
+
+        for(auto event = parser.next(); !(event == E_XMLEvent::EndElement && openNodes.empty());
+            event = parser.next())
+        {
+            if(event == E_XMLEvent::EndOfDocument)
+                throw std::runtime_error("Unexpected end of XML document.");
+
+            if(event == E_XMLEvent::StartElement)
+            {
+                OpenNode node;
+                node.type = parser.name;
+
+                if(node.type == "number")
+                {
+                    auto value = parser.getAttribute("value");
+                    node.attributes.value = value ? parseDouble(*value) : 0.0;
+                }
+                else if(node.type == "variable")
+                {
+                    auto coefficient = parser.getAttribute("coef");
+                    auto index = parser.getAttribute("idx");
+
+                    if(!index)
+                        throw std::runtime_error("Missing index in nonlinear variable.");
+
+                    node.attributes.coefficient = coefficient ? parseDouble(*coefficient) : 1.0;
+                    node.attributes.variableIndex = parseInteger(*index);
+
+                    if(node.attributes.variableIndex < 0 || node.attributes.variableIndex >= numberOfVariables)
+                        throw std::runtime_error("Variable index out of range in nonlinear expression.");
+                }
+
+                openNodes.push_back(std::move(node));
+            }
+            else if(event == E_XMLEvent::EndElement)
+            {
+                auto node = std::move(openNodes.back());
+                openNodes.pop_back();
+
+                auto nodeExpression
+                    = createNonlinearExpression(node.type, node.children, node.attributes, problem);
+
+                if(!openNodes.empty())
+                    openNodes.back().children.push_back(nodeExpression);
+                else if(!expression) // Only the first child of the nl element is used
+                    expression = nodeExpression;
+            }
+        }
+
+        return (expression);
+    }
+
+    E_ProblemCreationStatus createConstraintsAndObjective()
+    {
+        if(numberOfVariables == 0)
+        {
+            env->output->outputError(fmt::format("No variables defined."));
+            return (E_ProblemCreationStatus::ErrorInVariables);
+        }
+
+        if(numberOfObjectives == 0)
+            return (E_ProblemCreationStatus::ErrorInObjective);
+
+        int numberOfConstraints = constraintNames.size();
+
+        std::vector<bool> containsQuadraticTerms(numberOfConstraints + 1, false);
+
+        for(auto placement : quadraticPlacements)
+        {
+            if(placement < -1 || placement >= numberOfConstraints)
+                return (E_ProblemCreationStatus::ErrorInConstraints);
+
+            containsQuadraticTerms[placement + 1] = true;
+        }
+
+        for(int i = 0; i < numberOfConstraints; i++)
+        {
+            auto nonlinearExpression = nonlinearExpressions.find(i);
+
+            if(nonlinearExpression != nonlinearExpressions.end())
+                problem->add(std::make_shared<NonlinearConstraint>(i, constraintNames[i],
+                    nonlinearExpression->second, constraintLowerBounds[i], constraintUpperBounds[i]));
+            else if(containsQuadraticTerms[i + 1])
+                problem->add(std::make_shared<QuadraticConstraint>(
+                    i, constraintNames[i], constraintLowerBounds[i], constraintUpperBounds[i]));
+            else
+                problem->add(std::make_shared<LinearConstraint>(
+                    i, constraintNames[i], constraintLowerBounds[i], constraintUpperBounds[i]));
+        }
+
+        // The memory used for the constraint names is released before the terms are created
+        std::vector<std::string>().swap(constraintNames);
+
+        auto nonlinearObjectiveExpression = nonlinearExpressions.find(-1);
+
+        if(nonlinearObjectiveExpression != nonlinearExpressions.end())
+            problem->add(std::make_shared<NonlinearObjectiveFunction>(
+                objectiveDirection, nonlinearObjectiveExpression->second, objectiveConstant));
+        else if(containsQuadraticTerms[0])
+            problem->add(std::make_shared<QuadraticObjectiveFunction>(objectiveDirection, objectiveConstant));
+        else
+            problem->add(std::make_shared<LinearObjectiveFunction>(objectiveDirection, objectiveConstant));
+
+        auto isVariableIndex = [&](int index) { return (index >= 0 && index < numberOfVariables); };
+
+        auto linearObjective = std::dynamic_pointer_cast<LinearObjectiveFunction>(problem->objectiveFunction);
+
+        for(size_t i = 0; i < objectiveVariableIndexes.size(); i++)
+        {
+            if(!isVariableIndex(objectiveVariableIndexes[i]))
+                return (E_ProblemCreationStatus::ErrorInObjective);
+
+            linearObjective->add(std::make_shared<LinearTerm>(
+                objectiveCoefficients[i], problem->allVariables[objectiveVariableIndexes[i]]));
+        }
+
+        for(size_t i = 0; i < quadraticPlacements.size(); i++)
+        {
+            if(!isVariableIndex(quadraticFirstVariableIndexes[i])
+                || !isVariableIndex(quadraticSecondVariableIndexes[i]))
+                return (E_ProblemCreationStatus::ErrorInConstraints);
+
+            auto term = std::make_shared<QuadraticTerm>(quadraticCoefficients[i],
+                problem->allVariables[quadraticFirstVariableIndexes[i]],
+                problem->allVariables[quadraticSecondVariableIndexes[i]]);
+
+            if(quadraticPlacements[i] == -1)
+                std::dynamic_pointer_cast<QuadraticObjectiveFunction>(problem->objectiveFunction)->add(term);
+            else
+                std::dynamic_pointer_cast<QuadraticConstraint>(problem->numericConstraints[quadraticPlacements[i]])
+                    ->add(term);
+        }
+
+        if(numberOfLinearCoefficients == 0)
+            return (E_ProblemCreationStatus::NormalCompletion);
+
+        // Rows in row format, otherwise columns
+        int numberOfVectors = isRowFormat ? numberOfConstraints : numberOfVariables;
+
+        if((int)linearStarts.size() < numberOfVectors + 1)
+            return (E_ProblemCreationStatus::ErrorInConstraints);
+
+        int counter = 0;
+
+        for(int i = 0; i < numberOfVectors; i++)
+        {
+            for(; counter < linearStarts[i + 1] && counter < numberOfLinearCoefficients; counter++)
+            {
+                int constraintIndex = isRowFormat ? i : linearIndexes[counter];
+                int variableIndex = isRowFormat ? linearIndexes[counter] : i;
+
+                if(constraintIndex < 0 || constraintIndex >= numberOfConstraints || !isVariableIndex(variableIndex))
+                    return (E_ProblemCreationStatus::ErrorInConstraints);
+
+                std::dynamic_pointer_cast<LinearConstraint>(problem->numericConstraints[constraintIndex])
+                    ->add(std::make_shared<LinearTerm>(
+                        linearCoefficients[counter], problem->allVariables[variableIndex]));
+            }
+        }
+
+        return (E_ProblemCreationStatus::NormalCompletion);
+    }
+};
+
+} // namespace
 
 ModelingSystemOSiL::ModelingSystemOSiL(EnvironmentPtr envPtr) : IModelingSystem(envPtr) {}
 
@@ -40,6 +1126,63 @@ void ModelingSystemOSiL::augmentSettings([[maybe_unused]] SettingsPtr settings)
 void ModelingSystemOSiL::updateSettings([[maybe_unused]] SettingsPtr settings) {}
 
 E_ProblemCreationStatus ModelingSystemOSiL::createProblem(ProblemPtr& problem, const std::string& filename)
+{
+    E_ProblemCreationStatus status;
+    bool useDocumentReader = !env->settings->getSetting<bool>("Input.OSiL.UseStreamingReader", "Model");
+    wasReadWithStreamingReader = false;
+
+    if(!useDocumentReader)
+    {
+        try
+        {
+            status = createProblemStreaming(problem, filename);
+            wasReadWithStreamingReader = true;
+        }
+        catch(const std::exception& e)
+        {
+            env->output->outputDebug(
+                fmt::format(" Could not read OSiL file with the streaming reader: {}", e.what()));
+            env->output->outputDebug(" Using the document reader instead.");
+
+            // The problem may have been partially created
+            problem = std::make_shared<SHOT::Problem>(env);
+            useDocumentReader = true;
+        }
+    }
+
+    if(useDocumentReader)
+        status = createProblemFromDocument(problem, filename);
+
+    if(status != E_ProblemCreationStatus::NormalCompletion)
+        return (status);
+
+    problem->updateProperties();
+
+    bool extractMonomialTerms = env->settings->getSetting<bool>("Reformulation.Monomials.Extract", "Model");
+    bool extractSignomialTerms = env->settings->getSetting<bool>("Reformulation.Signomials.Extract", "Model");
+    bool extractQuadraticTerms = (env->settings->getSetting<int>("Reformulation.Quadratics.ExtractStrategy", "Model")
+        >= static_cast<int>(ES_QuadraticTermsExtractStrategy::ExtractTermsToSame));
+
+    simplifyNonlinearExpressions(problem, extractMonomialTerms, extractSignomialTerms, extractQuadraticTerms);
+
+    problem->finalize();
+
+    return (E_ProblemCreationStatus::NormalCompletion);
+}
+
+E_ProblemCreationStatus ModelingSystemOSiL::createProblemStreaming(ProblemPtr& problem, const std::string& filename)
+{
+    Utilities::MappedFile file;
+
+    if(!file.open(filename))
+        throw std::runtime_error(fmt::format("Could not open file {}.", filename));
+
+    OSiLStreamReader reader(env, problem, file.begin(), file.end());
+
+    return (reader.read());
+}
+
+E_ProblemCreationStatus ModelingSystemOSiL::createProblemFromDocument(ProblemPtr& problem, const std::string& filename)
 {
     if(false && !fs::filesystem::exists(fs::filesystem::path(filename)))
     {
@@ -432,172 +1575,32 @@ E_ProblemCreationStatus ModelingSystemOSiL::createProblem(ProblemPtr& problem, c
         return (E_ProblemCreationStatus::ErrorInConstraints);
     }
 
-    problem->updateProperties();
-
-    bool extractMonomialTerms = env->settings->getSetting<bool>("Reformulation.Monomials.Extract", "Model");
-    bool extractSignomialTerms = env->settings->getSetting<bool>("Reformulation.Signomials.Extract", "Model");
-    bool extractQuadraticTerms = (env->settings->getSetting<int>("Reformulation.Quadratics.ExtractStrategy", "Model")
-        >= static_cast<int>(ES_QuadraticTermsExtractStrategy::ExtractTermsToSame));
-
-    simplifyNonlinearExpressions(problem, extractMonomialTerms, extractSignomialTerms, extractQuadraticTerms);
-
-    problem->finalize();
-
     return (E_ProblemCreationStatus::NormalCompletion);
 }
 
 NonlinearExpressionPtr ModelingSystemOSiL::convertNonlinearNode(tinyxml2::XMLNode* node, const ProblemPtr& destination)
 {
-    std::string expressionType = node->ToElement()->Name();
-
-    if(expressionType.compare("plus") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        auto secondChildNode = firstChildNode->NextSibling();
-
-        return std::make_shared<ExpressionSum>(
-            convertNonlinearNode(firstChildNode, destination), convertNonlinearNode(secondChildNode, destination));
-    }
-    else if(expressionType.compare("sum") == 0)
-    {
-        NonlinearExpressions terms;
-
-        for(auto C = node->FirstChildElement(); C != nullptr; C = C->NextSiblingElement())
-            terms.push_back(convertNonlinearNode(C, destination));
-
-        switch(terms.size())
-        {
-        case 0:
-            return std::make_shared<ExpressionConstant>(0.);
-        case 1:
-            return terms[1];
-        default:
-            return std::make_shared<ExpressionSum>(terms);
-        }
-    }
-    else if(expressionType.compare("minus") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        auto secondChildNode = firstChildNode->NextSibling();
-
-        return std::make_shared<ExpressionSum>(convertNonlinearNode(firstChildNode, destination),
-            std::make_shared<ExpressionNegate>(convertNonlinearNode(secondChildNode, destination)));
-    }
-    else if(expressionType.compare("negate") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-
-        return std::make_shared<ExpressionNegate>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("times") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        auto secondChildNode = firstChildNode->NextSibling();
-
-        return std::make_shared<ExpressionProduct>(
-            convertNonlinearNode(firstChildNode, destination), convertNonlinearNode(secondChildNode, destination));
-    }
-    else if(expressionType.compare("divide") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        auto secondChildNode = firstChildNode->NextSibling();
-
-        return std::make_shared<ExpressionDivide>(
-            convertNonlinearNode(firstChildNode, destination), convertNonlinearNode(secondChildNode, destination));
-    }
-    else if(expressionType.compare("power") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        auto secondChildNode = firstChildNode->NextSibling();
+    auto element = node->ToElement();
 
-        return std::make_shared<ExpressionPower>(
-            convertNonlinearNode(firstChildNode, destination), convertNonlinearNode(secondChildNode, destination));
-    }
-    else if(expressionType.compare("product") == 0)
-    {
-        NonlinearExpressions factors;
+    NonlinearExpressions children;
 
-        for(auto C = node->FirstChildElement(); C != nullptr; C = C->NextSiblingElement())
-            factors.push_back(convertNonlinearNode(C, destination));
+    for(auto C = element->FirstChildElement(); C != nullptr; C = C->NextSiblingElement())
+        children.push_back(convertNonlinearNode(C, destination));
 
-        switch(factors.size())
-        {
-        case 0:
-            return std::make_shared<ExpressionConstant>(0.);
-        case 1:
-            return factors[1];
-        default:
-            return std::make_shared<ExpressionProduct>(factors);
-        }
-    }
-    else if(expressionType.compare("abs") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
+    std::string_view type = element->Name();
+    NonlinearNodeAttributes attributes;
 
-        return std::make_shared<ExpressionAbs>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("square") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionSquare>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("sqrt") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionSquareRoot>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("ln") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionLog>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("exp") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionExp>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("sin") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionSin>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("cos") == 0)
-    {
-        auto firstChildNode = node->FirstChild();
-        return std::make_shared<ExpressionCos>(convertNonlinearNode(firstChildNode, destination));
-    }
-    else if(expressionType.compare("number") == 0)
-    {
-        return std::make_shared<ExpressionConstant>(std::stod(node->ToElement()->Attribute("value")));
-    }
-    else if(expressionType.compare("pi") == 0)
-    {
-        return std::make_shared<ExpressionConstant>(3.14159265);
-    }
-    else if(expressionType.compare("variable") == 0)
+    if(type == "number")
     {
-        double coefficient
-            = (node->ToElement()->Attribute("coef") != NULL) ? std::stod(node->ToElement()->Attribute("coef")) : 1.0;
-
-        int variableIndex = std::stoi(node->ToElement()->Attribute("idx"));
-
-        if(coefficient == 0.)
-            return std::make_shared<ExpressionConstant>(0.);
-        if(coefficient == 1.)
-            return std::make_shared<ExpressionVariable>(destination->getVariable(variableIndex));
-        if(coefficient == -1.)
-            return std::make_shared<ExpressionNegate>(
-                std::make_shared<ExpressionVariable>(destination->getVariable(variableIndex)));
-
-        return std::make_shared<ExpressionProduct>(std::make_shared<ExpressionConstant>(coefficient),
-            std::make_shared<ExpressionVariable>(destination->getVariable(variableIndex)));
+        attributes.value = (element->Attribute("value") != NULL) ? std::stod(element->Attribute("value")) : 0.0;
     }
-    else
+    else if(type == "variable")
     {
-        throw OperationNotImplementedException(fmt::format("Error: Unsupported OSiL function {}", expressionType));
+        attributes.coefficient = (element->Attribute("coef") != NULL) ? std::stod(element->Attribute("coef")) : 1.0;
+        attributes.variableIndex = std::stoi(element->Attribute("idx"));
     }
 
-    return nullptr;
+    return (createNonlinearExpression(type, children, attributes, destination));
 }
 
 void ModelingSystemOSiL::finalizeSolution() {}
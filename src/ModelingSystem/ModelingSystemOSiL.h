@@ -41,13 +41,26 @@ public:
     // Get specific settings from modeling system
     void updateSettings(SettingsPtr settings) override;
 
-    // Create the optimization problem by filename in either OSiL or Ampl format
+    // Create the optimization problem by filename in OSiL format. The file is read with the streaming reader unless
+    // it is disabled, and with the document reader if the streaming reader fails.
     E_ProblemCreationStatus createProblem(ProblemPtr& problem, const std::string& filename);
 
+    // Whether the last problem created was read with the streaming reader
+    inline bool isReadWithStreamingReader() const { return (wasReadWithStreamingReader); }
+
     // Move the solution and statistics from SHOT to the modeling system
     void finalizeSolution() override;
 
 private:
+    bool wasReadWithStreamingReader = false;
+
+    // Reads the problem in one pass over the memory mapped file without creating a document tree. Throws an exception
+    // if the file cannot be parsed.
+    E_ProblemCreationStatus createProblemStreaming(ProblemPtr& problem, const std::string& filename);
+
+    // Reads the problem from a tinyxml2 document tree of the whole file
+    E_ProblemCreationStatus createProblemFromDocument(ProblemPtr& problem, const std::string& filename);
+
     NonlinearExpressionPtr convertNonlinearNode(tinyxml2::XMLNode* node, const ProblemPtr& destination);
 };
 
@@ -18,6 +18,7 @@
 #include "../DualSolver.h"
 #include "../MIPSolver/IMIPSolver.h"
 
+#include <algorithm>
 #include <functional>
 #include <map>
 
@@ -57,8 +58,8 @@ public:
     }
 };
 
-NLPSolverCuttingPlaneMinimax::NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr, ProblemPtr problem)
-    : INLPSolver(envPtr), sourceProblem(problem)
+NLPSolverCuttingPlaneMinimax::NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr, ProblemPtr problem, bool isMainSolver)
+    : INLPSolver(envPtr), sourceProblem(problem), isMainSolver(isMainSolver)
 {
     auto solver = static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual"));
 
@@ -106,8 +107,6 @@ void NLPSolverCuttingPlaneMinimax::saveProblemToFile([[maybe_unused]] std::strin
 
 E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
 {
-    int numVar = sourceProblem->properties.numberOfVariables;
-
     // Sets the maximal number of iterations
     int maxIter = env->settings->getSetting<int>("ESH.InteriorPoint.CuttingPlane.IterationLimit", "Dual");
     double termObjTolAbs
@@ -137,14 +136,27 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
 
     int numHyperAdded = 0;
     int numHyperTot = 0;
-    bool NaNWarningPrinted = false;
+
+    // The cuts in the starting point give a different first LP solution than without starting point
+    if(startingPoint.size() > 0)
+    {
+        for(auto& C : sourceProblem->nonlinearConstraints)
+        {
+            auto constraintValue = C->calculateNumericValue(startingPoint);
+
+            std::string name = "minimax_start_" + std::to_string(constraintValue.constraint->index);
+
+            if(addCuttingPlane(constraintValue, startingPoint, name))
+                numHyperTot++;
+        }
+    }
 
     for(int i = 0; i <= maxIter; i++)
     {
         boost::uintmax_t maxIterSubsolverTmp = maxIterSubsolver;
 
         // Saves the LP problem to file if in debug mode
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        if(isMainSolver && env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
             std::stringstream ss;
             ss << env->settings->getSetting<std::string>("Debug.Path", "Output");
@@ -156,7 +168,7 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
 
         // Solves the problem and obtains the solution
         auto solStatus = LPSolver->solveProblem();
-        env->solutionStatistics.numberOfProblemsMinimaxLP++;
+        numberOfSolvedLPProblems++;
 
         if(solStatus == E_ProblemSolutionStatus::Infeasible)
         {
@@ -190,7 +202,7 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
         LPObjVar = LPSolver->getObjectiveValue();
 
         // Saves the LP solution to file if in debug mode
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        if(isMainSolver && env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
             std::stringstream ss;
             ss << env->settings->getSetting<std::string>("Debug.Path", "Output");
@@ -211,7 +223,9 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
             currSol = LPVarSol;
             lambda = -1; // For reporting purposes only
             mu = LPObjVar;
-            env->report->outputIterationDetailHeaderMinimax();
+
+            if(isMainSolver)
+                env->report->outputIterationDetailHeaderMinimax();
         }
         else
         {
@@ -235,7 +249,7 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
             maxObjDiffRel = maxObjDiffAbs / ((1e-10) + std::abs(LPObjVar));
 
             // Saves the LP solution to file if in debug mode
-            if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+            if(isMainSolver && env->settings->getSetting<bool>("Debug.Enable", "Output"))
             {
                 std::stringstream ss;
                 ss << env->settings->getSetting<std::string>("Debug.Path", "Output");
@@ -246,8 +260,11 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
             }
         }
 
-        env->report->outputIterationDetailMinimax((i + 1), "LP", env->timing->getElapsedTime("Total"), numHyperAdded,
-            numHyperTot, LPObjVar, mu, maxObjDiffAbs, maxObjDiffRel);
+        if(isMainSolver)
+        {
+            env->report->outputIterationDetailMinimax((i + 1), "LP", env->timing->getElapsedTime("Total"),
+                numHyperAdded, numHyperTot, LPObjVar, mu, maxObjDiffAbs, maxObjDiffRel);
+        }
 
         if(mu < 0 && (maxObjDiffAbs < termObjTolAbs || maxObjDiffRel < termObjTolRel))
         {
@@ -263,77 +280,14 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
 
         for(auto& NCV : constraintValues)
         {
-            // Contains the coefficient and variable index for the terms in the generated cut
-            std::map<int, double> elements;
-
-            double constant = NCV.normalizedValue;
-            auto gradient = NCV.constraint->calculateGradient(currSol, true);
-
-            for(auto& G : gradient)
-            {
-                int variableIndex = G.first->index;
-                double coefficient = G.second;
-
-                auto element = elements.emplace(variableIndex, coefficient);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
-
-                constant = constant - coefficient * currSol.at(variableIndex);
-            }
-
-            // Adding the objective term
-            elements.emplace(numVar, -1.0);
-
-            // Small fix to fix badly scaled cuts.
-            // TODO: this should be made so it also takes into account small/large coefficients of the linear terms
-            if(abs(constant) > 1e15)
-            {
-                double scalingFactor = abs(constant) - 1e15;
-                for(auto& E : elements)
-                    E.second /= scalingFactor;
-
-                constant /= scalingFactor;
-
-                if(!NaNWarningPrinted)
-                {
-                    env->output->outputWarning(
-                        "        Large values found in RHS of cut, you might want to consider reducing the "
-                        "bounds of the nonlinear variables.");
-
-                    NaNWarningPrinted = true;
-                }
-            }
-
-            bool cutHasNoNaNsorInfs = true;
-
-            for(auto& E : elements)
-            {
-                if(E.second != E.second || std::isinf(E.second)) // Check for NaN or inf
-                {
-                    env->output->outputWarning(
-                        fmt::format("        Hyperplane for constraint {}  not generated,  NaN or "
-                                    "inf found in linear terms for {} = {}",
-                            NCV.constraint->name, env->reformulatedProblem->getVariable(E.first)->name,
-                            std::to_string(currSol.at(E.first))));
-
-                    cutHasNoNaNsorInfs = false;
-                }
-            }
-
-            // Adds the linear constraint
-            if(cutHasNoNaNsorInfs
-                && LPSolver->addLinearConstraint(elements, constant,
-                       "minimax_" + std::to_string(NCV.constraint->index) + "_" + std::to_string(numHyperTot))
-                    >= 0)
+            if(addCuttingPlane(NCV, currSol,
+                   "minimax_" + std::to_string(NCV.constraint->index) + "_" + std::to_string(numHyperTot)))
             {
                 numHyperTot++;
                 numHyperAdded++;
 
-                if(mu >= 0 && env->settings->getSetting<bool>("ESH.InteriorPoint.CuttingPlane.Reuse", "Dual")
+                if(isMainSolver && mu >= 0
+                    && env->settings->getSetting<bool>("ESH.InteriorPoint.CuttingPlane.Reuse", "Dual")
                     && NCV.constraint->properties.convexity == E_Convexity::Convex)
                 {
                     auto tmpPoint = currSol;
@@ -385,6 +339,73 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
     return (statusCode);
 }
 
+bool NLPSolverCuttingPlaneMinimax::addCuttingPlane(
+    const NumericConstraintValue& constraintValue, const VectorDouble& point, std::string name)
+{
+    int numVar = sourceProblem->properties.numberOfVariables;
+
+    // Contains the coefficient and variable index for the terms in the generated cut
+    std::map<int, double> elements;
+
+    double constant = constraintValue.normalizedValue;
+    constraintValue.constraint->calculateGradient(point, true, gradient);
+
+    for(auto& G : gradient)
+    {
+        int variableIndex = G.first;
+        double coefficient = G.second;
+
+        auto element = elements.emplace(variableIndex, coefficient);
+
+        if(!element.second)
+        {
+            // Element already exists for the variable
+            element.first->second += coefficient;
+        }
+
+        constant = constant - coefficient * point.at(variableIndex);
+    }
+
+    // Adding the objective term
+    elements.emplace(numVar, -1.0);
+
+    // Small fix to fix badly scaled cuts.
+    // TODO: this should be made so it also takes into account small/large coefficients of the linear terms
+    if(abs(constant) > 1e15)
+    {
+        double scalingFactor = abs(constant) - 1e15;
+        for(auto& E : elements)
+            E.second /= scalingFactor;
+
+        constant /= scalingFactor;
+
+        if(!NaNWarningPrinted)
+        {
+            env->output->outputWarning(
+                "        Large values found in RHS of cut, you might want to consider reducing the "
+                "bounds of the nonlinear variables.");
+
+            NaNWarningPrinted = true;
+        }
+    }
+
+    for(auto& E : elements)
+    {
+        if(E.second != E.second || std::isinf(E.second)) // Check for NaN or inf
+        {
+            env->output->outputWarning(fmt::format("        Hyperplane for constraint {}  not generated,  NaN or "
+                                                   "inf found in linear terms for {} = {}",
+                constraintValue.constraint->name, sourceProblem->getVariable(E.first)->name,
+                std::to_string(point.at(E.first))));
+
+            return (false);
+        }
+    }
+
+    // Adds the linear constraint
+    return (LPSolver->addLinearConstraint(elements, constant, name) >= 0);
+}
+
 double NLPSolverCuttingPlaneMinimax::getSolution(int i) { return (solution.at(i)); }
 
 VectorDouble NLPSolverCuttingPlaneMinimax::getSolution() { return (solution); }
@@ -473,9 +494,19 @@ void NLPSolverCuttingPlaneMinimax::fixVariables(VectorInteger variableIndexes, V
 
 void NLPSolverCuttingPlaneMinimax::unfixVariables() { LPSolver->unfixVariables(); }
 
-void NLPSolverCuttingPlaneMinimax::setStartingPoint(
-    [[maybe_unused]] VectorInteger variableIndexes, [[maybe_unused]] VectorDouble variableValues)
+void NLPSolverCuttingPlaneMinimax::setStartingPoint(VectorInteger variableIndexes, VectorDouble variableValues)
 {
+    // The values not given are taken as close to zero as the bounds allow
+    if(startingPoint.size() == 0)
+    {
+        for(auto& V : sourceProblem->allVariables)
+            startingPoint.push_back(std::clamp(0.0, V->lowerBound, V->upperBound));
+
+        startingPoint.push_back(0.0);
+    }
+
+    for(size_t i = 0; i < variableIndexes.size(); i++)
+        startingPoint.at(variableIndexes.at(i)) = variableValues.at(i);
 }
 
 bool NLPSolverCuttingPlaneMinimax::isObjectiveFunctionNonlinear() { return (false); }
@@ -502,7 +533,7 @@ void NLPSolverCuttingPlaneMinimax::updateVariableUpperBound(int variableIndex, d
     LPSolver->updateVariableUpperBound(variableIndex, bound);
 }
 
-void NLPSolverCuttingPlaneMinimax::clearStartingPoint() { }
+void NLPSolverCuttingPlaneMinimax::clearStartingPoint() { startingPoint.clear(); }
 
 void NLPSolverCuttingPlaneMinimax::saveOptionsToFile([[maybe_unused]] std::string fileName) { }
 } // namespace SHOT
\ No newline at end of file
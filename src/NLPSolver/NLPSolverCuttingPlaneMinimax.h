@@ -32,9 +32,12 @@ namespace SHOT
 class NLPSolverCuttingPlaneMinimax : public NLPSolverBase
 {
 public:
-    NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr, ProblemPtr problem);
+    // When several minimax problems are solved concurrently, only the main solver writes the iteration report and
+    // debug files and reuses its cuts as hyperplanes in the dual problem
+    NLPSolverCuttingPlaneMinimax(EnvironmentPtr envPtr, ProblemPtr problem, bool isMainSolver = true);
     ~NLPSolverCuttingPlaneMinimax() override;
 
+    // The starting point is used for initial cuts, so that the LP problems differ from the ones without starting point
     void setStartingPoint(VectorInteger variableIndexes, VectorDouble variableValues) override;
     void clearStartingPoint() override;
 
@@ -51,11 +54,24 @@ public:
 
     std::string getSolverDescription() override { return ("Built in minmax solver"); };
 
+    // The number of LP problems solved, which is not added to the solution statistics by the solver itself
+    int getNumberOfSolvedLPProblems() { return (numberOfSolvedLPProblems); }
+
 private:
     std::unique_ptr<IMIPSolver> LPSolver;
     ProblemPtr sourceProblem;
     VectorString variableNames;
 
+    bool isMainSolver;
+    int numberOfSolvedLPProblems = 0;
+
+    // Has an element for the minimax objective variable last, like the LP solutions
+    VectorDouble startingPoint;
+
+    // Reused when calculating the gradients for the cuts
+    SparseVariableVector gradient;
+    bool NaNWarningPrinted = false;
+
     double getSolution(int i) override;
     VectorDouble getSolution() override;
     double getObjectiveValue() override;
@@ -72,5 +88,8 @@ private:
     double objectiveValue = NAN;
 
     bool createProblem(IMIPSolver* destinationProblem, ProblemPtr sourceProblem);
+
+    // Adds the linearization of the constraint in the point as a cut for the minimax objective variable
+    bool addCuttingPlane(const NumericConstraintValue& constraintValue, const VectorDouble& point, std::string name);
 };
 } // namespace SHOT
\ No newline at end of file
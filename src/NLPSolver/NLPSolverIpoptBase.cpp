@@ -10,6 +10,7 @@
 
 #include "NLPSolverIpoptBase.h"
 
+#include <algorithm>
 #include <cstdio>
 
 #include "../Output.h"
@@ -91,21 +92,104 @@ void IpoptJournal::FlushBufferImpl()
     env->output->flush();
 }
 
+namespace
+{
+// Sorts the columns in each row of a compressed row structure and removes duplicate columns
+void sortAndCompressRows(std::vector<int>& rowStarts, std::vector<int>& columns)
+{
+    int numberOfNonzeros = 0;
+
+    for(size_t row = 0; row + 1 < rowStarts.size(); row++)
+    {
+        auto rowBegin = columns.begin() + rowStarts[row];
+        auto rowEnd = columns.begin() + rowStarts[row + 1];
+
+        std::sort(rowBegin, rowEnd);
+        rowEnd = std::unique(rowBegin, rowEnd);
+
+        // The row start is overwritten only after it has been read, and the columns are moved backwards
+        rowStarts[row] = numberOfNonzeros;
+
+        for(auto C = rowBegin; C != rowEnd; C++)
+            columns[numberOfNonzeros++] = *C;
+    }
+
+    rowStarts.back() = numberOfNonzeros;
+    columns.resize(numberOfNonzeros);
+}
+
+// Returns the position of an element in a compressed row structure, or -1 if it is not in the structure
+inline int findNonzeroPosition(const std::vector<int>& rowStarts, const std::vector<int>& columns, int row, int column)
+{
+    auto rowBegin = columns.begin() + rowStarts[row];
+    auto rowEnd = columns.begin() + rowStarts[row + 1];
+    auto position = std::lower_bound(rowBegin, rowEnd, column);
+
+    if(position == rowEnd || *position != column)
+        return (-1);
+
+    return (position - columns.begin());
+}
+} // namespace
+
 IpoptProblem::IpoptProblem(EnvironmentPtr envPtr, ProblemPtr problem) : env(envPtr), sourceProblem(problem) {}
 
-bool IpoptProblem::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g, Index& nnz_h_lag, IndexStyleEnum& index_style)
+void IpoptProblem::initializeSparsityStructures()
 {
-    n = sourceProblem->properties.numberOfVariables;
-    m = sourceProblem->properties.numberOfNumericConstraints;
+    if(areSparsityStructuresInitialized)
+        return;
+
+    int numberOfConstraints = sourceProblem->numericConstraints.size();
+
+    jacobianRowStarts.assign(numberOfConstraints + 1, 0);
+    jacobianColumns.clear();
+
+    for(int i = 0; i < numberOfConstraints; i++)
+    {
+        assert(sourceProblem->numericConstraints[i]->index == i);
 
-    nnz_jac_g = 0;
+        for(auto& V : *sourceProblem->numericConstraints[i]->getGradientSparsityPattern())
+            jacobianColumns.push_back(V->index);
 
-    for(auto& E : *sourceProblem->getConstraintsJacobianSparsityPattern())
+        jacobianRowStarts[i + 1] = jacobianColumns.size();
+    }
+
+    sortAndCompressRows(jacobianRowStarts, jacobianColumns);
+
+    // The Hessian pattern contains the upper triangular part, and the elements are placed in their rows
+    auto hessianPattern = sourceProblem->getLagrangianHessianSparsityPattern();
+
+    lagrangianHessianRowStarts.assign(sourceProblem->properties.numberOfVariables + 1, 0);
+    lagrangianHessianColumns.resize(hessianPattern->size());
+
+    for(auto& E : *hessianPattern)
     {
-        nnz_jac_g += E.second.size();
+        assert(E.first->index <= E.second->index);
+        lagrangianHessianRowStarts[E.first->index + 1]++;
     }
 
-    nnz_h_lag = sourceProblem->getLagrangianHessianSparsityPattern()->size();
+    for(size_t i = 1; i < lagrangianHessianRowStarts.size(); i++)
+        lagrangianHessianRowStarts[i] += lagrangianHessianRowStarts[i - 1];
+
+    std::vector<int> nextPositions(lagrangianHessianRowStarts.begin(), lagrangianHessianRowStarts.end() - 1);
+
+    for(auto& E : *hessianPattern)
+        lagrangianHessianColumns[nextPositions[E.first->index]++] = E.second->index;
+
+    sortAndCompressRows(lagrangianHessianRowStarts, lagrangianHessianColumns);
+
+    areSparsityStructuresInitialized = true;
+}
+
+bool IpoptProblem::get_nlp_info(Index& n, Index& m, Index& nnz_jac_g, Index& nnz_h_lag, IndexStyleEnum& index_style)
+{
+    initializeSparsityStructures();
+
+    n = sourceProblem->properties.numberOfVariables;
+    m = sourceProblem->properties.numberOfNumericConstraints;
+
+    nnz_jac_g = jacobianColumns.size();
+    nnz_h_lag = lagrangianHessianColumns.size();
 
     // use the C style indexing (0-based)
     index_style = TNLP::C_STYLE;
@@ -128,7 +212,7 @@ bool IpoptProblem::get_bounds_info(Index n, Number* x_l, Number* x_u, Index m, N
 
     for(int i = 0; i < m; i++)
     {
-        auto constraint = std::dynamic_pointer_cast<NumericConstraint>(sourceProblem->getConstraint(i));
+        auto& constraint = sourceProblem->numericConstraints[i];
 
         g_l[i] = constraint->valueLHS;
         g_u[i] = constraint->valueRHS;
@@ -192,13 +276,26 @@ bool IpoptProblem::get_list_of_nonlinear_variables(
 }
 
 // returns the initial point for the problem
-bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[maybe_unused]] Number* x,
-    [[maybe_unused]] bool init_z, [[maybe_unused]] Number* z_L, [[maybe_unused]] Number* z_U, [[maybe_unused]] Index m,
-    [[maybe_unused]] bool init_lambda, [[maybe_unused]] Number* lambda)
+bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, Number* x, bool init_z, Number* z_L,
+    Number* z_U, Index m, bool init_lambda, Number* lambda)
 {
     assert(init_x == true);
-    assert(init_z == false);
-    assert(init_lambda == false);
+
+    // The multipliers are only requested when warm starting, which is done if there are multipliers
+    if(init_z)
+    {
+        for(int k = 0; k < n; k++)
+        {
+            z_L[k] = hasMultipliers ? lowerBoundMultipliers[k] : 0.0;
+            z_U[k] = hasMultipliers ? upperBoundMultipliers[k] : 0.0;
+        }
+    }
+
+    if(init_lambda)
+    {
+        for(int k = 0; k < m; k++)
+            lambda[k] = hasMultipliers ? constraintMultipliers[k] : 0.0;
+    }
 
     std::vector<bool> isInitialized(n, false);
 
@@ -302,12 +399,9 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
 // Returns the value of the objective function
 bool IpoptProblem::eval_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number& obj_value)
 {
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    currentPoint.assign(x, x + n);
 
-    obj_value = sourceProblem->objectiveFunction->calculateValue(vectorPoint);
+    obj_value = sourceProblem->objectiveFunction->calculateValue(currentPoint);
 
     return (true);
 }
@@ -315,16 +409,15 @@ bool IpoptProblem::eval_f(Index n, const Number* x, [[maybe_unused]] bool new_x,
 // Returns the gradient of the objective function
 bool IpoptProblem::eval_grad_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number* grad_f)
 {
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    currentPoint.assign(x, x + n);
 
     for(int i = 0; i < n; i++)
         grad_f[i] = 0.0;
 
-    for(auto& G : sourceProblem->objectiveFunction->calculateGradient(vectorPoint, false))
-        grad_f[G.first->index] = G.second;
+    sourceProblem->objectiveFunction->calculateGradient(currentPoint, false, gradientStorage);
+
+    for(auto& G : gradientStorage)
+        grad_f[G.first] = G.second;
 
     return (true);
 }
@@ -332,45 +425,35 @@ bool IpoptProblem::eval_grad_f(Index n, const Number* x, [[maybe_unused]] bool n
 // Return the value of the constraints
 bool IpoptProblem::eval_g(Index n, const Number* x, [[maybe_unused]] bool new_x, Index m, Number* g)
 {
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    currentPoint.assign(x, x + n);
 
     for(int i = 0; i < m; i++)
         g[i] = 0.0;
 
     for(int i = 0; i < m; i++)
-        g[i] = sourceProblem->numericConstraints[i]->calculateFunctionValue(vectorPoint);
+        g[i] = sourceProblem->numericConstraints[i]->calculateFunctionValue(currentPoint);
 
     return (true);
 }
 
 // Return the structure or values of the jacobian
-bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool new_x, [[maybe_unused]] Index m,
-    Index nele_jac, Index* iRow, Index* jCol, Number* values)
+bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool new_x, Index m, Index nele_jac,
+    Index* iRow, Index* jCol, Number* values)
 {
+    initializeSparsityStructures();
+
     // The structure
     if(values == nullptr)
     {
-        int counter = 0;
+        assert(nele_jac == (Index)jacobianColumns.size());
 
-        jacobianCounterPlacement.clear();
-
-        for(auto& C : sourceProblem->numericConstraints)
+        for(int i = 0; i < m; i++)
         {
-            auto jacobian = C->getGradientSparsityPattern();
-
-            for(auto& G : *jacobian)
+            for(int k = jacobianRowStarts[i]; k < jacobianRowStarts[i + 1]; k++)
             {
-                iRow[counter] = C->index;
-                jCol[counter] = G->index;
-
-                jacobianCounterPlacement.emplace(std::make_pair(C->index, G->index), counter);
-                counter++;
+                iRow[k] = i;
+                jCol[k] = jacobianColumns[k];
             }
-
-            assert(counter <= nele_jac);
         }
 
         return (true);
@@ -378,26 +461,24 @@ bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool ne
 
     // The values
 
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    currentPoint.assign(x, x + n);
 
     for(int i = 0; i < nele_jac; i++)
         values[i] = 0.0;
 
     for(auto& C : sourceProblem->numericConstraints)
     {
-        auto jacobian = C->calculateGradient(vectorPoint, false);
+        C->calculateGradient(currentPoint, false, gradientStorage);
 
-        for(auto& G : jacobian)
+        for(auto& G : gradientStorage)
         {
-            int location = jacobianCounterPlacement[std::make_pair(C->index, G.first->index)];
+            int location = findNonzeroPosition(jacobianRowStarts, jacobianColumns, C->index, G.first);
 
-            values[location] += G.second;
-
-            assert(location < nele_jac);
             assert(location >= 0);
+            assert(location < nele_jac);
+
+            if(location >= 0)
+                values[location] += G.second;
         }
     }
 
@@ -405,26 +486,23 @@ bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool ne
 }
 
 // Return the structure or values of the Hessian of the Langragian
-bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x, Number obj_factor,
-    [[maybe_unused]] Index m, const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow,
-    Index* jCol, Number* values)
+bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x, Number obj_factor, Index m,
+    const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow, Index* jCol, Number* values)
 {
+    initializeSparsityStructures();
+
     // The structure
     if(values == nullptr)
     {
-        int counter = 0;
-        lagrangianHessianCounterPlacement.clear();
+        assert(nele_hess == (Index)lagrangianHessianColumns.size());
 
-        for(auto& E : *sourceProblem->getLagrangianHessianSparsityPattern())
+        for(int i = 0; i < n; i++)
         {
-            assert(E.first->index <= E.second->index);
-
-            iRow[counter] = E.first->index;
-            jCol[counter] = E.second->index;
-
-            lagrangianHessianCounterPlacement.emplace(std::make_pair(E.first->index, E.second->index), counter);
-
-            counter++;
+            for(int k = lagrangianHessianRowStarts[i]; k < lagrangianHessianRowStarts[i + 1]; k++)
+            {
+                iRow[k] = i;
+                jCol[k] = lagrangianHessianColumns[k];
+            }
         }
 
         return (true);
@@ -432,46 +510,26 @@ bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x,
 
     // The values
 
-    VectorDouble vectorPoint(n);
-
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    currentPoint.assign(x, x + n);
 
     for(int i = 0; i < nele_hess; i++)
         values[i] = 0.0;
 
-    if(obj_factor != 0.0)
-    {
-        for(auto& E : sourceProblem->objectiveFunction->calculateHessian(vectorPoint, false))
-        {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
-
-            assert(location < nele_hess);
-            assert(location >= 0);
+    lagrangianMultipliers.assign(lambda, lambda + m);
 
-            values[location] = obj_factor * E.second;
-        }
-    }
+    // All nonlinear expressions are evaluated in one weighted sweep
+    sourceProblem->calculateLagrangianHessian(currentPoint, obj_factor, lagrangianMultipliers, false, hessianStorage);
 
-    for(auto& C : sourceProblem->numericConstraints)
+    for(auto& E : hessianStorage)
     {
-        if(C->properties.classification == E_ConstraintClassification::Linear)
-            continue;
-
-        if(lambda[C->index] == 0.0)
-            continue;
-
-        for(auto& E : C->calculateHessian(vectorPoint, false))
-        {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
+        int location = findNonzeroPosition(
+            lagrangianHessianRowStarts, lagrangianHessianColumns, E.first.first, E.first.second);
 
-            assert(location < nele_hess);
-            assert(location >= 0);
+        assert(location >= 0);
+        assert(location < nele_hess);
 
-            values[location] += lambda[C->index] * E.second;
-        }
+        if(location >= 0)
+            values[location] = E.second;
     }
 
     return (true);
@@ -489,13 +547,22 @@ bool IpoptProblem::get_scaling_parameters(Number& obj_scaling, [[maybe_unused]]
     return (true);
 }
 
-void IpoptProblem::finalize_solution(SolverReturn status, [[maybe_unused]] Index n, const Number* x,
-    [[maybe_unused]] const Number* z_L, [[maybe_unused]] const Number* z_U, [[maybe_unused]] Index m,
-    [[maybe_unused]] const Number* g, [[maybe_unused]] const Number* lambda, Number obj_value,
+void IpoptProblem::finalize_solution(SolverReturn status, Index n, const Number* x, const Number* z_L,
+    const Number* z_U, Index m, [[maybe_unused]] const Number* g, const Number* lambda, Number obj_value,
     [[maybe_unused]] const IpoptData* ip_data, [[maybe_unused]] IpoptCalculatedQuantities* ip_cq)
 {
     int numberOfVariables = sourceProblem->properties.numberOfVariables;
 
+    hasMultipliers = (status == SUCCESS || status == STOP_AT_ACCEPTABLE_POINT) && z_L != nullptr && z_U != nullptr
+        && lambda != nullptr;
+
+    if(hasMultipliers)
+    {
+        lowerBoundMultipliers.assign(z_L, z_L + n);
+        upperBoundMultipliers.assign(z_U, z_U + n);
+        constraintMultipliers.assign(lambda, lambda + m);
+    }
+
     switch(status)
     {
     case SUCCESS:
@@ -702,14 +769,26 @@ E_NLPSolutionStatus NLPSolverIpoptBase::solveProblemInstance()
     {
         Ipopt::ApplicationReturnStatus ipoptStatus;
 
-        if(!hasBeenSolved)
+        // The multipliers of the previous solution are a good starting point, since the problems solved in sequence
+        // usually only differ in the bounds of the fixed variables
+        bool useWarmStart = env->settings->getSetting<bool>("Ipopt.WarmStart", "Subsolver");
+
+        ipoptApplication->Options()->SetStringValue(
+            "warm_start_init_point", (useWarmStart && ipoptProblem->hasMultipliers) ? "yes" : "no");
+
+        if(!useWarmStart || !hasBeenSolved)
         {
             ipoptStatus = ipoptApplication->OptimizeTNLP(ipoptProblem);
+
+            // The data structures can only be reused if the algorithm was started, i.e. not if there is an error in
+            // the problem definition or the options
+            hasBeenSolved = (ipoptStatus > Ipopt::ApplicationReturnStatus::Not_Enough_Degrees_Of_Freedom);
         }
         else
         {
+            // Reuses the data structures created by Ipopt in the first solve, since the structure is the same. This is
+            // only done when warm starting, so that each problem is otherwise solved from scratch.
             ipoptStatus = ipoptApplication->ReOptimizeTNLP(ipoptProblem);
-            hasBeenSolved = true;
         }
 
         switch(ipoptStatus)
@@ -900,7 +979,6 @@ void NLPSolverIpoptBase::setInitialSettings()
     ipoptApplication->Options()->SetStringValue("ma86_order", "auto", true, true);
     ipoptApplication->Options()->SetStringValue("mu_oracle", "probing", true, true);
     ipoptApplication->Options()->SetStringValue("expect_infeasible_problem", "yes", true, true);
-    // ipoptApplication->Options()->SetStringValue("warm_start_init_point", "yes", true, true);
     ipoptApplication->Options()->SetNumericValue("gamma_phi", 1e-8, true, true);
     ipoptApplication->Options()->SetNumericValue("gamma_theta", 1e-4, true, true);
     ipoptApplication->Options()->SetNumericValue("required_infeasibility_reduction", 0.1, true, true);
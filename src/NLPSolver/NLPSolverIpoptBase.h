@@ -69,6 +69,12 @@ public:
 
     double divergingIterativesTolerance = 1e20;
 
+    // The multipliers of the latest solution satisfying the tolerances, used to warm start the next solve
+    bool hasMultipliers = false;
+    VectorDouble lowerBoundMultipliers;
+    VectorDouble upperBoundMultipliers;
+    VectorDouble constraintMultipliers;
+
     /** the IpoptProblemclass constructor */
     IpoptProblem(EnvironmentPtr envPtr, ProblemPtr problem);
     ~IpoptProblem() override = default;
@@ -136,8 +142,24 @@ private:
 
     ProblemPtr sourceProblem;
 
-    std::map<std::pair<int, int>, int> lagrangianHessianCounterPlacement;
-    std::map<std::pair<int, int>, int> jacobianCounterPlacement;
+    // The structures of the Jacobian and the Hessian of the Lagrangian in compressed row form with sorted columns in
+    // each row. The position of a nonzero in these is its position in the values given to Ipopt. They are only created
+    // once, since the structure does not change between solves, e.g. when variables are fixed.
+    void initializeSparsityStructures();
+
+    bool areSparsityStructuresInitialized = false;
+
+    std::vector<int> jacobianRowStarts;
+    std::vector<int> jacobianColumns;
+
+    std::vector<int> lagrangianHessianRowStarts;
+    std::vector<int> lagrangianHessianColumns;
+
+    // Reused between the evaluation calls to avoid allocations
+    VectorDouble currentPoint;
+    SparseVariableVector gradientStorage;
+    SparseVariableMatrix hessianStorage;
+    VectorDouble lagrangianMultipliers;
 };
 
 class NLPSolverIpoptBase : virtual public INLPSolver
@@ -34,6 +34,24 @@ public:
     void outputDebug(std::string message);
     void outputTrace(std::string message);
 
+    // Outputs a message in fmt format, e.g. outputDebug(" Added {} cuts.", number). The message is only formatted if
+    // the log level is enabled, so this should be used instead of formatting the message before calling outputDebug.
+    template <typename T, typename... Args>
+    void outputDebug(spdlog::string_view_t format, const T& argument, const Args&... arguments)
+    {
+        logger->debug(format, argument, arguments...);
+    }
+
+    // As outputDebug, but trace messages are only output in debug builds
+    template <typename T, typename... Args>
+    void outputTrace([[maybe_unused]] spdlog::string_view_t format, [[maybe_unused]] const T& argument,
+        [[maybe_unused]] const Args&... arguments)
+    {
+#ifndef NDEBUG
+        logger->trace(format, argument, arguments...);
+#endif
+    }
+
     void setLogLevels(E_LogLevel consoleLogLevel, E_LogLevel fileLogLevel);
 
     void setConsoleSink(std::shared_ptr<spdlog::sinks::sink> newSink);
@@ -46,7 +64,7 @@ public:
 
 private:
     std::shared_ptr<spdlog::sinks::sink> consoleSink;
-    std::shared_ptr<spdlog::sinks::basic_file_sink_st> fileSink;
+    std::shared_ptr<spdlog::sinks::basic_file_sink_mt> fileSink;
 
     std::shared_ptr<spdlog::logger> logger;
 };
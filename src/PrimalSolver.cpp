@@ -73,19 +73,48 @@ void PrimalSolver::addPrimalSolutionCandidate(SolutionPoint pt, E_PrimalSolution
 
 void PrimalSolver::addPrimalSolutionCandidates(std::vector<SolutionPoint> pts, E_PrimalSolutionSource source)
 {
+    // All points are checked together, so that the constraints can be evaluated in all of them at once
     for(auto& PT : pts)
     {
-        addPrimalSolutionCandidate(PT, source);
+        PrimalSolution sol;
+
+        sol.point = PT.point;
+        sol.sourceType = source;
+        sol.objValue = PT.objectiveValue;
+        sol.iterFound = PT.iterFound;
+
+        env->primalSolver->primalSolutionCandidates.push_back(sol);
     }
+
+    this->checkPrimalSolutionCandidates();
 }
 
 void PrimalSolver::checkPrimalSolutionCandidates()
 {
     env->timing->startTimer("PrimalStrategy");
 
-    for(auto& cand : env->primalSolver->primalSolutionCandidates)
+    auto& candidates = env->primalSolver->primalSolutionCandidates;
+
+    // The nonlinear constraints are evaluated in all candidates at once if there are several of them
+    NumericConstraintValues maxNonlinearConstraintValues;
+
+    if(candidates.size() > 1 && env->problem->properties.numberOfNonlinearConstraints > 0)
     {
-        this->checkPrimalSolutionPoint(cand);
+        PointBatch points(env->problem->properties.numberOfVariables, candidates.size());
+
+        for(size_t i = 0; i < candidates.size(); i++)
+            points.setPoint(i, candidates[i].point);
+
+        maxNonlinearConstraintValues
+            = env->problem->getMaxNumericConstraintValues(points, env->problem->nonlinearConstraints);
+    }
+
+    for(size_t i = 0; i < candidates.size(); i++)
+    {
+        if(i < maxNonlinearConstraintValues.size())
+            this->checkPrimalSolutionPoint(candidates[i], maxNonlinearConstraintValues[i]);
+        else
+            this->checkPrimalSolutionPoint(candidates[i]);
     }
 
     env->primalSolver->primalSolutionCandidates.clear();
@@ -93,7 +122,8 @@ void PrimalSolver::checkPrimalSolutionCandidates()
     env->timing->stopTimer("PrimalStrategy");
 }
 
-bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
+bool PrimalSolver::checkPrimalSolutionPoint(
+    PrimalSolution primalSol, std::optional<NumericConstraintValue> maxNonlinearConstraintValue)
 {
     std::string sourceDesc;
 
@@ -129,8 +159,8 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         break;
     }
 
-    env->output->outputDebug(fmt::format(
-        "        Checking primal solution point with objective value {} from {}.", primalSol.objValue, sourceDesc));
+    env->output->outputDebug("        Checking primal solution point with objective value {} from {}.",
+        primalSol.objValue, sourceDesc);
 
     primalSol.sourceDescription = sourceDesc;
 
@@ -268,14 +298,12 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
             reCalculateObjective = true;
             tmpPoint = ptRounded;
 
-            auto tmpLine = fmt::format(
+            env->output->outputDebug(
                 "         Discrete variables were not fulfilled to tolerance {}. Rounding performed...", integerTol);
-            env->output->outputDebug(tmpLine);
         }
         else
         {
-            auto tmpLine = fmt::format("         All discrete variables are fulfilled to tolerance {}.", integerTol);
-            env->output->outputDebug(tmpLine);
+            env->output->outputDebug("         All discrete variables are fulfilled to tolerance {}.", integerTol);
         }
 
         primalSol.integerRoundingPerformed = isRounded;
@@ -316,17 +344,15 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
 
             if(maxLinearConstraintValue.error > linTol)
             {
-                auto tmpLine = fmt::format("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
+                env->output->outputDebug("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
                     maxLinearConstraintValue.constraint->index, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
 
                 return (false);
             }
             else
             {
-                auto tmpLine = fmt::format("         Linear constraints are fulfilled. Most deviating {}: {} > {}.",
+                env->output->outputDebug("         Linear constraints are fulfilled. Most deviating {}: {} > {}.",
                     maxLinearConstraintValue.constraint->index, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
             }
         }
 
@@ -348,17 +374,15 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
 
         if(mostDevQuadraticConstraints.value > nonlinTol)
         {
-            auto tmpLine = fmt::format("         Quadratic constraints are not fulfilled. Most deviating {}: {} > {}.",
+            env->output->outputDebug("         Quadratic constraints are not fulfilled. Most deviating {}: {} > {}.",
                 maxQuadraticConstraintValue.constraint->index, maxQuadraticConstraintValue.error, nonlinTol);
-            env->output->outputDebug(tmpLine);
 
             return (false);
         }
         else
         {
-            auto tmpLine = fmt::format("         Quadratic constraints are fulfilled. Most deviating {}: {} > {}.",
+            env->output->outputDebug("         Quadratic constraints are fulfilled. Most deviating {}: {} > {}.",
                 maxQuadraticConstraintValue.constraint->index, maxQuadraticConstraintValue.error, nonlinTol);
-            env->output->outputDebug(tmpLine);
         }
 
         primalSol.maxDevatingConstraintQuadratic = mostDevQuadraticConstraints;
@@ -369,27 +393,29 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
     {
         PairIndexValue mostDevNonlinearConstraints;
 
-        auto maxNonlinearConstraintValue
-            = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->nonlinearConstraints);
+        // The given value is not valid if the point has been projected or rounded
+        if(!maxNonlinearConstraintValue || reCalculateObjective)
+        {
+            maxNonlinearConstraintValue
+                = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->nonlinearConstraints);
+        }
 
-        mostDevNonlinearConstraints.index = maxNonlinearConstraintValue.constraint->index;
-        mostDevNonlinearConstraints.value = maxNonlinearConstraintValue.normalizedValue;
+        mostDevNonlinearConstraints.index = maxNonlinearConstraintValue->constraint->index;
+        mostDevNonlinearConstraints.value = maxNonlinearConstraintValue->normalizedValue;
 
         auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
 
         if(mostDevNonlinearConstraints.value > nonlinTol)
         {
-            auto tmpLine = fmt::format("         Nonlinear constraints are not fulfilled. Most deviating {}: {} > {}.",
-                maxNonlinearConstraintValue.constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            env->output->outputDebug("         Nonlinear constraints are not fulfilled. Most deviating {}: {} > {}.",
+                maxNonlinearConstraintValue->constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
 
             return (false);
         }
         else
         {
-            auto tmpLine = fmt::format("         Nonlinear constraints are fulfilled. Most deviating {}: {} > {}.",
-                maxNonlinearConstraintValue.constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
-            env->output->outputDebug(tmpLine);
+            env->output->outputDebug("         Nonlinear constraints are fulfilled. Most deviating {}: {} > {}.",
+                maxNonlinearConstraintValue->constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
         }
 
         primalSol.maxDevatingConstraintNonlinear = mostDevNonlinearConstraints;
@@ -454,21 +480,26 @@ void PrimalSolver::addFixedNLPCandidate(
             PrimalFixedNLPCandidate { candidate, source, objVal, iter, maxConstrDev, pointHash });
     }
     else
-        env->output->outputDebug(
-            fmt::format("        Candidate for fixed integer search with hash {} has been used already.", pointHash));
+        env->output->outputDebug("        Candidate for fixed integer search with hash {} has been used already.",
+            pointHash);
 }
 
 bool PrimalSolver::hasFixedNLPCandidateBeenTested(double hash)
 {
-    for(auto& IC : usedPrimalNLPCandidates)
-    {
-        if(Utilities::isAlmostEqual(IC.discreteVariablePointHash, hash, 1e-8))
-        {
-            return (true);
-        }
-    }
+    bool found = usedPrimalNLPCandidateIndex.contains(0, hash, env->solutionStatistics.numberOfHashIndexCollisions);
+
+    if(found)
+        env->solutionStatistics.numberOfHashIndexHits++;
+    else
+        env->solutionStatistics.numberOfHashIndexMisses++;
 
-    return (false);
+    return (found);
+}
+
+void PrimalSolver::addUsedFixedNLPCandidate(const PrimalFixedNLPCandidate& candidate)
+{
+    usedPrimalNLPCandidates.push_back(candidate);
+    usedPrimalNLPCandidateIndex.add(0, candidate.discreteVariablePointHash);
 }
 
 } // namespace SHOT
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include "Environment.h"
 #include "Enums.h"
 #include "Structs.h"
+#include "Utilities.h"
+#include "Model/Constraints.h"
+
+#include <optional>
 
 namespace SHOT
 {
@@ -35,19 +39,28 @@ public:
 
     void checkPrimalSolutionCandidates();
 
-    bool checkPrimalSolutionPoint(PrimalSolution primalSol);
+    // The maximum nonlinear constraint value can be given if it has already been calculated for the point
+    bool checkPrimalSolutionPoint(PrimalSolution primalSol,
+        std::optional<NumericConstraintValue> maxNonlinearConstraintValue = std::nullopt);
 
     void addFixedNLPCandidate(
         VectorDouble pt, E_PrimalNLPSource source, double objVal, int iter, PairIndexValue maxConstrDev);
 
     bool hasFixedNLPCandidateBeenTested(double hash);
+    void addUsedFixedNLPCandidate(const PrimalFixedNLPCandidate& candidate);
 
     std::vector<PrimalSolution> primalSolutionCandidates;
     std::vector<PrimalFixedNLPCandidate> fixedPrimalNLPCandidates;
     std::vector<PrimalFixedNLPCandidate> usedPrimalNLPCandidates;
 
+    // The workers solving fixed NLP problems asynchronously, shared by the tasks for the original and the reformulated
+    // problem and kept as long as one of them exists
+    std::weak_ptr<Utilities::BackgroundWorkers> fixedNLPWorkers;
+
 private:
     EnvironmentPtr env;
+
+    Utilities::HashIndex usedPrimalNLPCandidateIndex;
 };
 
 } // namespace SHOT
\ No newline at end of file
@@ -168,6 +168,18 @@ void Report::outputIterationDetail(int iterationNumber, std::string iterationDes
             env->output->outputDebug(fmt::format("        Explored nodes: {}. Open nodes: {}.",
                 env->solutionStatistics.numberOfExploredNodes, env->results->getCurrentIteration()->numberOfOpenNodes));
         }
+
+        if(env->results->getCurrentIteration()->numberOfDeactivatedPoolCuts > 0
+            || env->results->getCurrentIteration()->numberOfActivatedPoolCuts > 0
+            || env->results->getCurrentIteration()->numberOfDeletedPoolCuts > 0)
+        {
+            env->output->outputInfo(
+                fmt::format("        Cut pool: {} active cuts, {} removed, {} added again and {} deleted.",
+                    env->results->getCurrentIteration()->numberOfActivePoolCuts,
+                    env->results->getCurrentIteration()->numberOfDeactivatedPoolCuts,
+                    env->results->getCurrentIteration()->numberOfActivatedPoolCuts,
+                    env->results->getCurrentIteration()->numberOfDeletedPoolCuts));
+        }
     }
     catch(...)
     {
@@ -1153,6 +1165,18 @@ void Report::outputSolutionReport()
         env->output->outputInfo("");
     }
 
+    if(env->solutionStatistics.numberOfHashIndexHits + env->solutionStatistics.numberOfHashIndexMisses > 0)
+    {
+        env->output->outputDebug(" Duplicate checks of cuts and fixed NLP candidates:");
+        env->output->outputDebug(fmt::format(
+            " - duplicates found:                             {}", env->solutionStatistics.numberOfHashIndexHits));
+        env->output->outputDebug(fmt::format(
+            " - no duplicates found:                          {}", env->solutionStatistics.numberOfHashIndexMisses));
+        env->output->outputDebug(fmt::format(" - compared values not equal:                    {}",
+            env->solutionStatistics.numberOfHashIndexCollisions));
+        env->output->outputDebug("");
+    }
+
     if(env->results->hasPrimalSolution())
     {
         env->output->outputInfo(fmt::format(
@@ -1202,6 +1226,25 @@ void Report::outputSolutionReport()
         if(elapsed > 0)
             env->output->outputInfo(fmt::format(" {:<48}{:g}", T.description + ':', elapsed));
     }
+
+    bool histogramHeaderPrinted = false;
+
+    for(auto& H : env->timing->histograms)
+    {
+        if(H.getCount() == 0)
+            continue;
+
+        if(!histogramHeaderPrinted)
+        {
+            env->output->outputInfo("");
+            env->output->outputInfo(fmt::format(" {:<48}{:>10}{:>12}{:>12}{:>12}", "Durations of", "count", "p50",
+                "p95", "max"));
+            histogramHeaderPrinted = true;
+        }
+
+        env->output->outputInfo(fmt::format(" {:<48}{:>10d}{:>12.3g}{:>12.3g}{:>12.3g}", " - " + H.description + ':',
+            H.getCount(), H.getQuantile(0.5), H.getQuantile(0.95), H.getMax()));
+    }
 }
 
 void Report::outputInteriorPointPreReport()
@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <tuple>
 
 #include "EventHandler.h"
 #include "Iteration.h"
@@ -233,6 +234,7 @@ Results::Results(EnvironmentPtr envPtr) : env(envPtr) { }
 Results::~Results()
 {
     iterations.clear();
+    removedIterationSummaries.clear();
     primalSolution.clear();
     primalSolutions.clear();
     dualSolutions.clear();
@@ -288,7 +290,8 @@ std::string Results::getResultsOSrL()
 
     otherNode = osrlDocument.NewElement("other");
     otherNode->SetAttribute("name", "MaxConstraintError");
-    otherNode->SetAttribute("value", getCurrentIteration()->maxDeviation);
+    otherNode->SetAttribute(
+        "value", (numberOfIterations > 0) ? getIterationSummary(numberOfIterations).maxDeviation : SHOT_DBL_MAX);
     otherNode->SetAttribute("description", "The maximal constraint error");
     otherResultsNode->InsertEndChild(otherNode);
 
@@ -477,6 +480,28 @@ std::string Results::getResultsOSrL()
         otherResultsNode->InsertEndChild(otherNode);
     }
 
+    for(auto& H : env->timing->histograms)
+    {
+        if(H.getCount() == 0)
+            continue;
+
+        std::vector<std::tuple<std::string, double, std::string>> statistics
+            = { { "Count", (double)H.getCount(), "The number of " + H.description },
+                  { "P50", H.getQuantile(0.5), "The median duration in seconds of " + H.description },
+                  { "P95", H.getQuantile(0.95), "The 95th percentile of the durations in seconds of " + H.description },
+                  { "Max", H.getMax(), "The maximal duration in seconds of " + H.description },
+                  { "Total", H.getTotal(), "The total duration in seconds of " + H.description } };
+
+        for(auto& [suffix, value, description] : statistics)
+        {
+            otherNode = osrlDocument.NewElement("other");
+            otherNode->SetAttribute("name", ("Durations" + H.name + suffix).c_str());
+            otherNode->SetAttribute("value", value);
+            otherNode->SetAttribute("description", description.c_str());
+            otherResultsNode->InsertEndChild(otherNode);
+        }
+    }
+
     generalNode->InsertFirstChild(otherResultsNode);
 
     osrlNode->InsertFirstChild(generalNode);
@@ -1038,14 +1063,37 @@ std::string Results::getResultsSol()
     return (ss.str());
 }
 
-void Results::createIteration() { iterations.push_back(std::make_shared<Iteration>(env)); }
+void Results::createIteration()
+{
+    iterations.push_back(std::make_shared<Iteration>(env));
+    numberOfIterations++;
+
+    // The previous iteration is always kept, since many tasks need it
+    int historySize = env->settings->getSetting<int>("IterationHistory.Size", "Output");
+
+    if(historySize == 0)
+        return;
+
+    historySize = std::max(2, historySize);
+
+    while((int)iterations.size() > historySize)
+    {
+        auto& iteration = iterations.front();
+
+        if(iteration->solutionPoints.size() > 0)
+            lastRemovedFeasibleIteration = iteration;
+
+        removedIterationSummaries.push_back(iteration->getSummary());
+        iterations.pop_front();
+    }
+}
 
 IterationPtr Results::getCurrentIteration() { return (iterations.back()); }
 
 IterationPtr Results::getPreviousIteration()
 {
     if(getNumberOfIterations() > 1)
-        return (iterations[getNumberOfIterations() - 2]);
+        return (iterations[iterations.size() - 2]);
     else
         throw Exception("Only one iteration!");
 }
@@ -1063,10 +1111,45 @@ std::optional<IterationPtr> Results::getLastFeasibleIteration()
         }
     }
 
+    if(!iteration && lastRemovedFeasibleIteration)
+        iteration = lastRemovedFeasibleIteration;
+
     return iteration;
 }
 
-int Results::getNumberOfIterations() { return (iterations.size()); }
+int Results::getNumberOfIterations() { return (numberOfIterations); }
+
+std::optional<IterationPtr> Results::getIteration(int iterationNumber)
+{
+    // The iteration numbers in the history are consecutive and end with the current iteration
+    int index = iterationNumber - (numberOfIterations - (int)iterations.size()) - 1;
+
+    if(index < 0 || index >= (int)iterations.size())
+        return (std::nullopt);
+
+    return (iterations[index]);
+}
+
+IterationSummary Results::getIterationSummary(int iterationNumber)
+{
+    if(iterationNumber < 1 || iterationNumber > numberOfIterations)
+        throw Exception("Iteration " + std::to_string(iterationNumber) + " does not exist!");
+
+    if(iterationNumber <= (int)removedIterationSummaries.size())
+        return (removedIterationSummaries[iterationNumber - 1]);
+
+    return (getIteration(iterationNumber).value()->getSummary());
+}
+
+std::vector<IterationSummary> Results::getIterationSummaries()
+{
+    auto summaries = removedIterationSummaries;
+
+    for(auto& I : iterations)
+        summaries.push_back(I->getSummary());
+
+    return (summaries);
+}
 
 double Results::getPrimalBound()
 {
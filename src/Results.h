@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <vector>
@@ -68,9 +69,21 @@ public:
     IterationPtr getCurrentIteration();
     IterationPtr getPreviousIteration();
     std::optional<IterationPtr> getLastFeasibleIteration();
-    std::vector<IterationPtr> iterations;
+
+    // The most recent iterations, at most Output.IterationHistory.Size of them. Only summaries are kept of the older
+    // iterations.
+    std::deque<IterationPtr> iterations;
+
+    // The number of iterations created, also those no longer in the iteration history
     int getNumberOfIterations();
 
+    // Returns the iteration with the given number if it is still in the iteration history
+    std::optional<IterationPtr> getIteration(int iterationNumber);
+
+    // The summaries are available for all iterations
+    IterationSummary getIterationSummary(int iterationNumber);
+    std::vector<IterationSummary> getIterationSummaries();
+
     E_TerminationReason terminationReason = E_TerminationReason::None;
     std::string terminationReasonDescription;
 
@@ -99,6 +112,14 @@ public:
 
 private:
     EnvironmentPtr env;
+
+    int numberOfIterations = 0;
+
+    // The summaries of the iterations removed from the iteration history, ordered by the iteration number
+    std::vector<IterationSummary> removedIterationSummaries;
+
+    // The last iteration with solution points that is no longer in the iteration history
+    IterationPtr lastRemovedFeasibleIteration;
 };
 
 } // namespace SHOT
\ No newline at end of file
@@ -37,6 +37,12 @@ public:
         double lambdaTol, double constrTol, ObjectiveFunctionPtr objectiveFunction)
         = 0;
 
+    // Can be called from several threads simultaneously, since each call uses its own evaluation context and no output
+    // is written nor primal solution candidates added. The first returned point fulfills the constraints.
+    virtual std::pair<VectorDouble, VectorDouble> findZeroConcurrently(const VectorDouble& ptA, const VectorDouble& ptB,
+        int Nmax, double lambdaTol, const std::vector<NumericConstraint*>& constraints)
+        = 0;
+
 protected:
     EnvironmentPtr env;
 };
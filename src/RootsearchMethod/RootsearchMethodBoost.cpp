@@ -15,14 +15,12 @@
 #include "../Results.h"
 #include "../PrimalSolver.h"
 #include "../Iteration.h"
+#include "../Timing.h"
 
 #include "boost/math/tools/roots.hpp"
 
 namespace SHOT
 {
-std::vector<NumericConstraint*> activeConstraints;
-double lastActiveConstraintUpdateValue;
-
 Test::Test(EnvironmentPtr envPtr) : env(envPtr) {}
 
 Test::~Test()
@@ -48,30 +46,69 @@ std::vector<NumericConstraint*> Test::getActiveConstraints() { return (activeCon
 double Test::operator()(const double x)
 {
     auto length = firstPt.size();
-    VectorDouble ptNew(length);
+    ptNew.resize(length);
 
-    for(size_t i = 0; i < length; i++)
+    if(blockVariables.size() > 0)
+    {
+        for(auto I : blockVariables)
+            ptNew[I] = x * firstPt[I] + (1 - x) * secondPt[I];
+    }
+    else
     {
-        ptNew.at(i) = x * firstPt.at(i) + (1 - x) * secondPt.at(i);
+        for(size_t i = 0; i < length; i++)
+            ptNew[i] = x * firstPt[i] + (1 - x) * secondPt[i];
     }
 
     auto currentConstraints = getActiveConstraints();
 
-    std::vector<NumericConstraint*> activeConstraints;
+    std::vector<NumericConstraint*> newActiveConstraints;
 
-    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, activeConstraints);
+    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, newActiveConstraints);
     double calculatedValue = constraintValue.normalizedValue;
 
     if(!constraintValue.isFulfilled && calculatedValue <= lastActiveConstraintUpdateValue
-        && activeConstraints.size() < currentConstraints.size())
+        && newActiveConstraints.size() < currentConstraints.size())
     {
-        setActiveConstraints(activeConstraints);
+        setActiveConstraints(newActiveConstraints);
         lastActiveConstraintUpdateValue = calculatedValue;
     }
 
     return (calculatedValue);
 }
 
+void Test::calculateValues(const VectorDouble& lambdas, VectorDouble& values)
+{
+    int numberOfVariables = firstPt.size();
+    int numberOfPoints = lambdas.size();
+
+    points.resize(numberOfVariables, numberOfPoints);
+
+    auto interpolate = [&](int variableIndex) {
+        double* variableValues = points.getVariableValues(variableIndex);
+
+        for(int k = 0; k < numberOfPoints; k++)
+            variableValues[k] = lambdas[k] * firstPt[variableIndex] + (1 - lambdas[k]) * secondPt[variableIndex];
+    };
+
+    if(blockVariables.size() > 0)
+    {
+        for(auto I : blockVariables)
+            interpolate(I);
+    }
+    else
+    {
+        for(int i = 0; i < numberOfVariables; i++)
+            interpolate(i);
+    }
+
+    auto constraintValues = problem->getMaxNumericConstraintValues(points, activeConstraints);
+
+    values.resize(numberOfPoints);
+
+    for(int k = 0; k < numberOfPoints; k++)
+        values[k] = constraintValues[k].normalizedValue;
+}
+
 TestObjective::TestObjective(EnvironmentPtr envPtr) : env(envPtr) {}
 
 TestObjective::~TestObjective() = default;
@@ -90,9 +127,14 @@ RootsearchMethodBoost::RootsearchMethodBoost(EnvironmentPtr envPtr) : env(envPtr
 {
     test = std::make_unique<Test>(env);
     testObjective = std::make_unique<TestObjective>(env);
+
+    methodSetting = env->settings->getSettingHandle<int>("Rootsearch.Method", "Subsolver");
+    multiSectionPointsSetting = env->settings->getSettingHandle<int>("Rootsearch.MultiSection.Points", "Subsolver");
+
+    rootsearchHistogram = env->timing->getHistogramHandle("Rootsearch");
 }
 
-RootsearchMethodBoost::~RootsearchMethodBoost() { activeConstraints.clear(); }
+RootsearchMethodBoost::~RootsearchMethodBoost() = default;
 
 std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const VectorDouble& ptA, const VectorDouble& ptB,
     int Nmax, double lambdaTol, double constrTol, const NonlinearConstraints constraints,
@@ -124,71 +166,107 @@ std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const Vect
         env->output->outputError("        No constraints selected for root search");
     }
 
+    std::pair<VectorDouble, VectorDouble> points;
+    std::uintmax_t iterations = Nmax;
+
+    if(!performRootsearch(*test, ptA, ptB, lambdaTol, constraints, points, iterations))
+        return (points);
+
+    if((int)iterations == Nmax)
+    {
+        env->output->outputDebug("        Warning, number of line search iterations {} reached!", iterations);
+    }
+    else
+    {
+        env->output->outputTrace("        Line search iterations: {}", iterations);
+    }
+
+    // The first point is the one fulfilling the constraints
+    if(addPrimalCandidate)
+    {
+        env->primalSolver->addPrimalSolutionCandidate(
+            points.first, E_PrimalSolutionSource::Rootsearch, env->results->getCurrentIteration()->iterationNumber);
+    }
+
+    return (points);
+}
+
+std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZeroConcurrently(const VectorDouble& ptA,
+    const VectorDouble& ptB, int Nmax, double lambdaTol, const std::vector<NumericConstraint*>& constraints)
+{
+    assert(ptA.size() == ptB.size());
+    assert(constraints.size() > 0);
+
+    // Each call has its own evaluation context
+    Test localTest(env);
+
+    std::pair<VectorDouble, VectorDouble> points;
+    std::uintmax_t iterations = Nmax;
+
+    performRootsearch(localTest, ptA, ptB, lambdaTol, constraints, points, iterations);
+
+    return (points);
+}
+
+bool RootsearchMethodBoost::performRootsearch(Test& test, const VectorDouble& ptA, const VectorDouble& ptB,
+    double lambdaTol, const std::vector<NumericConstraint*>& constraints, std::pair<VectorDouble, VectorDouble>& points,
+    std::uintmax_t& iterations)
+{
     if(auto sharedProblem = constraints[0]->ownerProblem.lock())
     {
-        test->problem = sharedProblem.get();
+        test.problem = sharedProblem.get();
     }
 
     auto length = ptA.size();
     VectorDouble ptNew(length);
     VectorDouble ptNew2(length);
 
-    boost::uintmax_t max_iter = Nmax;
-
-    test->firstPt = ptA;
-    test->secondPt = ptB;
+    test.firstPt = ptA;
+    test.secondPt = ptB;
 
     std::vector<NumericConstraint*> firstActiveConstraints;
     std::vector<NumericConstraint*> secondActiveConstraints;
 
-    test->valFirstPt
-        = test->problem->getMaxNumericConstraintValue(ptA, constraints, firstActiveConstraints).normalizedValue;
-    test->valSecondPt
-        = test->problem->getMaxNumericConstraintValue(ptB, constraints, secondActiveConstraints).normalizedValue;
+    test.valFirstPt
+        = test.problem->getMaxNumericConstraintValue(ptA, constraints, firstActiveConstraints).normalizedValue;
+    test.valSecondPt
+        = test.problem->getMaxNumericConstraintValue(ptB, constraints, secondActiveConstraints).normalizedValue;
 
-    if(test->valFirstPt > 0)
-        test->setActiveConstraints(firstActiveConstraints);
+    if(test.valFirstPt > 0)
+        test.setActiveConstraints(firstActiveConstraints);
     else
-        test->setActiveConstraints(secondActiveConstraints);
+        test.setActiveConstraints(secondActiveConstraints);
 
-    if(test->getActiveConstraints().size() == 0) // All constraints are fulfilled.
+    if(test.getActiveConstraints().size() == 0) // All constraints are fulfilled.
     {
-        if(test->valFirstPt > test->valSecondPt)
-        {
-            std::pair<VectorDouble, VectorDouble> tmpPair(ptB, ptA);
+        if(test.valFirstPt > test.valSecondPt)
+            points = std::make_pair(ptB, ptA);
+        else
+            points = std::make_pair(ptA, ptB);
 
-            return (tmpPair);
-        }
-
-        std::pair<VectorDouble, VectorDouble> tmpPair(ptA, ptB);
-
-        return (tmpPair);
+        return (false);
     }
 
-    int tempFEvals = env->solutionStatistics.numberOfFunctionEvalutions;
+    // Only the variables in the blocks of the active constraints change the function values
+    test.blockVariables = test.problem->getBlockVariables(test.getActiveConstraints());
+
+    auto startTime = env->timing->getTime();
 
     PairDouble r1;
 
-    if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
-        == ES_RootsearchMethod::BoostTOMS748)
-    {
-        r1 = boost::math::tools::toms748_solve(*test, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
-    }
-    else
+    auto method = static_cast<ES_RootsearchMethod>(methodSetting.get());
+
+    if(method == ES_RootsearchMethod::BoostTOMS748)
     {
-        r1 = boost::math::tools::bisect(*test, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
+        r1 = boost::math::tools::toms748_solve(test, 0.0, 1.0, TerminationCondition(lambdaTol), iterations);
     }
-
-    int resFVals = env->solutionStatistics.numberOfFunctionEvalutions - tempFEvals;
-    if((int)max_iter == Nmax)
+    else if(method == ES_RootsearchMethod::MultiSection)
     {
-        env->output->outputDebug(
-            "        Warning, number of line search iterations " + std::to_string(max_iter) + " reached!");
+        r1 = multiSection(test, lambdaTol, multiSectionPointsSetting.get(), iterations);
     }
     else
     {
-        env->output->outputTrace("        Line search iterations: " + std::to_string(max_iter)
-            + ". Function evaluations: " + std::to_string(resFVals));
+        r1 = boost::math::tools::bisect(test, 0.0, 1.0, TerminationCondition(lambdaTol), iterations);
     }
 
     for(size_t i = 0; i < length; i++)
@@ -197,30 +275,60 @@ std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const Vect
         ptNew2.at(i) = r1.second * ptA.at(i) + (1 - r1.second) * ptB.at(i);
     }
 
-    auto validNewPt = test->problem->areNonlinearConstraintsFulfilled(ptNew, 0);
+    auto validNewPt = test.problem->areNonlinearConstraintsFulfilled(ptNew, 0);
 
     if(!validNewPt) // ptNew Outside feasible region
-    {
-        if(addPrimalCandidate)
-        {
-            env->primalSolver->addPrimalSolutionCandidate(
-                ptNew2, E_PrimalSolutionSource::Rootsearch, env->results->getCurrentIteration()->iterationNumber);
-        }
-
-        std::pair<VectorDouble, VectorDouble> tmpPair(ptNew2, ptNew);
-        return (tmpPair);
-    }
+        points = std::make_pair(ptNew2, ptNew);
     else
+        points = std::make_pair(ptNew, ptNew2);
+
+    env->timing->addHistogramSample(rootsearchHistogram, startTime);
+
+    return (true);
+}
+
+PairDouble RootsearchMethodBoost::multiSection(
+    Test& test, double lambdaTol, int numberOfPoints, std::uintmax_t& maxIter)
+{
+    // The point for lambda = 0 is the second point and for lambda = 1 the first point
+    double lowerLambda = 0.0;
+    double upperLambda = 1.0;
+    bool isLowerPositive = (test.valSecondPt > 0);
+
+    VectorDouble lambdas(numberOfPoints);
+    VectorDouble values;
+
+    std::uintmax_t iterations = 0;
+
+    while(upperLambda - lowerLambda > lambdaTol && iterations < maxIter)
     {
-        if(addPrimalCandidate)
+        double step = (upperLambda - lowerLambda) / (numberOfPoints + 1);
+
+        for(int k = 0; k < numberOfPoints; k++)
+            lambdas[k] = lowerLambda + (k + 1) * step;
+
+        test.calculateValues(lambdas, values);
+        iterations++;
+
+        // The root is in the last subinterval if there is no sign change before it
+        int k = 0;
+
+        for(; k < numberOfPoints; k++)
         {
-            env->primalSolver->addPrimalSolutionCandidate(
-                ptNew, E_PrimalSolutionSource::Rootsearch, env->results->getCurrentIteration()->iterationNumber);
+            if((values[k] > 0) != isLowerPositive)
+                break;
         }
 
-        std::pair<VectorDouble, VectorDouble> tmpPair(ptNew, ptNew2);
-        return (tmpPair);
+        if(k > 0)
+            lowerLambda = lambdas[k - 1];
+
+        if(k < numberOfPoints)
+            upperLambda = lambdas[k];
     }
+
+    maxIter = iterations;
+
+    return (PairDouble(lowerLambda, upperLambda));
 }
 
 std::pair<double, double> RootsearchMethodBoost::findZero(const VectorDouble& pt, double objectiveLB,
@@ -237,10 +345,11 @@ std::pair<double, double> RootsearchMethodBoost::findZero(const VectorDouble& pt
 
     int tempFEvals = env->solutionStatistics.numberOfFunctionEvalutions;
 
+    auto startTime = env->timing->getTime();
+
     PairDouble r1;
 
-    if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
-        == ES_RootsearchMethod::BoostTOMS748)
+    if(static_cast<ES_RootsearchMethod>(methodSetting.get()) == ES_RootsearchMethod::BoostTOMS748)
     {
         r1 = boost::math::tools::toms748_solve(*testObjective, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
@@ -249,16 +358,16 @@ std::pair<double, double> RootsearchMethodBoost::findZero(const VectorDouble& pt
         r1 = boost::math::tools::bisect(*testObjective, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
 
+    env->timing->addHistogramSample(rootsearchHistogram, startTime);
+
     int resFVals = env->solutionStatistics.numberOfFunctionEvalutions - tempFEvals;
     if((int)max_iter == Nmax)
     {
-        env->output->outputDebug(
-            "        Warning, number of line search iterations " + std::to_string(max_iter) + " reached!");
+        env->output->outputDebug("        Warning, number of line search iterations {} reached!", max_iter);
     }
     else
     {
-        env->output->outputTrace("        Line search iterations: " + std::to_string(max_iter)
-            + ". Function evaluations: " + std::to_string(resFVals));
+        env->output->outputTrace("        Line search iterations: {}. Function evaluations: {}", max_iter, resFVals);
     }
 
     double ptNew = r1.first * objectiveLB + (1 - r1.first) * objectiveUB;
@@ -11,6 +11,11 @@
 #pragma once
 #include "IRootsearchMethod.h"
 #include "../Environment.h"
+#include "../Settings.h"
+#include "../Timing.h"
+#include "../Model/Variables.h"
+
+#include <cstdint>
 
 namespace SHOT
 {
@@ -19,12 +24,19 @@ class Test
 private:
     EnvironmentPtr env;
 
+    std::vector<NumericConstraint*> activeConstraints;
+    double lastActiveConstraintUpdateValue = 0.0;
+
 public:
     Problem* problem;
 
     VectorDouble firstPt;
     VectorDouble secondPt;
 
+    // If not empty, only these variables are interpolated between the points, since the values of the active
+    // constraints do not depend on the other ones
+    VectorInteger blockVariables;
+
     double valFirstPt;
     double valSecondPt;
 
@@ -37,6 +49,14 @@ public:
     void addActiveConstraint(NumericConstraint* constraint);
 
     double operator()(const double x);
+
+    // Calculates the function value in all the points given by lambdas at once, without updating the active
+    // constraints
+    void calculateValues(const VectorDouble& lambdas, VectorDouble& values);
+
+private:
+    VectorDouble ptNew;
+    PointBatch points;
 };
 
 class TestObjective
@@ -84,9 +104,28 @@ public:
     std::pair<double, double> findZero(const VectorDouble& pt, double objectiveLB, double objectiveUB, int Nmax,
         double lambdaTol, double constrTol, ObjectiveFunctionPtr objectiveFunction) override;
 
+    std::pair<VectorDouble, VectorDouble> findZeroConcurrently(const VectorDouble& ptA, const VectorDouble& ptB,
+        int Nmax, double lambdaTol, const std::vector<NumericConstraint*>& constraints) override;
+
 private:
     std::unique_ptr<Test> test;
     std::unique_ptr<TestObjective> testObjective;
     EnvironmentPtr env;
+
+    SettingHandle<int> methodSetting;
+    SettingHandle<int> multiSectionPointsSetting;
+
+    HistogramHandle rootsearchHistogram;
+
+    // Performs the root search using the evaluation context in test, without writing output or adding primal
+    // solution candidates. Returns false if no root search was needed since all constraints are fulfilled. The
+    // maximum number of iterations is given in iterations, which is then updated with the number used.
+    bool performRootsearch(Test& test, const VectorDouble& ptA, const VectorDouble& ptB, double lambdaTol,
+        const std::vector<NumericConstraint*>& constraints, std::pair<VectorDouble, VectorDouble>& points,
+        std::uintmax_t& iterations);
+
+    // Divides the interval [0,1] into several subintervals in each iteration and continues with the first one where
+    // the function changes sign. Returns the final interval, and the number of iterations in maxIter.
+    PairDouble multiSection(Test& test, double lambdaTol, int numberOfPoints, std::uintmax_t& maxIter);
 };
 } // namespace SHOT
\ No newline at end of file
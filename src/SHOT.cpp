@@ -46,6 +46,7 @@ int main(int argc, char* argv[])
     cmdl.add_params({ "--sol" });
     cmdl.add_params({ "--docs" });
     cmdl.add_params({ "--debug" });
+    cmdl.add_params({ "--snapshot", "--load-snapshot" });
 
     cmdl.parse(argc, argv);
 
@@ -99,6 +100,8 @@ int main(int argc, char* argv[])
 #endif
         env->output->outputCritical("   --debug [DIRECTORY]      Saves debug information in the specified directory");
         env->output->outputCritical("                            If DIRECTORY is empty a temporary directory is used");
+        env->output->outputCritical("   --load-snapshot FILE     Reads the problem from a snapshot file");
+        env->output->outputCritical("                            PROBLEMFILE is not needed in this case");
         env->output->outputCritical("   --log FILE               Sets the filename for the log file");
         env->output->outputCritical("   --opt [FILE]             Reads in options from FILE in GAMS format");
         env->output->outputCritical(
@@ -107,6 +110,8 @@ int main(int argc, char* argv[])
         env->output->outputCritical(
             "                            If FILE is empty, a new options file SHOT.osol will be created");
         env->output->outputCritical("   --osrl FILE              Sets the filename for the OSrL result file");
+        env->output->outputCritical(
+            "   --snapshot FILE          Writes the problem to a snapshot file for faster restarts");
         env->output->outputCritical(
             "   --trc [FILE]             Prints a trace file to <problemname>.trc or specified filename");
         env->output->outputCritical("");
@@ -620,30 +625,52 @@ int main(int argc, char* argv[])
         env->output->outputInfo("");
     }
 
-    if(!cmdl(1))
+    if(cmdl("--load-snapshot"))
     {
-        env->output->outputCritical(" No problem file specified.");
-        env->output->outputCritical("");
-        env->output->outputCritical(" Try 'SHOT --help' for more information.");
-        return (0);
+        // The AMPL modeling system is not available when the problem is read from a snapshot
+        if(useASL)
+        {
+            env->output->outputCritical(" Error: Cannot use parameter AMPL when reading the problem from a snapshot.");
+            return (0);
+        }
+
+        if(!solver.setProblemFromSnapshot(cmdl("--load-snapshot").str()))
+        {
+            return (0);
+        }
     }
+    else
+    {
+        if(!cmdl(1))
+        {
+            env->output->outputCritical(" No problem file specified.");
+            env->output->outputCritical("");
+            env->output->outputCritical(" Try 'SHOT --help' for more information.");
+            return (0);
+        }
 
-    filename = cmdl[1];
+        filename = cmdl[1];
 
-    if(!fs::filesystem::exists(filename))
-    {
-        if(useASL && fs::filesystem::exists(filename + ".nl"))
+        if(!fs::filesystem::exists(filename))
         {
-            filename += ".nl";
+            if(useASL && fs::filesystem::exists(filename + ".nl"))
+            {
+                filename += ".nl";
+            }
+            else
+            {
+                env->output->outputCritical(" Problem file " + filename + " not found!");
+                return (0);
+            }
         }
-        else
+
+        if(!solver.setProblem(filename))
         {
-            env->output->outputCritical(" Problem file " + filename + " not found!");
             return (0);
         }
     }
 
-    if(!solver.setProblem(filename))
+    if(cmdl("--snapshot") && !solver.saveProblemSnapshot(cmdl("--snapshot").str()))
     {
         return (0);
     }
@@ -180,6 +180,12 @@ template <typename T> void Settings::updateSetting(std::string name, std::string
     }
 
     settingIsDefaultValue[key] = false;
+
+    if(auto listeners = settingChangeListeners.find(key); listeners != settingChangeListeners.end())
+    {
+        for(auto& L : listeners->second)
+            L();
+    }
 }
 
 // String settings ===============================================================
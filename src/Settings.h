@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,8 @@ public:
     }
 };
 
+template <typename T> class SettingHandle;
+
 class DllExport Settings
 {
 private:
@@ -92,18 +95,13 @@ private:
     using TupleStringPairInt = std::tuple<std::string, std::string, int>;
     std::map<TupleStringPairInt, std::string> enumDescriptions;
 
-public:
-    bool settingsInitialized = false;
-
-    Settings(OutputPtr outputPtr);
-
-    ~Settings();
-
-    template <typename T> void updateSetting(std::string name, std::string category, T value);
+    std::map<PairString, std::vector<std::function<void()>>> settingChangeListeners;
 
-    // template <typename T> T getSetting(std::string name, std::string category);
+    template <typename T> friend class SettingHandle;
 
-    template <typename T> T getSetting(std::string name, std::string category)
+    // Returns a reference to the stored value of the setting. The values are stored in nodes of the setting maps,
+    // which are never erased, so the reference stays valid and reflects later updates
+    template <typename T> const T& getSettingReference(std::string name, std::string category)
     {
         // Check that setting is of the correct type
         using value_type
@@ -150,6 +148,40 @@ public:
         return (value->second);
     }
 
+public:
+    bool settingsInitialized = false;
+
+    Settings(OutputPtr outputPtr);
+
+    ~Settings();
+
+    template <typename T> void updateSetting(std::string name, std::string category, T value);
+
+    // template <typename T> T getSetting(std::string name, std::string category);
+
+    template <typename T> T getSetting(std::string name, std::string category)
+    {
+        return (getSettingReference<T>(name, category));
+    }
+
+    // Returns a handle that reads the value of the setting without a lookup, for use in code that is run often. If the
+    // settings have not been initialized yet, the setting is looked up when the handle is first read.
+    template <typename T> SettingHandle<T> getSettingHandle(std::string name, std::string category)
+    {
+        SettingHandle<T> handle(this, name, category);
+
+        if(settingsInitialized)
+            handle.get();
+
+        return (handle);
+    }
+
+    // Registers a function that is called after the value of the setting has been updated
+    void addSettingChangeListener(std::string name, std::string category, std::function<void()> listener)
+    {
+        settingChangeListeners[make_pair(category, name)].push_back(listener);
+    }
+
     std::string getSettingDescription(std::string name, std::string category)
     {
         return settingDescriptions.at(PairString(category, name));
@@ -200,4 +232,32 @@ public:
     bool readSettingsFromOSoL(std::string osol);
     bool readSettingsFromString(std::string options);
 };
+
+// A typed handle to the value of a setting. The setting is looked up the first time the value is read, afterwards
+// reading the value is a pointer dereference. Updates of the setting are seen directly through the handle.
+template <typename T> class SettingHandle
+{
+public:
+    SettingHandle() = default;
+
+    SettingHandle(Settings* settings, std::string name, std::string category)
+        : settings(settings), name(name), category(category)
+    {
+    }
+
+    inline const T& get()
+    {
+        if(value == nullptr)
+            value = &settings->getSettingReference<T>(name, category);
+
+        return (*value);
+    }
+
+private:
+    Settings* settings = nullptr;
+    const T* value = nullptr;
+
+    std::string name;
+    std::string category;
+};
 } // namespace SHOT
@@ -85,6 +85,8 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
     env->timing->createTimer("DualProblemsRelaxed", "   - solving relaxed problems");
     env->timing->createTimer("DualProblemsIntegerFixed", "   - solving integer-fixed problems");
     env->timing->createTimer("DualProblemsDiscrete", "   - solving MIP problems");
+    env->timing->createTimer("DualProblemsCbcRebuild", "     - rebuilding Cbc models");
+    env->timing->createTimer("DualProblemsCbcSolve", "     - Cbc solve");
     env->timing->createTimer("DualCutGenerationRootSearch", "   - root search for constraint cuts");
     env->timing->createTimer("DualObjectiveRootSearch", "   - root search for objective cut");
 
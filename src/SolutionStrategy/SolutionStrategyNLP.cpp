@@ -80,6 +80,8 @@ SolutionStrategyNLP::SolutionStrategyNLP(EnvironmentPtr envPtr)
     env->timing->createTimer("DualStrategy", " - dual strategy");
     env->timing->createTimer("DualProblemsRelaxed", "   - solving relaxed problems");
     env->timing->createTimer("DualProblemsDiscrete", "   - solving MIP problems");
+    env->timing->createTimer("DualProblemsCbcRebuild", "     - rebuilding Cbc models");
+    env->timing->createTimer("DualProblemsCbcSolve", "     - Cbc solve");
     env->timing->createTimer("DualCutGenerationRootSearch", "   - root search for constraint cuts");
     env->timing->createTimer("DualObjectiveRootSearch", "   - root search for objective cut");
 
@@ -35,7 +35,10 @@
 #include "../Tasks/TaskPerformBoundTightening.h"
 #include "../Tasks/TaskReformulateProblem.h"
 
+#include "Model/ProblemSnapshot.h"
+
 #include <map>
+#include <thread>
 
 #ifdef HAS_STD_FILESYSTEM
 #include <filesystem>
@@ -73,6 +76,10 @@ Solver::Solver()
     env->timing->createTimer("BoundTighteningFBBTOriginal", "   - feasibility based (original problem)");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "   - feasibility based (reformulated problem)");
 
+    env->timing->createHistogram("Rootsearch", "root searches");
+    env->timing->createHistogram("DualProblem", "dual problem solves");
+    env->timing->createHistogram("PrimalNLP", "fixed NLP problem solves");
+
     env->settings = std::make_shared<Settings>(env->output);
     env->tasks = std::make_shared<TaskHandler>(env);
     env->events = std::make_shared<EventHandler>(env);
@@ -104,6 +111,10 @@ Solver::Solver(std::shared_ptr<spdlog::sinks::sink> consoleSink)
     env->timing->createTimer("BoundTighteningFBBTOriginal", "   - feasibility based (original problem");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "   - feasibility based (reformulated problem");
 
+    env->timing->createHistogram("Rootsearch", "root searches");
+    env->timing->createHistogram("DualProblem", "dual problem solves");
+    env->timing->createHistogram("PrimalNLP", "fixed NLP problem solves");
+
     env->settings = std::make_shared<Settings>(env->output);
     env->tasks = std::make_shared<TaskHandler>(env);
     env->events = std::make_shared<EventHandler>(env);
@@ -246,15 +257,7 @@ bool Solver::setProblem(std::string fileName)
         initializeDebugMode();
     }
 
-    // Do not do convexifying reformulations if the problem is assumed to be convex
-    if(env->settings->getSetting<bool>("Convexity.AssumeConvex", "Model"))
-    {
-        env->settings->updateSetting(
-            "Reformulation.Bilinear.IntegerFormulation", "Model", (int)ES_ReformulatiomBilinearInteger::None);
-
-        env->settings->updateSetting(
-            "Reformulation.Monomials.Formulation", "Model", (int)ES_ReformulatiomBilinearInteger::None);
-    }
+    adjustReformulationSettings();
 
 #ifndef HAS_GAMS
     if(problemExtension == ".gms")
@@ -272,15 +275,6 @@ bool Solver::setProblem(std::string fileName)
     }
 #endif
 
-#ifdef HAS_CBC
-    // TODO: figure out a better way to do this
-    if(static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual")) == ES_MIPSolver::Cbc)
-    {
-        env->settings->updateSetting(
-            "Reformulation.Quadratics.Strategy", "Model", (int)ES_QuadraticProblemStrategy::Nonlinear);
-    }
-#endif
-
     try
     {
         if(problemExtension == ".osil" || problemExtension == ".xml")
@@ -414,6 +408,129 @@ bool Solver::setProblem(
         Utilities::writeStringToFile(filename.string(), problem.str());
     }
 
+    adjustReformulationSettings();
+
+    verifySettings();
+
+    if(reformulatedProblem)
+    {
+        env->reformulatedProblem = reformulatedProblem;
+    }
+    else
+    {
+        auto taskReformulateProblem = std::make_unique<TaskReformulateProblem>(env);
+        taskReformulateProblem->run();
+    }
+
+    setConvexityBasedSettings();
+
+    return (this->selectStrategy());
+}
+
+bool Solver::setProblemFromSnapshot(std::string fileName)
+{
+    if(!fs::filesystem::exists(fileName))
+    {
+        env->output->outputError(" Snapshot file \"" + fileName + "\" does not exist.");
+
+        return (false);
+    }
+
+    fs::filesystem::path snapshotFile(fileName);
+
+    env->settings->updateSetting("ProblemFile", "Input", fs::filesystem::absolute(snapshotFile).string());
+
+    // Sets the result path
+    if(static_cast<ES_OutputDirectory>(env->settings->getSetting<int>("OutputDirectory", "Output"))
+        == ES_OutputDirectory::Program)
+    {
+        env->settings->updateSetting("ResultPath", "Output", fs::filesystem::current_path().string());
+    }
+    else
+    {
+        env->settings->updateSetting("ResultPath", "Output", snapshotFile.parent_path().string());
+    }
+
+    adjustReformulationSettings();
+
+    ProblemSnapshot snapshot;
+
+    try
+    {
+        snapshot = readProblemSnapshot(env, fileName);
+    }
+    catch(const std::exception& e)
+    {
+        env->output->outputError(fmt::format(" Error when reading problem snapshot: {}", e.what()));
+
+        return (false);
+    }
+
+    env->report->outputModelingSystemReport(snapshot.sourceFormat, fileName);
+    env->settings->updateSetting("SourceFormat", "Input", static_cast<int>(snapshot.sourceFormat));
+
+    // The reformulated problem depends on the settings, and is recreated if it was made with other settings
+    if(snapshot.reformulatedProblem && snapshot.reformulationSettings != getReformulationSettings())
+    {
+        env->output->outputInfo(" The problem snapshot was reformulated with other settings, reformulating again.");
+        snapshot.reformulatedProblem.reset();
+    }
+
+    if(snapshot.reformulatedProblem)
+    {
+        for(auto& V : snapshot.reformulatedProblem->auxiliaryVariables)
+            env->results->increaseAuxiliaryVariableCounter(V->properties.auxiliaryType);
+
+        if(snapshot.reformulatedProblem->auxiliaryObjectiveVariable)
+        {
+            env->results->increaseAuxiliaryVariableCounter(
+                snapshot.reformulatedProblem->auxiliaryObjectiveVariable->properties.auxiliaryType);
+        }
+    }
+
+    return (setProblem(snapshot.problem, snapshot.reformulatedProblem));
+}
+
+bool Solver::saveProblemSnapshot(std::string fileName)
+{
+    if(!env->problem)
+    {
+        env->output->outputError(" Cannot write problem snapshot since no problem has been set.");
+        return (false);
+    }
+
+    ProblemSnapshot snapshot;
+    snapshot.sourceFormat = static_cast<ES_SourceFormat>(env->settings->getSetting<int>("SourceFormat", "Input"));
+
+    // The GAMS NLP solvers need the modeling object, which is not available when the problem is read from a snapshot
+    if(snapshot.sourceFormat == ES_SourceFormat::GAMS)
+    {
+        env->output->outputError(" Cannot write problem snapshots of GAMS models.");
+        return (false);
+    }
+
+    snapshot.reformulationSettings = getReformulationSettings();
+    snapshot.problem = env->problem;
+    snapshot.reformulatedProblem = env->reformulatedProblem;
+
+    try
+    {
+        writeProblemSnapshot(snapshot, fileName);
+    }
+    catch(const std::exception& e)
+    {
+        env->output->outputError(fmt::format(" Error when writing problem snapshot: {}", e.what()));
+
+        return (false);
+    }
+
+    env->output->outputInfo(fmt::format(" Problem snapshot written to: {}", fileName));
+
+    return (true);
+}
+
+void Solver::adjustReformulationSettings()
+{
     // Do not do convexifying reformulations if the problem is assumed to be convex
     if(env->settings->getSetting<bool>("Convexity.AssumeConvex", "Model"))
     {
@@ -432,22 +549,36 @@ bool Solver::setProblem(
             "Reformulation.Quadratics.Strategy", "Model", (int)ES_QuadraticProblemStrategy::Nonlinear);
     }
 #endif
+}
 
-    verifySettings();
+std::string Solver::getReformulationSettings()
+{
+    std::stringstream settings;
 
-    if(reformulatedProblem)
+    // The reformulations depend on the model settings and on what the MIP solver supports
+    for(auto type : { E_SettingType::Boolean, E_SettingType::Double, E_SettingType::Enum, E_SettingType::Integer })
     {
-        env->reformulatedProblem = reformulatedProblem;
-    }
-    else
-    {
-        auto taskReformulateProblem = std::make_unique<TaskReformulateProblem>(env);
-        taskReformulateProblem->run();
+        for(auto& [category, name] : env->settings->getSettingSplitIdentifiers(type))
+        {
+            if(category != "Model" || name.compare(0, 6, "Input.") == 0)
+                continue;
+
+            settings << category << '.' << name << " = ";
+
+            if(type == E_SettingType::Boolean)
+                settings << env->settings->getSetting<bool>(name, category);
+            else if(type == E_SettingType::Double)
+                settings << fmt::format("{}", env->settings->getSetting<double>(name, category));
+            else
+                settings << env->settings->getSetting<int>(name, category);
+
+            settings << '\n';
+        }
     }
 
-    setConvexityBasedSettings();
+    settings << "Dual.MIP.Solver = " << env->settings->getSetting<int>("MIP.Solver", "Dual") << '\n';
 
-    return (this->selectStrategy());
+    return (settings.str());
 }
 
 bool Solver::selectStrategy()
@@ -462,6 +593,15 @@ bool Solver::selectStrategy()
                 solutionStrategy = std::make_unique<SolutionStrategyNLP>(env);
                 env->results->usedSolutionStrategy = E_SolutionStrategy::NLP;
             }
+            else if(static_cast<ES_TreeStrategy>(env->settings->getSetting<int>("TreeStrategy", "Dual"))
+                == ES_TreeStrategy::SingleTree)
+            {
+                env->output->outputDebug(" Using single-tree solution strategy.");
+                solutionStrategy = std::make_unique<SolutionStrategySingleTree>(env);
+                isProblemInitialized = true;
+                env->results->usedSolutionStrategy = E_SolutionStrategy::SingleTree;
+                env->dualSolver->isSingleTree = true;
+            }
             else
             {
                 solutionStrategy = std::make_unique<SolutionStrategyMultiTree>(env);
@@ -687,6 +827,11 @@ void Solver::initializeSettings()
     env->settings->createSetting("ESH.InteriorPoint.MinimaxObjectiveUpperBound", "Dual", 0.1,
         "Upper bound for minimax objective variable", SHOT_DBL_MIN, SHOT_DBL_MAX);
 
+    env->settings->createSetting("ESH.InteriorPoint.MultiStart.Points", "Dual", 1,
+        "Number of minimax problems solved in parallel from different starting points. With more than one, the "
+        "interior point closest to the solution point is used in the root searches",
+        1, 999);
+
     VectorString enumAddPrimalPointAsInteriorPoint;
     enumAddPrimalPointAsInteriorPoint.push_back("No");
     enumAddPrimalPointAsInteriorPoint.push_back("Add as new");
@@ -720,6 +865,22 @@ void Solver::initializeSettings()
     env->settings->createSetting("HyperplaneCuts.MaxPerIteration", "Dual", 200,
         "Maximal number of hyperplanes to add per iteration", 0, SHOT_INT_MAX);
 
+    env->settings->createSetting("HyperplaneCuts.Pool.DeleteAge", "Dual", 20,
+        "Number of further iterations a removed hyperplane cut can be nonbinding before its row is deleted from the "
+        "MIP problem and it is dropped from the cut pool",
+        1, SHOT_INT_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Pool.MaxAge", "Dual", 10,
+        "Number of iterations a hyperplane cut in the cut pool can be nonbinding before it is removed", 1,
+        SHOT_INT_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Pool.SlackTolerance", "Dual", 1e-6,
+        "A hyperplane cut in the cut pool is binding if its slack is less than this", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Pool.Use", "Dual", false,
+        "Remove hyperplane cuts that are not binding from the MIP problem and add them again when violated. Only in "
+        "the multi-tree strategy");
+
     env->settings->createSetting("HyperplaneCuts.UseIntegerCuts", "Dual", false,
         "Add integer cuts for infeasible integer-combinations for binary problems");
 
@@ -877,6 +1038,23 @@ void Solver::initializeSettings()
         "These settings control various aspects of SHOT's representation  for and handling of the provided "
         "optimization model.");
 
+    // Automatic differentiation
+
+    env->settings->createSettingGroup("Model", "AutomaticDifferentiation", "Automatic differentiation",
+        "These settings control how the CppAD tapes used for calculating derivatives of nonlinear expressions are "
+        "created.");
+
+    VectorString enumGradientTapePartitioning;
+    enumGradientTapePartitioning.push_back("One tape for the whole problem");
+    enumGradientTapePartitioning.push_back("One tape per constraint");
+    enumGradientTapePartitioning.push_back("One tape per group of constraints sharing variables");
+    env->settings->createSetting("AutomaticDifferentiation.GradientTapes", "Model",
+        static_cast<int>(ES_GradientTapePartitioning::None),
+        "How to partition the tapes used when calculating gradients", enumGradientTapePartitioning, 0);
+
+    env->settings->createSetting("AutomaticDifferentiation.Optimize", "Model", false,
+        "Optimize the gradient tapes, an optimized tape is only used if it gives the same values and derivatives");
+
     // Bound tightening
 
     env->settings->createSettingGroup("Model", "BoundTightening", "Bound tightening",
@@ -885,8 +1063,11 @@ void Solver::initializeSettings()
 
     // Bound tightening: feasibility based
 
-    env->settings->createSetting(
-        "BoundTightening.FeasibilityBased.MaxIterations", "Model", 5, "Maximal number of bound tightening iterations");
+    env->settings->createSetting("BoundTightening.FeasibilityBased.MaxIterations", "Model", 5,
+        "Maximal number of times each constraint is used for bound tightening");
+
+    env->settings->createSetting("BoundTightening.FeasibilityBased.MinimumRelativeTightening", "Model", 1e-3,
+        "Relative reduction of a variable domain needed to use the constraints with the variable again", 0.0, 1.0);
 
     env->settings->createSetting("BoundTightening.FeasibilityBased.TimeLimit", "Model", 5.0,
         "Time limit for bound tightening", 0.0, SHOT_DBL_MAX);
@@ -941,6 +1122,24 @@ void Solver::initializeSettings()
     env->settings->createSetting("Convexity.Quadratics.EigenValueTolerance", "Model", 1e-5,
         "Convexity tolerance for the eigenvalues of the Hessian matrix for quadratic terms", 0.0, SHOT_DBL_MAX);
 
+    // Evaluation settings
+
+    env->settings->createSettingGroup(
+        "Model", "Evaluation", "Evaluation", "These settings control how the constraints are evaluated in points");
+
+    env->settings->createSetting("Evaluation.Parallel.MinimumConstraints", "Model", 2000,
+        "Minimum number of constraints evaluated in a point for the evaluation to be divided between the threads given "
+        "by Strategy.Threads. 0: never in parallel",
+        0, SHOT_INT_MAX);
+
+    // Input settings
+
+    env->settings->createSettingGroup(
+        "Model", "Input", "Input", "These settings control how the problem files are read");
+
+    env->settings->createSetting("Input.OSiL.UseStreamingReader", "Model", true,
+        "Read OSiL files in one pass without a document tree, the document tree is used if this fails");
+
     // Variable settings
 
     env->settings->createSettingGroup("Model", "Variables", "Variables",
@@ -1095,6 +1294,10 @@ void Solver::initializeSettings()
         enumIterationDetail, 0);
     enumIterationDetail.clear();
 
+    env->settings->createSetting("IterationHistory.Size", "Output", 100,
+        "Number of most recent iterations kept in full, while only summaries are kept of the older ones. 0 keeps all.",
+        0, SHOT_INT_MAX);
+
     VectorString enumOutputDirectory;
     enumOutputDirectory.push_back("Problem directory");
     enumOutputDirectory.push_back("Program directory");
@@ -1105,6 +1308,9 @@ void Solver::initializeSettings()
     env->settings->createSetting(
         "SaveNumberOfSolutions", "Output", 1, "Save this number of primal solutions to OSrL file");
 
+    env->settings->createSetting("Timing.Histograms.Use", "Output", false,
+        "Record the durations of single root searches and dual and primal problem solves");
+
     env->settings->createSettingGroup(
         "Primal", "", "Primal heuristics", "These settings control the primal heuristics used in SHOT.");
 
@@ -1118,6 +1324,13 @@ void Solver::initializeSettings()
     enumPrimalNLPStrategy.push_back("Based on iteration or time");
     enumPrimalNLPStrategy.push_back("Based on iteration or time, and for all feasible MIP solutions");
 
+    env->settings->createSetting("FixedInteger.Asynchronous.Threads", "Primal", 1,
+        "Number of threads solving fixed NLP problems asynchronously, which are not used by the MIP solver", 1, 999);
+
+    env->settings->createSetting("FixedInteger.Asynchronous.Use", "Primal", false,
+        "Solve the fixed NLP problems in separate threads while the MIP solver continues. Only with Ipopt, which needs "
+        "a thread-safe linear solver such as MA27 or MA57");
+
     env->settings->createSetting("FixedInteger.CallStrategy", "Primal",
         static_cast<int>(ES_PrimalNLPStrategy::IterationOrTimeAndAllFeasibleSolutions),
         "When should the fixed strategy be used", enumPrimalNLPStrategy, 0);
@@ -1221,6 +1434,9 @@ void Solver::initializeSettings()
     env->settings->createSetting("UseRecommendedSettings", "Strategy", true,
         "Modifies some settings to their recommended values based on the strategy");
 
+    env->settings->createSetting("Threads", "Strategy", 0,
+        "Number of threads to use in SHOT, e.g., for root searches. Does not affect subsolvers. 0: Automatic", 0, 999);
+
     // Subsolver settings: Cplex
 
     env->settings->createSettingGroup("Subsolver", "", "Subsolver functionality",
@@ -1418,6 +1634,10 @@ void Solver::initializeSettings()
     env->settings->createSetting("Cbc.Strategy", "Subsolver", 1, "This turns on newer features", enumStrategy, 0);
     enumStrategy.clear();
 
+    env->settings->createSetting("Cbc.UseLazyConstraints", "Subsolver", false,
+        "Use the single-tree strategy with lazy constraints in Cbc, if selected with Dual.TreeStrategy. Cbc then uses "
+        "one thread.");
+
 #endif
 
     // Subsolver settings: GAMS NLP
@@ -1461,6 +1681,9 @@ void Solver::initializeSettings()
     env->settings->createSetting(
         "Ipopt.RelativeConvergenceTolerance", "Subsolver", 1E-8, "Relative convergence tolerance");
 
+    env->settings->createSetting("Ipopt.WarmStart", "Subsolver", false,
+        "Warm start Ipopt with the multipliers and data structures of the previous solve in a sequence of problems");
+
 #endif
 
     // Subsolver settings: root searches
@@ -1477,10 +1700,14 @@ void Solver::initializeSettings()
     VectorString enumRootsearchMethod;
     enumRootsearchMethod.push_back("TOMS748");
     enumRootsearchMethod.push_back("Bisection");
+    enumRootsearchMethod.push_back("MultiSection");
     env->settings->createSetting("Rootsearch.Method", "Subsolver", static_cast<int>(ES_RootsearchMethod::BoostTOMS748),
         "Root search method to use", enumRootsearchMethod, 0);
     enumRootsearchMethod.clear();
 
+    env->settings->createSetting("Rootsearch.MultiSection.Points", "Subsolver", 8,
+        "Number of points evaluated simultaneously in each multisection iteration", 1, 1000);
+
     env->settings->createSetting("Rootsearch.TerminationTolerance", "Subsolver", 1e-16,
         "Epsilon lambda tolerance for root search", 0.0, SHOT_DBL_MAX);
 
@@ -1538,6 +1765,20 @@ void Solver::initializeSettings()
 
     env->settings->settingsInitialized = true;
 
+    // The log levels are updated directly when the settings are changed
+    auto updateLogLevels = [settings = env->settings.get(), output = env->output.get()]() {
+        output->setLogLevels(static_cast<E_LogLevel>(settings->getSetting<int>("Console.LogLevel", "Output")),
+            static_cast<E_LogLevel>(settings->getSetting<int>("File.LogLevel", "Output")));
+    };
+
+    env->settings->addSettingChangeListener("Console.LogLevel", "Output", updateLogLevels);
+    env->settings->addSettingChangeListener("File.LogLevel", "Output", updateLogLevels);
+
+    env->settings->addSettingChangeListener(
+        "Timing.Histograms.Use", "Output", [settings = env->settings.get(), timing = env->timing.get()]() {
+            timing->useHistograms = settings->getSetting<bool>("Timing.Histograms.Use", "Output");
+        });
+
     env->output->outputDebug(" Initialization of settings complete.");
 }
 
@@ -1645,6 +1886,48 @@ void Solver::verifySettings()
 #endif
     }
 
+    // The threads used for the asynchronous fixed NLP problems are not used by the MIP solver
+    if(env->settings->getSetting<bool>("FixedInteger.Use", "Primal")
+        && env->settings->getSetting<bool>("FixedInteger.Asynchronous.Use", "Primal"))
+    {
+        if(static_cast<ES_PrimalNLPSolver>(env->settings->getSetting<int>("FixedInteger.Solver", "Primal"))
+            != ES_PrimalNLPSolver::Ipopt)
+        {
+            env->output->outputWarning(" Fixed NLP problems can only be solved asynchronously with Ipopt.");
+            env->settings->updateSetting("FixedInteger.Asynchronous.Use", "Primal", false);
+        }
+        else
+        {
+            auto linearSolver
+                = static_cast<ES_IpoptSolver>(env->settings->getSetting<int>("Ipopt.LinearSolver", "Subsolver"));
+
+            // MUMPS, which is used by Ipopt by default, cannot be used by several threads at once
+            if((linearSolver == ES_IpoptSolver::IpoptDefault || linearSolver == ES_IpoptSolver::mumps)
+                && env->settings->getSetting<int>("FixedInteger.Asynchronous.Threads", "Primal") > 1)
+            {
+                env->output->outputWarning(" Fixed NLP problems are solved asynchronously in one thread since the "
+                                           "Ipopt linear solver is not thread-safe, use MA27 or MA57 for more.");
+                env->settings->updateSetting("FixedInteger.Asynchronous.Threads", "Primal", 1);
+            }
+
+            if(env->settings->getSetting<int>("MIP.NumberOfThreads", "Dual") == 0)
+            {
+                int numberOfThreads = env->settings->getSetting<int>("Threads", "Strategy");
+
+                if(numberOfThreads == 0)
+                    numberOfThreads = std::thread::hardware_concurrency();
+
+                int numberOfMIPThreads = std::max(1,
+                    numberOfThreads - env->settings->getSetting<int>("FixedInteger.Asynchronous.Threads", "Primal"));
+
+                env->settings->updateSetting("MIP.NumberOfThreads", "Dual", numberOfMIPThreads);
+                env->output->outputDebug(
+                    " MIP solver uses {} threads since fixed NLP problems are solved asynchronously.",
+                    numberOfMIPThreads);
+            }
+        }
+    }
+
     // Checking for errors in MIP solver selection
 
     auto solver = static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual"));
@@ -1704,8 +1987,10 @@ void Solver::verifySettings()
         MIPSolverDefined = true;
         unboundedVariableBound = 1e50;
 
-        // Some features are not available in Cbc
-        env->settings->updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+        // Some features are not available in Cbc, and the single-tree strategy is only used if activated
+        if(!env->settings->getSetting<bool>("Cbc.UseLazyConstraints", "Subsolver"))
+            env->settings->updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+
         env->settings->updateSetting(
             "Reformulation.Quadratics.Strategy", "Model", static_cast<int>(ES_QuadraticProblemStrategy::Nonlinear));
         env->settings->updateSetting(
@@ -37,6 +37,12 @@ private:
 
     void setConvexityBasedSettings();
 
+    // Adjusts the settings affecting the reformulations that are not supported by the selected solvers
+    void adjustReformulationSettings();
+
+    // The settings the reformulated problem depends on, used to check that a stored reformulation can be reused
+    std::string getReformulationSettings();
+
     void initializeDebugMode();
 
     bool selectStrategy();
@@ -67,6 +73,14 @@ public:
         return setProblem(problem, nullptr, modelingSystem);
     };
 
+    // Reads the problem from a snapshot written with saveProblemSnapshot, which is faster than reading the problem
+    // from the original file since the parsing, simplification and bound tightening are not needed. The reformulated
+    // problem in the snapshot is used if the reformulation settings have not been changed.
+    bool setProblemFromSnapshot(std::string fileName);
+
+    // Writes the current original and reformulated problems to a binary snapshot
+    bool saveProblemSnapshot(std::string fileName);
+
     bool solveProblem();
 
     void finalizeSolution();
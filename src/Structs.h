@@ -176,7 +176,8 @@ struct Hyperplane
 {
     NumericConstraintPtr sourceConstraint;
     int sourceConstraintIndex; // -1 if objective function
-    VectorDouble generatedPoint;
+    VectorDouble generatedPoint; // Empty when the hyperplane is in the waiting list
+    int generatedPointHandle = -1; // The point in DualSolver::hyperplanePoints if in the waiting list, otherwise -1
     double objectiveFunctionValue; // Used for the objective cuts only
     E_HyperplaneSource source;
     bool isObjectiveHyperplane = false;
@@ -184,11 +185,76 @@ struct Hyperplane
     double pointHash;
 };
 
+// Linear constraints sum(coefficients[j] * x[variableIndexes[j]]) + constants[i] <= 0 in compressed sparse row format,
+// i.e. the terms of row i are in positions rowStarts[i], ..., rowStarts[i + 1] - 1
+struct LinearConstraintBlock
+{
+    VectorInteger rowStarts { 0 };
+    VectorInteger variableIndexes;
+    VectorDouble coefficients;
+    VectorDouble constants;
+    std::vector<bool> allowRepair;
+    VectorString names; // Empty if the rows should not be named
+
+    inline int getNumberOfRows() const { return ((int)constants.size()); }
+};
+
+// Points given by the values of some of the variables, stored one after the other in shared vectors so that storing a
+// point does not allocate memory of its own. The values of point i are in positions pointStarts[i], ...,
+// pointStarts[i + 1] - 1.
+struct SparsePointArena
+{
+    VectorInteger pointStarts { 0 };
+    VectorInteger variableIndexes;
+    VectorDouble values;
+
+    // Adds the value of the variable in the dense point to the point being stored
+    inline void addValue(int variableIndex, const VectorDouble& point)
+    {
+        variableIndexes.push_back(variableIndex);
+        values.push_back(point[variableIndex]);
+    }
+
+    // Ends the point being stored and returns its handle
+    inline int endPoint()
+    {
+        pointStarts.push_back(values.size());
+        return (getNumberOfPoints() - 1);
+    }
+
+    // Stores a copy of a point in another arena and returns its handle in this arena
+    inline int copyPoint(const SparsePointArena& source, int handle)
+    {
+        variableIndexes.insert(variableIndexes.end(), source.variableIndexes.begin() + source.pointStarts[handle],
+            source.variableIndexes.begin() + source.pointStarts[handle + 1]);
+        values.insert(values.end(), source.values.begin() + source.pointStarts[handle],
+            source.values.begin() + source.pointStarts[handle + 1]);
+
+        return (endPoint());
+    }
+
+    // Writes the stored values into the dense point, the values of the other variables are not changed
+    inline void copyToDensePoint(int handle, VectorDouble& point) const
+    {
+        for(int i = pointStarts[handle]; i < pointStarts[handle + 1]; i++)
+            point[variableIndexes[i]] = values[i];
+    }
+
+    inline int getNumberOfPoints() const { return ((int)pointStarts.size() - 1); }
+
+    inline void clear()
+    {
+        pointStarts.assign(1, 0);
+        variableIndexes.clear();
+        values.clear();
+    }
+};
+
 struct GeneratedHyperplane
 {
     NumericConstraintPtr sourceConstraint;
     int sourceConstraintIndex; // -1 if objective function
-    VectorDouble generatedPoint;
+    int generatedPointHandle = -1; // In DualSolver::generatedHyperplanePoints, -1 if the point is not saved
     E_HyperplaneSource source = E_HyperplaneSource::None;
     bool isLazy = false;
     bool isRemoved = false;
@@ -232,6 +298,11 @@ struct SolutionStatistics
 
     int numberOfIntegerCuts = 0;
 
+    // Lookups in the hash indexes used to detect duplicate hyperplanes, integer cuts and fixed NLP candidates
+    int numberOfHashIndexHits = 0;
+    int numberOfHashIndexMisses = 0;
+    int numberOfHashIndexCollisions = 0;
+
     int numberOfIterationsWithDualStagnation = 0;
     int lastIterationWithSignificantDualUpdate = 0;
     int numberOfIterationsWithPrimalStagnation = 0;
@@ -39,40 +39,91 @@ void TaskAddHyperplanes::run()
 
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
+    // The cut pool is only used in the multi-tree strategy when the MIP problem is not recreated in each iteration
+    bool useCutPool = env->settings->getSetting<bool>("HyperplaneCuts.Pool.Use", "Dual")
+        && static_cast<ES_TreeStrategy>(env->settings->getSetting<int>("TreeStrategy", "Dual"))
+            == ES_TreeStrategy::MultiTree
+        && !env->settings->getSetting<bool>("TreeStrategy.Multi.Reinitialize", "Dual");
+
+    if(useCutPool && env->results->getNumberOfIterations() > 1)
+    {
+        env->dualSolver->updateCutPool(
+            env->results->getPreviousIteration()->solutionPoints, currIter->iterationNumber);
+    }
+
     if(!currIter->isMIP() || !env->settings->getSetting<bool>("HyperplaneCuts.Delay", "Dual")
         || !currIter->MIPSolutionLimitUpdated || itersWithoutAddedHPs > 5)
     {
         int addedHyperplanes = 0;
+        int maxHyperplanes = env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual");
 
-        for(auto k = env->dualSolver->hyperplaneWaitingList.size(); k > 0; k--)
-        {
-            if(addedHyperplanes >= env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual"))
-                break;
-
-            auto tmpItem = env->dualSolver->hyperplaneWaitingList.at(k - 1);
+        // The ordinary hyperplanes are added to the MIP solver as blocks. Only the hyperplanes actually created count
+        // towards the maximum, so if some in a block are rejected, the next block fills the remaining slots.
+        auto k = env->dualSolver->hyperplaneWaitingList.size();
 
-            bool cutAddedSuccessfully = false;
+        while(k > 0 && addedHyperplanes < maxHyperplanes)
+        {
+            std::vector<Hyperplane> hyperplanes;
 
-            if(tmpItem.source == E_HyperplaneSource::PrimalSolutionSearchInteriorObjective)
+            for(; k > 0; k--)
             {
-                cutAddedSuccessfully = env->dualSolver->MIPSolver->createInteriorHyperplane(tmpItem);
+                if(addedHyperplanes + (int)hyperplanes.size() >= maxHyperplanes)
+                    break;
+
+                auto& tmpItem = env->dualSolver->hyperplaneWaitingList.at(k - 1);
+
+                if(tmpItem.source == E_HyperplaneSource::PrimalSolutionSearchInteriorObjective)
+                {
+                    if(env->dualSolver->MIPSolver->createInteriorHyperplane(tmpItem))
+                    {
+                        env->dualSolver->addGeneratedHyperplane(tmpItem);
+                        addedHyperplanes++;
+                        this->itersWithoutAddedHPs = 0;
+                    }
+                }
+                else
+                {
+                    hyperplanes.push_back(tmpItem);
+                }
             }
-            else
+
+            if(hyperplanes.size() == 0)
+                continue;
+
+            LinearConstraintBlock createdConstraints;
+            auto constraintIndexes = env->dualSolver->MIPSolver->createHyperplanes(hyperplanes, createdConstraints);
+
+            // The indexes of the created constraints, which are the rows in createdConstraints
+            VectorInteger createdConstraintIndexes;
+            VectorInteger createdHyperplaneIndexes;
+
+            for(size_t i = 0; i < hyperplanes.size(); i++)
             {
-                cutAddedSuccessfully = env->dualSolver->MIPSolver->createHyperplane(tmpItem);
+                if(constraintIndexes[i] >= 0)
+                {
+                    int numberOfGeneratedHyperplanes = env->dualSolver->generatedHyperplanes.size();
+
+                    env->dualSolver->addGeneratedHyperplane(hyperplanes[i]);
+                    addedHyperplanes++;
+                    this->itersWithoutAddedHPs = 0;
+
+                    createdConstraintIndexes.push_back(constraintIndexes[i]);
+                    createdHyperplaneIndexes.push_back(
+                        ((int)env->dualSolver->generatedHyperplanes.size() > numberOfGeneratedHyperplanes)
+                            ? numberOfGeneratedHyperplanes
+                            : -1);
+                }
             }
 
-            if(cutAddedSuccessfully)
+            if(useCutPool)
             {
-                env->dualSolver->addGeneratedHyperplane(tmpItem);
-                addedHyperplanes++;
-                this->itersWithoutAddedHPs = 0;
+                env->dualSolver->addCutsToPool(createdConstraints, createdConstraintIndexes, createdHyperplaneIndexes);
             }
         }
 
         if(!env->settings->getSetting<bool>("TreeStrategy.Multi.Reinitialize", "Dual"))
         {
-            env->dualSolver->hyperplaneWaitingList.clear();
+            env->dualSolver->clearHyperplaneWaitingList();
         }
     }
     else
@@ -48,7 +48,7 @@ void TaskAddIntegerCuts::run()
             numAdded++;
         }
 
-        env->output->outputDebug("        Added " + std::to_string(numAdded) + " integer cuts.");
+        env->output->outputDebug("        Added {} integer cuts.", numAdded);
 
         env->dualSolver->integerCutWaitingList.clear();
     }
@@ -41,11 +41,17 @@ void TaskCalculateSolutionChangeNorm::run()
 
     auto currIterSol = env->results->getCurrentIteration()->hyperplanePoints.at(0);
 
-    for(int i = env->results->getNumberOfIterations() - 2; i >= 1; i--)
+    // Only the iterations in the iteration history are compared with, excluding the first iteration
+    for(int i = env->results->getNumberOfIterations() - 1; i >= 2; i--)
     {
-        if(env->results->getNumberOfIterations() > 0 && !env->results->iterations.at(i)->isMIP())
+        auto prevIter = env->results->getIteration(i);
+
+        if(!prevIter)
+            break;
+
+        if(!prevIter.value()->isMIP())
         {
-            auto prevIterSol = env->results->iterations.at(i)->hyperplanePoints.at(0);
+            auto prevIterSol = prevIter.value()->hyperplanePoints.at(0);
 
             double distance = 0;
 
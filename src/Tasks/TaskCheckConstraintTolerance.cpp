@@ -49,16 +49,14 @@ void TaskCheckConstraintTolerance::run()
     if(env->problem->objectiveFunction->properties.classification > E_ObjectiveFunctionClassification::Quadratic
         && objectiveValueDifference > constraintTolerance)
     {
-        env->output->outputDebug(
-            fmt::format("        Nonlinear objective termination tolerance not fulfilled. Deviation {} > {}.",
-                objectiveValueDifference, constraintTolerance));
+        env->output->outputDebug("        Nonlinear objective termination tolerance not fulfilled. Deviation {} > {}.",
+            objectiveValueDifference, constraintTolerance);
         return;
     }
     else
     {
-        env->output->outputDebug(
-            fmt::format("        Nonlinear objective termination tolerance fulfilled. Deviation {} <= {}.",
-                objectiveValueDifference, constraintTolerance));
+        env->output->outputDebug("        Nonlinear objective termination tolerance fulfilled. Deviation {} <= {}.",
+            objectiveValueDifference, constraintTolerance);
     }
 
     // Checks if the quadratic constraints are fulfilled to tolerance
@@ -19,6 +19,9 @@
 
 #include "../NLPSolver/NLPSolverCuttingPlaneMinimax.h"
 
+#include <algorithm>
+#include <random>
+
 namespace SHOT
 {
 
@@ -109,6 +112,22 @@ void TaskFindInteriorPoint::run()
 
     NLPSolvers.emplace_back(std::make_unique<NLPSolverCuttingPlaneMinimax>(env, env->reformulatedProblem));
 
+    // The additional solvers use copies of the problem, since the nonlinear functions in a problem cannot be evaluated
+    // in several threads at once
+    int numberOfStarts = env->settings->getSetting<int>("ESH.InteriorPoint.MultiStart.Points", "Dual");
+
+    VectorInteger variableIndexes;
+
+    for(auto& V : env->reformulatedProblem->allVariables)
+        variableIndexes.push_back(V->index);
+
+    for(int i = 1; i < numberOfStarts; i++)
+    {
+        NLPSolvers.emplace_back(std::make_unique<NLPSolverCuttingPlaneMinimax>(
+            env, env->reformulatedProblem->createCopy(env), false));
+        NLPSolvers.back()->setStartingPoint(variableIndexes, createStartingPoint(i));
+    }
+
     env->output->outputDebug(" Cutting plane minimax selected as NLP solver.");
 
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
@@ -127,12 +146,24 @@ void TaskFindInteriorPoint::run()
 
     env->output->outputDebug(" Solving NLP problem.");
 
+    // Cbc has state shared between its models, so the minimax problems are then solved one at a time
+    int numberOfThreads = env->settings->getSetting<int>("Threads", "Strategy");
+
+    if(static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual")) == ES_MIPSolver::Cbc)
+        numberOfThreads = 1;
+
+    Utilities::parallelFor(NLPSolvers.size(), numberOfThreads, [&](int i) { NLPSolvers.at(i)->solveProblem(); });
+
+    for(auto& S : NLPSolvers)
+    {
+        env->solutionStatistics.numberOfProblemsMinimaxLP
+            += dynamic_cast<NLPSolverCuttingPlaneMinimax*>(S.get())->getNumberOfSolvedLPProblems();
+    }
+
     bool foundNLPPoint = false;
 
     for(size_t i = 0; i < NLPSolvers.size(); i++)
     {
-        NLPSolvers.at(i)->solveProblem();
-
         if(NLPSolvers.at(i)->getSolution().size() == 0)
             continue;
 
@@ -157,6 +188,12 @@ void TaskFindInteriorPoint::run()
                 Utilities::saveVariablePointVectorToFile(tmpIP->point, variableNames, filename);
             }
         }
+        else if(std::any_of(env->dualSolver->interiorPts.begin(), env->dualSolver->interiorPts.end(),
+                    [&](auto& IP) { return (Utilities::L2Norm(IP->point, tmpIP->point) < 1e-6); }))
+        {
+            // Several starting points may give the same interior point
+            env->output->outputDebug(" Interior point from start {} is the same as a previous one.", i);
+        }
         else
         {
             env->output->outputInfo("\n Valid interior point with constraint deviation "
@@ -190,6 +227,39 @@ void TaskFindInteriorPoint::run()
     env->timing->stopTimer("InteriorPointSearch");
 }
 
+VectorDouble TaskFindInteriorPoint::createStartingPoint(int start)
+{
+    // The same points are used in each run
+    std::mt19937 generator(start);
+
+    VectorDouble point;
+
+    for(auto& V : env->reformulatedProblem->allVariables)
+    {
+        // Unbounded directions are restricted to a unit distance from the other bound, or from zero
+        double lowerBound = V->lowerBound;
+        double upperBound = V->upperBound;
+
+        if(lowerBound < -1e10 && upperBound > 1e10)
+        {
+            lowerBound = -1.0;
+            upperBound = 1.0;
+        }
+        else if(lowerBound < -1e10)
+        {
+            lowerBound = upperBound - 1.0;
+        }
+        else if(upperBound > 1e10)
+        {
+            upperBound = lowerBound + 1.0;
+        }
+
+        point.push_back(std::uniform_real_distribution<double>(lowerBound, upperBound)(generator));
+    }
+
+    return (point);
+}
+
 std::string TaskFindInteriorPoint::getType()
 {
     std::string type = typeid(this).name();
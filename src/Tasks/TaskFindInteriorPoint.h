@@ -32,5 +32,8 @@ private:
     std::vector<std::unique_ptr<INLPSolver>> NLPSolvers;
 
     VectorString variableNames;
+
+    // A random point within the variable bounds for the given start, used as starting point in the minimax solver
+    VectorDouble createStartingPoint(int start);
 };
 } // namespace SHOT
\ No newline at end of file
@@ -127,23 +127,25 @@ void TaskPerformBoundTightening::createPOA()
 
     int hyperplaneCounter = 0;
 
-    for(auto& HP : this->POASolver->solver->getEnvironment()->dualSolver->generatedHyperplanes)
-    {
-        Hyperplane newHP;
+    auto POADualSolver = this->POASolver->solver->getEnvironment()->dualSolver;
+
+    // Only the values needed for the source constraint are updated in the point for each hyperplane
+    Hyperplane newHP;
 
+    for(auto& HP : POADualSolver->generatedHyperplanes)
+    {
         if(HP.source == E_HyperplaneSource::ObjectiveCuttingPlane
-            || HP.source == E_HyperplaneSource::ObjectiveRootsearch)
+            || HP.source == E_HyperplaneSource::ObjectiveRootsearch || HP.generatedPointHandle < 0)
             continue;
 
         newHP.source = HP.source;
         newHP.sourceConstraintIndex = HP.sourceConstraintIndex;
         newHP.sourceConstraint
             = std::dynamic_pointer_cast<NumericConstraint>(sourceProblem->getConstraint(HP.sourceConstraintIndex));
-        newHP.generatedPoint = HP.generatedPoint;
+        POADualSolver->getGeneratedHyperplanePoint(HP, newHP.generatedPoint);
         newHP.isSourceConvex = HP.isSourceConvex;
-        newHP.objectiveFunctionValue = sourceProblem->objectiveFunction->calculateValue(newHP.generatedPoint);
 
-        auto optional = this->POASolver->solver->getEnvironment()->dualSolver->MIPSolver->createHyperplaneTerms(newHP);
+        auto optional = POADualSolver->MIPSolver->createHyperplaneTerms(newHP);
 
         if(!optional)
             continue;
@@ -24,8 +24,7 @@ namespace SHOT
 
 TaskSelectHyperplanePointsECP::TaskSelectHyperplanePointsECP(EnvironmentPtr envPtr) : TaskBase(envPtr)
 {
-    env->timing->startTimer("DualCutGenerationRootSearch");
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    rootsearchTimer = env->timing->getTimerHandle("DualCutGenerationRootSearch");
 }
 
 TaskSelectHyperplanePointsECP::~TaskSelectHyperplanePointsECP() = default;
@@ -39,7 +38,7 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
 
     env->output->outputDebug("        Selecting cutting planes using the ECP method:");
 
-    env->timing->startTimer("DualCutGenerationRootSearch");
+    env->timing->startTimer(rootsearchTimer);
 
     int addedHyperplanes = 0;
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
@@ -68,7 +67,7 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
         {
             if(addedHyperplanes >= maxHyperplanesPerIter)
             {
-                env->timing->stopTimer("DualCutGenerationRootSearch");
+                env->timing->stopTimer(rootsearchTimer);
                 break;
             }
 
@@ -94,8 +93,8 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
 
             if(env->dualSolver->hasHyperplaneBeenAdded(hash, NCV.constraint->index))
             {
-                env->output->outputDebug("         Hyperplane already added for constraint "
-                    + std::to_string(NCV.constraint->index) + " and hash " + std::to_string(hash));
+                env->output->outputDebug("         Hyperplane already added for constraint {} and hash {}",
+                    NCV.constraint->index, hash);
                 continue;
             }
 
@@ -142,17 +141,16 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
         addedHyperplanes++;
         hyperplaneAddedToConstraint.at(NCV.constraint->index) = true;
 
-        env->output->outputDebug(
-            fmt::format("         Added hyperplane for constraint {} to waiting list with deviation {}",
-                NCV.constraint->name, NCV.error));
+        env->output->outputDebug("         Added hyperplane for constraint {} to waiting list with deviation {}",
+            NCV.constraint->name, NCV.error);
     }
 
     std::vector<std::pair<Hyperplane, double>> hyperplanesCuttingAwayPrimals;
 
     if(addedHyperplanes == 0)
     {
-        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: "
-            + std::to_string(nonconvexSelectedNumericValues.size()));
+        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: {}",
+            nonconvexSelectedNumericValues.size());
 
         for(auto& values : nonconvexSelectedNumericValues)
         {
@@ -210,8 +208,8 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
             if(!cutsAwayPrimalSolution)
             {
                 env->output->outputDebug(
-                    fmt::format("         Added hyperplane for constraint {} to waiting list with deviation {}",
-                        NCV.constraint->name, NCV.error));
+                    "         Added hyperplane for constraint {} to waiting list with deviation {}",
+                    NCV.constraint->name, NCV.error);
 
                 env->dualSolver->addHyperplane(hyperplane);
                 hyperplaneAddedToConstraint.at(NCV.constraint->index) = true;
@@ -230,9 +228,9 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
             env->dualSolver->addHyperplane(HP.first);
             hyperplaneAddedToConstraint.at(HP.first.sourceConstraint->index) = true;
             addedHyperplanes++;
-            env->output->outputDebug(fmt::format("         Selected hyperplane cut for constraint {} that cuts away "
-                                                 "previous primal solution with error {}",
-                HP.first.sourceConstraint->index, HP.second));
+            env->output->outputDebug("         Selected hyperplane cut for constraint {} that cuts away "
+                                     "previous primal solution with error {}",
+                HP.first.sourceConstraint->index, HP.second);
 
             addedHyperplanes++;
 
@@ -246,7 +244,7 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         All nonlinear constraints fulfilled, so no constraint cuts added.");
     }
 
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    env->timing->stopTimer(rootsearchTimer);
 }
 
 std::string TaskSelectHyperplanePointsECP::getType()
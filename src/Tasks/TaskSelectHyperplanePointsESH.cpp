@@ -13,6 +13,7 @@
 #include "../DualSolver.h"
 #include "../MIPSolver/IMIPSolver.h"
 #include "../Output.h"
+#include "../PrimalSolver.h"
 #include "../Results.h"
 #include "../Settings.h"
 #include "../Utilities.h"
@@ -28,8 +29,7 @@ namespace SHOT
 
 TaskSelectHyperplanePointsESH::TaskSelectHyperplanePointsESH(EnvironmentPtr envPtr) : TaskBase(envPtr)
 {
-    env->timing->startTimer("DualCutGenerationRootSearch");
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    rootsearchTimer = env->timing->getTimerHandle("DualCutGenerationRootSearch");
 }
 
 TaskSelectHyperplanePointsESH::~TaskSelectHyperplanePointsESH() = default;
@@ -43,7 +43,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
     env->output->outputDebug("        Selecting separating hyperplanes using the ESH method:");
 
-    env->timing->startTimer("DualCutGenerationRootSearch");
+    env->timing->startTimer(rootsearchTimer);
 
     if(env->dualSolver->interiorPts.size() == 0)
     {
@@ -53,7 +53,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         Adding cutting plane since no interior point is known.");
         tSelectHPPts->run(solPoints);
 
-        env->timing->stopTimer("DualCutGenerationRootSearch");
+        env->timing->stopTimer(rootsearchTimer);
         return;
     }
     else if(env->solutionStatistics.numberOfIterationsWithDualStagnation > 2
@@ -65,7 +65,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         Adding cutting plane since the dual has stagnated.");
         tSelectHPPts->run(solPoints);
 
-        env->timing->stopTimer("DualCutGenerationRootSearch");
+        env->timing->stopTimer(rootsearchTimer);
         return;
     }
 
@@ -76,10 +76,6 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         = env->settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
     bool useUniqueConstraints = env->settings->getSetting<bool>("ESH.Rootsearch.UniqueConstraints", "Dual");
 
-    int rootMaxIter = env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver");
-    double rootTerminationTolerance = env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver");
-    double rootActiveConstraintTolerance
-        = env->settings->getSetting<double>("Rootsearch.ActiveConstraintTolerance", "Subsolver");
     int maxHyperplanesPerIter = env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual");
     double rootsearchConstraintTolerance
         = env->settings->getSetting<double>("ESH.Rootsearch.ConstraintTolerance", "Dual");
@@ -93,26 +89,62 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
     std::vector<std::tuple<int, int, NumericConstraintValue>> selectedNumericValues;
     std::vector<std::tuple<int, int, NumericConstraintValue>> nonconvexSelectedNumericValues;
 
+    // The nonlinear constraints are evaluated in all solution points at once
+    PointBatch points(env->reformulatedProblem->properties.numberOfVariables, solPoints.size());
+
+    for(size_t i = 0; i < solPoints.size(); i++)
+        points.setPoint(i, solPoints.at(i).point);
+
+    auto deviatingConstraintValues = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(
+        points, 0.0, constraintSelectionFactor);
+
+    // With interior points from several starting points, only the one closest to the solution point is used, since it
+    // gives the shortest root search segment
+    bool useClosestInteriorPoint = env->settings->getSetting<int>("ESH.InteriorPoint.MultiStart.Points", "Dual") > 1;
+
     for(size_t i = 0; i < solPoints.size(); i++)
     {
-        auto numericConstraintValues = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(
-            solPoints.at(i).point, 0.0, constraintSelectionFactor);
+        auto& numericConstraintValues = deviatingConstraintValues.at(i);
 
         if(numericConstraintValues.size() == 0)
         {
             continue;
         }
 
+        size_t closestInteriorPoint = 0;
+
+        if(useClosestInteriorPoint)
+        {
+            double shortestDistance = SHOT_DBL_MAX;
+
+            for(size_t j = 0; j < env->dualSolver->interiorPts.size(); j++)
+            {
+                double distance = Utilities::L2Norm(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point);
+
+                if(distance < shortestDistance)
+                {
+                    shortestDistance = distance;
+                    closestInteriorPoint = j;
+                }
+            }
+        }
+
         for(auto& NCV : numericConstraintValues)
         {
             for(size_t j = 0; j < env->dualSolver->interiorPts.size(); j++)
             {
-                if(addedHyperplanes >= maxHyperplanesPerIter)
+                // The root searches are done for the selected values only, so no more are selected than the number of
+                // hyperplanes that can be added
+                if((int)selectedNumericValues.size() >= maxHyperplanesPerIter)
                 {
-                    env->timing->stopTimer("DualCutGenerationRootSearch");
                     break;
                 }
 
+                if(useClosestInteriorPoint && j != closestInteriorPoint)
+                {
+                    continue;
+                }
+
                 // Do not add hyperplane if one has been added for this constraint already
                 if(useUniqueConstraints && hyperplaneAddedToConstraint.at(NCV.constraint->index))
                 {
@@ -139,7 +171,9 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
                 if(NCV.constraint->properties.convexity != E_Convexity::Convex)
                 {
-                    nonconvexSelectedNumericValues.emplace_back(i, j, NCV);
+                    if((int)nonconvexSelectedNumericValues.size() < maxHyperplanesPerIter)
+                        nonconvexSelectedNumericValues.emplace_back(i, j, NCV);
+
                     continue;
                 }
 
@@ -148,11 +182,12 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         }
     }
 
-    for(auto& values : selectedNumericValues)
+    auto roots = performRootsearches(solPoints, selectedNumericValues);
+
+    for(size_t k = 0; k < selectedNumericValues.size(); k++)
     {
-        int i = std::get<0>(values);
-        int j = std::get<1>(values);
-        auto NCV = std::get<2>(values);
+        int i = std::get<0>(selectedNumericValues[k]);
+        auto NCV = std::get<2>(selectedNumericValues[k]);
 
         if(NCV.error <= 0.0)
             continue;
@@ -160,23 +195,16 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         VectorDouble externalPoint;
         VectorDouble internalPoint;
 
-        std::vector<NumericConstraint*> currentConstraint;
-        currentConstraint.push_back(std::dynamic_pointer_cast<NumericConstraint>(NCV.constraint).get());
-
-        try
+        if(roots[k])
         {
-            env->timing->startTimer("DualCutGenerationRootSearch");
-            auto xNewc
-                = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                    rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
-
-            env->timing->stopTimer("DualCutGenerationRootSearch");
-            internalPoint = xNewc.first;
-            externalPoint = xNewc.second;
+            internalPoint = roots[k]->first;
+            externalPoint = roots[k]->second;
+
+            env->primalSolver->addPrimalSolutionCandidate(
+                internalPoint, E_PrimalSolutionSource::Rootsearch, currIter->iterationNumber);
         }
-        catch(std::exception&)
+        else
         {
-            env->timing->stopTimer("DualCutGenerationRootSearch");
             externalPoint = solPoints.at(i).point;
 
             env->output->outputDebug("         Cannot find solution with rootsearch, using solution point instead.");
@@ -190,8 +218,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
             if(env->dualSolver->hasHyperplaneBeenAdded(hash, externalConstraintValue.constraint->index))
             {
-                env->output->outputDebug("         Hyperplane already added for constraint "
-                    + std::to_string(externalConstraintValue.constraint->index) + " and hash " + std::to_string(hash));
+                env->output->outputDebug("         Hyperplane already added for constraint {} and hash {}",
+                    externalConstraintValue.constraint->index, hash);
                 continue;
             }
 
@@ -222,8 +250,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
             hyperplaneAddedToConstraint.at(externalConstraintValue.constraint->index) = true;
 
-            env->output->outputDebug("         Added hyperplane to waiting list with deviation: "
-                + Utilities::toString(externalConstraintValue.error));
+            env->output->outputDebug("         Added hyperplane to waiting list with deviation: {:.3f}",
+                externalConstraintValue.error);
 
             hyperplane.generatedPoint.clear();
 
@@ -231,23 +259,24 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         }
         else
         {
-            env->output->outputDebug("         Could not add hyperplane to waiting list since constraint value is "
-                + std::to_string(externalConstraintValue.normalizedValue));
+            env->output->outputDebug("         Could not add hyperplane to waiting list since constraint value is {}",
+                externalConstraintValue.normalizedValue);
         }
     }
 
     if(addedHyperplanes == 0)
     {
-        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: "
-            + std::to_string(nonconvexSelectedNumericValues.size()));
-        for(auto& values : nonconvexSelectedNumericValues)
+        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: {}",
+            nonconvexSelectedNumericValues.size());
+        auto nonconvexRoots = performRootsearches(solPoints, nonconvexSelectedNumericValues);
+
+        for(size_t k = 0; k < nonconvexSelectedNumericValues.size(); k++)
         {
             if(addedHyperplanes > maxHyperplanesPerIter)
                 break;
 
-            int i = std::get<0>(values);
-            int j = std::get<1>(values);
-            auto NCV = std::get<2>(values);
+            int i = std::get<0>(nonconvexSelectedNumericValues[k]);
+            auto NCV = std::get<2>(nonconvexSelectedNumericValues[k]);
 
             if(NCV.error <= 0.0)
                 continue;
@@ -255,23 +284,16 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             VectorDouble externalPoint;
             VectorDouble internalPoint;
 
-            std::vector<NumericConstraint*> currentConstraint;
-            currentConstraint.push_back(std::dynamic_pointer_cast<NumericConstraint>(NCV.constraint).get());
-
-            try
+            if(nonconvexRoots[k])
             {
-                env->timing->startTimer("DualCutGenerationRootSearch");
-                auto xNewc
-                    = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
-
-                env->timing->stopTimer("DualCutGenerationRootSearch");
-                internalPoint = xNewc.first;
-                externalPoint = xNewc.second;
+                internalPoint = nonconvexRoots[k]->first;
+                externalPoint = nonconvexRoots[k]->second;
+
+                env->primalSolver->addPrimalSolutionCandidate(
+                    internalPoint, E_PrimalSolutionSource::Rootsearch, currIter->iterationNumber);
             }
-            catch(std::exception&)
+            else
             {
-                env->timing->stopTimer("DualCutGenerationRootSearch");
                 externalPoint = solPoints.at(i).point;
 
                 env->output->outputDebug(
@@ -286,9 +308,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
                 if(env->dualSolver->hasHyperplaneBeenAdded(hash, externalConstraintValue.constraint->index))
                 {
-                    env->output->outputTrace("         Hyperplane already added for constraint "
-                        + std::to_string(externalConstraintValue.constraint->index) + " and hash "
-                        + std::to_string(hash));
+                    env->output->outputTrace("         Hyperplane already added for constraint {} and hash {}",
+                        externalConstraintValue.constraint->index, hash);
                     continue;
                 }
 
@@ -320,15 +341,16 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
                 hyperplaneAddedToConstraint.at(externalConstraintValue.constraint->index) = true;
 
-                env->output->outputDebug("         Added hyperplane to waiting list with deviation: "
-                    + Utilities::toString(externalConstraintValue.error));
+                env->output->outputDebug("         Added hyperplane to waiting list with deviation: {:.3f}",
+                    externalConstraintValue.error);
 
                 hyperplane.generatedPoint.clear();
             }
             else
             {
-                env->output->outputDebug("         Could not add hyperplane to waiting list since constraint value is "
-                    + std::to_string(externalConstraintValue.normalizedValue));
+                env->output->outputDebug(
+                    "         Could not add hyperplane to waiting list since constraint value is {}",
+                    externalConstraintValue.normalizedValue);
             }
         }
     }
@@ -337,17 +359,18 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
     if(addedHyperplanes == 0)
     {
-        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: "
-            + std::to_string(nonconvexSelectedNumericValues.size()));
+        env->output->outputDebug("         Could not add hyperplane for convex constraints, number of nonconvex: {}",
+            nonconvexSelectedNumericValues.size());
+
+        auto nonconvexRoots = performRootsearches(solPoints, nonconvexSelectedNumericValues);
 
-        for(auto& values : nonconvexSelectedNumericValues)
+        for(size_t k = 0; k < nonconvexSelectedNumericValues.size(); k++)
         {
             if(addedHyperplanes > maxHyperplanesPerIter)
                 break;
 
-            int i = std::get<0>(values);
-            int j = std::get<1>(values);
-            auto NCV = std::get<2>(values);
+            int i = std::get<0>(nonconvexSelectedNumericValues[k]);
+            auto NCV = std::get<2>(nonconvexSelectedNumericValues[k]);
 
             if(NCV.error <= 0.0)
                 continue;
@@ -355,23 +378,16 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             VectorDouble externalPoint;
             VectorDouble internalPoint;
 
-            std::vector<NumericConstraint*> currentConstraint;
-            currentConstraint.push_back(std::dynamic_pointer_cast<NumericConstraint>(NCV.constraint).get());
-
-            try
+            if(nonconvexRoots[k])
             {
-                env->timing->startTimer("DualCutGenerationRootSearch");
-                auto xNewc
-                    = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(j)->point, solPoints.at(i).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
-
-                env->timing->stopTimer("DualCutGenerationRootSearch");
-                internalPoint = xNewc.first;
-                externalPoint = xNewc.second;
+                internalPoint = nonconvexRoots[k]->first;
+                externalPoint = nonconvexRoots[k]->second;
+
+                env->primalSolver->addPrimalSolutionCandidate(
+                    internalPoint, E_PrimalSolutionSource::Rootsearch, currIter->iterationNumber);
             }
-            catch(std::exception&)
+            else
             {
-                env->timing->stopTimer("DualCutGenerationRootSearch");
                 externalPoint = solPoints.at(i).point;
 
                 env->output->outputDebug(
@@ -386,9 +402,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
                 if(env->dualSolver->hasHyperplaneBeenAdded(hash, externalConstraintValue.constraint->index))
                 {
-                    env->output->outputTrace("         Hyperplane already added for constraint "
-                        + std::to_string(externalConstraintValue.constraint->index) + " and hash "
-                        + std::to_string(hash));
+                    env->output->outputTrace("         Hyperplane already added for constraint {} and hash {}",
+                        externalConstraintValue.constraint->index, hash);
                     continue;
                 }
 
@@ -420,8 +435,8 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
                 hyperplaneAddedToConstraint.at(externalConstraintValue.constraint->index) = true;
 
-                env->output->outputDebug("         Added hyperplane to waiting list with deviation: "
-                    + Utilities::toString(externalConstraintValue.error));
+                env->output->outputDebug("         Added hyperplane to waiting list with deviation: {:.3f}",
+                    externalConstraintValue.error);
 
                 bool cutsAwayPrimalSolution = false;
 
@@ -454,8 +469,9 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             }
             else
             {
-                env->output->outputDebug("         Could not add hyperplane to waiting list since constraint value is "
-                    + std::to_string(externalConstraintValue.normalizedValue));
+                env->output->outputDebug(
+                    "         Could not add hyperplane to waiting list since constraint value is {}",
+                    externalConstraintValue.normalizedValue);
             }
         }
     }
@@ -471,17 +487,17 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
             if(env->dualSolver->hasHyperplaneBeenAdded(hash, HP.first.sourceConstraintIndex))
             {
-                env->output->outputTrace("         Hyperplane already added for constraint "
-                    + std::to_string(HP.first.sourceConstraintIndex) + " and hash " + std::to_string(hash));
+                env->output->outputTrace("         Hyperplane already added for constraint {} and hash {}",
+                    HP.first.sourceConstraintIndex, hash);
                 continue;
             }
 
             env->dualSolver->addHyperplane(HP.first);
             hyperplaneAddedToConstraint.at(HP.first.sourceConstraint->index) = true;
             addedHyperplanes++;
-            env->output->outputDebug(fmt::format("         Selected hyperplane cut for constraint {} that cuts away "
-                                                 "previous primal solution with error {}",
-                HP.first.sourceConstraint->index, HP.second));
+            env->output->outputDebug("         Selected hyperplane cut for constraint {} that cuts away "
+                                     "previous primal solution with error {}",
+                HP.first.sourceConstraint->index, HP.second);
 
             addedHyperplanes++;
 
@@ -495,7 +511,46 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         All nonlinear constraints fulfilled, so no constraint cuts added.");
     }
 
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    env->timing->stopTimer(rootsearchTimer);
+}
+
+std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> TaskSelectHyperplanePointsESH::performRootsearches(
+    const std::vector<SolutionPoint>& solPoints,
+    const std::vector<std::tuple<int, int, NumericConstraintValue>>& selectedNumericValues)
+{
+    int rootMaxIter = env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver");
+    double rootTerminationTolerance = env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver");
+
+    std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> roots(selectedNumericValues.size());
+
+    env->timing->startTimer(rootsearchTimer);
+
+    // The root searches are independent, and the results are stored in the same order as the selected values so that
+    // the hyperplanes are added in the same order regardless of the number of threads
+    Utilities::parallelFor(selectedNumericValues.size(), env->settings->getSetting<int>("Threads", "Strategy"),
+        [&](int k) {
+            int i = std::get<0>(selectedNumericValues[k]);
+            int j = std::get<1>(selectedNumericValues[k]);
+            auto& NCV = std::get<2>(selectedNumericValues[k]);
+
+            if(NCV.error <= 0.0)
+                return;
+
+            std::vector<NumericConstraint*> currentConstraint { NCV.constraint.get() };
+
+            try
+            {
+                roots[k] = env->rootsearchMethod->findZeroConcurrently(env->dualSolver->interiorPts.at(j)->point,
+                    solPoints.at(i).point, rootMaxIter, rootTerminationTolerance, currentConstraint);
+            }
+            catch(std::exception&)
+            {
+            }
+        });
+
+    env->timing->stopTimer(rootsearchTimer);
+
+    return (roots);
 }
 
 std::string TaskSelectHyperplanePointsESH::getType()
@@ -10,12 +10,17 @@
 
 #pragma once
 #include "TaskBase.h"
+#include "../Timing.h"
+
+#include <optional>
+#include <tuple>
 
 namespace SHOT
 {
 
 class Constraint;
 class TaskSelectHyperplanePointsECP;
+struct NumericConstraintValue;
 
 class TaskSelectHyperplanePointsESH : public TaskBase
 {
@@ -30,6 +35,13 @@ public:
 
 private:
     std::unique_ptr<TaskSelectHyperplanePointsECP> tSelectHPPts;
+    TimerHandle rootsearchTimer;
     std::vector<Constraint*> nonlinearConstraints;
+
+    // Performs the root searches between the interior and solution points given in the selected values in parallel.
+    // An empty result means that the root search failed.
+    std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> performRootsearches(
+        const std::vector<SolutionPoint>& solPoints,
+        const std::vector<std::tuple<int, int, NumericConstraintValue>>& selectedNumericValues);
 };
 } // namespace SHOT
\ No newline at end of file
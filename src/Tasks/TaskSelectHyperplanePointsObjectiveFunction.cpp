@@ -27,6 +27,7 @@ namespace SHOT
 TaskSelectHyperplanePointsObjectiveFunction::TaskSelectHyperplanePointsObjectiveFunction(EnvironmentPtr envPtr)
     : TaskBase(envPtr)
 {
+    rootsearchTimer = env->timing->getTimerHandle("DualObjectiveRootSearch");
 }
 
 TaskSelectHyperplanePointsObjectiveFunction::~TaskSelectHyperplanePointsObjectiveFunction() = default;
@@ -91,7 +92,7 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
 
     if(useRootsearch)
     {
-        env->timing->startTimer("DualObjectiveRootSearch");
+        env->timing->startTimer(rootsearchTimer);
 
         for(auto& SOLPT : sourcePoints)
         {
@@ -143,17 +144,17 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
             {
                 env->output->outputWarning(
                     "        Cannot find solution with root search for generating supporting objective hyperplane.");
-                env->output->outputDebug(fmt::format("        {}", e.what()));
+                env->output->outputDebug("        {}", e.what());
             }
         }
 
-        env->timing->stopTimer("DualObjectiveRootSearch");
+        env->timing->stopTimer(rootsearchTimer);
     }
 
     if(numHyperplaneAdded > 0)
     {
-        env->output->outputDebug(fmt::format(
-            "        Added {} separating hyperplanes for objective function to waiting list.", numHyperplaneAdded));
+        env->output->outputDebug("        Added {} separating hyperplanes for objective function to waiting list.",
+            numHyperplaneAdded);
     }
     else
     {
@@ -172,8 +173,8 @@ void TaskSelectHyperplanePointsObjectiveFunction::run(std::vector<SolutionPoint>
             env->dualSolver->addHyperplane(hyperplane);
         }
 
-        env->output->outputDebug(
-            fmt::format("        Added {} cutting planes for objective function to waiting list.", numHyperplaneAdded));
+        env->output->outputDebug("        Added {} cutting planes for objective function to waiting list.",
+            numHyperplaneAdded);
     }
 }
 
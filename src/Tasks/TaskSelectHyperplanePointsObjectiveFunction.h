@@ -10,6 +10,7 @@
 
 #pragma once
 #include "TaskBase.h"
+#include "../Timing.h"
 
 #include "../Structs.h"
 
@@ -26,5 +27,8 @@ public:
     void run() override;
     virtual void run(std::vector<SolutionPoint> solPoints);
     std::string getType() override;
+
+private:
+    TimerHandle rootsearchTimer;
 };
 } // namespace SHOT
\ No newline at end of file
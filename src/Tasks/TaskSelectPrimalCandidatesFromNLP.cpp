@@ -47,6 +47,8 @@ TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(Environment
     env->timing->startTimer("PrimalStrategy");
     env->timing->startTimer("PrimalBoundStrategyNLP");
 
+    primalNLPHistogram = env->timing->getHistogramHandle("PrimalNLP");
+
     originalNLPTime = env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
     originalNLPIter = env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal");
 
@@ -146,14 +148,46 @@ TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(Environment
         NLPSolver->updateVariableUpperBound(V->index, V->upperBound);
     }
 
+    if(env->settings->getSetting<bool>("FixedInteger.Asynchronous.Use", "Primal"))
+        startAsynchronousWorkers();
+
     env->timing->stopTimer("PrimalBoundStrategyNLP");
     env->timing->stopTimer("PrimalStrategy");
 }
 
-TaskSelectPrimalCandidatesFromNLP::~TaskSelectPrimalCandidatesFromNLP() = default;
+TaskSelectPrimalCandidatesFromNLP::~TaskSelectPrimalCandidatesFromNLP()
+{
+    if(!asynchronousWorkers)
+        return;
+
+    // The workers finish the problems they are solving, which are limited by FixedInteger.TimeLimit, and are stopped
+    // when the tasks sharing them have been removed
+    asynchronousWorkers->discardJobs(this);
+    asynchronousWorkers->waitForJobs(this);
+}
 
 void TaskSelectPrimalCandidatesFromNLP::run()
 {
+    if(asynchronousWorkers)
+    {
+        env->timing->startTimer("PrimalStrategy");
+        env->timing->startTimer("PrimalBoundStrategyNLP");
+
+        if(env->primalSolver->fixedPrimalNLPCandidates.size() == 0
+            || env->results->getRelativeGlobalObjectiveGap() < 1e-10)
+            env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP++;
+        else
+            queueFixedNLPProblems();
+
+        // When the solution is finalized, the problems already queued are solved so that their solutions are used
+        processSolvedFixedNLPProblems(env->results->terminationReason != E_TerminationReason::None);
+
+        env->timing->stopTimer("PrimalBoundStrategyNLP");
+        env->timing->stopTimer("PrimalStrategy");
+
+        return;
+    }
+
     if(env->primalSolver->fixedPrimalNLPCandidates.size() == 0)
     {
         env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP++;
@@ -187,8 +221,6 @@ bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
 {
     auto currIter = env->results->getCurrentIteration();
 
-    std::vector<PrimalFixedNLPCandidate> testPts;
-
     env->output->outputDebug("        Solving fixed NLP problem:");
 
     if(env->primalSolver->fixedPrimalNLPCandidates.size() == 0)
@@ -202,342 +234,486 @@ bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
 
     for(auto& CAND : env->primalSolver->fixedPrimalNLPCandidates)
     {
-        VectorDouble fixedVariableValues(discreteVariableIndexes.size());
+        auto problem = createFixedNLPProblem(CAND, currIter->iterationNumber, counter);
+        solveFixedNLPProblem(*NLPSolver, problem);
+        processFixedNLPSolution(problem);
 
-        int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
+        env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
+        env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
+        counter++;
 
-        // TODO: remove?
-        if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
-        {
-            env->output->outputDebug("         Updating variable bounds from MIP presolve.");
-            for(auto& V : env->reformulatedProblem->allVariables)
-            {
-                if(V->index > sizeOfVariableVector)
-                    continue;
-
-                if(V->properties.hasUpperBoundBeenTightened)
-                {
-                    NLPSolver->updateVariableUpperBound(V->index, V->upperBound);
-                }
-
-                if(V->properties.hasLowerBoundBeenTightened)
-                {
-                    NLPSolver->updateVariableLowerBound(V->index, V->upperBound);
-                }
-            }
-        }
+        env->primalSolver->addUsedFixedNLPCandidate(CAND);
+    }
 
-        VectorInteger startingPointIndexes(sizeOfVariableVector);
-        VectorDouble startingPointValues(sizeOfVariableVector);
+    return (true);
+}
 
-        // Sets the fixed values for discrete variables
-        for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
-        {
-            int currVarIndex = discreteVariableIndexes.at(k);
+TaskSelectPrimalCandidatesFromNLP::FixedNLPProblem TaskSelectPrimalCandidatesFromNLP::createFixedNLPProblem(
+    const PrimalFixedNLPCandidate& candidate, int iterationNumber, int counter)
+{
+    FixedNLPProblem problem;
+    problem.candidate = candidate;
+    problem.iterationNumber = iterationNumber;
+    problem.counter = counter;
+    problem.fixedVariableValues.resize(discreteVariableIndexes.size());
 
-            auto tmpSolPt = std::round(CAND.point.at(currVarIndex));
+    int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
 
-            fixedVariableValues.at(k) = tmpSolPt;
+    // TODO: remove?
+    if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
+    {
+        env->output->outputDebug("         Updating variable bounds from MIP presolve.");
+        for(auto& V : env->reformulatedProblem->allVariables)
+        {
+            if(V->index > sizeOfVariableVector)
+                continue;
 
-            // Sets the starting point to the fixed value
-            if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
+            if(V->properties.hasUpperBoundBeenTightened)
             {
-                startingPointIndexes.at(currVarIndex) = currVarIndex;
-                startingPointValues.at(currVarIndex) = tmpSolPt;
+                problem.upperBoundUpdates.emplace_back(V->index, V->upperBound);
             }
-        }
-
-        if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
-        {
-            env->output->outputDebug(
-                "         Setting warm start for continuous variable to candidate solution value.");
 
-            for(auto& V : sourceProblem->realVariables)
+            if(V->properties.hasLowerBoundBeenTightened)
             {
-                startingPointIndexes.at(V->index) = V->index;
-                startingPointValues.at(V->index) = CAND.point.at(V->index);
+                problem.lowerBoundUpdates.emplace_back(V->index, V->upperBound);
             }
+        }
+    }
 
-            if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
-            {
-                std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output")
-                    + "/primalnlp_warmstart" + std::to_string(currIter->iterationNumber) + "_" + std::to_string(counter)
-                    + ".txt";
+    bool useWarmstart = env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal");
 
-                Utilities::saveVariablePointVectorToFile(startingPointValues, variableNames, filename);
-            }
+    if(useWarmstart)
+    {
+        problem.startingPointIndexes.resize(sizeOfVariableVector);
+        problem.startingPointValues.resize(sizeOfVariableVector);
+    }
+
+    // Sets the fixed values for discrete variables
+    for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
+    {
+        int currVarIndex = discreteVariableIndexes.at(k);
+
+        auto tmpSolPt = std::round(candidate.point.at(currVarIndex));
 
-            NLPSolver->setStartingPoint(startingPointIndexes, startingPointValues);
+        problem.fixedVariableValues.at(k) = tmpSolPt;
+
+        // Sets the starting point to the fixed value
+        if(useWarmstart)
+        {
+            problem.startingPointIndexes.at(currVarIndex) = currVarIndex;
+            problem.startingPointValues.at(currVarIndex) = tmpSolPt;
         }
+    }
 
-        NLPSolver->fixVariables(discreteVariableIndexes, fixedVariableValues);
+    if(useWarmstart)
+    {
+        env->output->outputDebug("         Setting warm start for continuous variable to candidate solution value.");
+
+        for(auto& V : sourceProblem->realVariables)
+        {
+            problem.startingPointIndexes.at(V->index) = V->index;
+            problem.startingPointValues.at(V->index) = candidate.point.at(V->index);
+        }
 
         if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
-            std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
-                + std::to_string(currIter->iterationNumber) + "_" + std::to_string(counter);
-            NLPSolver->saveProblemToFile(filename + ".txt");
-            NLPSolver->saveOptionsToFile(filename + ".osrl");
+            std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output")
+                + "/primalnlp_warmstart" + std::to_string(iterationNumber) + "_" + std::to_string(counter) + ".txt";
+
+            Utilities::saveVariablePointVectorToFile(problem.startingPointValues, variableNames, filename);
         }
+    }
 
-        auto solvestatus = NLPSolver->solveProblem();
+    return (problem);
+}
 
-        NLPSolver->unfixVariables();
-        env->solutionStatistics.numberOfProblemsFixedNLP++;
+void TaskSelectPrimalCandidatesFromNLP::solveFixedNLPProblem(INLPSolver& solver, FixedNLPProblem& problem)
+{
+    for(auto& B : problem.upperBoundUpdates)
+        solver.updateVariableUpperBound(B.index, B.value);
 
-        std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
+    for(auto& B : problem.lowerBoundUpdates)
+        solver.updateVariableLowerBound(B.index, B.value);
 
-        std::string sourceDesc;
-        switch(CAND.sourceType)
-        {
-        case E_PrimalNLPSource::FirstSolution:
-            env->output->outputDebug("         Source from candidate point is first MIP solution point.");
-            sourceDesc = "SOLPT-" + source;
-            break;
-        case E_PrimalNLPSource::FeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is MIP solution pool.");
-            sourceDesc = "FEASP-" + source;
-            break;
-        case E_PrimalNLPSource::InfeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
-            sourceDesc = "UNFEA-" + source;
-            break;
-        case E_PrimalNLPSource::SmallestDeviationSolution:
-            env->output->outputDebug(
-                "         Source from candidate point is MIP solution with smallest nonlinear error.");
-            sourceDesc = "SMDEV-" + source;
-            break;
-        case E_PrimalNLPSource::FirstSolutionNewDualBound:
-            env->output->outputDebug(
-                "         Source from candidate point is first MIP solution point which gave dual bound update.");
-            sourceDesc = "NEWDB-" + source;
-            break;
-        default:
-            break;
-        }
+    if(problem.startingPointIndexes.size() > 0)
+        solver.setStartingPoint(problem.startingPointIndexes, problem.startingPointValues);
 
-        switch(solvestatus)
-        {
-        case E_NLPSolutionStatus::Optimal:
-            env->output->outputDebug(fmt::format(
-                "         Optimal solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+    solver.fixVariables(discreteVariableIndexes, problem.fixedVariableValues);
 
-        case E_NLPSolutionStatus::Feasible:
-            env->output->outputDebug(fmt::format(
-                "         Feasible solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+    if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+    {
+        std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
+            + std::to_string(problem.iterationNumber) + "_" + std::to_string(problem.counter);
+        solver.saveProblemToFile(filename + ".txt");
+        solver.saveOptionsToFile(filename + ".osrl");
+    }
 
-        case E_NLPSolutionStatus::Infeasible:
-            env->output->outputDebug("         Fixed NLP problem is infeasible.");
-            break;
+    auto startTime = env->timing->getTime();
+    problem.solutionStatus = solver.solveProblem();
+    env->timing->addHistogramSample(primalNLPHistogram, startTime);
 
-        case E_NLPSolutionStatus::Unbounded:
-            env->output->outputDebug("         Fixed NLP problem is unbounded.");
-            break;
+    problem.objectiveValue = solver.getObjectiveValue();
+    problem.solution = solver.getSolution();
 
-        case E_NLPSolutionStatus::TimeLimit:
-            env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
-            break;
+    solver.unfixVariables();
+}
 
-        case E_NLPSolutionStatus::IterationLimit:
-            env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
-            break;
+void TaskSelectPrimalCandidatesFromNLP::processFixedNLPSolution(const FixedNLPProblem& problem)
+{
+    auto currIter = env->results->getCurrentIteration();
+    auto& CAND = problem.candidate;
+    auto solvestatus = problem.solutionStatus;
 
-        case E_NLPSolutionStatus::Error:
-            env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
-            break;
+    env->solutionStatistics.numberOfProblemsFixedNLP++;
 
-        default:
+    std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
 
-            break;
-        }
+    std::string sourceDesc;
+    switch(CAND.sourceType)
+    {
+    case E_PrimalNLPSource::FirstSolution:
+        env->output->outputDebug("         Source from candidate point is first MIP solution point.");
+        sourceDesc = "SOLPT-" + source;
+        break;
+    case E_PrimalNLPSource::FeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is MIP solution pool.");
+        sourceDesc = "FEASP-" + source;
+        break;
+    case E_PrimalNLPSource::InfeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
+        sourceDesc = "UNFEA-" + source;
+        break;
+    case E_PrimalNLPSource::SmallestDeviationSolution:
+        env->output->outputDebug("         Source from candidate point is MIP solution with smallest nonlinear error.");
+        sourceDesc = "SMDEV-" + source;
+        break;
+    case E_PrimalNLPSource::FirstSolutionNewDualBound:
+        env->output->outputDebug(
+            "         Source from candidate point is first MIP solution point which gave dual bound update.");
+        sourceDesc = "NEWDB-" + source;
+        break;
+    default:
+        break;
+    }
+
+    switch(solvestatus)
+    {
+    case E_NLPSolutionStatus::Optimal:
+        env->output->outputDebug("         Optimal solution {} found to fixed NLP problem.", problem.objectiveValue);
+        break;
+
+    case E_NLPSolutionStatus::Feasible:
+        env->output->outputDebug("         Feasible solution {} found to fixed NLP problem.", problem.objectiveValue);
+        break;
+
+    case E_NLPSolutionStatus::Infeasible:
+        env->output->outputDebug("         Fixed NLP problem is infeasible.");
+        break;
+
+    case E_NLPSolutionStatus::Unbounded:
+        env->output->outputDebug("         Fixed NLP problem is unbounded.");
+        break;
+
+    case E_NLPSolutionStatus::TimeLimit:
+        env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
+        break;
+
+    case E_NLPSolutionStatus::IterationLimit:
+        env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
+        break;
+
+    case E_NLPSolutionStatus::Error:
+        env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
+        break;
+
+    default:
+
+        break;
+    }
+
+    if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
+    {
+        double tmpObj = problem.objectiveValue;
+        auto& variableSolution = problem.solution;
 
-        if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
+        if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
         {
-            double tmpObj = NLPSolver->getObjectiveValue();
-            auto variableSolution = NLPSolver->getSolution();
+            int iters = std::max(
+                std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
+                originalNLPIter);
 
-            if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
-            {
-                int iters = std::max(
-                    std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
-                    originalNLPIter);
+            if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
 
-                if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+            double interval = std::max(
+                0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
 
-                double interval = std::max(
-                    0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
+            if(interval > 0.1 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
 
-                if(interval > 0.1 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+            env->output->outputDebug("         Iteration frequency updated to {} and time frequency updated to {} ",
+                iters, interval);
+        }
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
+        env->primalSolver->addPrimalSolutionCandidate(
+            variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, problem.iterationNumber);
 
-            env->primalSolver->addPrimalSolutionCandidate(
-                variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, currIter->iterationNumber);
+        if(sourceProblem->properties.numberOfNonlinearConstraints > 0
+            || sourceProblem->properties.numberOfQuadraticConstraints > 0)
+        {
+            auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
 
-            if(sourceProblem->properties.numberOfNonlinearConstraints > 0
-                || sourceProblem->properties.numberOfQuadraticConstraints > 0)
-            {
-                auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+            env->output->outputDebug("         Max error {} from nonlinear or quadratic constraint {}.",
+                mostDevConstr->normalizedValue, mostDevConstr->constraint->name);
 
-                env->output->outputDebug(fmt::format("         Max error {} from nonlinear or quadratic constraint {}.",
-                    mostDevConstr->normalizedValue, mostDevConstr->constraint->name));
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
+                E_IterationLineType::PrimalNLP);
+        }
+        else
+        {
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj,
+                -1, // Not shown
+                0.0, // Not shown
+                E_IterationLineType::PrimalNLP);
+        }
 
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
-                    E_IterationLineType::PrimalNLP);
-            }
-            else
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj,
-                    -1, // Not shown
-                    0.0, // Not shown
-                    E_IterationLineType::PrimalNLP);
-            }
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
+
+        if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
+            createInfeasibilityCut(variableSolution);
+    }
+    else if(sourceProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        double tmpObj = problem.objectiveValue;
+
+        // Utilize the solution point for adding a cutting plane / supporting hyperplane
 
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+        auto& variableSolution = problem.solution;
+
+        if(variableSolution.size() > 0)
+        {
+            auto mostDevConstr = sourceProblem->getMaxNumericConstraintValue(
+                variableSolution, sourceProblem->nonlinearConstraints);
 
             if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
                 createInfeasibilityCut(variableSolution);
+
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr.constraint->index, mostDevConstr.normalizedValue,
+                E_IterationLineType::PrimalNLP);
         }
-        else if(sourceProblem->properties.numberOfNonlinearConstraints > 0)
+        else
         {
-            double tmpObj = NLPSolver->getObjectiveValue();
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
+                -1, NAN, E_IterationLineType::PrimalNLP);
+        }
 
-            // Utilize the solution point for adding a cutting plane / supporting hyperplane
+        if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+        {
+            int iters
+                = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
 
-            auto variableSolution = NLPSolver->getSolution();
+            if(iters < 10 * this->originalIterFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
 
-            if(variableSolution.size() > 0)
+            double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
+
+            if(interval < 10 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+
+            env->output->outputDebug("         Iteration frequency updated to {} and time frequency updated to {} ",
+                iters, interval);
+        }
+
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
+    }
+    else
+    {
+        env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
+            env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
+            env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+            env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
+            NAN, E_IterationLineType::PrimalNLP);
+
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
+    }
+    if(static_cast<ES_PrimalNLPSolver>(env->settings->getSetting<int>("FixedInteger.Solver", "Primal"))
+        == ES_PrimalNLPSolver::SHOT)
+    {
+        auto SHOTSolver = std::dynamic_pointer_cast<NLPSolverSHOT>(NLPSolver);
+        auto SHOTDualSolver = SHOTSolver->solver->getEnvironment()->dualSolver;
+        int numHyperplanesToCopy = env->settings->getSetting<int>("FixedInteger.CopyNumberOfHyperplanes", "Primal");
+        int hyperplaneCounter = 0;
+
+        for(auto it = SHOTDualSolver->generatedHyperplanes.rbegin(); it != SHOTDualSolver->generatedHyperplanes.rend();
+            ++it)
+        {
+            auto& HP = *it;
+
+            if(hyperplaneCounter >= numHyperplanesToCopy)
+                break;
+
+            if(HP.generatedPointHandle < 0)
+                continue;
+
+            Hyperplane newHP;
+
+            // The reformulated problem solved by SHOT is a copy of this one, so the constraint indexes are the same
+            if(HP.source == E_HyperplaneSource::ObjectiveCuttingPlane
+                || HP.source == E_HyperplaneSource::ObjectiveRootsearch)
+            {
+                newHP.isObjectiveHyperplane = true;
+                newHP.sourceConstraintIndex = -1;
+                newHP.source = HP.source;
+            }
+            else if(auto constraint = std::dynamic_pointer_cast<NumericConstraint>(
+                        env->reformulatedProblem->getConstraint(HP.sourceConstraintIndex)))
             {
-                auto mostDevConstr = sourceProblem->getMaxNumericConstraintValue(
-                    variableSolution, sourceProblem->nonlinearConstraints);
-
-                if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
-                    createInfeasibilityCut(variableSolution);
-
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr.constraint->index, mostDevConstr.normalizedValue,
-                    E_IterationLineType::PrimalNLP);
+                newHP.sourceConstraintIndex = constraint->index;
+                newHP.sourceConstraint = constraint;
+                newHP.source = HP.source;
             }
             else
             {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
-                    -1, NAN, E_IterationLineType::PrimalNLP);
+                continue;
             }
 
-            if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+            // The saved point only has the values needed for the source constraint or objective
+            newHP.generatedPoint.assign(env->reformulatedProblem->properties.numberOfVariables, 0.0);
+            SHOTDualSolver->getGeneratedHyperplanePoint(HP, newHP.generatedPoint);
+            newHP.isSourceConvex = HP.isSourceConvex;
+
+            if(newHP.isObjectiveHyperplane)
             {
-                int iters
-                    = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
+                newHP.objectiveFunctionValue
+                    = env->reformulatedProblem->objectiveFunction->calculateValue(newHP.generatedPoint);
+            }
 
-                if(iters < 10 * this->originalIterFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+            env->dualSolver->addHyperplane(newHP);
+            hyperplaneCounter++;
+        }
 
-                double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
+        SHOTSolver->solver->getEnvironment()->dualSolver->clearGeneratedHyperplanes();
+    }
+}
+
+void TaskSelectPrimalCandidatesFromNLP::startAsynchronousWorkers()
+{
+#ifdef HAS_IPOPT
+    if(static_cast<ES_PrimalNLPSolver>(env->settings->getSetting<int>("FixedInteger.Solver", "Primal"))
+        != ES_PrimalNLPSolver::Ipopt)
+    {
+        env->output->outputDebug("        Fixed NLP problems are only solved asynchronously with Ipopt.");
+        return;
+    }
 
-                if(interval < 10 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+    // The workers are shared with the task for the other source problem if both are used
+    asynchronousWorkers = env->primalSolver->fixedNLPWorkers.lock();
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
+    if(!asynchronousWorkers)
+    {
+        asynchronousWorkers = std::make_shared<Utilities::BackgroundWorkers>(
+            env->settings->getSetting<int>("FixedInteger.Asynchronous.Threads", "Primal"));
+        env->primalSolver->fixedNLPWorkers = asynchronousWorkers;
 
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
-        }
-        else
+        env->output->outputDebug("        Solving fixed NLP problems asynchronously in {} threads.",
+            asynchronousWorkers->getNumberOfWorkers());
+    }
+
+    for(int i = 0; i < asynchronousWorkers->getNumberOfWorkers(); i++)
+    {
+        // The workers use copies of the source problem, since the CppAD tapes in the problem cannot be used by several
+        // threads at once
+        std::shared_ptr<INLPSolver> workerNLPSolver
+            = std::make_shared<NLPSolverIpoptRelaxed>(env, sourceProblem->createCopy(env));
+
+        for(auto& V : sourceProblem->allVariables)
         {
-            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
-                env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
-                env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
-                NAN, E_IterationLineType::PrimalNLP);
-
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+            workerNLPSolver->updateVariableLowerBound(V->index, V->lowerBound);
+            workerNLPSolver->updateVariableUpperBound(V->index, V->upperBound);
         }
-        if(static_cast<ES_PrimalNLPSolver>(env->settings->getSetting<int>("FixedInteger.Solver", "Primal"))
-            == ES_PrimalNLPSolver::SHOT)
-        {
-            auto SHOTSolver = std::dynamic_pointer_cast<NLPSolverSHOT>(NLPSolver);
-            int numHyperplanesToCopy = env->settings->getSetting<int>("FixedInteger.CopyNumberOfHyperplanes", "Primal");
-            int hyperplaneCounter = 0;
 
-            for(auto it = SHOTSolver->solver->getEnvironment()->dualSolver->generatedHyperplanes.rbegin();
-                it != SHOTSolver->solver->getEnvironment()->dualSolver->generatedHyperplanes.rend(); ++it)
-            {
-                auto HP = *it;
-
-                if(hyperplaneCounter >= numHyperplanesToCopy)
-                    break;
-
-                Hyperplane newHP;
-
-                if(HP.source == E_HyperplaneSource::ObjectiveCuttingPlane
-                    || HP.source == E_HyperplaneSource::ObjectiveRootsearch)
-                {
-                    newHP.isObjectiveHyperplane = true;
-                    newHP.sourceConstraintIndex = -1;
-                    newHP.source = HP.source;
-                }
-                else if(auto NCV = env->reformulatedProblem->getMostDeviatingNonlinearConstraint(HP.generatedPoint);
-                        NCV)
-                {
-                    newHP.sourceConstraintIndex = NCV->constraint->index;
-                    newHP.sourceConstraint = NCV->constraint;
-                    newHP.source = HP.source;
-                }
-                else
-                {
-                    continue;
-                }
-
-                newHP.generatedPoint = HP.generatedPoint;
-                newHP.isSourceConvex = HP.isSourceConvex;
-                newHP.objectiveFunctionValue
-                    = env->reformulatedProblem->objectiveFunction->calculateValue(newHP.generatedPoint);
+        workerNLPSolvers.push_back(workerNLPSolver);
+    }
+#endif
+}
+
+void TaskSelectPrimalCandidatesFromNLP::queueFixedNLPProblems()
+{
+    auto currIter = env->results->getCurrentIteration();
+    int counter = 0;
+    int numberOfDiscardedProblems = 0;
 
-                env->dualSolver->addHyperplane(newHP);
-                hyperplaneCounter++;
+    for(auto& CAND : env->primalSolver->fixedPrimalNLPCandidates)
+    {
+        auto solveProblem = [this, problem = createFixedNLPProblem(CAND, currIter->iterationNumber, counter)](
+                                int workerIndex) mutable {
+            try
+            {
+                solveFixedNLPProblem(*workerNLPSolvers[workerIndex], problem);
+            }
+            catch(std::exception&)
+            {
+                problem.solutionStatus = E_NLPSolutionStatus::Error;
+                problem.solution.clear();
             }
 
-            SHOTSolver->solver->getEnvironment()->dualSolver->generatedHyperplanes.clear();
-        }
+            std::lock_guard<std::mutex> lock(solvedProblemsMutex);
+            solvedProblems.push_back(std::move(problem));
+        };
+
+        // Newer candidates are based on more cuts, so they are preferred if the workers cannot keep up
+        numberOfDiscardedProblems
+            += asynchronousWorkers->queueJob(this, std::move(solveProblem), asynchronousWorkers->getNumberOfWorkers());
 
-        env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
-        env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
         counter++;
+        env->primalSolver->addUsedFixedNLPCandidate(CAND);
+    }
+
+    env->output->outputDebug("        Queued {} fixed NLP problems, and discarded {} problems not yet solved.", counter,
+        numberOfDiscardedProblems);
+
+    env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
+    env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
+}
 
-        env->primalSolver->usedPrimalNLPCandidates.push_back(CAND);
+void TaskSelectPrimalCandidatesFromNLP::processSolvedFixedNLPProblems(bool waitForQueuedProblems)
+{
+    if(waitForQueuedProblems)
+        asynchronousWorkers->waitForJobs(this);
+
+    std::deque<FixedNLPProblem> problems;
+
+    {
+        std::lock_guard<std::mutex> lock(solvedProblemsMutex);
+        problems.swap(solvedProblems);
     }
 
-    return (true);
+    for(auto& P : problems)
+        processFixedNLPSolution(P);
 }
 
 void TaskSelectPrimalCandidatesFromNLP::createInfeasibilityCut(const VectorDouble variableSolution)
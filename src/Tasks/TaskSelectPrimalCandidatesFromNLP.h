@@ -11,11 +11,15 @@
 #pragma once
 #include "TaskBase.h"
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "../Structs.h"
+#include "../Timing.h"
+#include "../Utilities.h"
 
 namespace SHOT
 {
@@ -30,8 +34,36 @@ public:
     std::string getType() override;
 
 private:
+    // A fixed NLP problem created from a primal candidate, together with its solution once it has been solved
+    struct FixedNLPProblem
+    {
+        PrimalFixedNLPCandidate candidate;
+        int iterationNumber = 0;
+        int counter = 0;
+
+        VectorDouble fixedVariableValues;
+        VectorInteger startingPointIndexes;
+        VectorDouble startingPointValues;
+
+        std::vector<PairIndexValue> lowerBoundUpdates;
+        std::vector<PairIndexValue> upperBoundUpdates;
+
+        E_NLPSolutionStatus solutionStatus = E_NLPSolutionStatus::Error;
+        VectorDouble solution;
+        double objectiveValue = NAN;
+    };
+
     virtual bool solveFixedNLP();
 
+    FixedNLPProblem createFixedNLPProblem(const PrimalFixedNLPCandidate& candidate, int iterationNumber, int counter);
+
+    // Solves the problem with the given solver, does not change anything else than the solver and the problem so that
+    // it can be called in the asynchronous workers
+    void solveFixedNLPProblem(INLPSolver& solver, FixedNLPProblem& problem);
+
+    // Adds the solution as a primal candidate, and creates cuts from it
+    void processFixedNLPSolution(const FixedNLPProblem& problem);
+
     void createInfeasibilityCut(const VectorDouble point);
     void createIntegerCut(VectorDouble point);
 
@@ -56,5 +88,24 @@ private:
 
     ProblemPtr sourceProblem;
     bool sourceIsReformulatedProblem = false;
+
+    HistogramHandle primalNLPHistogram;
+
+    // Used if the fixed NLP problems are solved asynchronously, in which case the problems are solved by workers shared
+    // with the task for the other source problem. Each worker has its own NLP solver and copy of the source problem
+    // for this task, and the solutions are processed when the task is run.
+    void startAsynchronousWorkers();
+
+    // Adds the problems to the queue, where at most one problem per worker is kept, so the oldest ones are discarded
+    void queueFixedNLPProblems();
+
+    // Processes the solutions found since the previous call, or waits until all queued problems have been solved
+    void processSolvedFixedNLPProblems(bool waitForQueuedProblems);
+
+    std::shared_ptr<Utilities::BackgroundWorkers> asynchronousWorkers;
+    std::vector<std::shared_ptr<INLPSolver>> workerNLPSolvers;
+
+    std::deque<FixedNLPProblem> solvedProblems;
+    std::mutex solvedProblemsMutex;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace SHOT
 TaskSelectPrimalCandidatesFromRootsearch::TaskSelectPrimalCandidatesFromRootsearch(EnvironmentPtr envPtr)
     : TaskBase(envPtr)
 {
+    rootsearchTimer = env->timing->getTimerHandle("PrimalBoundStrategyRootSearch");
 }
 
 TaskSelectPrimalCandidatesFromRootsearch::~TaskSelectPrimalCandidatesFromRootsearch() = default;
@@ -47,7 +48,7 @@ void TaskSelectPrimalCandidatesFromRootsearch::run(std::vector<SolutionPoint> so
         || env->results->usedSolutionStrategy == E_SolutionStrategy::NLP)
     {
         env->timing->startTimer("PrimalStrategy");
-        env->timing->startTimer("PrimalBoundStrategyRootSearch");
+        env->timing->startTimer(rootsearchTimer);
 
         for(auto& P : solPoints)
         {
@@ -80,13 +81,13 @@ void TaskSelectPrimalCandidatesFromRootsearch::run(std::vector<SolutionPoint> so
 
                     try
                     {
-                        env->timing->startTimer("PrimalBoundStrategyRootSearch");
+                        env->timing->startTimer(rootsearchTimer);
                         xNewc = env->rootsearchMethod->findZero(xNLP, P.point,
                             env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver"),
                             env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver"), 0,
                             env->reformulatedProblem->nonlinearConstraints, false);
 
-                        env->timing->stopTimer("PrimalBoundStrategyRootSearch");
+                        env->timing->stopTimer(rootsearchTimer);
 
                         env->primalSolver->addPrimalSolutionCandidate(xNewc.first, E_PrimalSolutionSource::Rootsearch,
                             env->results->getCurrentIteration()->iterationNumber);
@@ -99,7 +100,7 @@ void TaskSelectPrimalCandidatesFromRootsearch::run(std::vector<SolutionPoint> so
             }
 
             env->timing->stopTimer("PrimalStrategy");
-            env->timing->stopTimer("PrimalBoundStrategyRootSearch");
+            env->timing->stopTimer(rootsearchTimer);
         }
     }
 }
@@ -10,6 +10,7 @@
 
 #pragma once
 #include "TaskBase.h"
+#include "../Timing.h"
 
 #include "../Structs.h"
 
@@ -26,5 +27,6 @@ public:
     std::string getType() override;
 
 private:
+    TimerHandle rootsearchTimer;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -28,6 +28,8 @@ namespace SHOT
 
 TaskSolveIteration::TaskSolveIteration(EnvironmentPtr envPtr) : TaskBase(envPtr)
 {
+    dualProblemHistogram = env->timing->getHistogramHandle("DualProblem");
+
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
     {
         for(auto& V : env->reformulatedProblem->allVariables)
@@ -65,8 +67,7 @@ void TaskSolveIteration::run()
         {
             env->dualSolver->useCutOff = true;
             env->dualSolver->cutOffToUse = env->settings->getSetting<double>("MIP.CutOff.InitialValue", "Dual");
-            env->output->outputDebug(
-                fmt::format("        Setting user-provided cutoff value to {}.", env->dualSolver->cutOffToUse));
+            env->output->outputDebug("        Setting user-provided cutoff value to {}.", env->dualSolver->cutOffToUse);
         }
 
         if(isMinimization)
@@ -102,8 +103,8 @@ void TaskSolveIteration::run()
         {
             env->dualSolver->MIPSolver->updateVariableBound(
                 env->dualSolver->MIPSolver->getDualAuxiliaryObjectiveVariableIndex(), newLB, newUB);
-            env->output->outputDebug(
-                fmt::format("        Bounds for nonlinear objective function updated to {} and {}", newLB, newUB));
+            env->output->outputDebug("        Bounds for nonlinear objective function updated to {} and {}", newLB,
+                newUB);
         }
     }
 
@@ -129,7 +130,10 @@ void TaskSolveIteration::run()
     }
 
     env->output->outputDebug("        Solving dual problem.");
+    auto startTime = env->timing->getTime();
     auto solStatus = env->dualSolver->MIPSolver->solveProblem();
+    env->timing->addHistogramSample(dualProblemHistogram, startTime);
+    currIter->solutionTime = std::chrono::duration<double>(Timing::getTime() - startTime).count();
 
     // Must update the pointer to the current iteration if we use the lazy
     // strategy since new iterations have been created when solving
@@ -148,13 +152,13 @@ void TaskSolveIteration::run()
 
     currIter->solutionStatus = solStatus;
 
-    env->output->outputDebug(fmt::format("        Dual problem solved with return code: {}", (int)solStatus));
+    env->output->outputDebug("        Dual problem solved with return code: {}", (int)solStatus);
 
     auto sols = env->dualSolver->MIPSolver->getAllVariableSolutions();
 
     if(sols.size() > 0)
     {
-        env->output->outputDebug(fmt::format("        Number of solutions in solution pool: {} ", sols.size()));
+        env->output->outputDebug("        Number of solutions in solution pool: {} ", sols.size());
 
         if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
         {
@@ -12,6 +12,7 @@
 #include "TaskBase.h"
 
 #include "../Structs.h"
+#include "../Timing.h"
 
 namespace SHOT
 {
@@ -26,5 +27,7 @@ public:
 
 private:
     VectorString variableNames;
+
+    HistogramHandle dualProblemHistogram;
 };
 } // namespace SHOT
\ No newline at end of file
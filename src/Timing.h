@@ -12,12 +12,27 @@
 #include "Environment.h"
 #include "Timer.h"
 
-#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace SHOT
 {
 
+// A handle to a timer, i.e. its position in the list of timers, so that it can be started and stopped without looking
+// it up by name. Using a handle to a timer that has not been created does nothing.
+struct TimerHandle
+{
+    int index = -1;
+};
+
+// A handle to a latency histogram, used as the timer handles
+struct HistogramHandle
+{
+    int index = -1;
+};
+
 class Timing
 {
 public:
@@ -25,64 +40,113 @@ public:
 
     inline ~Timing() { timers.clear(); }
 
-    inline void createTimer(std::string name, std::string description) { timers.emplace_back(name, description); }
+    inline TimerHandle createTimer(const std::string& name, const std::string& description)
+    {
+        // If there already is a timer with the same name, it is the one used
+        auto timerIndex = timerIndexes.emplace(name, timers.size());
+
+        if(timerIndex.second)
+            timers.emplace_back(name, description);
 
-    inline void startTimer(std::string name)
+        return (TimerHandle { timerIndex.first->second });
+    }
+
+    inline TimerHandle getTimerHandle(const std::string& name) const
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        auto timerIndex = timerIndexes.find(name);
 
-        if(timer == timers.end())
+        if(timerIndex == timerIndexes.end())
         {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
+            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
+            return (TimerHandle());
         }
 
-        timer->start();
+        return (TimerHandle { timerIndex->second });
     }
 
-    inline void stopTimer(std::string name)
+    inline void startTimer(TimerHandle timer)
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        if(timer.index >= 0)
+            timers[timer.index].start();
+    }
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
-        }
+    inline void stopTimer(TimerHandle timer)
+    {
+        if(timer.index >= 0)
+            timers[timer.index].stop();
+    }
 
-        timer->stop();
+    inline void restartTimer(TimerHandle timer)
+    {
+        if(timer.index >= 0)
+            timers[timer.index].restart();
     }
 
-    inline void restartTimer(std::string name)
+    inline double getElapsedTime(TimerHandle timer)
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        if(timer.index < 0)
+            return (0.0);
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
-        }
+        return (timers[timer.index].elapsed());
+    }
+
+    inline void startTimer(const std::string& name) { startTimer(getTimerHandle(name)); }
+
+    inline void stopTimer(const std::string& name) { stopTimer(getTimerHandle(name)); }
 
-        timer->restart();
+    inline void restartTimer(const std::string& name) { restartTimer(getTimerHandle(name)); }
+
+    inline double getElapsedTime(const std::string& name) { return (getElapsedTime(getTimerHandle(name))); }
+
+    inline HistogramHandle createHistogram(const std::string& name, const std::string& description)
+    {
+        auto histogramIndex = histogramIndexes.emplace(name, histograms.size());
+
+        if(histogramIndex.second)
+            histograms.emplace_back(name, description);
+
+        return (HistogramHandle { histogramIndex.first->second });
     }
 
-    inline double getElapsedTime(std::string name)
+    inline HistogramHandle getHistogramHandle(const std::string& name) const
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        auto histogramIndex = histogramIndexes.find(name);
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return (0.0);
-        }
+        if(histogramIndex == histogramIndexes.end())
+            return (HistogramHandle());
 
-        return (timer->elapsed());
+        return (HistogramHandle { histogramIndex->second });
+    }
+
+    // The start time of an operation whose duration is added to a histogram with addHistogramSample
+    static inline TimerClock::time_point getTime() { return (TimerClock::now()); }
+
+    // Adds the time since the given start time to the histogram if histograms are used. Can be called from several
+    // threads at once.
+    inline void addHistogramSample(HistogramHandle histogram, TimerClock::time_point startTime)
+    {
+        if(!useHistograms || histogram.index < 0)
+            return;
+
+        auto duration = TimerClock::now() - startTime;
+
+        std::lock_guard<std::mutex> lock(histogramMutex);
+        histograms[histogram.index].add(duration);
     }
 
     std::vector<Timer> timers;
+    std::vector<LatencyHistogram> histograms;
+
+    // Set from the setting Timing.Histograms.Use in category Output
+    bool useHistograms = false;
 
 private:
     EnvironmentPtr env;
+
+    std::unordered_map<std::string, int> timerIndexes;
+    std::unordered_map<std::string, int> histogramIndexes;
+
+    std::mutex histogramMutex;
 };
 
-} // namespace SHOT
\ No newline at end of file
+} // namespace SHOT
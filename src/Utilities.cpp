@@ -8,13 +8,22 @@
    Please see the README and LICENSE files for more information.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <numeric>
+#include <thread>
 
 #include "Utilities.h"
 
@@ -22,6 +31,13 @@
 
 #include "spdlog/fmt/fmt.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef HAS_STD_FILESYSTEM
 #include <filesystem>
 namespace fs = std;
@@ -530,164 +546,92 @@ template <typename T> double calculateHash(std::vector<T> const& point)
 
 bool isAlmostEqual(double x, double y, const double epsilon) { return std::abs(x - y) <= epsilon * std::abs(x); }
 
-std::string trim(const std::string& str)
-{
-    size_t first = str.find_first_not_of(' ');
-    if(std::string::npos == first)
-    {
-        return str;
-    }
-
-    size_t last = str.find_last_not_of(' ');
-    return str.substr(first, (last - first + 1));
-}
+HashIndex::HashIndex(double tolerance) : tolerance(tolerance) { assert(tolerance > 0.0); }
 
-bool isInteger(double value)
+size_t HashIndex::KeyHash::operator()(const Key& key) const
 {
-    double intpart;
+    size_t seed = 0;
+    boost::hash_combine(seed, key.group);
+    boost::hash_combine(seed, key.sign);
+    boost::hash_combine(seed, key.bucket);
 
-    return (std::modf(value, &intpart) == 0.0);
+    return (seed);
 }
 
-SparseVariableVector combineSparseVariableVectors(const SparseVariableVector& first, const SparseVariableVector& second)
+HashIndex::Key HashIndex::getKey(int group, double hash) const
 {
-    SparseVariableVector result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
+    if(hash == 0.0)
+        return (Key { group, 0, 0 });
 
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    // If x and y are almost equal, their logarithms differ by at most about the tolerance, so with buckets twice as
+    // wide they are either in the same or in neighbouring buckets
+    auto bucket = (std::int64_t)std::floor(std::log(std::abs(hash)) / (2.0 * tolerance));
 
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
+    return (Key { group, (hash > 0.0) ? 1 : -1, bucket });
+}
 
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+void HashIndex::add(int group, double hash)
+{
+    // Nonfinite values are never almost equal to anything
+    if(!std::isfinite(hash))
+        return;
 
-    return result;
+    buckets[getKey(group, hash)].push_back(hash);
+    numberOfValues++;
 }
 
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second, const SparseVariableVector& third)
+bool HashIndex::contains(int group, double hash, int& numberOfCollisions) const
 {
-    SparseVariableVector result;
+    if(!std::isfinite(hash))
+        return (false);
 
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
+    auto key = getKey(group, hash);
 
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    // Zero is only almost equal to zero, which is stored in the same bucket
+    int neighbours = (hash == 0.0) ? 0 : 1;
 
-    for(auto& G : second)
+    for(int i = -neighbours; i <= neighbours; i++)
     {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+        auto bucket = buckets.find(Key { key.group, key.sign, key.bucket + i });
 
-    for(auto& G : third)
-    {
-        auto element = result.emplace(G.first, G.second);
+        if(bucket == buckets.end())
+            continue;
 
-        if(!element.second)
+        for(auto& H : bucket->second)
         {
-            // Element already exists for the variable
-            element.first->second += G.second;
+            if(isAlmostEqual(H, hash, tolerance))
+                return (true);
+
+            numberOfCollisions++;
         }
     }
 
-    return result;
+    return (false);
 }
 
-SparseVariableMatrix combineSparseVariableMatrices(
-    const SparseVariableMatrix& first, const SparseVariableMatrix& second)
+void HashIndex::clear()
 {
-    SparseVariableMatrix result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    return result;
+    buckets.clear();
+    numberOfValues = 0;
 }
 
-SparseVariableMatrix combineSparseVariableMatrices(
-    const SparseVariableMatrix& first, const SparseVariableMatrix& second, const SparseVariableMatrix& third)
+std::string trim(const std::string& str)
 {
-    SparseVariableMatrix result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
+    size_t first = str.find_first_not_of(' ');
+    if(std::string::npos == first)
     {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
+        return str;
     }
 
-    for(auto& G : third)
-    {
-        auto element = result.emplace(G.first, G.second);
+    size_t last = str.find_last_not_of(' ');
+    return str.substr(first, (last - first + 1));
+}
 
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+bool isInteger(double value)
+{
+    double intpart;
 
-    return result;
+    return (std::modf(value, &intpart) == 0.0);
 }
 
 E_Convexity combineConvexity(const E_Convexity first, const E_Convexity second)
@@ -786,4 +730,330 @@ std::string createTemporaryDirectory(std::string filePrefix, std::string folder)
     return (path.string());
 }
 
-} // namespace SHOT::Utilities
\ No newline at end of file
+namespace
+{
+// A loop started with parallelFor. The tasks are taken in order by the calling thread and by at most numberOfHelpers
+// threads of the pool. The state is shared, so that a helper can hold on to it after the loop has finished.
+struct ParallelLoop
+{
+    const std::function<void(int)>* function;
+    int numberOfTasks;
+    int numberOfHelpers;
+
+    std::atomic<int> nextTask { 0 };
+    std::atomic<int> remainingTasks { 0 };
+    std::atomic<bool> hasFailed { false };
+    std::exception_ptr exception;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    // Performs tasks until there are none left. After a task has thrown an exception, the remaining tasks are only
+    // marked as done.
+    void work()
+    {
+        for(int i = nextTask++; i < numberOfTasks; i = nextTask++)
+        {
+            if(!hasFailed)
+            {
+                try
+                {
+                    (*function)(i);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if(!exception)
+                        exception = std::current_exception();
+
+                    hasFailed = true;
+                }
+            }
+
+            if(--remainingTasks == 0)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+// Whether the thread is performing tasks of a loop, in which case nested loops are performed serially
+thread_local bool isInParallelLoop = false;
+
+// The threads helping the calling threads with the loops in parallelFor. The threads are started when first needed and
+// are kept until the program exits, so that also short loops, e.g. over the constraints in a point, benefit.
+class ThreadPool
+{
+public:
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+        }
+
+        hasLoops.notify_all();
+
+        for(auto& T : threads)
+            T.join();
+    }
+
+    void run(std::shared_ptr<ParallelLoop> loop)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            while((int)threads.size() < loop->numberOfHelpers)
+                threads.emplace_back([this]() { help(); });
+
+            loops.push_back(loop);
+        }
+
+        hasLoops.notify_all();
+
+        isInParallelLoop = true;
+        loop->work();
+        isInParallelLoop = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto position = std::find(loops.begin(), loops.end(), loop);
+
+            if(position != loops.end())
+                loops.erase(position);
+        }
+
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->finished.wait(lock, [&]() { return (loop->remainingTasks == 0); });
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::shared_ptr<ParallelLoop>> loops;
+
+    std::mutex mutex;
+    std::condition_variable hasLoops;
+    bool isStopping = false;
+
+    void help()
+    {
+        isInParallelLoop = true;
+
+        while(true)
+        {
+            std::shared_ptr<ParallelLoop> loop;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                hasLoops.wait(lock, [&]() { return (isStopping || !loops.empty()); });
+
+                if(isStopping)
+                    return;
+
+                loop = loops.front();
+
+                if(--loop->numberOfHelpers == 0)
+                    loops.pop_front();
+            }
+
+            loop->work();
+        }
+    }
+};
+} // namespace
+
+void parallelFor(int numberOfTasks, int numberOfThreads, const std::function<void(int)>& function)
+{
+    if(numberOfThreads <= 0)
+        numberOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    numberOfThreads = std::min(numberOfThreads, numberOfTasks);
+
+    if(numberOfThreads <= 1 || isInParallelLoop)
+    {
+        for(int i = 0; i < numberOfTasks; i++)
+            function(i);
+
+        return;
+    }
+
+    static ThreadPool threadPool;
+
+    auto loop = std::make_shared<ParallelLoop>();
+    loop->function = &function;
+    loop->numberOfTasks = numberOfTasks;
+    loop->numberOfHelpers = numberOfThreads - 1;
+    loop->remainingTasks = numberOfTasks;
+
+    threadPool.run(loop);
+
+    if(loop->exception)
+        std::rethrow_exception(loop->exception);
+}
+
+BackgroundWorkers::BackgroundWorkers(int numberOfWorkers)
+{
+    for(int i = 0; i < numberOfWorkers; i++)
+        threads.emplace_back(&BackgroundWorkers::work, this, i);
+}
+
+BackgroundWorkers::~BackgroundWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+        queuedJobs.clear();
+    }
+
+    hasQueuedJobs.notify_all();
+
+    for(auto& T : threads)
+        T.join();
+}
+
+int BackgroundWorkers::queueJob(const void* owner, std::function<void(int)> job, int maxQueuedJobs)
+{
+    int numberOfDiscardedJobs = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queuedJobs.push_back(Job { owner, std::move(job) });
+
+        int numberOfQueuedJobs
+            = std::count_if(queuedJobs.begin(), queuedJobs.end(), [&](const Job& J) { return (J.owner == owner); });
+
+        for(auto it = queuedJobs.begin(); numberOfQueuedJobs > maxQueuedJobs;)
+        {
+            if(it->owner == owner)
+            {
+                it = queuedJobs.erase(it);
+                numberOfQueuedJobs--;
+                numberOfDiscardedJobs++;
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    hasQueuedJobs.notify_one();
+
+    if(numberOfDiscardedJobs > 0)
+        hasFinishedJobs.notify_all();
+
+    return (numberOfDiscardedJobs);
+}
+
+void BackgroundWorkers::discardJobs(const void* owner)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queuedJobs.erase(std::remove_if(queuedJobs.begin(), queuedJobs.end(),
+                             [&](const Job& J) { return (J.owner == owner); }),
+            queuedJobs.end());
+    }
+
+    hasFinishedJobs.notify_all();
+}
+
+void BackgroundWorkers::waitForJobs(const void* owner)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    hasFinishedJobs.wait(lock, [&]() {
+        return (numberOfRunningJobs[owner] == 0
+            && std::none_of(
+                queuedJobs.begin(), queuedJobs.end(), [&](const Job& J) { return (J.owner == owner); }));
+    });
+}
+
+void BackgroundWorkers::work(int workerIndex)
+{
+    while(true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hasQueuedJobs.wait(lock, [&]() { return (isStopping || !queuedJobs.empty()); });
+
+            if(isStopping)
+                return;
+
+            job = std::move(queuedJobs.front());
+            queuedJobs.pop_front();
+            numberOfRunningJobs[job.owner]++;
+        }
+
+        // The jobs are expected to handle their own errors
+        try
+        {
+            job.function(workerIndex);
+        }
+        catch(...)
+        {
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            numberOfRunningJobs[job.owner]--;
+        }
+
+        hasFinishedJobs.notify_all();
+    }
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    if(mappedAddress != nullptr)
+        munmap(mappedAddress, size);
+#endif
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+
+    if(fileDescriptor < 0)
+        return (false);
+
+    struct stat fileStatus;
+
+    if(fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+    {
+        ::close(fileDescriptor);
+        return (false);
+    }
+
+    size = fileStatus.st_size;
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+
+    if(address == MAP_FAILED)
+        return (false);
+
+    madvise(address, size, MADV_SEQUENTIAL);
+
+    mappedAddress = address;
+    data = static_cast<const char*>(address);
+#else
+    std::ifstream file(fileName, std::ios::binary);
+
+    if(!file)
+        return (false);
+
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+#endif
+
+    return (size > 0);
+}
+
+} // namespace SHOT::Utilities
@@ -10,22 +10,21 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Structs.h"
 
-namespace SHOT
-{
-class Variable;
-using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
-using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
-}
-
 namespace SHOT::Utilities
 {
 
@@ -111,20 +110,51 @@ template <typename T> double calculateHash(std::vector<T> const& point);
 
 bool isAlmostEqual(double x, double y, const double epsilon);
 
-bool isInteger(double value);
-std::string trim(const std::string& str);
+// An index of hash values, e.g. from calculateHash(), divided into groups such as constraint indexes. Checks whether a
+// value that is almost equal to a given one (in the sense of isAlmostEqual()) has been added to a group. The values are
+// bucketed by the logarithm of their magnitude, so only the values in three buckets need to be compared.
+class HashIndex
+{
+public:
+    HashIndex(double tolerance = 1e-8);
+
+    void add(int group, double hash);
+
+    // The number of values in the searched buckets that were not almost equal is added to numberOfCollisions
+    bool contains(int group, double hash, int& numberOfCollisions) const;
+
+    void clear();
+
+    inline size_t size() const { return (numberOfValues); }
 
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second);
+private:
+    struct Key
+    {
+        int group;
+        int sign;
+        std::int64_t bucket;
+
+        inline bool operator==(const Key& other) const
+        {
+            return (group == other.group && sign == other.sign && bucket == other.bucket);
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
 
-SparseVariableVector combineSparseVariableVectors(
-    const SparseVariableVector& first, const SparseVariableVector& second, const SparseVariableVector& third);
+    double tolerance;
+    size_t numberOfValues = 0;
 
-SparseVariableMatrix combineSparseVariableMatrices(
-    const SparseVariableMatrix& first, const SparseVariableMatrix& second);
+    std::unordered_map<Key, VectorDouble, KeyHash> buckets;
 
-SparseVariableMatrix combineSparseVariableMatrices(
-    const SparseVariableMatrix& first, const SparseVariableMatrix& second, const SparseVariableMatrix& third);
+    Key getKey(int group, double hash) const;
+};
+
+bool isInteger(double value);
+std::string trim(const std::string& str);
 
 E_Convexity combineConvexity(const E_Convexity first, const E_Convexity second);
 
@@ -135,4 +165,77 @@ std::vector<std::string> splitStringByCharacter(const std::string& source, char
 // Creates a unique directory in the specified folder (or system temporary folder if folder is an empty string).
 // Returns an empty string if the directory could not be created.
 std::string createTemporaryDirectory(std::string filePrefix, std::string folder = "");
+
+// Calls function(i) for i = 0, ..., numberOfTasks - 1 using at most numberOfThreads threads (0 means the number of
+// hardware threads). The tasks are distributed dynamically, so the function needs to be independent of the order in
+// which they are performed. The first exception thrown in a task is rethrown after all threads have finished.
+void parallelFor(int numberOfTasks, int numberOfThreads, const std::function<void(int)>& function);
+
+// Threads running jobs in the background, which can be shared by several owners of jobs. The jobs are given the index
+// of the thread running them, so that they can use resources of their own in each thread.
+class BackgroundWorkers
+{
+public:
+    BackgroundWorkers(int numberOfWorkers);
+    BackgroundWorkers(const BackgroundWorkers&) = delete;
+    BackgroundWorkers& operator=(const BackgroundWorkers&) = delete;
+
+    // Discards the queued jobs and waits for the running ones to finish
+    ~BackgroundWorkers();
+
+    inline int getNumberOfWorkers() const { return (threads.size()); }
+
+    // Queues the job, and discards the oldest queued jobs of the owner if it has more than maxQueuedJobs queued.
+    // Returns the number of discarded jobs.
+    int queueJob(const void* owner, std::function<void(int)> job, int maxQueuedJobs);
+
+    // Discards the queued jobs of the owner
+    void discardJobs(const void* owner);
+
+    // Waits until the owner has no queued or running jobs
+    void waitForJobs(const void* owner);
+
+private:
+    struct Job
+    {
+        const void* owner = nullptr;
+        std::function<void(int)> function;
+    };
+
+    std::vector<std::thread> threads;
+    std::deque<Job> queuedJobs;
+    std::unordered_map<const void*, int> numberOfRunningJobs;
+
+    std::mutex mutex;
+    std::condition_variable hasQueuedJobs;
+    std::condition_variable hasFinishedJobs;
+    bool isStopping = false;
+
+    void work(int workerIndex);
+};
+
+// The contents of a file, which is memory mapped if supported by the platform and otherwise read into a buffer. The
+// file is assumed to be read once from the beginning to the end.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    // Returns false if the file could not be opened or is empty
+    bool open(const std::string& fileName);
+
+    inline const char* begin() const { return (data); }
+    inline const char* end() const { return (data + size); }
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+
+    void* mappedAddress = nullptr;
+    std::string buffer;
+};
 } // namespace SHOT::Utilities
\ No newline at end of file
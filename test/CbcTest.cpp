@@ -8,6 +8,7 @@
    Please see the README and LICENSE files for more information.
 */
 
+#include "../src/DualSolver.h"
 #include "../src/Results.h"
 #include "../src/Output.h"
 #include "../src/Settings.h"
@@ -17,6 +18,9 @@
 
 #include "../src/Model/Problem.h"
 
+#include "TestUtilities.h"
+
+#include <algorithm>
 #include <iostream>
 
 using namespace SHOT;
@@ -115,6 +119,131 @@ bool CbcTerminationCallbackTest(std::string filename)
     return (true);
 }
 
+// Solves a MINLP problem in the multi-tree strategy where nonbinding cuts are removed from the MIP problem
+bool CbcCutPoolTest(std::string filename)
+{
+    auto settingVariants = createSettingVariants(std::vector<bool> { false, true }, [](Solver& solver, bool use) {
+        solver.updateSetting("MIP.Solver", "Dual", static_cast<int>(ES_MIPSolver::Cbc));
+        solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+        solver.updateSetting("HyperplaneCuts.Pool.Use", "Dual", use);
+        solver.updateSetting("HyperplaneCuts.Pool.MaxAge", "Dual", 1);
+        solver.updateSetting("HyperplaneCuts.Pool.DeleteAge", "Dual", 1);
+    });
+
+    std::vector<std::unique_ptr<Solver>> solvers;
+
+    if(!solveWithSettingVariants(filename, settingVariants, solvers))
+        return (false);
+
+    for(size_t i = 0; i < solvers.size(); i++)
+    {
+        auto env = solvers[i]->getEnvironment();
+        bool usedCutPool = (i == 1);
+
+        int numberOfDeactivatedCuts = 0;
+        int numberOfDeletedCuts = 0;
+        int numberOfActivePoolCuts = 0;
+
+        // The cuts are only dropped from the pool when deleted, so no iteration can have more active cuts than the
+        // final pool and the deleted cuts
+        for(auto& I : env->results->getIterationSummaries())
+        {
+            numberOfDeactivatedCuts += I.numberOfDeactivatedPoolCuts;
+            numberOfDeletedCuts += I.numberOfDeletedPoolCuts;
+            numberOfActivePoolCuts = std::max(numberOfActivePoolCuts, I.numberOfActivePoolCuts);
+        }
+
+        int numberOfPoolCuts = env->dualSolver->getNumberOfPoolCuts();
+
+        std::cout << numberOfDeactivatedCuts << " cuts removed, " << numberOfDeletedCuts << " deleted and at most "
+                  << numberOfActivePoolCuts << " of " << numberOfPoolCuts << " cuts active "
+                  << (usedCutPool ? "with" : "without") << " the cut pool\n";
+
+        // With the maximum age of one iteration some cuts should be nonbinding long enough to be removed
+        if(usedCutPool && numberOfDeactivatedCuts == 0)
+        {
+            std::cout << "No cuts were removed with the cut pool\n";
+            return (false);
+        }
+
+        if(!usedCutPool && numberOfDeactivatedCuts > 0)
+        {
+            std::cout << "Cuts were removed without the cut pool\n";
+            return (false);
+        }
+
+        // With the delete age of one iteration some removed cuts should also have their rows deleted
+        if(usedCutPool && numberOfDeletedCuts == 0)
+        {
+            std::cout << "No cuts were deleted with the cut pool\n";
+            return (false);
+        }
+
+        if(numberOfDeletedCuts > numberOfDeactivatedCuts)
+        {
+            std::cout << "More cuts deleted than were removed\n";
+            return (false);
+        }
+
+        if(numberOfActivePoolCuts > numberOfPoolCuts + numberOfDeletedCuts)
+        {
+            std::cout << "More cuts active than there are in the cut pool\n";
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+// Solves a MINLP problem in the single-tree strategy with lazy constraints and compares with the multi-tree strategy
+bool CbcSingleTreeTest(std::string filename)
+{
+    std::vector<ES_TreeStrategy> treeStrategies = { ES_TreeStrategy::MultiTree, ES_TreeStrategy::SingleTree };
+
+    auto settingVariants = createSettingVariants(treeStrategies, [](Solver& solver, ES_TreeStrategy treeStrategy) {
+        solver.updateSetting("MIP.Solver", "Dual", static_cast<int>(ES_MIPSolver::Cbc));
+        solver.updateSetting("Cbc.UseLazyConstraints", "Subsolver", true);
+        solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(treeStrategy));
+    });
+
+    std::vector<std::unique_ptr<Solver>> solvers;
+
+    if(!solveWithSettingVariants(filename, settingVariants, solvers))
+        return (false);
+
+    auto env = solvers[1]->getEnvironment();
+
+    if(env->results->usedSolutionStrategy != E_SolutionStrategy::SingleTree)
+    {
+        std::cout << "The single-tree strategy was not used\n";
+        return (false);
+    }
+
+    int numberOfLazyHyperplanes = std::count_if(env->dualSolver->generatedHyperplanes.begin(),
+        env->dualSolver->generatedHyperplanes.end(), [](const GeneratedHyperplane& H) { return (H.isLazy); });
+
+    int numberOfMIPProblems
+        = env->solutionStatistics.numberOfProblemsOptimalMILP + env->solutionStatistics.numberOfProblemsFeasibleMILP;
+
+    std::cout << numberOfLazyHyperplanes << " of " << env->dualSolver->generatedHyperplanes.size()
+              << " hyperplanes added as lazy constraints in " << numberOfMIPProblems
+              << " MIP problems in the single-tree strategy\n";
+
+    if(numberOfLazyHyperplanes == 0)
+    {
+        std::cout << "No hyperplanes were added as lazy constraints in the callback\n";
+        return (false);
+    }
+
+    if(numberOfMIPProblems != 1)
+    {
+        std::cout << "The MIP problem was not solved exactly once\n";
+        return (false);
+    }
+
+    return (true);
+}
+
 int CbcTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -144,6 +273,21 @@ int CbcTest(int argc, char* argv[])
         passed = CbcTerminationCallbackTest("data/tls2.osil");
         std::cout << "Finished test checking termination callback in Cbc." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to solve a MINLP problem with a cut pool in Cbc:" << std::endl;
+        passed = CbcCutPoolTest("data/tls2.osil");
+        std::cout << "Finished test to solve a MINLP problem with a cut pool in Cbc." << std::endl;
+        break;
+    case 4:
+        std::cout << "Starting test to solve a MINLP problem in the single-tree strategy in Cbc:" << std::endl;
+        passed = CbcSingleTreeTest("data/tls2.osil");
+        std::cout << "Finished test to solve a MINLP problem in the single-tree strategy in Cbc." << std::endl;
+        break;
+    case 5:
+        std::cout << "Starting test to find interior points from several starting points using Cbc:" << std::endl;
+        passed = testMultiStartInteriorPoints("data/tls2.osil", ES_MIPSolver::Cbc, 0);
+        std::cout << "Finished test to find interior points from several starting points using Cbc." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -11,6 +11,8 @@
 #include "../src/Utilities.h"
 #include "../src/TaskHandler.h"
 
+#include "TestUtilities.h"
+
 #include <iostream>
 
 using namespace SHOT;
@@ -139,6 +141,13 @@ int CplexTest(int argc, char* argv[])
         passed = CplexTerminationCallbackTest("data/tls2.osil");
         std::cout << "Finished test checking termination callback in Cplex." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to find interior points from several starting points in parallel using Cplex:"
+                  << std::endl;
+        passed = testMultiStartInteriorPoints("data/tls2.osil", ES_MIPSolver::Cplex, 4);
+        std::cout << "Finished test to find interior points from several starting points in parallel using Cplex."
+                  << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -205,11 +205,12 @@ bool TestGradientGAMS(const std::string& problemFile)
 
         std::cout << "\nCalculating gradient for constraint:\t" << C << ":\n";
 
-        auto gradient = C->calculateGradient(point, true);
+        SparseVariableVector gradient;
+        C->calculateGradient(point, true, gradient);
 
         for(auto const& G : gradient)
         {
-            std::cout << G.first->name << ":  " << G.second << '\n';
+            std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
         }
 
         std::cout << '\n';
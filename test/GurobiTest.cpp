@@ -17,6 +17,8 @@
 
 #include "../src/Model/Problem.h"
 
+#include "TestUtilities.h"
+
 #include <iostream>
 
 using namespace SHOT;
@@ -145,6 +147,13 @@ int GurobiTest(int argc, char* argv[])
         passed = GurobiTerminationCallbackTest("data/tls2.osil");
         std::cout << "Finished test checking termination callback in Gurobi." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to find interior points from several starting points in parallel using Gurobi:"
+                  << std::endl;
+        passed = testMultiStartInteriorPoints("data/tls2.osil", ES_MIPSolver::Gurobi, 4);
+        std::cout << "Finished test to find interior points from several starting points in parallel using Gurobi."
+                  << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -22,6 +22,8 @@
 
 #include "../src/NLPSolver/NLPSolverIpoptRelaxed.h"
 
+#include "TestUtilities.h"
+
 using namespace SHOT;
 
 bool IpoptTest1()
@@ -115,20 +117,21 @@ bool IpoptTest1()
     point.push_back(2.0);
     point.push_back(3.0);
 
-    auto gradient = problem->objectiveFunction->calculateGradient(point, true);
+    SparseVariableVector gradient;
+    problem->objectiveFunction->calculateGradient(point, true, gradient);
 
     for(auto const& G : gradient)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating constraint gradient in point (2.0,3.0):\n";
 
-    gradient = problem->nonlinearConstraints.at(0)->calculateGradient(point, true);
+    problem->nonlinearConstraints.at(0)->calculateGradient(point, true, gradient);
 
     for(auto const& G : gradient)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     NLPSolver->setStartingPoint(std::vector<int>({ 0, 1 }), std::vector<double>({ 5.0, 5.0 }));
@@ -214,11 +217,12 @@ bool IpoptTest2()
     point.push_back(2.0);
     point.push_back(3.0);
 
-    auto gradient = problem->objectiveFunction->calculateGradient(point, true);
+    SparseVariableVector gradient;
+    problem->objectiveFunction->calculateGradient(point, true, gradient);
 
     for(auto const& G : gradient)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     NLPSolver->setStartingPoint(std::vector<int>({ 0, 1 }), std::vector<double>({ 5.0, 5.0 }));
@@ -237,6 +241,161 @@ bool IpoptTest2()
     return (passed);
 }
 
+// Solves a MINLP problem with the fixed NLP problems solved in the main thread and asynchronously, where the workers
+// are also shared by the original and reformulated problems
+bool IpoptTest3()
+{
+    // Whether the problems are solved asynchronously and from which problem
+    std::vector<std::pair<bool, ES_PrimalNLPProblemSource>> variants
+        = { { false, ES_PrimalNLPProblemSource::OriginalProblem }, { true, ES_PrimalNLPProblemSource::OriginalProblem },
+              { true, ES_PrimalNLPProblemSource::Both } };
+
+    auto settingVariants
+        = createSettingVariants(variants, [](Solver& solver, std::pair<bool, ES_PrimalNLPProblemSource> variant) {
+              solver.updateSetting("FixedInteger.Asynchronous.Use", "Primal", variant.first);
+              solver.updateSetting("FixedInteger.Asynchronous.Threads", "Primal", 2);
+              solver.updateSetting("FixedInteger.SourceProblem", "Primal", static_cast<int>(variant.second));
+          });
+
+    std::vector<std::unique_ptr<Solver>> solvers;
+
+    if(!solveWithSettingVariants("data/tls2.osil", settingVariants, solvers))
+        return (false);
+
+    for(size_t i = 0; i < solvers.size(); i++)
+    {
+        auto env = solvers[i]->getEnvironment();
+
+        std::cout << env->solutionStatistics.numberOfProblemsFixedNLP << " fixed NLP problems solved "
+                  << (i > 0 ? "asynchronously" : "in the main thread") << '\n';
+
+        if(env->solutionStatistics.numberOfProblemsFixedNLP == 0)
+        {
+            std::cout << "No fixed NLP problems were solved\n";
+            return (false);
+        }
+
+        if(i == 0)
+            continue;
+
+        if(env->settings->getSetting<int>("MIP.NumberOfThreads", "Dual") == 0)
+        {
+            std::cout << "The threads were not divided between the MIP solver and the NLP problems\n";
+            return (false);
+        }
+
+        // The default linear solver in Ipopt is not thread-safe
+        if(static_cast<ES_IpoptSolver>(env->settings->getSetting<int>("Ipopt.LinearSolver", "Subsolver"))
+                == ES_IpoptSolver::IpoptDefault
+            && env->settings->getSetting<int>("FixedInteger.Asynchronous.Threads", "Primal") != 1)
+        {
+            std::cout << "The fixed NLP problems were solved in several threads with the default linear solver\n";
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+// Solves the same sequence of NLP problems with fixed variables with and without warm starting Ipopt, which should
+// give the same solution status and objective value for each problem
+bool IpoptTest4()
+{
+    bool passed = true;
+
+    std::vector<double> fixedValues = { 0.0, 1.0, 2.0, 3.0, 4.0, 2.0, 1.0 };
+
+    std::vector<std::vector<E_NLPSolutionStatus>> statuses;
+    std::vector<std::vector<double>> objectiveValues;
+
+    for(bool useWarmStart : { false, true })
+    {
+        std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+        auto env = solver->getEnvironment();
+
+        solver->updateSetting("Ipopt.WarmStart", "Subsolver", useWarmStart);
+
+        SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+        env->problem = problem;
+
+        /*
+         * min_x f(x) = (y-2)^2 + x*y
+         *  s.t.
+         *       x^2 + y^2 <= 9
+         *       0 <= x <= 4, -10 <= y <= 10
+         */
+
+        auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 4.0);
+        SHOT::ExpressionVariablePtr expressionVariable_x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+
+        auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -10.0, 10.0);
+        SHOT::ExpressionVariablePtr expressionVariable_y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+
+        SHOT::Variables variables = { var_x, var_y };
+        problem->add(variables);
+
+        SHOT::NonlinearObjectiveFunctionPtr objectiveFunction
+            = std::make_shared<SHOT::NonlinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+
+        SHOT::NonlinearExpressionPtr exprMinus = std::make_shared<SHOT::ExpressionSum>(
+            expressionVariable_y, std::make_shared<ExpressionNegate>(std::make_shared<SHOT::ExpressionConstant>(2.0)));
+
+        SHOT::NonlinearExpressionPtr exprProduct
+            = std::make_shared<SHOT::ExpressionProduct>(expressionVariable_x, expressionVariable_y);
+
+        objectiveFunction->add(
+            std::make_shared<SHOT::ExpressionSum>(std::make_shared<SHOT::ExpressionSquare>(exprMinus), exprProduct));
+        problem->add(objectiveFunction);
+
+        SHOT::NonlinearExpressionPtr exprPlus
+            = std::make_shared<SHOT::ExpressionSum>(std::make_shared<SHOT::ExpressionSquare>(expressionVariable_x),
+                std::make_shared<SHOT::ExpressionSquare>(expressionVariable_y));
+        SHOT::NonlinearConstraintPtr nonlinearConstraint
+            = std::make_shared<SHOT::NonlinearConstraint>(0, "nlconstr", exprPlus, SHOT_DBL_MIN, 9.0);
+        problem->add(nonlinearConstraint);
+
+        problem->finalize();
+
+        // Fixing variables is only public in the interface
+        std::shared_ptr<INLPSolver> NLPSolver = std::make_shared<NLPSolverIpoptRelaxed>(env, problem);
+
+        statuses.emplace_back();
+        objectiveValues.emplace_back();
+
+        for(auto value : fixedValues)
+        {
+            NLPSolver->fixVariables(std::vector<int>({ 0 }), std::vector<double>({ value }));
+
+            statuses.back().push_back(NLPSolver->solveProblem());
+            objectiveValues.back().push_back(NLPSolver->getObjectiveValue());
+
+            NLPSolver->unfixVariables();
+
+            std::cout << "Objective value " << objectiveValues.back().back() << " with x fixed to " << value
+                      << (useWarmStart ? " with warm start" : " without warm start") << '\n';
+        }
+    }
+
+    for(size_t i = 0; i < fixedValues.size(); i++)
+    {
+        if(statuses[0][i] != statuses[1][i])
+        {
+            std::cout << "Different solution status with x fixed to " << fixedValues[i] << '\n';
+            passed = false;
+        }
+        else if((statuses[0][i] == E_NLPSolutionStatus::Optimal || statuses[0][i] == E_NLPSolutionStatus::Feasible)
+            && std::abs(objectiveValues[0][i] - objectiveValues[1][i])
+                > 1e-5 * (1.0 + std::abs(objectiveValues[0][i])))
+        {
+            std::cout << "Different objective value with x fixed to " << fixedValues[i] << '\n';
+            passed = false;
+        }
+    }
+
+    return (passed);
+}
+
 int IpoptTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -266,6 +425,16 @@ int IpoptTest(int argc, char* argv[])
         passed = IpoptTest2();
         std::cout << "Finished test to solve 2D unconstrained problem using Ipopt." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to solve fixed NLP problems asynchronously using Ipopt:" << std::endl;
+        passed = IpoptTest3();
+        std::cout << "Finished test to solve fixed NLP problems asynchronously using Ipopt." << std::endl;
+        break;
+    case 4:
+        std::cout << "Starting test to solve fixed NLP problems with and without warm start using Ipopt:" << std::endl;
+        passed = IpoptTest4();
+        std::cout << "Finished test to solve fixed NLP problems with and without warm start using Ipopt." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -18,8 +18,13 @@
 #include "../src/Model/NonlinearExpressions.h"
 #include "../src/Model/Problem.h"
 
+#include "../src/RootsearchMethod/RootsearchMethodBoost.h"
 #include "../src/Tasks/TaskReformulateProblem.h"
 
+#include <Eigen/Eigenvalues>
+
+#include <chrono>
+#include <random>
 #include <sstream>
 
 using namespace SHOT;
@@ -34,6 +39,10 @@ bool ModelTestCreateProblem2();
 bool ModelTestCreateProblem3();
 bool ModelTestConvexity();
 bool ModelTestCopy();
+bool ModelTestBoundTightening();
+bool ModelTestQuadraticConvexity();
+bool ModelTestDecomposition();
+bool ModelTestParallelEvaluation();
 
 bool TestReadProblem(const std::string& problemFile);
 bool TestRootsearch(const std::string& problemFile);
@@ -89,6 +98,18 @@ int ModelTest(int argc, char* argv[])
     case 10:
         passed = ModelTestCopy();
         break;
+    case 11:
+        passed = ModelTestBoundTightening();
+        break;
+    case 12:
+        passed = ModelTestQuadraticConvexity();
+        break;
+    case 13:
+        passed = ModelTestDecomposition();
+        break;
+    case 14:
+        passed = ModelTestParallelEvaluation();
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -521,15 +542,17 @@ bool ModelTestCreateProblem()
     }
 
     std::cout << "\nCalculating gradient for function in linear constraint:\n";
-    auto gradientLinear = linearConstraint->calculateGradient(point, true);
+    SparseVariableVector gradientLinear;
+    linearConstraint->calculateGradient(point, true, gradientLinear);
 
     for(auto const& G : gradientLinear)
     {
-        std::cout << G.first->name << ": " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ": " << G.second << '\n';
     }
 
     std::cout << "\nCalculating Hessian for function in linear constraint (there should be none):\n";
-    auto hessianLinear = linearConstraint->calculateHessian(point, true);
+    SparseVariableMatrix hessianLinear;
+    linearConstraint->calculateHessian(point, true, hessianLinear);
 
     if(hessianLinear.size() > 0)
     {
@@ -537,58 +560,68 @@ bool ModelTestCreateProblem()
 
         for(auto const& H : hessianLinear)
         {
-            std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+            std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                      << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
         }
 
         passed = false;
     }
 
     std::cout << "\nCalculating gradient for function in quadratic constraint:\n";
-    auto gradientQuadratic = quadraticConstraint->calculateGradient(point, true);
+    SparseVariableVector gradientQuadratic;
+    quadraticConstraint->calculateGradient(point, true, gradientQuadratic);
 
     for(auto const& G : gradientQuadratic)
     {
-        std::cout << G.first->name << ": " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ": " << G.second << '\n';
     }
 
     std::cout << "\nCalculating hessian for function in quadratic constraint:\n";
-    auto hessianQuadratic = quadraticConstraint->calculateHessian(point, true);
+    SparseVariableMatrix hessianQuadratic;
+    quadraticConstraint->calculateHessian(point, true, hessianQuadratic);
 
     for(auto const& H : hessianQuadratic)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
     }
 
     std::cout << "\nCalculating gradient for function in first nonlinear constraint:\n";
-    auto gradientNonlinear = nonlinearConstraint->calculateGradient(point, true);
+    SparseVariableVector gradientNonlinear;
+    nonlinearConstraint->calculateGradient(point, true, gradientNonlinear);
 
     for(auto const& G : gradientNonlinear)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating hessian for function in first nonlinear constraint (there should be one element):\n";
-    auto hessianNonlinear = nonlinearConstraint->calculateHessian(point, true);
+    SparseVariableMatrix hessianNonlinear;
+    nonlinearConstraint->calculateHessian(point, true, hessianNonlinear);
 
     for(auto const& H : hessianNonlinear)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
     }
 
     std::cout << "\nCalculating gradient for function in second nonlinear constraint:\n";
-    auto gradientNonlinear2 = nonlinearConstraint2->calculateGradient(point, true);
+    SparseVariableVector gradientNonlinear2;
+    nonlinearConstraint2->calculateGradient(point, true, gradientNonlinear2);
 
     for(auto const& G : gradientNonlinear2)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating hessian for function in second nonlinear constraint:\n";
-    auto hessianNonlinear2 = nonlinearConstraint2->calculateHessian(point, true);
+    SparseVariableMatrix hessianNonlinear2;
+    nonlinearConstraint2->calculateHessian(point, true, hessianNonlinear2);
 
     for(auto const& H : hessianNonlinear2)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
     }
 
     SHOT::Interval X(1., 2.);
@@ -783,19 +816,22 @@ bool ModelTestCreateProblem2()
     }
 
     std::cout << "\nCalculating gradient for function in first nonlinear constraint:\n";
-    auto gradientNonlinear = nonlinearConstraint->calculateGradient(point, true);
+    SparseVariableVector gradientNonlinear;
+    nonlinearConstraint->calculateGradient(point, true, gradientNonlinear);
 
     for(auto const& G : gradientNonlinear)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating Hessian for function in first nonlinear constraint:\n";
-    auto hessianNonlinear = nonlinearConstraint->calculateHessian(point, true);
+    SparseVariableMatrix hessianNonlinear;
+    nonlinearConstraint->calculateHessian(point, true, hessianNonlinear);
 
     for(auto const& H : hessianNonlinear)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
     }
 
     return passed;
@@ -923,35 +959,92 @@ bool ModelTestCreateProblem3()
     }
 
     std::cout << "\nCalculating gradient for function in first nonlinear constraint:\n";
-    auto gradientNonlinear = nonlinearConstraint->calculateGradient(point, true);
+    SparseVariableVector gradientNonlinear;
+    nonlinearConstraint->calculateGradient(point, true, gradientNonlinear);
 
     for(auto const& G : gradientNonlinear)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating Hessian for function in first nonlinear constraint:\n";
-    auto hessianNonlinear = nonlinearConstraint->calculateHessian(point, true);
+    SparseVariableMatrix hessianNonlinear;
+    nonlinearConstraint->calculateHessian(point, true, hessianNonlinear);
 
     for(auto const& H : hessianNonlinear)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
     }
 
     std::cout << "\nCalculating gradient for function in second nonlinear constraint:\n";
-    gradientNonlinear = nonlinearConstraint2->calculateGradient(point, true);
+    nonlinearConstraint2->calculateGradient(point, true, gradientNonlinear);
 
     for(auto const& G : gradientNonlinear)
     {
-        std::cout << G.first->name << ":  " << G.second << '\n';
+        std::cout << problem->getVariable(G.first)->name << ":  " << G.second << '\n';
     }
 
     std::cout << "\nCalculating hessian for function in second nonlinear constraint:\n";
-    hessianNonlinear = nonlinearConstraint2->calculateHessian(point, true);
+    nonlinearConstraint2->calculateHessian(point, true, hessianNonlinear);
 
     for(auto const& H : hessianNonlinear)
     {
-        std::cout << "(" + H.first.first->name << "," << H.first.second->name << "): " << H.second << '\n';
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
+    }
+
+    std::cout << "\nCalculating Hessian of the Lagrangian:\n";
+    VectorDouble multipliers;
+
+    for(int i = 0; i < problem->properties.numberOfNumericConstraints; i++)
+        multipliers.push_back(i + 1.0);
+
+    SparseVariableMatrix hessianLagrangian;
+    problem->calculateLagrangianHessian(point, 2.0, multipliers, true, hessianLagrangian);
+
+    for(auto const& H : hessianLagrangian)
+    {
+        std::cout << "(" + problem->getVariable(H.first.first)->name << ","
+                  << problem->getVariable(H.first.second)->name << "): " << H.second << '\n';
+    }
+
+    // The Hessian of the Lagrangian should equal the weighted sum of the Hessians of the individual functions
+    SparseVariableMatrix hessianSum;
+    SparseVariableMatrix hessianFunction;
+
+    problem->objectiveFunction->calculateHessian(point, false, hessianFunction);
+
+    for(auto const& H : hessianFunction)
+        hessianSum.add(H.first.first, H.first.second, 2.0 * H.second);
+
+    for(auto& C : problem->numericConstraints)
+    {
+        C->calculateHessian(point, false, hessianFunction);
+
+        for(auto const& H : hessianFunction)
+            hessianSum.add(H.first.first, H.first.second, multipliers[C->index] * H.second);
+    }
+
+    hessianSum.sortAndCombine();
+    hessianSum.eraseZeroes();
+
+    if(hessianSum.size() != hessianLagrangian.size())
+    {
+        std::cout << "The number of elements in the Hessian of the Lagrangian is wrong!\n";
+        passed = false;
+    }
+    else
+    {
+        for(size_t i = 0; i < hessianSum.size(); i++)
+        {
+            if(hessianSum[i].first != hessianLagrangian[i].first
+                || std::abs(hessianSum[i].second - hessianLagrangian[i].second) > 1e-8)
+            {
+                std::cout << "The Hessian of the Lagrangian is wrong!\n";
+                passed = false;
+            }
+        }
     }
 
     return passed;
@@ -1187,3 +1280,592 @@ bool ModelTestCopy()
 
     return passed;
 }
+
+bool ModelTestBoundTightening()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    // A chain of constraints x_{i+1} - x_i >= 1, where the bounds have to be propagated through all constraints both
+    // forwards and backwards
+    int numberOfVariables = 20;
+    SHOT::Variables variables;
+
+    for(int i = 0; i < numberOfVariables; i++)
+        variables.push_back(
+            std::make_shared<SHOT::Variable>("x" + std::to_string(i), i, SHOT::E_VariableType::Real, 0.0, 100.0));
+
+    problem->add(variables);
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, variables[0]));
+    problem->add(objectiveFunction);
+
+    // The constraints are added in reverse order, so a single pass in order propagates the upper bounds but not the
+    // lower bounds
+    for(int i = numberOfVariables - 2; i >= 0; i--)
+    {
+        SHOT::LinearTerms linearTerms;
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, variables[i + 1]));
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(-1.0, variables[i]));
+
+        problem->add(std::make_shared<SHOT::LinearConstraint>(
+            numberOfVariables - 2 - i, "c" + std::to_string(i), linearTerms, 1.0, SHOT_DBL_MAX));
+    }
+
+    problem->finalize();
+
+    solver->updateSetting("BoundTightening.FeasibilityBased.MaxIterations", "Model", numberOfVariables);
+    problem->doFBBT();
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        std::cout << variables[i]->name << ": [" << variables[i]->lowerBound << ", " << variables[i]->upperBound
+                  << "]\n";
+
+        if(std::abs(variables[i]->lowerBound - i) > 1e-6
+            || std::abs(variables[i]->upperBound - (100.0 - (numberOfVariables - 1 - i))) > 1e-6)
+        {
+            std::cout << "Bounds for variable " << variables[i]->name << " not tightened correctly\n";
+            passed = false;
+        }
+    }
+
+    // The constraints z - x <= 0 and x - y <= 0, where y is in [0, 1] and the other variables are unbounded. The upper
+    // bound of x becomes finite in the second constraint, so the first has to be propagated again even if the width of
+    // the domain of x is still infinite.
+    solver = std::make_unique<Solver>();
+    env = solver->getEnvironment();
+    problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, SHOT_DBL_MIN, SHOT_DBL_MAX);
+    auto y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, 0.0, 1.0);
+    auto z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, SHOT_DBL_MIN, SHOT_DBL_MAX);
+    problem->add(SHOT::Variables { x, y, z });
+
+    objectiveFunction = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, y));
+    problem->add(objectiveFunction);
+
+    SHOT::LinearTerms firstTerms;
+    firstTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, z));
+    firstTerms.add(std::make_shared<SHOT::LinearTerm>(-1.0, x));
+    problem->add(std::make_shared<SHOT::LinearConstraint>(0, "c0", firstTerms, SHOT_DBL_MIN, 0.0));
+
+    SHOT::LinearTerms secondTerms;
+    secondTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, x));
+    secondTerms.add(std::make_shared<SHOT::LinearTerm>(-1.0, y));
+    problem->add(std::make_shared<SHOT::LinearConstraint>(1, "c1", secondTerms, SHOT_DBL_MIN, 0.0));
+
+    problem->finalize();
+    problem->doFBBT();
+
+    std::cout << "z: [" << z->lowerBound << ", " << z->upperBound << "]\n";
+
+    if(std::abs(z->upperBound - 1.0) > 1e-6)
+    {
+        std::cout << "Upper bound for variable z not tightened after the upper bound of x became finite\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+// Adds the terms sign * (x^T L x + shift * x^T x) for the variables in the block, where L is the Laplacian of a random
+// connected graph, so that the terms are positive semidefinite and singular if the shift is zero and sign is one
+void addQuadraticBlock(QuadraticTerms& terms, const Variables& variables, int first, int size, double shift,
+    double sign, std::mt19937& generator)
+{
+    std::vector<std::pair<int, int>> edges;
+
+    for(int i = 1; i < size; i++)
+        edges.emplace_back(std::uniform_int_distribution<int>(0, i - 1)(generator), i);
+
+    for(int i = 0; i < size / 2; i++)
+    {
+        int firstEnd = std::uniform_int_distribution<int>(0, size - 1)(generator);
+        int secondEnd = std::uniform_int_distribution<int>(0, size - 1)(generator);
+
+        if(firstEnd != secondEnd)
+            edges.emplace_back(firstEnd, secondEnd);
+    }
+
+    std::vector<double> degrees(size, shift);
+
+    for(auto& E : edges)
+    {
+        degrees[E.first] += 1.0;
+        degrees[E.second] += 1.0;
+        terms.add(std::make_shared<QuadraticTerm>(
+            -2.0 * sign, variables[first + E.first], variables[first + E.second]));
+    }
+
+    for(int i = 0; i < size; i++)
+    {
+        if(degrees[i] != 0.0)
+            terms.add(std::make_shared<QuadraticTerm>(sign * degrees[i], variables[first + i], variables[first + i]));
+    }
+}
+
+// The convexity of the terms from the eigenvalues of the whole matrix
+E_Convexity getReferenceConvexity(const QuadraticTerms& terms, int numberOfVariables, double tolerance)
+{
+    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(numberOfVariables, numberOfVariables);
+
+    for(auto& T : terms)
+    {
+        if(T->firstVariable == T->secondVariable)
+        {
+            matrix(T->firstVariable->index, T->firstVariable->index) += T->coefficient;
+        }
+        else
+        {
+            matrix(T->firstVariable->index, T->secondVariable->index) += 0.5 * T->coefficient;
+            matrix(T->secondVariable->index, T->firstVariable->index) += 0.5 * T->coefficient;
+        }
+    }
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigenSolver(matrix, Eigen::DecompositionOptions::EigenvaluesOnly);
+
+    // Variables not in the terms give zero eigenvalues
+    if(eigenSolver.eigenvalues()(0) >= -tolerance)
+        return (E_Convexity::Convex);
+
+    if(eigenSolver.eigenvalues()(numberOfVariables - 1) <= tolerance)
+        return (E_Convexity::Concave);
+
+    return (E_Convexity::Nonconvex);
+}
+
+// Checks the block decomposed convexity detection for quadratic terms against the eigenvalues of the whole matrix
+bool ModelTestQuadraticConvexity()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    double tolerance = env->settings->getSetting<double>("Convexity.Quadratics.EigenValueTolerance", "Model");
+
+    std::mt19937 generator(1);
+
+    int numberOfVariables = 3000;
+    Variables variables;
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        variables.push_back(std::make_shared<SHOT::Variable>(
+            "x_" + std::to_string(i), i, SHOT::E_VariableType::Real, -10.0, 10.0));
+    }
+
+    problem->add(variables);
+
+    // The shift and sign of the terms in a block
+    struct BlockType
+    {
+        double shift;
+        double sign;
+    };
+
+    BlockType singularConvex { 0.0, 1.0 };
+    BlockType convex { 1.0, 1.0 };
+    BlockType concave { 1.0, -1.0 };
+    BlockType indefinite { -0.5, 1.0 };
+
+    std::vector<std::vector<BlockType>> constraintBlocks = { { convex, convex, convex, convex, convex },
+        { singularConvex, singularConvex, convex, singularConvex, convex },
+        { concave, concave, concave, concave, concave }, { convex, convex, indefinite, convex, convex },
+        { convex, convex, convex, convex, concave }, { indefinite, indefinite, indefinite, indefinite, indefinite } };
+
+    // The graphs of the blocks are the same in all constraints, so that the blocks with the same shift and sign have
+    // identical structure
+    std::vector<int> blockSizes = { 1, 3, 20, 80, 300 };
+
+    // Checks the convexity of the terms and returns the time used
+    auto checkConvexity = [&](QuadraticTerms& terms, const std::string& name, E_Convexity expectedConvexity) {
+        terms.takeOwnership(problem);
+
+        auto startTime = std::chrono::steady_clock::now();
+        auto convexity = terms.getConvexity();
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        std::cout << "Terms in " << name << " were checked in " << time << " s.\n";
+
+        if(convexity != expectedConvexity)
+        {
+            std::cout << "Test failed: the convexity of the terms in " << name << " is " << (int)convexity
+                      << " and not " << (int)expectedConvexity << ".\n";
+            passed = false;
+        }
+
+        if(convexity == E_Convexity::Convex && !terms.minEigenValueWithinTolerance)
+        {
+            std::cout << "Test failed: the smallest eigenvalue of the terms in " << name
+                      << " is not within the tolerance.\n";
+            passed = false;
+        }
+
+        // All convex terms are positive semidefinite also without the tolerance
+        if(convexity == E_Convexity::Convex && terms.minEigenValue < 0.0)
+        {
+            std::cout << "Test failed: the smallest eigenvalue of the terms in " << name << " is "
+                      << terms.minEigenValue << " and not nonnegative.\n";
+            passed = false;
+        }
+    };
+
+    for(size_t i = 0; i < constraintBlocks.size(); i++)
+    {
+        QuadraticTerms terms;
+        int first = 0;
+
+        for(size_t j = 0; j < blockSizes.size(); j++)
+        {
+            std::mt19937 blockGenerator(j);
+            addQuadraticBlock(terms, variables, first, blockSizes[j], constraintBlocks[i][j].shift,
+                constraintBlocks[i][j].sign, blockGenerator);
+            first += blockSizes[j];
+        }
+
+        checkConvexity(terms, "constraint " + std::to_string(i), getReferenceConvexity(terms, first, tolerance));
+    }
+
+    // The convexity of a constraint with the same terms as an earlier one is taken from the cache
+    std::mt19937 blockGenerator(4);
+    QuadraticTerms terms;
+    addQuadraticBlock(terms, variables, 1000, 300, convex.shift, convex.sign, blockGenerator);
+    checkConvexity(terms, "constraint with cached block", E_Convexity::Convex);
+
+    // A large objective function with many blocks
+    QuadraticTerms objectiveTerms;
+
+    for(int first = 0; first < numberOfVariables; first += 100)
+        addQuadraticBlock(objectiveTerms, variables, first, 100, (first % 300 == 0) ? 0.0 : 1.0, 1.0, generator);
+
+    checkConvexity(objectiveTerms, "objective with " + std::to_string(numberOfVariables) + " variables",
+        E_Convexity::Convex);
+
+    return passed;
+}
+
+// Checks the block structure found for a problem with three blocks and one linking constraint, and a root search
+// restricted to one of the blocks
+bool ModelTestDecomposition()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    int numberOfBlocks = 3;
+    Variables variables;
+
+    for(int i = 0; i < 3 * numberOfBlocks + 1; i++)
+    {
+        variables.push_back(std::make_shared<SHOT::Variable>(
+            "x_" + std::to_string(i), i, SHOT::E_VariableType::Real, 0.0, 10.0));
+    }
+
+    problem->add(variables);
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, variables[3 * numberOfBlocks]));
+    problem->add(objectiveFunction);
+
+    std::vector<NumericConstraint*> nonlinearConstraints;
+
+    for(int i = 0; i < numberOfBlocks; i++)
+    {
+        // exp(x_3i) + x_3i+1^2 <= 10
+        auto nonlinearConstraint = std::make_shared<SHOT::NonlinearConstraint>(
+            2 * i, "n_" + std::to_string(i), SHOT_DBL_MIN, 10.0);
+        nonlinearConstraint->add(std::make_shared<ExpressionSum>(
+            std::make_shared<ExpressionExp>(std::make_shared<ExpressionVariable>(variables[3 * i])),
+            std::make_shared<ExpressionSquare>(std::make_shared<ExpressionVariable>(variables[3 * i + 1]))));
+        problem->add(nonlinearConstraint);
+        nonlinearConstraints.push_back(nonlinearConstraint.get());
+
+        // x_3i+1 + x_3i+2 <= 4
+        SHOT::LinearTerms linearTerms;
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, variables[3 * i + 1]));
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, variables[3 * i + 2]));
+        problem->add(std::make_shared<SHOT::LinearConstraint>(
+            2 * i + 1, "l_" + std::to_string(i), linearTerms, SHOT_DBL_MIN, 4.0));
+    }
+
+    // The linking constraint sum x_3i <= 5
+    SHOT::LinearTerms linkingTerms;
+
+    for(int i = 0; i < numberOfBlocks; i++)
+        linkingTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, variables[3 * i]));
+
+    problem->add(std::make_shared<SHOT::LinearConstraint>(
+        2 * numberOfBlocks, "linking", linkingTerms, SHOT_DBL_MIN, 5.0));
+
+    problem->finalize();
+
+    auto& decomposition = problem->decomposition;
+
+    std::cout << "Number of blocks: " << decomposition.getNumberOfBlocks()
+              << ", number of linking constraints: " << decomposition.linkingConstraints.size() << '\n';
+
+    if(decomposition.getNumberOfBlocks() != numberOfBlocks || decomposition.linkingConstraints.size() != 1
+        || decomposition.linkingConstraints[0] != 2 * numberOfBlocks)
+    {
+        std::cout << "Wrong block structure found\n";
+        passed = false;
+    }
+
+    for(int i = 0; passed && i < numberOfBlocks; i++)
+    {
+        if(decomposition.blockVariables[i] != VectorInteger({ 3 * i, 3 * i + 1, 3 * i + 2 })
+            || decomposition.blockConstraints[i] != VectorInteger({ 2 * i, 2 * i + 1 }))
+        {
+            std::cout << "Wrong variables or constraints in block " << i << '\n';
+            passed = false;
+        }
+    }
+
+    if(decomposition.variableBlocks[3 * numberOfBlocks] != -1)
+    {
+        std::cout << "Variable not in any constraint is in a block\n";
+        passed = false;
+    }
+
+    if(problem->getBlockVariables({ nonlinearConstraints[1] }) != VectorInteger({ 3, 4, 5 }))
+    {
+        std::cout << "Wrong variables in the block of constraint " << nonlinearConstraints[1]->name << '\n';
+        passed = false;
+    }
+
+    // The blocks of two constraints contain more than half of the variables, so all variables are used
+    if(problem->getBlockVariables({ nonlinearConstraints[0], nonlinearConstraints[1] }).size() != 0)
+    {
+        std::cout << "Variables restricted to blocks with more than half of the variables\n";
+        passed = false;
+    }
+
+    // The root search for a constraint only interpolates the variables in its block, the other variables are
+    // interpolated when creating the final points
+    RootsearchMethodBoost rootsearch(env);
+
+    VectorDouble interiorPoint(variables.size(), 0.0);
+    VectorDouble exteriorPoint(variables.size(), 2.5);
+
+    auto points
+        = rootsearch.findZeroConcurrently(interiorPoint, exteriorPoint, 100, 1e-10, { nonlinearConstraints[1] });
+
+    double interiorValue = nonlinearConstraints[1]->calculateNumericValue(points.first).normalizedValue;
+    double exteriorValue = nonlinearConstraints[1]->calculateNumericValue(points.second).normalizedValue;
+
+    std::cout << "Constraint values in the points found by the root search: " << interiorValue << " and "
+              << exteriorValue << '\n';
+
+    if(interiorValue > 0.0 || exteriorValue < 0.0 || exteriorValue - interiorValue > 1e-6)
+    {
+        std::cout << "Root search restricted to a block failed\n";
+        passed = false;
+    }
+
+    if(std::abs(points.first[0] - points.first[3]) > 1e-6 || std::abs(points.first[0] - points.first[9]) > 1e-6)
+    {
+        std::cout << "Variables outside the block not interpolated in the final points\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+// Checks that evaluating the constraints in parallel gives the same results as evaluating them in one thread
+bool ModelTestParallelEvaluation()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    int numberOfVariables = 1000;
+    int numberOfConstraints = 5000;
+
+    Variables variables;
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        variables.push_back(std::make_shared<SHOT::Variable>(
+            "x_" + std::to_string(i), i, SHOT::E_VariableType::Real, 0.0, 3.0));
+    }
+
+    problem->add(variables);
+
+    auto objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, variables[0]));
+    problem->add(objectiveFunction);
+
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> variableDistribution(0, numberOfVariables - 1);
+    std::uniform_real_distribution<double> valueDistribution(0.0, 3.0);
+
+    // exp(x_i) + x_j^2 <= U, where U is random so that some constraints are violated
+    for(int i = 0; i < numberOfConstraints; i++)
+    {
+        auto constraint = std::make_shared<SHOT::NonlinearConstraint>(
+            i, "c_" + std::to_string(i), SHOT_DBL_MIN, 1.0 + 10.0 * valueDistribution(generator));
+        constraint->add(std::make_shared<ExpressionSum>(
+            std::make_shared<ExpressionExp>(
+                std::make_shared<ExpressionVariable>(variables[variableDistribution(generator)])),
+            std::make_shared<ExpressionSquare>(
+                std::make_shared<ExpressionVariable>(variables[variableDistribution(generator)]))));
+        problem->add(constraint);
+    }
+
+    problem->finalize();
+
+    int numberOfPoints = 5;
+    std::vector<VectorDouble> points(numberOfPoints, VectorDouble(numberOfVariables));
+    PointBatch pointBatch(numberOfVariables, numberOfPoints);
+
+    for(int k = 0; k < numberOfPoints; k++)
+    {
+        for(int i = 0; i < numberOfVariables; i++)
+        {
+            points[k][i] = valueDistribution(generator);
+            pointBatch.getVariableValues(i)[k] = points[k][i];
+        }
+    }
+
+    std::vector<NumericConstraint*> constraintSelection;
+
+    for(auto& C : problem->nonlinearConstraints)
+        constraintSelection.push_back(C.get());
+
+    // The results for each point as the values of the deviating constraints, the largest deviating constraints, the
+    // maximum value and the violated constraints
+    using EvaluationResults = std::tuple<NumericConstraintValues, NumericConstraintValues, NumericConstraintValue,
+        std::vector<NumericConstraint*>>;
+
+    auto evaluate = [&]() {
+        std::vector<EvaluationResults> results;
+
+        for(auto& P : points)
+        {
+            std::vector<NumericConstraint*> activeConstraints;
+            auto maxValue = problem->getMaxNumericConstraintValue(P, constraintSelection, activeConstraints);
+
+            results.emplace_back(problem->getAllDeviatingNonlinearConstraints(P, 0.0),
+                problem->getFractionOfDeviatingNonlinearConstraints(P, 0.0, 0.01), maxValue, activeConstraints);
+        }
+
+        return (results);
+    };
+
+    auto isEqual = [](const NumericConstraintValues& first, const NumericConstraintValues& second) {
+        if(first.size() != second.size())
+            return (false);
+
+        for(size_t i = 0; i < first.size(); i++)
+        {
+            // The values calculated for several points at once may differ in the last digits
+            if(first[i].constraint != second[i].constraint
+                || std::abs(first[i].normalizedValue - second[i].normalizedValue)
+                    > 1e-10 * (1.0 + std::abs(first[i].normalizedValue)))
+                return (false);
+        }
+
+        return (true);
+    };
+
+    int numberOfRepetitions = 20;
+
+    solver->updateSetting("Evaluation.Parallel.MinimumConstraints", "Model", 0);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < numberOfRepetitions - 1; i++)
+        evaluate();
+
+    auto serialResults = evaluate();
+    auto serialBatchResults = problem->getFractionOfDeviatingNonlinearConstraints(pointBatch, 0.0, 0.01);
+    auto serialBatchMaxValues = problem->getMaxNumericConstraintValues(pointBatch, problem->nonlinearConstraints);
+
+    std::chrono::duration<double> serialTime = std::chrono::steady_clock::now() - startTime;
+
+    solver->updateSetting("Evaluation.Parallel.MinimumConstraints", "Model", 1000);
+    solver->updateSetting("Threads", "Strategy", 4);
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < numberOfRepetitions - 1; i++)
+        evaluate();
+
+    auto parallelResults = evaluate();
+    auto parallelBatchResults = problem->getFractionOfDeviatingNonlinearConstraints(pointBatch, 0.0, 0.01);
+    auto parallelBatchMaxValues = problem->getMaxNumericConstraintValues(pointBatch, problem->nonlinearConstraints);
+
+    std::chrono::duration<double> parallelTime = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << "Time for evaluating the constraints in one thread: " << serialTime.count()
+              << " s, and in four threads: " << parallelTime.count() << " s\n";
+
+    for(int k = 0; k < numberOfPoints; k++)
+    {
+        auto& serial = serialResults[k];
+        auto& parallel = parallelResults[k];
+
+        std::cout << "Point " << k << ": " << std::get<0>(serial).size() << " deviating constraints, "
+                  << std::get<1>(serial).size() << " selected, maximum value " << std::get<2>(serial).normalizedValue
+                  << '\n';
+
+        if(std::get<0>(serial).size() == 0 || std::get<1>(serial).size() != 50)
+        {
+            std::cout << "Too few deviating constraints in point " << k << '\n';
+            passed = false;
+        }
+
+        if(!isEqual(std::get<0>(serial), std::get<0>(parallel)) || !isEqual(std::get<1>(serial), std::get<1>(parallel))
+            || !isEqual(std::get<1>(serial), serialBatchResults[k])
+            || !isEqual(std::get<1>(serial), parallelBatchResults[k]))
+        {
+            std::cout << "Different deviating constraints found in point " << k << '\n';
+            passed = false;
+        }
+
+        if(std::get<2>(serial).constraint != std::get<2>(parallel).constraint
+            || std::get<2>(serial).constraint != serialBatchMaxValues[k].constraint
+            || std::get<2>(serial).constraint != parallelBatchMaxValues[k].constraint
+            || std::get<3>(serial) != std::get<3>(parallel))
+        {
+            std::cout << "Different maximum values or violated constraints found in point " << k << '\n';
+            passed = false;
+        }
+
+        // The selected constraints should be the ones with the largest values, in decreasing order
+        auto sortedValues = std::get<0>(serial);
+        std::sort(sortedValues.begin(), sortedValues.end(), std::greater<NumericConstraintValue>());
+
+        for(size_t i = 0; i < std::get<1>(serial).size(); i++)
+        {
+            if(std::get<1>(serial)[i].normalizedValue != sortedValues[i].normalizedValue)
+            {
+                std::cout << "The selected constraints in point " << k << " are not the ones with largest values\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    return passed;
+}
@@ -22,11 +22,13 @@ namespace fs = std;
 namespace fs = std::experimental;
 #endif
 
+#include <chrono>
 #include <iostream>
 
 using namespace SHOT;
 
 bool SettingsTestOptions(bool useOSiL);
+bool SettingsTestHandles();
 
 int SettingsTest(int argc, char* argv[])
 {
@@ -57,6 +59,11 @@ int SettingsTest(int argc, char* argv[])
         passed = SettingsTestOptions(false);
         std::cout << "Finished test to read and write opt files." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test of setting handles:" << std::endl;
+        passed = SettingsTestHandles();
+        std::cout << "Finished test of setting handles." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -120,4 +127,70 @@ bool SettingsTestOptions(bool useOSiL)
     }
 
     return passed;
-}
\ No newline at end of file
+}
+
+// Test that setting handles and change listeners follow updates, and compare the time of reading settings through
+// handles with normal lookups
+bool SettingsTestHandles()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto settings = solver->getEnvironment()->settings;
+
+    auto treeStrategy = settings->getSettingHandle<int>("TreeStrategy", "Dual");
+    auto lambdaTolerance = settings->getSettingHandle<double>("Rootsearch.TerminationTolerance", "Subsolver");
+
+    int numberOfChanges = 0;
+    settings->addSettingChangeListener("TreeStrategy", "Dual", [&numberOfChanges]() { numberOfChanges++; });
+
+    int originalTreeStrategy = settings->getSetting<int>("TreeStrategy", "Dual");
+    int newTreeStrategy = (originalTreeStrategy == 0) ? 1 : 0;
+
+    solver->updateSetting("TreeStrategy", "Dual", newTreeStrategy);
+
+    if(treeStrategy.get() != newTreeStrategy)
+    {
+        std::cout << "Setting handle did not follow the update of the setting." << std::endl;
+        passed = false;
+    }
+
+    // Updating with the same value should not notify the listener
+    solver->updateSetting("TreeStrategy", "Dual", newTreeStrategy);
+
+    if(numberOfChanges != 1)
+    {
+        std::cout << "Change listener called " << numberOfChanges << " times instead of once." << std::endl;
+        passed = false;
+    }
+
+    int numberOfReads = 1000000;
+    double lookupSum = 0.0;
+    double handleSum = 0.0;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < numberOfReads; i++)
+        lookupSum += settings->getSetting<int>("TreeStrategy", "Dual")
+            + settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver");
+
+    auto lookupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    startTime = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < numberOfReads; i++)
+        handleSum += treeStrategy.get() + lambdaTolerance.get();
+
+    auto handleTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "Time for " << 2 * numberOfReads << " setting reads: " << lookupTime << " s with lookups and "
+              << handleTime << " s with handles." << std::endl;
+
+    if(lookupSum != handleSum)
+    {
+        std::cout << "Setting handles and lookups gave different values." << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
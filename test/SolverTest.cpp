@@ -10,6 +10,7 @@
 
 #include "../src/Solver.h"
 #include "../src/Environment.h"
+#include "../src/DualSolver.h"
 #include "../src/Results.h"
 #include "../src/Structs.h"
 #include "../src/TaskHandler.h"
@@ -28,6 +29,25 @@
 #include "../src/RootsearchMethod/RootsearchMethodBoost.h"
 
 #include "../src/Tasks/TaskReformulateProblem.h"
+#include "../src/Tasks/TaskSelectHyperplanePointsESH.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <tuple>
+
+#ifdef HAS_STD_FILESYSTEM
+#include <filesystem>
+namespace fs = std;
+#endif
+
+#ifdef HAS_STD_EXPERIMENTAL_FILESYSTEM
+#include <experimental/filesystem>
+namespace fs = std::experimental;
+#endif
 
 using namespace SHOT;
 
@@ -204,11 +224,12 @@ bool TestGradient(const std::string& problemFile)
     {
         std::cout << "\nCalculating gradient for constraint:\t" << C << ":\n";
 
-        auto gradient = C->calculateGradient(point, true);
+        SparseVariableVector gradient;
+        C->calculateGradient(point, true, gradient);
 
         for(auto const& G : gradient)
         {
-            std::cout << G.first->name << ":  " << G.second << '\n';
+            std::cout << env->problem->getVariable(G.first)->name << ":  " << G.second << '\n';
         }
 
         std::cout << '\n';
@@ -217,6 +238,400 @@ bool TestGradient(const std::string& problemFile)
     return passed;
 }
 
+// Deterministic points spread out between the variable bounds
+std::vector<VectorDouble> createPointsWithinBounds(ProblemPtr problem, int numberOfPoints)
+{
+    std::vector<VectorDouble> points(numberOfPoints);
+
+    for(int i = 0; i < numberOfPoints; i++)
+    {
+        for(auto& V : problem->allVariables)
+        {
+            double lowerBound = std::max(V->lowerBound, -100.0);
+            double upperBound = std::min(V->upperBound, 100.0);
+            double fraction = std::fmod(0.618033988749895 * (i + 1) * (V->index + 1), 1.0);
+
+            points[i].push_back(lowerBound + fraction * (upperBound - lowerBound));
+        }
+    }
+
+    return (points);
+}
+
+bool TestExpressionTape(const std::string& problemFile)
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+
+    env->modelingSystem = std::make_shared<SHOT::ModelingSystemOSiL>(env);
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    if(std::dynamic_pointer_cast<ModelingSystemOSiL>(env->modelingSystem)->createProblem(problem, problemFile)
+        != E_ProblemCreationStatus::NormalCompletion)
+    {
+        std::cout << "Error while reading problem";
+        return (false);
+    }
+
+    std::cout << "Number of compiled expressions: " << problem->expressionTape->getNumberOfExpressions()
+              << " with " << problem->expressionTape->getNumberOfInstructions() << " instructions\n";
+
+    int numberOfPoints = 1000;
+    auto points = createPointsWithinBounds(problem, numberOfPoints);
+
+    auto isEqual = [](double first, double second) {
+        if(std::isnan(first) || std::isnan(second))
+            return (std::isnan(first) && std::isnan(second));
+
+        if(std::isinf(first) || std::isinf(second))
+            return (first == second);
+
+        return (std::abs(first - second) <= 1e-10 * std::max(1.0, std::abs(first)));
+    };
+
+    for(auto& C : problem->nonlinearConstraints)
+    {
+        if(!C->expressionTape)
+        {
+            std::cout << "Test failed: no compiled expression for constraint " << C->name << '\n';
+            passed = false;
+            continue;
+        }
+
+        for(auto& P : points)
+        {
+            double treeValue = C->nonlinearExpression->calculate(P);
+            double tapeValue = C->expressionTape->calculate(C->expressionTapeIndex, P);
+
+            if(!isEqual(treeValue, tapeValue))
+            {
+                std::cout << "Test failed: value " << tapeValue << " for constraint " << C->name
+                          << " differs from the value " << treeValue << " of the expression tree\n";
+                passed = false;
+                break;
+            }
+        }
+
+        IntervalVector intervalVector;
+
+        for(auto& V : problem->allVariables)
+            intervalVector.push_back(Interval(V->lowerBound, V->upperBound));
+
+        try
+        {
+            Interval treeInterval = C->nonlinearExpression->calculate(intervalVector);
+            Interval tapeInterval = C->expressionTape->calculate(C->expressionTapeIndex, intervalVector);
+
+            if(!isEqual(treeInterval.l(), tapeInterval.l()) || !isEqual(treeInterval.u(), tapeInterval.u()))
+            {
+                std::cout << "Test failed: interval " << tapeInterval << " for constraint " << C->name
+                          << " differs from the interval " << treeInterval << " of the expression tree\n";
+                passed = false;
+            }
+        }
+        catch(const mc::Interval::Exceptions&)
+        {
+            std::cout << "Interval bounds could not be calculated for constraint " << C->name << '\n';
+        }
+    }
+
+    // Compares the time needed to evaluate all nonlinear expressions in all points
+    double sum = 0.0;
+    int repetitions = 20;
+
+    auto treeStart = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < repetitions; i++)
+    {
+        for(auto& P : points)
+        {
+            for(auto& C : problem->nonlinearConstraints)
+                sum += C->nonlinearExpression->calculate(P);
+        }
+    }
+
+    auto tapeStart = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < repetitions; i++)
+    {
+        for(auto& P : points)
+        {
+            for(auto& C : problem->nonlinearConstraints)
+                sum -= C->expressionTape->calculate(C->expressionTapeIndex, P);
+        }
+    }
+
+    auto tapeEnd = std::chrono::steady_clock::now();
+
+    double treeTime = std::chrono::duration<double>(tapeStart - treeStart).count();
+    double tapeTime = std::chrono::duration<double>(tapeEnd - tapeStart).count();
+
+    std::cout << "Time for evaluating expression trees:  " << treeTime << " s\n";
+    std::cout << "Time for evaluating compiled expressions:  " << tapeTime << " s\n";
+
+    if(tapeTime > 0)
+        std::cout << "Speedup:  " << treeTime / tapeTime << " (checksum " << sum << ")\n";
+
+    return passed;
+}
+
+bool TestBatchEvaluation(const std::string& problemFile)
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+
+    env->modelingSystem = std::make_shared<SHOT::ModelingSystemOSiL>(env);
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    if(std::dynamic_pointer_cast<ModelingSystemOSiL>(env->modelingSystem)->createProblem(problem, problemFile)
+        != E_ProblemCreationStatus::NormalCompletion)
+    {
+        std::cout << "Error while reading problem";
+        return (false);
+    }
+
+    int numberOfPoints = 50;
+    auto points = createPointsWithinBounds(problem, numberOfPoints);
+
+    PointBatch batch(problem->properties.numberOfVariables, numberOfPoints);
+    batch.setPoints(points);
+
+    VectorDouble values;
+
+    for(auto& C : problem->numericConstraints)
+    {
+        C->calculateFunctionValues(batch, values);
+
+        for(int k = 0; k < numberOfPoints; k++)
+        {
+            double value = C->calculateFunctionValue(points[k]);
+
+            if(std::abs(values[k] - value) > 1e-10 * std::max(1.0, std::abs(value)))
+            {
+                std::cout << "Test failed: batch value " << values[k] << " for constraint " << C->name
+                          << " differs from the value " << value << '\n';
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    auto maxValues = problem->getMaxNumericConstraintValues(batch, problem->nonlinearConstraints);
+
+    for(int k = 0; k < numberOfPoints; k++)
+    {
+        auto maxValue = problem->getMaxNumericConstraintValue(points[k], problem->nonlinearConstraints);
+
+        if(maxValues[k].constraint != maxValue.constraint || maxValues[k].normalizedValue != maxValue.normalizedValue)
+        {
+            std::cout << "Test failed: maximum constraint value in batch differs for point " << k << '\n';
+            passed = false;
+        }
+    }
+
+    // Compares the root searches with the TOMS748 and multisection methods for each constraint between a point where
+    // it is fulfilled and one where it is not
+    auto rootsearch = std::make_unique<RootsearchMethodBoost>(env);
+    int numberOfRootsearches = 0;
+
+    for(auto& C : problem->nonlinearConstraints)
+    {
+        C->calculateFunctionValues(batch, values);
+
+        int interiorPoint = -1;
+        int exteriorPoint = -1;
+
+        for(int k = 0; k < numberOfPoints; k++)
+        {
+            if(values[k] < C->valueRHS - 1e-3 && values[k] > C->valueLHS + 1e-3)
+                interiorPoint = k;
+            else if(values[k] > C->valueRHS + 1e-3)
+                exteriorPoint = k;
+        }
+
+        if(interiorPoint == -1 || exteriorPoint == -1)
+            continue;
+
+        std::vector<NumericConstraint*> constraints { C.get() };
+
+        solver->updateSetting("Rootsearch.Method", "Subsolver", static_cast<int>(ES_RootsearchMethod::BoostTOMS748));
+        auto root = rootsearch->findZero(
+            points[interiorPoint], points[exteriorPoint], 100, 1e-12, 0.0, constraints, false);
+
+        solver->updateSetting("Rootsearch.Method", "Subsolver", static_cast<int>(ES_RootsearchMethod::MultiSection));
+        auto multiSectionRoot = rootsearch->findZero(
+            points[interiorPoint], points[exteriorPoint], 100, 1e-12, 0.0, constraints, false);
+
+        numberOfRootsearches++;
+
+        for(size_t i = 0; i < root.first.size(); i++)
+        {
+            if(std::abs(root.first[i] - multiSectionRoot.first[i]) > 1e-6 * std::max(1.0, std::abs(root.first[i])))
+            {
+                std::cout << "Test failed: the roots for constraint " << C->name << " differ\n";
+                Utilities::displayVector(root.first, multiSectionRoot.first);
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    std::cout << "Number of root searches compared: " << numberOfRootsearches << '\n';
+
+    return passed;
+}
+
+bool TestConcurrentRootsearches(const std::string& problemFile)
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+
+    env->modelingSystem = std::make_shared<SHOT::ModelingSystemOSiL>(env);
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    if(std::dynamic_pointer_cast<ModelingSystemOSiL>(env->modelingSystem)->createProblem(problem, problemFile)
+        != E_ProblemCreationStatus::NormalCompletion)
+    {
+        std::cout << "Error while reading problem";
+        return (false);
+    }
+
+    int numberOfPoints = 50;
+    auto points = createPointsWithinBounds(problem, numberOfPoints);
+
+    // Root searches for all pairs of points and constraints where the constraint is fulfilled in the first point but
+    // not in the second one
+    std::vector<std::tuple<int, int, NumericConstraint*>> rootsearches;
+
+    for(auto& C : problem->nonlinearConstraints)
+    {
+        for(int k = 0; k < numberOfPoints; k++)
+        {
+            for(int l = 0; l < numberOfPoints; l++)
+            {
+                if(C->calculateNumericValue(points[k]).normalizedValue < -1e-3
+                    && C->calculateNumericValue(points[l]).normalizedValue > 1e-3)
+                    rootsearches.emplace_back(k, l, C.get());
+            }
+        }
+    }
+
+    std::cout << "Number of root searches: " << rootsearches.size() << '\n';
+
+    auto rootsearch = std::make_unique<RootsearchMethodBoost>(env);
+
+    auto performRootsearches = [&](int numberOfThreads) {
+        std::vector<std::pair<VectorDouble, VectorDouble>> roots(rootsearches.size());
+
+        Utilities::parallelFor(rootsearches.size(), numberOfThreads, [&](int i) {
+            auto [k, l, C] = rootsearches[i];
+            roots[i] = rootsearch->findZeroConcurrently(points[k], points[l], 100, 1e-14, { C });
+        });
+
+        return (roots);
+    };
+
+    auto serialStart = std::chrono::steady_clock::now();
+    auto serialRoots = performRootsearches(1);
+    auto parallelStart = std::chrono::steady_clock::now();
+    auto parallelRoots = performRootsearches(4);
+    auto parallelEnd = std::chrono::steady_clock::now();
+
+    std::cout << "Time for serial root searches:  "
+              << std::chrono::duration<double>(parallelStart - serialStart).count() << " s\n";
+    std::cout << "Time for parallel root searches:  "
+              << std::chrono::duration<double>(parallelEnd - parallelStart).count() << " s\n";
+
+    for(size_t i = 0; i < rootsearches.size(); i++)
+    {
+        if(serialRoots[i] != parallelRoots[i])
+        {
+            std::cout << "Test failed: the results of root search " << i << " differ\n";
+            passed = false;
+            break;
+        }
+    }
+
+    return passed;
+}
+
+bool TestHashIndex()
+{
+    bool passed = true;
+
+    Utilities::HashIndex index;
+    VectorDouble hashes;
+
+    // Hashes of random points with both signs and magnitudes spread out over several orders
+    for(int i = 0; i < 10000; i++)
+    {
+        VectorDouble point(10);
+
+        for(int j = 0; j < 10; j++)
+            point[j] = std::fmod(0.618033988749895 * (i + 1) * (j + 1), 1.0) - 0.5;
+
+        double hash = Utilities::calculateHash(point) * std::pow(10.0, i % 7 - 3);
+
+        hashes.push_back(hash);
+        index.add(i % 3, hash);
+    }
+
+    index.add(0, 0.0);
+    hashes.push_back(0.0);
+
+    int numberOfCollisions = 0;
+
+    for(size_t i = 0; i < hashes.size(); i++)
+    {
+        int group = (i < hashes.size() - 1) ? i % 3 : 0;
+        double hash = hashes[i];
+
+        if(!index.contains(group, hash, numberOfCollisions)
+            || !index.contains(group, hash * (1.0 + 0.9e-8), numberOfCollisions)
+            || !index.contains(group, hash * (1.0 - 0.9e-8), numberOfCollisions))
+        {
+            std::cout << "Test failed: hash " << hash << " not found in group " << group << '\n';
+            passed = false;
+            break;
+        }
+
+        if(hash != 0.0 && index.contains(group, hash * (1.0 + 1e-6), numberOfCollisions))
+        {
+            std::cout << "Test failed: hash " << hash * (1.0 + 1e-6) << " found in group " << group << '\n';
+            passed = false;
+            break;
+        }
+    }
+
+    if(index.contains(0, 1e-300, numberOfCollisions) || index.contains(1, 0.0, numberOfCollisions))
+    {
+        std::cout << "Test failed: value not in the index found\n";
+        passed = false;
+    }
+
+    std::cout << "Number of values in index: " << index.size() << ", collisions: " << numberOfCollisions << '\n';
+
+    return passed;
+}
+
 bool CreateAndSolveProblem()
 {
     bool passed = true;
@@ -414,6 +829,966 @@ bool CreateAndSolveProblem()
     return passed;
 }
 
+// Returns the current or the peak resident set size of the process in kB if available, otherwise -1
+long getResidentMemory([[maybe_unused]] bool peak)
+{
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    std::string key = peak ? "VmHWM:" : "VmRSS:";
+
+    while(std::getline(status, line))
+    {
+        if(line.compare(0, key.size(), key) == 0)
+            return (std::stol(line.substr(key.size())));
+    }
+#endif
+
+    return (-1);
+}
+
+// Resets the peak resident set size of the process to the current value if supported
+void resetPeakResidentMemory()
+{
+#ifdef __linux__
+    std::ofstream clearReferences("/proc/self/clear_refs");
+    clearReferences << "5";
+#endif
+}
+
+// Checks that two problems have the same variables and the same function values in a number of points
+bool compareProblems(ProblemPtr firstProblem, ProblemPtr secondProblem)
+{
+    auto isEqual = [](double first, double second) {
+        if(std::isnan(first) || std::isnan(second))
+            return (std::isnan(first) && std::isnan(second));
+
+        return (first == second || std::abs(first - second) <= 1e-10 * std::max(1.0, std::abs(first)));
+    };
+
+    if(firstProblem->allVariables.size() != secondProblem->allVariables.size()
+        || firstProblem->auxiliaryVariables.size() != secondProblem->auxiliaryVariables.size()
+        || firstProblem->numericConstraints.size() != secondProblem->numericConstraints.size()
+        || firstProblem->linearConstraints.size() != secondProblem->linearConstraints.size()
+        || firstProblem->quadraticConstraints.size() != secondProblem->quadraticConstraints.size()
+        || firstProblem->nonlinearConstraints.size() != secondProblem->nonlinearConstraints.size())
+    {
+        std::cout << "The problems " << firstProblem->name << " have different sizes\n";
+        return (false);
+    }
+
+    if(firstProblem->properties.convexity != secondProblem->properties.convexity
+        || firstProblem->properties.isMINLPProblem != secondProblem->properties.isMINLPProblem
+        || firstProblem->objectiveFunction->properties.classification
+            != secondProblem->objectiveFunction->properties.classification)
+    {
+        std::cout << "The problems " << firstProblem->name << " have different properties\n";
+        return (false);
+    }
+
+    bool passed = true;
+
+    for(size_t i = 0; i < firstProblem->allVariables.size(); i++)
+    {
+        auto& firstVariable = firstProblem->allVariables[i];
+        auto& secondVariable = secondProblem->allVariables[i];
+
+        if(firstVariable->name != secondVariable->name
+            || firstVariable->properties.type != secondVariable->properties.type
+            || firstVariable->properties.auxiliaryType != secondVariable->properties.auxiliaryType
+            || firstVariable->lowerBound != secondVariable->lowerBound
+            || firstVariable->upperBound != secondVariable->upperBound)
+        {
+            std::cout << "The problems " << firstProblem->name << " have different variables " << firstVariable->name
+                      << '\n';
+            passed = false;
+        }
+    }
+
+    for(auto& P : createPointsWithinBounds(firstProblem, 10))
+    {
+        if(!isEqual(firstProblem->objectiveFunction->calculateValue(P),
+               secondProblem->objectiveFunction->calculateValue(P)))
+        {
+            std::cout << "The objective function values of the problems " << firstProblem->name << " differ\n";
+            passed = false;
+        }
+
+        for(size_t i = 0; i < firstProblem->numericConstraints.size(); i++)
+        {
+            if(!isEqual(firstProblem->numericConstraints[i]->calculateFunctionValue(P),
+                   secondProblem->numericConstraints[i]->calculateFunctionValue(P)))
+            {
+                std::cout << "The values of constraint " << firstProblem->numericConstraints[i]->name
+                          << " of the problems " << firstProblem->name << " differ\n";
+                passed = false;
+            }
+        }
+
+        for(size_t i = 0; i < firstProblem->auxiliaryVariables.size(); i++)
+        {
+            if(!isEqual(firstProblem->auxiliaryVariables[i]->calculate(P),
+                   secondProblem->auxiliaryVariables[i]->calculate(P)))
+            {
+                std::cout << "The values of auxiliary variable " << firstProblem->auxiliaryVariables[i]->name
+                          << " of the problems " << firstProblem->name << " differ\n";
+                passed = false;
+            }
+        }
+    }
+
+    return (passed);
+}
+
+// Reads all OSiL files in the data directory with both the document and the streaming reader, checks that the problems
+// are equal, and compares the time and the peak memory used
+bool TestOSiLReaders()
+{
+    bool passed = true;
+
+    std::vector<std::string> problemFiles;
+
+    for(auto& F : fs::filesystem::directory_iterator("data"))
+    {
+        if(F.path().extension() == ".osil")
+            problemFiles.push_back(F.path().string());
+    }
+
+    std::sort(problemFiles.begin(), problemFiles.end());
+
+    std::cout << fmt::format("{:<25}{:>16}{:>16}{:>16}{:>16}\n", "Problem", "document [s]", "streaming [s]",
+        "document [kB]", "streaming [kB]");
+
+    for(auto& F : problemFiles)
+    {
+        // The solvers own the environments of the problems and are kept until the problems have been compared
+        std::vector<std::unique_ptr<Solver>> solvers;
+        std::vector<ProblemPtr> problems;
+        std::vector<double> times;
+        std::vector<long> memoryUsages;
+
+        for(bool useStreamingReader : { false, true })
+        {
+            solvers.push_back(std::make_unique<Solver>());
+            auto env = solvers.back()->getEnvironment();
+
+            solvers.back()->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+            solvers.back()->updateSetting("Input.OSiL.UseStreamingReader", "Model", useStreamingReader);
+
+            auto modelingSystem = std::make_shared<SHOT::ModelingSystemOSiL>(env);
+            env->modelingSystem = modelingSystem;
+            ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+
+            resetPeakResidentMemory();
+            long memoryBefore = getResidentMemory(false);
+            auto startTime = std::chrono::steady_clock::now();
+
+            if(modelingSystem->createProblem(problem, F) != E_ProblemCreationStatus::NormalCompletion)
+            {
+                std::cout << "Error while reading problem " << F << '\n';
+                return (false);
+            }
+
+            times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+            memoryUsages.push_back((memoryBefore >= 0) ? getResidentMemory(true) - memoryBefore : -1);
+
+            // The document reader is used as a fallback if the streaming reader fails
+            if(modelingSystem->isReadWithStreamingReader() != useStreamingReader)
+            {
+                std::cout << "Test failed: problem " << F << " was read with the "
+                          << (modelingSystem->isReadWithStreamingReader() ? "streaming" : "document") << " reader\n";
+                passed = false;
+            }
+            problems.push_back(problem);
+        }
+
+        std::cout << fmt::format("{:<25}{:>16.4f}{:>16.4f}{:>16}{:>16}\n",
+            fs::filesystem::path(F).filename().string(), times[0], times[1], memoryUsages[0], memoryUsages[1]);
+
+        if(!compareProblems(problems[0], problems[1]))
+        {
+            std::cout << "Test failed: the readers created different problems for " << F << '\n';
+            passed = false;
+        }
+    }
+
+    return passed;
+}
+
+// Writes snapshots of all OSiL files in the data directory, and checks that the problems read from the snapshots are
+// the same as when read from the files, also when the reformulation settings are changed
+bool TestProblemSnapshots()
+{
+    bool passed = true;
+
+    std::vector<std::string> problemFiles;
+
+    for(auto& F : fs::filesystem::directory_iterator("data"))
+    {
+        if(F.path().extension() == ".osil")
+            problemFiles.push_back(F.path().string());
+    }
+
+    std::sort(problemFiles.begin(), problemFiles.end());
+
+    std::string snapshotFile = (fs::filesystem::temp_directory_path() / "SHOT_test.snapshot").string();
+
+    std::cout << fmt::format("{:<25}{:>16}{:>16}{:>16}\n", "Problem", "file [s]", "snapshot [s]", "snapshot [kB]");
+
+    for(auto& F : problemFiles)
+    {
+        for(bool changeSettings : { false, true })
+        {
+            std::vector<std::unique_ptr<Solver>> solvers;
+            std::vector<double> times;
+
+            for(bool useSnapshot : { false, true })
+            {
+                solvers.push_back(std::make_unique<Solver>());
+                solvers.back()->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+
+                // The snapshot is always written with the default settings
+                if(changeSettings)
+                    solvers.back()->updateSetting("Reformulation.ObjectiveFunction.Epigraph.Use", "Model", true);
+
+                auto startTime = std::chrono::steady_clock::now();
+
+                if(!(useSnapshot ? solvers.back()->setProblemFromSnapshot(snapshotFile)
+                                 : solvers.back()->setProblem(F)))
+                {
+                    std::cout << "Error while reading problem " << F << '\n';
+                    return (false);
+                }
+
+                times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+                if(!useSnapshot && !changeSettings && !solvers.back()->saveProblemSnapshot(snapshotFile))
+                {
+                    std::cout << "Error while writing snapshot of problem " << F << '\n';
+                    return (false);
+                }
+            }
+
+            if(!changeSettings)
+            {
+                std::cout << fmt::format("{:<25}{:>16.4f}{:>16.4f}{:>16}\n",
+                    fs::filesystem::path(F).filename().string(), times[0], times[1],
+                    fs::filesystem::file_size(snapshotFile) / 1024);
+            }
+
+            auto fileEnvironment = solvers[0]->getEnvironment();
+            auto snapshotEnvironment = solvers[1]->getEnvironment();
+
+            if(!compareProblems(fileEnvironment->problem, snapshotEnvironment->problem)
+                || !compareProblems(fileEnvironment->reformulatedProblem, snapshotEnvironment->reformulatedProblem))
+            {
+                std::cout << "Test failed: the problems read from the file and the snapshot differ for " << F
+                          << (changeSettings ? " with changed settings" : "") << '\n';
+                passed = false;
+            }
+        }
+    }
+
+    fs::filesystem::remove(snapshotFile);
+
+    return passed;
+}
+
+// A problem with many small nonlinear constraints, where each pair of constraints shares a variable
+ProblemPtr createProblemWithSmallNonlinearConstraints(EnvironmentPtr env, int numberOfPairs)
+{
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    problem->name = "smallconstraints";
+
+    std::vector<NonlinearExpressionPtr> expressionVariables;
+
+    for(int i = 0; i < 3 * numberOfPairs; i++)
+    {
+        auto variable
+            = std::make_shared<Variable>("x" + std::to_string(i), i, E_VariableType::Real, 0.1 * (i % 7), 5.0);
+        problem->add(variable);
+        expressionVariables.push_back(std::make_shared<ExpressionVariable>(variable));
+    }
+
+    auto objective = std::make_shared<LinearObjectiveFunction>(E_ObjectiveFunctionDirection::Minimize);
+    objective->add(std::make_shared<LinearTerm>(1.0, problem->allVariables[0]));
+    problem->add(objective);
+
+    for(int i = 0; i < numberOfPairs; i++)
+    {
+        auto x1 = expressionVariables[3 * i];
+        auto x2 = expressionVariables[3 * i + 1];
+        auto x3 = expressionVariables[3 * i + 2];
+
+        // exp(x1) * x2 <= 10
+        auto first = std::make_shared<NonlinearConstraint>(2 * i, "e" + std::to_string(2 * i), SHOT_DBL_MIN, 10.0);
+        first->add(std::make_shared<ExpressionProduct>(std::make_shared<ExpressionExp>(x1), x2));
+        problem->add(first);
+
+        // log(1 + x2 * x3) + sqr(x3) <= 10
+        auto second
+            = std::make_shared<NonlinearConstraint>(2 * i + 1, "e" + std::to_string(2 * i + 1), SHOT_DBL_MIN, 10.0);
+        second->add(std::make_shared<ExpressionSum>(
+            std::make_shared<ExpressionLog>(std::make_shared<ExpressionSum>(
+                std::make_shared<ExpressionConstant>(1.0), std::make_shared<ExpressionProduct>(x2, x3))),
+            std::make_shared<ExpressionSquare>(x3)));
+        problem->add(second);
+    }
+
+    problem->updateProperties();
+    problem->finalize();
+
+    return (problem);
+}
+
+bool TestGradientTapes()
+{
+    bool passed = true;
+
+    int numberOfPairs = 500;
+    int numberOfPoints = 10;
+
+    // The gradients calculated with the unoptimized tape of the whole problem, used as reference
+    std::vector<std::vector<SparseVariableVector>> referenceGradients;
+
+    std::vector<std::tuple<ES_GradientTapePartitioning, bool, std::string>> alternatives
+        = { { ES_GradientTapePartitioning::None, false, "one tape" },
+              { ES_GradientTapePartitioning::None, true, "one optimized tape" },
+              { ES_GradientTapePartitioning::Constraint, true, "optimized tapes per constraint" },
+              { ES_GradientTapePartitioning::ConnectedConstraints, false, "tapes per connected constraints" },
+              { ES_GradientTapePartitioning::ConnectedConstraints, true,
+                  "optimized tapes per connected constraints" } };
+
+    for(auto& [partitioning, optimize, description] : alternatives)
+    {
+        auto solver = std::make_unique<SHOT::Solver>();
+        auto env = solver->getEnvironment();
+
+        solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+        solver->updateSetting("AutomaticDifferentiation.GradientTapes", "Model", static_cast<int>(partitioning));
+        solver->updateSetting("AutomaticDifferentiation.Optimize", "Model", optimize);
+
+        auto problem = createProblemWithSmallNonlinearConstraints(env, numberOfPairs);
+
+        size_t expectedNumberOfTapes = 0;
+
+        if(partitioning == ES_GradientTapePartitioning::Constraint)
+            expectedNumberOfTapes = 2 * numberOfPairs;
+        else if(partitioning == ES_GradientTapePartitioning::ConnectedConstraints)
+            expectedNumberOfTapes = numberOfPairs;
+
+        if(problem->gradientTapes.size() != expectedNumberOfTapes)
+        {
+            std::cout << "Test failed: " << problem->gradientTapes.size() << " tapes created with " << description
+                      << " instead of " << expectedNumberOfTapes << '\n';
+            passed = false;
+        }
+
+        auto points = createPointsWithinBounds(problem, numberOfPoints);
+        std::vector<std::vector<SparseVariableVector>> gradients(
+            numberOfPoints, std::vector<SparseVariableVector>(problem->nonlinearConstraints.size()));
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < numberOfPoints; i++)
+        {
+            for(size_t j = 0; j < problem->nonlinearConstraints.size(); j++)
+                problem->nonlinearConstraints[j]->calculateGradient(points[i], true, gradients[i][j]);
+        }
+
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "Gradients per second with " << description << ":  "
+                  << numberOfPoints * problem->nonlinearConstraints.size() / time << '\n';
+
+        if(referenceGradients.size() == 0)
+        {
+            referenceGradients = gradients;
+            continue;
+        }
+
+        for(int i = 0; i < numberOfPoints; i++)
+        {
+            for(size_t j = 0; j < problem->nonlinearConstraints.size(); j++)
+            {
+                auto& gradient = gradients[i][j];
+                auto& referenceGradient = referenceGradients[i][j];
+
+                bool isEqual = (gradient.size() == referenceGradient.size());
+
+                for(size_t k = 0; isEqual && k < gradient.size(); k++)
+                {
+                    isEqual = (gradient[k].first == referenceGradient[k].first)
+                        && std::abs(gradient[k].second - referenceGradient[k].second)
+                            <= 1e-10 * std::max(1.0, std::abs(referenceGradient[k].second));
+                }
+
+                if(!isEqual)
+                {
+                    std::cout << "Test failed: the gradient of constraint " << problem->nonlinearConstraints[j]->name
+                              << " with " << description << " differs from the one with one tape\n";
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    return passed;
+}
+
+// Creates more iterations than are kept in the iteration history and checks that the older ones are summarized
+bool TestIterationHistory()
+{
+    auto solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    int historySize = 5;
+    int numberOfIterations = 20;
+
+    solver->updateSetting("IterationHistory.Size", "Output", historySize);
+
+    for(int i = 1; i <= numberOfIterations; i++)
+    {
+        env->results->createIteration();
+
+        auto iteration = env->results->getCurrentIteration();
+        iteration->objectiveValue = i;
+        iteration->numHyperplanesAdded = 2 * i;
+    }
+
+    if(env->results->getNumberOfIterations() != numberOfIterations
+        || (int)env->results->iterations.size() != historySize)
+    {
+        std::cout << "Wrong number of iterations: " << env->results->getNumberOfIterations() << " created and "
+                  << env->results->iterations.size() << " in the history\n";
+        return (false);
+    }
+
+    if(env->results->getCurrentIteration()->iterationNumber != numberOfIterations
+        || env->results->getPreviousIteration()->iterationNumber != numberOfIterations - 1)
+    {
+        std::cout << "The current or previous iteration is wrong\n";
+        return (false);
+    }
+
+    if(env->results->getIteration(numberOfIterations - historySize)
+        || !env->results->getIteration(numberOfIterations - historySize + 1))
+    {
+        std::cout << "Wrong iterations kept in the history\n";
+        return (false);
+    }
+
+    auto summaries = env->results->getIterationSummaries();
+
+    if((int)summaries.size() != numberOfIterations)
+    {
+        std::cout << "Summaries found for " << summaries.size() << " iterations\n";
+        return (false);
+    }
+
+    for(int i = 1; i <= numberOfIterations; i++)
+    {
+        auto& summary = summaries[i - 1];
+
+        if(summary.iterationNumber != i || summary.objectiveValue != i || summary.numHyperplanesAdded != 2 * i
+            || env->results->getIterationSummary(i).objectiveValue != i)
+        {
+            std::cout << "Wrong summary for iteration " << i << '\n';
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+// Adds hyperplanes to the waiting list and checks that the sparse points stored for them give the same constraint
+// values and gradients as the dense points they were generated in
+bool TestSparseHyperplanePoints()
+{
+    bool passed = true;
+
+    int numberOfPairs = 50;
+    int numberOfPoints = 5;
+
+    for(auto partitioning : { ES_GradientTapePartitioning::None, ES_GradientTapePartitioning::ConnectedConstraints })
+    {
+        auto solver = std::make_unique<SHOT::Solver>();
+        auto env = solver->getEnvironment();
+
+        solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+        solver->updateSetting("AutomaticDifferentiation.GradientTapes", "Model", static_cast<int>(partitioning));
+
+        auto problem = createProblemWithSmallNonlinearConstraints(env, numberOfPairs);
+        env->reformulatedProblem = problem;
+
+        auto points = createPointsWithinBounds(problem, numberOfPoints);
+
+        // Only the values needed for the constraint are set, the others are left from another point
+        VectorDouble densePoint = points[numberOfPoints - 1];
+
+        SparseVariableVector gradient;
+        SparseVariableVector sparseGradient;
+
+        for(int i = 0; i < numberOfPoints - 1; i++)
+        {
+            for(auto& C : problem->nonlinearConstraints)
+            {
+                Hyperplane hyperplane;
+                hyperplane.sourceConstraint = C;
+                hyperplane.sourceConstraintIndex = C->index;
+                hyperplane.source = E_HyperplaneSource::MIPOptimalSolutionPoint;
+                hyperplane.generatedPoint = points[i];
+
+                env->dualSolver->addHyperplane(hyperplane);
+
+                auto& addedHyperplane = env->dualSolver->hyperplaneWaitingList.back();
+
+                if(hyperplane.generatedPoint != points[i] || addedHyperplane.generatedPoint.size() > 0
+                    || addedHyperplane.generatedPointHandle < 0)
+                {
+                    std::cout << "Test failed: the point for constraint " << C->name << " is not stored sparsely\n";
+                    passed = false;
+                    continue;
+                }
+
+                auto& point = env->dualSolver->getHyperplanePoint(addedHyperplane, densePoint);
+
+                double value = C->calculateFunctionValue(points[i]);
+                double sparseValue = C->calculateFunctionValue(point);
+
+                C->calculateGradient(points[i], true, gradient);
+                C->calculateGradient(point, true, sparseGradient);
+
+                bool isEqual = std::abs(value - sparseValue) <= 1e-10 * std::max(1.0, std::abs(value))
+                    && gradient.size() == sparseGradient.size();
+
+                for(size_t k = 0; isEqual && k < gradient.size(); k++)
+                {
+                    isEqual = (gradient[k].first == sparseGradient[k].first)
+                        && std::abs(gradient[k].second - sparseGradient[k].second)
+                            <= 1e-10 * std::max(1.0, std::abs(gradient[k].second));
+                }
+
+                if(!isEqual)
+                {
+                    std::cout << "Test failed: different value or gradient for constraint " << C->name
+                              << " in the sparse point\n";
+                    passed = false;
+                }
+            }
+        }
+
+        int numberOfHyperplanes = env->dualSolver->hyperplaneWaitingList.size();
+        int numberOfValues = env->dualSolver->hyperplanePoints.values.size();
+
+        std::cout << numberOfValues << " values stored for " << numberOfHyperplanes << " hyperplanes in a problem with "
+                  << problem->properties.numberOfVariables << " variables\n";
+
+        // The tapes of the connected constraints have three variables each
+        if(partitioning == ES_GradientTapePartitioning::ConnectedConstraints
+            && numberOfValues > 3 * numberOfHyperplanes)
+        {
+            std::cout << "Test failed: too many values stored\n";
+            passed = false;
+        }
+
+        env->dualSolver->clearHyperplaneWaitingList();
+
+        if(env->dualSolver->hyperplanePoints.getNumberOfPoints() != 0)
+        {
+            std::cout << "Test failed: the points are not removed with the waiting list\n";
+            passed = false;
+        }
+    }
+
+    return passed;
+}
+
+// A problem with abs, division and power terms, where each constraint uses the same quotient twice so that there is
+// something to remove when optimizing the tapes
+ProblemPtr createProblemWithNonsmoothConstraints(EnvironmentPtr env, int numberOfGroups)
+{
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    problem->name = "nonsmoothconstraints";
+
+    std::vector<NonlinearExpressionPtr> expressionVariables;
+
+    for(int i = 0; i < 3 * numberOfGroups; i++)
+    {
+        // The first variable in each group may be negative, the others are in the domain of the divisions and powers
+        double lowerBound = (i % 3 == 0) ? -2.0 : 0.5;
+
+        auto variable
+            = std::make_shared<Variable>("x" + std::to_string(i), i, E_VariableType::Real, lowerBound, 3.0 + i % 5);
+        problem->add(variable);
+        expressionVariables.push_back(std::make_shared<ExpressionVariable>(variable));
+    }
+
+    auto objective = std::make_shared<LinearObjectiveFunction>(E_ObjectiveFunctionDirection::Minimize);
+    objective->add(std::make_shared<LinearTerm>(1.0, problem->allVariables[0]));
+    problem->add(objective);
+
+    for(int i = 0; i < numberOfGroups; i++)
+    {
+        auto x1 = expressionVariables[3 * i];
+        auto x2 = expressionVariables[3 * i + 1];
+        auto x3 = expressionVariables[3 * i + 2];
+
+        // abs(x1 - x2) + x1 / x3 + abs(x1 / x3) <= 10
+        auto first = std::make_shared<NonlinearConstraint>(2 * i, "e" + std::to_string(2 * i), SHOT_DBL_MIN, 10.0);
+        first->add(std::make_shared<ExpressionSum>(
+            std::make_shared<ExpressionAbs>(
+                std::make_shared<ExpressionSum>(x1, std::make_shared<ExpressionNegate>(x2))),
+            std::make_shared<ExpressionDivide>(x1, x3),
+            std::make_shared<ExpressionAbs>(std::make_shared<ExpressionDivide>(x1, x3))));
+        problem->add(first);
+
+        // x3^2.5 + x2^x3 + (x2 / x3)^2.5 <= 100
+        auto second
+            = std::make_shared<NonlinearConstraint>(2 * i + 1, "e" + std::to_string(2 * i + 1), SHOT_DBL_MIN, 100.0);
+        second->add(std::make_shared<ExpressionSum>(
+            std::make_shared<ExpressionPower>(x3, std::make_shared<ExpressionConstant>(2.5)),
+            std::make_shared<ExpressionPower>(x2, x3),
+            std::make_shared<ExpressionPower>(
+                std::make_shared<ExpressionDivide>(x2, x3), std::make_shared<ExpressionConstant>(2.5))));
+        problem->add(second);
+    }
+
+    problem->updateProperties();
+    problem->finalize();
+
+    return (problem);
+}
+
+// Compares the gradients and Hessians calculated with optimized tapes to the ones calculated with the unoptimized tape
+// of the whole problem in the bounds, the midpoint and some other points between the bounds
+bool TestOptimizedTapes()
+{
+    bool passed = true;
+
+    int numberOfGroups = 20;
+
+    std::vector<VectorDouble> referencePoints;
+    std::vector<std::vector<SparseVariableVector>> referenceGradients;
+    std::vector<std::vector<SparseVariableMatrix>> referenceHessians;
+    std::vector<size_t> unoptimizedTapeSizes;
+
+    auto isEqual = [](double first, double second) {
+        return (std::abs(first - second) <= 1e-10 * std::max(1.0, std::abs(second)));
+    };
+
+    std::vector<std::tuple<ES_GradientTapePartitioning, bool, std::string>> alternatives
+        = { { ES_GradientTapePartitioning::None, false, "one tape" },
+              { ES_GradientTapePartitioning::None, true, "one tape with optimization" },
+              { ES_GradientTapePartitioning::Constraint, false, "tapes per constraint" },
+              { ES_GradientTapePartitioning::Constraint, true, "optimized tapes per constraint" },
+              { ES_GradientTapePartitioning::ConnectedConstraints, true,
+                  "optimized tapes per connected constraints" } };
+
+    for(auto& [partitioning, optimize, description] : alternatives)
+    {
+        auto solver = std::make_unique<SHOT::Solver>();
+        auto env = solver->getEnvironment();
+
+        solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+        solver->updateSetting("AutomaticDifferentiation.GradientTapes", "Model", static_cast<int>(partitioning));
+        solver->updateSetting("AutomaticDifferentiation.Optimize", "Model", optimize);
+
+        auto problem = createProblemWithNonsmoothConstraints(env, numberOfGroups);
+
+        if(referencePoints.size() == 0)
+        {
+            VectorDouble lowerBounds, upperBounds, midpoint;
+
+            for(auto& V : problem->allVariables)
+            {
+                lowerBounds.push_back(V->lowerBound);
+                upperBounds.push_back(V->upperBound);
+                midpoint.push_back(0.5 * (V->lowerBound + V->upperBound));
+            }
+
+            referencePoints = createPointsWithinBounds(problem, 5);
+            referencePoints.push_back(lowerBounds);
+            referencePoints.push_back(upperBounds);
+            referencePoints.push_back(midpoint);
+        }
+
+        // The optimized tapes should be smaller, otherwise they have not been used
+        if(partitioning == ES_GradientTapePartitioning::Constraint)
+        {
+            std::vector<size_t> tapeSizes;
+
+            for(auto& T : problem->gradientTapes)
+                tapeSizes.push_back(T->function.size_var());
+
+            if(!optimize)
+            {
+                unoptimizedTapeSizes = tapeSizes;
+            }
+            else if(tapeSizes.size() != unoptimizedTapeSizes.size())
+            {
+                std::cout << "Test failed: different number of tapes with " << description << '\n';
+                passed = false;
+            }
+            else
+            {
+                for(size_t i = 0; i < tapeSizes.size(); i++)
+                {
+                    if(tapeSizes[i] >= unoptimizedTapeSizes[i])
+                    {
+                        std::cout << "Test failed: tape " << i << " is not optimized\n";
+                        passed = false;
+                    }
+                }
+            }
+        }
+
+        std::vector<std::vector<SparseVariableVector>> gradients(
+            referencePoints.size(), std::vector<SparseVariableVector>(problem->nonlinearConstraints.size()));
+        std::vector<std::vector<SparseVariableMatrix>> hessians(
+            referencePoints.size(), std::vector<SparseVariableMatrix>(problem->nonlinearConstraints.size()));
+
+        for(size_t i = 0; i < referencePoints.size(); i++)
+        {
+            for(size_t j = 0; j < problem->nonlinearConstraints.size(); j++)
+            {
+                problem->nonlinearConstraints[j]->calculateGradient(referencePoints[i], false, gradients[i][j]);
+                problem->nonlinearConstraints[j]->calculateHessian(referencePoints[i], false, hessians[i][j]);
+            }
+        }
+
+        if(referenceGradients.size() == 0)
+        {
+            referenceGradients = gradients;
+            referenceHessians = hessians;
+            continue;
+        }
+
+        for(size_t i = 0; i < referencePoints.size(); i++)
+        {
+            for(size_t j = 0; j < problem->nonlinearConstraints.size(); j++)
+            {
+                auto& gradient = gradients[i][j];
+                auto& referenceGradient = referenceGradients[i][j];
+
+                bool isGradientEqual = (gradient.size() == referenceGradient.size());
+
+                for(size_t k = 0; isGradientEqual && k < gradient.size(); k++)
+                {
+                    isGradientEqual = (gradient[k].first == referenceGradient[k].first)
+                        && isEqual(gradient[k].second, referenceGradient[k].second);
+                }
+
+                auto& hessian = hessians[i][j];
+                auto& referenceHessian = referenceHessians[i][j];
+
+                bool isHessianEqual = (hessian.size() == referenceHessian.size());
+
+                for(size_t k = 0; isHessianEqual && k < hessian.size(); k++)
+                {
+                    isHessianEqual = (hessian[k].first == referenceHessian[k].first)
+                        && isEqual(hessian[k].second, referenceHessian[k].second);
+                }
+
+                if(!isGradientEqual || !isHessianEqual)
+                {
+                    std::cout << "Test failed: the " << (isGradientEqual ? "Hessian" : "gradient") << " of constraint "
+                              << problem->nonlinearConstraints[j]->name << " in point " << i << " with "
+                              << description << " differs from the one with one tape\n";
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    return passed;
+}
+
+// Selects hyperplane points for solution points outside a disc with several interior points, and checks that for each
+// solution point the root search is only done towards the closest interior point when there are several starting points
+bool TestClosestInteriorPoints()
+{
+    bool passed = true;
+
+    std::vector<VectorDouble> interiorPoints = { { 0.0, 0.5 }, { 0.0, -0.5 }, { 0.5, 0.0 } };
+
+    // The solution points and the indexes of the interior points closest to them
+    std::vector<VectorDouble> solutionPoints = { { 0.1, 2.0 }, { -0.1, -2.0 }, { 2.0, 0.3 } };
+    std::vector<int> closestInteriorPoints = { 0, 1, 2 };
+
+    // The distance from the point to the line through the interior and solution points
+    auto getDistanceToLine = [](const VectorDouble& point, const VectorDouble& interiorPoint,
+                                 const VectorDouble& solutionPoint) {
+        double dx = solutionPoint[0] - interiorPoint[0];
+        double dy = solutionPoint[1] - interiorPoint[1];
+
+        return (std::abs(dx * (point[1] - interiorPoint[1]) - dy * (point[0] - interiorPoint[0]))
+            / std::sqrt(dx * dx + dy * dy));
+    };
+
+    for(int numberOfStartingPoints : { 1, 3 })
+    {
+        auto solver = std::make_unique<SHOT::Solver>();
+        auto env = solver->getEnvironment();
+
+        solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+        solver->updateSetting("ESH.InteriorPoint.MultiStart.Points", "Dual", numberOfStartingPoints);
+
+        auto problem = std::make_shared<SHOT::Problem>(env);
+        problem->name = "disc";
+
+        auto x = std::make_shared<Variable>("x", 0, E_VariableType::Real, -5.0, 5.0);
+        auto y = std::make_shared<Variable>("y", 1, E_VariableType::Real, -5.0, 5.0);
+        problem->add(x);
+        problem->add(y);
+
+        auto objective = std::make_shared<LinearObjectiveFunction>(E_ObjectiveFunctionDirection::Minimize);
+        objective->add(std::make_shared<LinearTerm>(1.0, x));
+        problem->add(objective);
+
+        // x^2 + y^2 <= 1
+        auto constraint = std::make_shared<NonlinearConstraint>(0, "disc", SHOT_DBL_MIN, 1.0);
+        constraint->add(
+            std::make_shared<ExpressionSum>(std::make_shared<ExpressionSquare>(std::make_shared<ExpressionVariable>(x)),
+                std::make_shared<ExpressionSquare>(std::make_shared<ExpressionVariable>(y))));
+        problem->add(constraint);
+
+        problem->updateProperties();
+        problem->finalize();
+
+        env->problem = problem;
+        env->reformulatedProblem = problem;
+        env->rootsearchMethod = std::make_shared<RootsearchMethodBoost>(env);
+        env->results->createIteration();
+
+        for(auto& P : interiorPoints)
+        {
+            auto interiorPoint = std::make_shared<InteriorPoint>();
+            interiorPoint->point = P;
+            env->dualSolver->interiorPts.push_back(interiorPoint);
+        }
+
+        std::vector<SolutionPoint> points(solutionPoints.size());
+
+        for(size_t i = 0; i < solutionPoints.size(); i++)
+            points[i].point = solutionPoints[i];
+
+        TaskSelectHyperplanePointsESH task(env);
+        task.run(points);
+
+        auto& hyperplanes = env->dualSolver->hyperplaneWaitingList;
+
+        std::cout << hyperplanes.size() << " hyperplanes selected for " << solutionPoints.size()
+                  << " solution points with " << interiorPoints.size() << " interior points from "
+                  << numberOfStartingPoints << " starting points\n";
+
+        if(numberOfStartingPoints == 1)
+        {
+            if(hyperplanes.size() != solutionPoints.size() * interiorPoints.size())
+            {
+                std::cout << "Test failed: all interior points should be used with one starting point\n";
+                passed = false;
+            }
+
+            continue;
+        }
+
+        if(hyperplanes.size() != solutionPoints.size())
+        {
+            std::cout << "Test failed: one hyperplane per solution point expected\n";
+            passed = false;
+            continue;
+        }
+
+        // Each hyperplane should be generated on the segment from a solution point to its closest interior point
+        std::vector<int> numberOfHyperplanes(solutionPoints.size(), 0);
+        VectorDouble densePoint(2);
+
+        for(auto& H : hyperplanes)
+        {
+            auto& point = env->dualSolver->getHyperplanePoint(H, densePoint);
+
+            for(size_t i = 0; i < solutionPoints.size(); i++)
+            {
+                if(getDistanceToLine(point, interiorPoints[closestInteriorPoints[i]], solutionPoints[i]) < 1e-6)
+                    numberOfHyperplanes[i]++;
+            }
+        }
+
+        for(size_t i = 0; i < solutionPoints.size(); i++)
+        {
+            if(numberOfHyperplanes[i] != 1)
+            {
+                std::cout << "Test failed: " << numberOfHyperplanes[i] << " hyperplanes generated towards the "
+                          << "closest interior point of solution point " << i << '\n';
+                passed = false;
+            }
+        }
+    }
+
+    return passed;
+}
+
+// Queues jobs of two owners to one busy background worker, and checks that only the oldest jobs of an owner exceeding
+// its queue limit are discarded, and that the remaining jobs have been run when waiting for the owners returns
+bool TestBackgroundWorkers()
+{
+    bool passed = true;
+
+    int firstOwner = 0;
+    int secondOwner = 0;
+
+    std::mutex mutex;
+    std::condition_variable isReleased;
+    bool isBlocked = true;
+
+    std::vector<int> finishedJobs;
+
+    auto createJob = [&](int job) {
+        return [&, job](int) {
+            std::unique_lock<std::mutex> lock(mutex);
+            isReleased.wait(lock, [&]() { return (!isBlocked); });
+            finishedJobs.push_back(job);
+        };
+    };
+
+    Utilities::BackgroundWorkers workers(1);
+
+    // The first job keeps the worker busy, possibly after the next ones are queued
+    workers.queueJob(&secondOwner, createJob(0), 1);
+
+    int numberOfDiscardedJobs = 0;
+
+    for(int job = 1; job <= 4; job++)
+        numberOfDiscardedJobs += workers.queueJob(&firstOwner, createJob(job), 2);
+
+    numberOfDiscardedJobs += workers.queueJob(&secondOwner, createJob(5), 1);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isBlocked = false;
+    }
+
+    isReleased.notify_all();
+
+    workers.waitForJobs(&firstOwner);
+    workers.waitForJobs(&secondOwner);
+
+    std::sort(finishedJobs.begin(), finishedJobs.end());
+
+    // Job 0 may have been discarded by job 5 if the worker had not started it
+    if(finishedJobs.size() < 3 || finishedJobs.size() + numberOfDiscardedJobs != 6
+        || finishedJobs[finishedJobs.size() - 3] != 3 || finishedJobs[finishedJobs.size() - 2] != 4
+        || finishedJobs.back() != 5)
+    {
+        std::cout << "Test failed: " << finishedJobs.size() << " jobs were run and " << numberOfDiscardedJobs
+                  << " jobs were discarded\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
 int SolverTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -458,6 +1833,71 @@ int SolverTest(int argc, char* argv[])
         passed = CreateAndSolveProblem();
         std::cout << "Finished test solving model using SHOT API." << std::endl;
         break;
+    case 6:
+        std::cout << "Starting test to evaluate compiled expressions in OSiL file:" << std::endl;
+        passed = TestExpressionTape("data/synthes1.osil");
+        std::cout << "Finished test to evaluate compiled expressions in OSiL file." << std::endl;
+        break;
+    case 7:
+        std::cout << "Starting test to evaluate compiled expressions in OSiL file:" << std::endl;
+        passed = TestExpressionTape("data/clay0305h.osil");
+        std::cout << "Finished test to evaluate compiled expressions in OSiL file." << std::endl;
+        break;
+    case 8:
+        std::cout << "Starting test to evaluate constraints in several points at once:" << std::endl;
+        passed = TestBatchEvaluation("data/clay0305h.osil");
+        std::cout << "Finished test to evaluate constraints in several points at once." << std::endl;
+        break;
+    case 9:
+        std::cout << "Starting test to perform root searches in parallel:" << std::endl;
+        passed = TestConcurrentRootsearches("data/clay0305h.osil");
+        std::cout << "Finished test to perform root searches in parallel." << std::endl;
+        break;
+    case 10:
+        std::cout << "Starting test to find duplicate hashes:" << std::endl;
+        passed = TestHashIndex();
+        std::cout << "Finished test to find duplicate hashes." << std::endl;
+        break;
+    case 11:
+        std::cout << "Starting test to compare the OSiL readers:" << std::endl;
+        passed = TestOSiLReaders();
+        std::cout << "Finished test to compare the OSiL readers." << std::endl;
+        break;
+    case 12:
+        std::cout << "Starting test to read problems from snapshots:" << std::endl;
+        passed = TestProblemSnapshots();
+        std::cout << "Finished test to read problems from snapshots." << std::endl;
+        break;
+    case 13:
+        std::cout << "Starting test to calculate gradients with partitioned tapes:" << std::endl;
+        passed = TestGradientTapes();
+        std::cout << "Finished test to calculate gradients with partitioned tapes." << std::endl;
+        break;
+    case 14:
+        std::cout << "Starting test to keep a bounded iteration history:" << std::endl;
+        passed = TestIterationHistory();
+        std::cout << "Finished test to keep a bounded iteration history." << std::endl;
+        break;
+    case 15:
+        std::cout << "Starting test to store sparse hyperplane points:" << std::endl;
+        passed = TestSparseHyperplanePoints();
+        std::cout << "Finished test to store sparse hyperplane points." << std::endl;
+        break;
+    case 16:
+        std::cout << "Starting test to compare optimized tapes:" << std::endl;
+        passed = TestOptimizedTapes();
+        std::cout << "Finished test to compare optimized tapes." << std::endl;
+        break;
+    case 17:
+        std::cout << "Starting test to use the closest interior points in the ESH method:" << std::endl;
+        passed = TestClosestInteriorPoints();
+        std::cout << "Finished test to use the closest interior points in the ESH method." << std::endl;
+        break;
+    case 18:
+        std::cout << "Starting test to run jobs in background workers:" << std::endl;
+        passed = TestBackgroundWorkers();
+        std::cout << "Finished test to run jobs in background workers." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
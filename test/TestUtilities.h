@@ -0,0 +1,124 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../src/Environment.h"
+#include "../src/Results.h"
+#include "../src/Solver.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Solves the problem once for each of the setting variants, each updating the settings of a new solver, and checks that
+// a primal solution is found with all variants and that the objective values are the same. The solvers are returned so
+// that the caller can check what is specific to each variant.
+inline bool solveWithSettingVariants(const std::string& filename,
+    const std::vector<std::function<void(SHOT::Solver&)>>& settingVariants,
+    std::vector<std::unique_ptr<SHOT::Solver>>& solvers)
+{
+    solvers.clear();
+
+    for(auto& updateSettings : settingVariants)
+    {
+        auto solver = std::make_unique<SHOT::Solver>();
+        updateSettings(*solver);
+
+        if(!solver->setProblem(filename))
+        {
+            std::cout << "Error while reading problem\n";
+            return (false);
+        }
+
+        if(!solver->solveProblem() || solver->getPrimalSolutions().size() == 0)
+        {
+            std::cout << "No solution found\n";
+            return (false);
+        }
+
+        std::cout << "Objective value " << solver->getPrimalSolution().objValue << " found in "
+                  << solver->getEnvironment()->results->getNumberOfIterations() << " iterations with setting variant "
+                  << solvers.size() + 1 << '\n';
+
+        solvers.push_back(std::move(solver));
+    }
+
+    double referenceObjectiveValue = solvers[0]->getPrimalSolution().objValue;
+
+    for(auto& S : solvers)
+    {
+        if(std::abs(S->getPrimalSolution().objValue - referenceObjectiveValue)
+            > 1e-3 * (1.0 + std::abs(referenceObjectiveValue)))
+        {
+            std::cout << "Different objective values found\n";
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+// Returns one setting variant for each of the values, which updates the settings of a solver with the value
+template <typename T, typename F>
+std::vector<std::function<void(SHOT::Solver&)>> createSettingVariants(const std::vector<T>& values, F updateSettings)
+{
+    std::vector<std::function<void(SHOT::Solver&)>> settingVariants;
+
+    for(const auto& V : values)
+        settingVariants.push_back([V, updateSettings](SHOT::Solver& solver) { updateSettings(solver, V); });
+
+    return (settingVariants);
+}
+
+// Solves a MINLP problem with interior points from one and several minimax problems in the ESH method, where the
+// minimax problems are solved in parallel if more than one thread is used (0 is the automatic number of threads)
+inline bool testMultiStartInteriorPoints(const std::string& filename, SHOT::ES_MIPSolver MIPSolver, int numberOfThreads)
+{
+    std::vector<int> numbersOfPoints = { 1, 4 };
+
+    auto useStartingPoints = [MIPSolver, numberOfThreads](SHOT::Solver& solver, int numberOfPoints) {
+        solver.updateSetting("MIP.Solver", "Dual", static_cast<int>(MIPSolver));
+        solver.updateSetting("Threads", "Strategy", numberOfThreads);
+        solver.updateSetting("CutStrategy", "Dual", static_cast<int>(SHOT::ES_HyperplaneCutStrategy::ESH));
+        solver.updateSetting("ESH.InteriorPoint.MultiStart.Points", "Dual", numberOfPoints);
+    };
+
+    std::vector<std::unique_ptr<SHOT::Solver>> solvers;
+
+    if(!solveWithSettingVariants(filename, createSettingVariants(numbersOfPoints, useStartingPoints), solvers))
+        return (false);
+
+    for(size_t i = 0; i < solvers.size(); i++)
+    {
+        auto env = solvers[i]->getEnvironment();
+
+        std::cout << env->solutionStatistics.numberOfOriginalInteriorPoints << " interior points found from "
+                  << numbersOfPoints[i] << " starting points\n";
+
+        if(env->solutionStatistics.numberOfOriginalInteriorPoints == 0)
+        {
+            std::cout << "No interior point found\n";
+            return (false);
+        }
+
+        // Each minimax problem is solved with at least one LP problem
+        if(env->solutionStatistics.numberOfProblemsMinimaxLP < numbersOfPoints[i])
+        {
+            std::cout << "Not all minimax problems were solved\n";
+            return (false);
+        }
+    }
+
+    return (true);
+}